@@ -0,0 +1,105 @@
+/**
+ * @file alert.h
+ * @brief Alert state machine for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Every sensor has an alert state (normal, alert or critical). A state is entered when
+ * the value crosses its threshold and left only when the value falls back below the
+ * threshold minus a hysteresis band, and a change must persist for a minimum dwell
+ * time before it is taken. Only the resulting transitions are published, as events on
+ * the monitoring event queue, so a sensor hovering around a threshold produces one
+ * alert instead of one per sample.
+ *
+ * @note All public functions are serialized by an internal mutex.
+ */
+
+#ifndef ALERT_H
+#define ALERT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define ALERT_MAX_SENSORS 1024      ///< Maximum number of distinct sensors (power of two)
+
+// Alert states, in increasing severity
+typedef enum {
+    ALERT_STATE_NORMAL = 0,         ///< Below the alert threshold
+    ALERT_STATE_ALERT,              ///< Above the alert threshold
+    ALERT_STATE_CRITICAL            ///< Above the critical threshold
+} AlertState;
+
+// Thresholds and debounce of one sensor
+typedef struct {
+    float alert_threshold;          ///< Value above which the sensor is in alert
+    float critical_threshold;       ///< Value above which the sensor is critical
+    float hysteresis;               ///< Distance below a threshold needed to leave its state
+    uint32_t raise_dwell_s;         ///< Time a higher state must persist before it is entered
+    uint32_t clear_dwell_s;         ///< Time a lower state must persist before it is entered
+} AlertConfig;
+
+// Alert status of one sensor
+typedef struct {
+    AlertState state;               ///< Current state
+    uint32_t since;                 ///< Time the current state was entered
+    uint32_t alert_count;           ///< Transitions into alert or critical from normal
+    uint32_t critical_count;        ///< Transitions into critical
+    uint32_t samples;               ///< Valid samples evaluated
+    uint32_t critical_samples;      ///< Samples evaluated while critical
+} AlertStatus;
+
+// Function prototypes
+/**
+ * @brief Initialize the alert engine
+ * @param default_config Thresholds for sensors without their own configuration
+ * @return true if initialization successful, false otherwise
+ */
+bool alert_init(const AlertConfig* default_config);
+
+/**
+ * @brief Release alert engine resources
+ */
+void alert_cleanup(void);
+
+/**
+ * @brief Set the thresholds of one sensor
+ * @param sensor_id Sensor identifier
+ * @param config Pointer to the thresholds
+ * @return true if stored, false if the sensor table is full or the engine is not running
+ * @note The current state is kept; new thresholds apply from the next sample.
+ */
+bool alert_configure_sensor(const char* sensor_id, const AlertConfig* config);
+
+/**
+ * @brief Get the thresholds that apply to a sensor
+ * @param sensor_id Sensor identifier
+ * @param config Pointer to store the sensor's own thresholds, or the defaults
+ * @return true if stored, false if the engine is not running
+ */
+bool alert_get_config(const char* sensor_id, AlertConfig* config);
+
+/**
+ * @brief Run one sample through its sensor's state machine
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample caused a state transition, false otherwise
+ */
+bool alert_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the alert status of a sensor
+ * @param sensor_id Sensor identifier
+ * @param status Pointer to store the status
+ * @return true if the sensor is known, false otherwise
+ */
+bool alert_get_status(const char* sensor_id, AlertStatus* status);
+
+/**
+ * @brief Get the printable name of an alert state
+ * @param state Alert state
+ * @return Name of the state
+ */
+const char* alert_state_to_string(AlertState state);
+
+#endif // ALERT_H
@@ -0,0 +1,112 @@
+/**
+ * @file anomaly.h
+ * @brief Online anomaly detection for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Scores every sample against two O(1) models of its sensor's recent behaviour: an
+ * exponentially weighted mean and variance (z-score), and streaming estimates of the
+ * median and median absolute deviation (robust z-score, insensitive to the outliers it
+ * is looking for). A sample is anomalous when either score exceeds its threshold. The
+ * start of every anomalous run is published on the monitoring event queue.
+ *
+ * @note All registry functions are serialized by an internal mutex. AnomalyDetector
+ * itself has no locking and can be embedded in other components.
+ */
+
+#ifndef ANOMALY_H
+#define ANOMALY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define ANOMALY_MAX_SENSORS 1024    ///< Maximum number of distinct sensors (power of two)
+
+// Detector configuration
+typedef struct {
+    float alpha;                ///< EWMA weight of a new sample (0-1)
+    float median_step;          ///< Median and MAD step as a fraction of the current spread
+    float min_scale;            ///< Smallest spread used for the robust score, in sensor units
+    float z_threshold;          ///< |z-score| above which a sample is anomalous
+    float robust_threshold;     ///< |robust z-score| above which a sample is anomalous
+    uint32_t warmup_samples;    ///< Samples seen before any sample is scored as anomalous
+} AnomalyConfig;
+
+// Streaming state of one signal
+typedef struct {
+    float mean;                 ///< EWMA mean
+    float variance;             ///< EWMA variance
+    float median;               ///< Streaming median estimate
+    float mad;                  ///< Streaming median absolute deviation estimate
+    uint32_t count;             ///< Samples seen
+    bool anomalous;             ///< Whether the previous sample was anomalous
+} AnomalyDetector;
+
+// Score of one sample, against the state before the sample
+typedef struct {
+    float z_score;              ///< (value - mean) / standard deviation
+    float robust_z;             ///< (value - median) / (1.4826 * MAD)
+    bool is_anomaly;            ///< Whether either score exceeded its threshold
+} AnomalyScore;
+
+// Anomaly status of one sensor
+typedef struct {
+    AnomalyDetector detector;   ///< Current model of the sensor
+    AnomalyScore last_score;    ///< Score of the latest sample
+    uint32_t anomaly_count;     ///< Number of anomalous runs started
+} AnomalyStatus;
+
+// Function prototypes
+/**
+ * @brief Reset a detector
+ * @param detector Pointer to the detector
+ */
+void anomaly_detector_init(AnomalyDetector* detector);
+
+/**
+ * @brief Score a value and fold it into the detector
+ * @param detector Pointer to the detector
+ * @param config Pointer to the configuration
+ * @param value New value
+ * @param score Pointer to store the score, or NULL
+ * @return true if the value is anomalous, false otherwise
+ */
+bool anomaly_detector_update(AnomalyDetector* detector, const AnomalyConfig* config,
+                             float value, AnomalyScore* score);
+
+/**
+ * @brief Initialize the per-sensor anomaly detectors
+ * @param config Pointer to configuration, or NULL for the defaults
+ * @return true if initialization successful, false otherwise
+ */
+bool anomaly_init(const AnomalyConfig* config);
+
+/**
+ * @brief Release the per-sensor anomaly detectors
+ */
+void anomaly_cleanup(void);
+
+/**
+ * @brief Score one sample of a sensor
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample started an anomalous run, false otherwise
+ */
+bool anomaly_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the anomaly status of a sensor
+ * @param sensor_id Sensor identifier
+ * @param status Pointer to store the status
+ * @return true if the sensor is known, false otherwise
+ */
+bool anomaly_get_status(const char* sensor_id, AnomalyStatus* status);
+
+/**
+ * @brief Get the default detector configuration
+ * @param config Pointer to store the configuration
+ */
+void anomaly_get_default_config(AnomalyConfig* config);
+
+#endif // ANOMALY_H
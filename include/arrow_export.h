@@ -0,0 +1,44 @@
+/**
+ * @file arrow_export.h
+ * @brief Apache Arrow IPC export of sample history for the Industrial AI-Powered Edge
+ *        Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Writes chunk log samples to an Arrow IPC file (the "Feather v2" format read by
+ * pyarrow, pandas and Apache.Arrow for .NET) without any external library. The file has
+ * three columns: `timestamp` (timestamp[s, UTC]), `sensor_id` (utf8) and `value`
+ * (float32, exactly as stored). Buffers are little-endian, uncompressed and 64-byte
+ * aligned so readers can memory-map them without copying.
+ */
+
+#ifndef ARROW_EXPORT_H
+#define ARROW_EXPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ARROW_EXPORT_BATCH_ROWS 65536   ///< Rows per record batch
+
+// Export counters
+typedef struct {
+    uint64_t rows;          ///< Rows written
+    uint32_t batches;       ///< Record batches written
+    uint64_t bytes;         ///< Size of the written file
+} ArrowExportStats;
+
+// Function prototypes
+/**
+ * @brief Export chunk log samples to an Arrow IPC file
+ * @param path Output file path
+ * @param sensor_id Sensor identifier, or NULL for all sensors
+ * @param from First time of the range in Unix seconds
+ * @param to Last time of the range in Unix seconds
+ * @param stats Pointer to store export counters, may be NULL
+ * @return true if the file was written completely, false otherwise
+ * @note The chunk log must be initialized; rows follow chunk order, not global time order.
+ */
+bool arrow_export_chunk_log(const char* path, const char* sensor_id, uint32_t from, uint32_t to,
+                            ArrowExportStats* stats);
+
+#endif // ARROW_EXPORT_H
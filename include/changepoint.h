@@ -0,0 +1,163 @@
+/**
+ * @file changepoint.h
+ * @brief Streaming change-point detection for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Catches persistent shifts and slow drifts of a sensor's level that never cross an
+ * alert threshold, such as a fouling heat exchanger. Each sensor first learns a
+ * reference mean and standard deviation over a warm-up period; samples are then
+ * standardized against it and fed to two detectors in O(1) state:
+ * - a two-sided CUSUM, which accumulates deviations beyond an allowance k and signals
+ *   when either sum exceeds h, and is fastest on step changes;
+ * - a two-sided Page-Hinkley test, which accumulates deviations from the running mean
+ *   beyond a tolerance delta and signals when the sum rises lambda above its minimum
+ *   (or falls below its maximum), and is suited to gradual drifts.
+ * All parameters are in reference standard deviations, so one configuration fits every
+ * sensor of a type. A detected change is published on the monitoring event queue and
+ * the detector re-learns its reference from the new regime.
+ *
+ * @note All registry functions are serialized by an internal mutex. ChangepointDetector
+ * itself has no locking and can be embedded in other components.
+ */
+
+#ifndef CHANGEPOINT_H
+#define CHANGEPOINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define CHANGEPOINT_MAX_SENSORS 1024    ///< Maximum number of distinct sensors (power of two)
+
+// Detector configuration
+typedef struct {
+    bool enabled;               ///< Run the detectors on sensors of this type
+    uint32_t warmup_samples;    ///< Samples used to learn the reference
+    float min_sigma;            ///< Smallest reference standard deviation, in sensor units
+    float cusum_k;              ///< CUSUM allowance, in reference standard deviations
+    float cusum_h;              ///< CUSUM decision threshold, in reference standard deviations
+    float ph_delta;             ///< Page-Hinkley tolerance, in reference standard deviations
+    float ph_lambda;            ///< Page-Hinkley decision threshold, in reference standard deviations
+} ChangepointConfig;
+
+// Detectors that can signal a change
+typedef enum {
+    CHANGEPOINT_METHOD_NONE = 0,    ///< No change
+    CHANGEPOINT_METHOD_CUSUM,       ///< Two-sided CUSUM
+    CHANGEPOINT_METHOD_PAGE_HINKLEY ///< Two-sided Page-Hinkley
+} ChangepointMethod;
+
+// Detected change
+typedef struct {
+    ChangepointMethod method;   ///< Detector that signalled
+    int32_t direction;          ///< +1 for an upward change, -1 for a downward change
+    float shift;                ///< Estimated shift of the mean, in reference standard deviations
+    float reference;            ///< Reference mean before the change
+} ChangepointResult;
+
+// Streaming state of one signal
+typedef struct {
+    uint32_t count;             ///< Samples since the reference was (re)started
+    double warmup_mean;         ///< Running mean during the warm-up
+    double warmup_m2;           ///< Running sum of squared deviations during the warm-up
+    float reference;            ///< Reference mean
+    float sigma;                ///< Reference standard deviation
+    bool ready;                 ///< Reference learned, detectors running
+    float cusum_high;           ///< Upper CUSUM
+    float cusum_low;            ///< Lower CUSUM
+    uint32_t high_run;          ///< Samples since the upper CUSUM was last zero
+    uint32_t low_run;           ///< Samples since the lower CUSUM was last zero
+    float high_sum;             ///< Sum of standardized samples over high_run
+    float low_sum;              ///< Sum of standardized samples over low_run
+    uint32_t ph_count;          ///< Samples fed to Page-Hinkley
+    double ph_sum;              ///< Sum of the standardized samples
+    double ph_up;               ///< Cumulative sum for upward changes
+    double ph_up_min;           ///< Minimum of ph_up
+    uint32_t ph_up_min_count;   ///< ph_count when ph_up reached its minimum
+    double ph_up_min_sum;       ///< ph_sum when ph_up reached its minimum
+    double ph_down;             ///< Cumulative sum for downward changes
+    double ph_down_max;         ///< Maximum of ph_down
+    uint32_t ph_down_max_count; ///< ph_count when ph_down reached its maximum
+    double ph_down_max_sum;     ///< ph_sum when ph_down reached its maximum
+} ChangepointDetector;
+
+// Change-point status of one sensor
+typedef struct {
+    ChangepointDetector detector;   ///< Current state of the sensor's detectors
+    ChangepointResult last_change;  ///< Most recent change
+    uint32_t last_change_time;      ///< Time of the most recent change in Unix seconds, 0 if none
+    uint32_t change_count;          ///< Number of changes detected
+} ChangepointStatus;
+
+// Function prototypes
+/**
+ * @brief Reset a detector
+ * @param detector Pointer to the detector
+ */
+void changepoint_detector_init(ChangepointDetector* detector);
+
+/**
+ * @brief Feed one value to a detector
+ * @param detector Pointer to the detector
+ * @param config Pointer to the configuration
+ * @param value New value
+ * @param result Pointer to store the change, or NULL
+ * @return true if the value completed a change, false otherwise
+ * @note After a change the detector restarts its warm-up on the following samples.
+ */
+bool changepoint_detector_update(ChangepointDetector* detector, const ChangepointConfig* config,
+                                 float value, ChangepointResult* result);
+
+/**
+ * @brief Initialize the per-sensor change-point detectors
+ * @param default_config Pointer to the configuration of every sensor type, or NULL for
+ * the defaults
+ * @return true if initialization successful, false otherwise
+ */
+bool changepoint_init(const ChangepointConfig* default_config);
+
+/**
+ * @brief Release the per-sensor change-point detectors
+ */
+void changepoint_cleanup(void);
+
+/**
+ * @brief Set the configuration of one sensor type
+ * @param type Sensor type
+ * @param config Pointer to the configuration
+ * @return true if the configuration is valid, false otherwise
+ * @note Sensors of the type that are already running keep their learned reference.
+ */
+bool changepoint_configure_type(SensorType type, const ChangepointConfig* config);
+
+/**
+ * @brief Feed one sample of a sensor
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample completed a change, false otherwise
+ */
+bool changepoint_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the change-point status of a sensor
+ * @param sensor_id Sensor identifier
+ * @param status Pointer to store the status
+ * @return true if the sensor is known, false otherwise
+ */
+bool changepoint_get_status(const char* sensor_id, ChangepointStatus* status);
+
+/**
+ * @brief Get the printable name of a detection method
+ * @param method Detection method
+ * @return Name of the method
+ */
+const char* changepoint_method_to_string(ChangepointMethod method);
+
+/**
+ * @brief Get the default detector configuration
+ * @param config Pointer to store the configuration
+ */
+void changepoint_get_default_config(ChangepointConfig* config);
+
+#endif // CHANGEPOINT_H
@@ -0,0 +1,152 @@
+/**
+ * @file chunk_log.h
+ * @brief Multiplexed append-only sample log for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Samples of all sensors go to a single append-only data file. Each sensor's samples
+ * are buffered in memory and written out as one contiguous chunk (a header followed by
+ * a column of timestamps and a column of values), so the file only ever sees large
+ * sequential writes and a per-sensor read touches only that sensor's chunks. Every
+ * chunk gets a fixed-size entry in a companion index file keyed by sensor and time
+ * range; the index is loaded at start-up and rebuilt from the data file if it is
+ * missing or behind.
+ *
+ * @note All public functions are serialized by an internal mutex.
+ */
+
+#ifndef CHUNK_LOG_H
+#define CHUNK_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define CHUNK_LOG_MAGIC 0x4B4E4843u      ///< "CHNK" in little-endian byte order
+#define CHUNK_LOG_VERSION 1              ///< On-disk format version
+#define CHUNK_LOG_MAX_SAMPLES 4096       ///< Upper bound on samples per chunk
+#define CHUNK_LOG_MAX_SENSORS 4096       ///< Maximum number of distinct sensors (power of two)
+
+// On-disk chunk header; followed by uint32_t timestamps[count] and float values[count]
+typedef struct {
+    uint32_t magic;         ///< CHUNK_LOG_MAGIC
+    uint16_t version;       ///< CHUNK_LOG_VERSION
+    uint16_t count;         ///< Number of samples in the chunk
+    char sensor_id[32];     ///< Sensor identifier
+    uint32_t sensor_type;   ///< SensorType of the sensor
+    uint32_t t_min;         ///< Earliest sample time in Unix seconds
+    uint32_t t_max;         ///< Latest sample time in Unix seconds
+    uint32_t crc;           ///< CRC-32 of the payload
+} ChunkHeader;
+
+// On-disk index entry, one per chunk
+typedef struct {
+    uint32_t sensor_hash;   ///< FNV-1a hash of the sensor identifier
+    uint32_t t_min;         ///< Earliest sample time in the chunk
+    uint32_t t_max;         ///< Latest sample time in the chunk
+    uint32_t count;         ///< Number of samples in the chunk
+    uint64_t offset;        ///< Offset of the chunk header in the data file
+} ChunkIndexEntry;
+
+// Chunk log configuration
+typedef struct {
+    char data_file[128];    ///< Path of the multiplexed data file
+    char index_file[128];   ///< Path of the chunk index file
+    uint32_t chunk_samples; ///< Samples buffered per sensor before a chunk is written
+    uint32_t max_buffer_age_s; ///< Oldest buffered sample age that forces a chunk out, 0 to disable
+    bool read_only;         ///< Open for queries only, e.g. from a tool while the logger is running
+} ChunkLogConfig;
+
+/**
+ * @brief Receives the samples of one chunk that fall into a query range
+ * @param sensor_id Sensor identifier
+ * @param type Sensor type
+ * @param timestamps Sample times in Unix seconds
+ * @param values Sample values
+ * @param count Number of samples
+ * @param context Caller context passed to the query
+ * @return true to continue the query, false to stop it
+ */
+typedef bool (*ChunkLogCallback)(const char* sensor_id, SensorType type, const uint32_t* timestamps,
+                                 const float* values, uint32_t count, void* context);
+
+// Function prototypes
+/**
+ * @brief Open the chunk log, loading or rebuilding its index
+ * @param config Pointer to chunk log configuration
+ * @return true if initialization successful, false otherwise
+ * @note A torn chunk at the end of the data file, left by a crash, is truncated away unless
+ *       the log is opened read-only, in which case it is just ignored.
+ */
+bool chunk_log_init(const ChunkLogConfig* config);
+
+/**
+ * @brief Write out all buffered samples and close the chunk log
+ */
+void chunk_log_cleanup(void);
+
+/**
+ * @brief Buffer one sample; a chunk is written when the sensor's buffer fills up
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample was accepted, false otherwise
+ * @note When a chunk write fails, the full buffer is kept and the write is retried on the
+ * sensor's next sample, which is rejected while the write keeps failing.
+ */
+bool chunk_log_append(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Write out buffers whose oldest sample exceeds the configured age
+ * @param now Current time in Unix seconds
+ * @return true if all due chunks were written, false on I/O error
+ * @note Call periodically; chunk_log_append() only checks the age of the sensor it
+ * appends to, so a quiet sensor's buffer is written out here. Does nothing when
+ * max_buffer_age_s is 0.
+ */
+bool chunk_log_flush(uint32_t now);
+
+/**
+ * @brief Read the samples of a sensor, or of all sensors, within a time range
+ * @param sensor_id Sensor identifier, or NULL for all sensors
+ * @param from First time of the range in Unix seconds
+ * @param to Last time of the range in Unix seconds
+ * @param callback Function receiving the samples chunk by chunk
+ * @param context Caller context passed to the callback
+ * @return true if the query completed, false on error or when stopped by the callback
+ * @note Samples still buffered in memory are reported after the stored chunks. Chunks
+ * that fail their CRC or do not match their index entry are skipped and counted, see
+ * chunk_log_skipped_chunks().
+ */
+bool chunk_log_query(const char* sensor_id, uint32_t from, uint32_t to,
+                     ChunkLogCallback callback, void* context);
+
+/**
+ * @brief Get the number of chunks in the index
+ * @return Number of indexed chunks
+ */
+uint32_t chunk_log_chunk_count(void);
+
+/**
+ * @brief Get the number of damaged chunks queries have skipped
+ * @return Chunks skipped since initialization, counted once per query that met them
+ */
+uint32_t chunk_log_skipped_chunks(void);
+
+/**
+ * @brief Check a chunk read straight from a data file
+ * @param header Pointer to the chunk header
+ * @param payload Pointer to the timestamps and values that follow it, or NULL to check
+ *        only the header
+ * @return true if the magic, version and count are valid and the payload matches its
+ *         CRC-32, false otherwise
+ * @note Needs no initialized chunk log, so tools can read data files directly.
+ */
+bool chunk_log_verify_chunk(const ChunkHeader* header, const void* payload);
+
+/**
+ * @brief Get the default chunk log configuration
+ * @param config Pointer to store the configuration
+ */
+void chunk_log_get_default_config(ChunkLogConfig* config);
+
+#endif // CHUNK_LOG_H
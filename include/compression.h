@@ -0,0 +1,168 @@
+/**
+ * @file compression.h
+ * @brief Report-by-exception compression for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Thins each sensor's samples before they are stored or sent, keeping only the points
+ * needed to reconstruct the signal within a configured deviation:
+ * - deadband forwards a sample when it differs from the last forwarded one by more than
+ *   the deviation; holding the last forwarded value reconstructs the signal;
+ * - swinging door holds the latest sample back while every sample since the last
+ *   forwarded point stays within the deviation of the straight line to it. When a
+ *   sample falls outside the doors, the held sample is forwarded and becomes the new
+ *   pivot. Linear interpolation between forwarded points reconstructs the signal.
+ * Forwarded points are always real samples. Invalid samples and samples older than
+ * the previous one are forwarded as they are, after any held sample, and restart the
+ * compression. A maximum interval forces a point out on quiet signals, so storage
+ * shows the sensor is still reporting.
+ *
+ * @note All registry functions are serialized by an internal mutex; sinks are called
+ * with it held and must not call back into this module. Compressor itself has no
+ * locking and can be embedded in other components.
+ */
+
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define COMPRESSION_MAX_SENSORS 1024    ///< Maximum number of distinct sensors (power of two)
+#define COMPRESSION_MAX_OUTPUT 2        ///< Most points forwarded for one sample
+
+// Compression methods
+typedef enum {
+    COMPRESSION_NONE = 0,           ///< Forward every sample
+    COMPRESSION_DEADBAND,           ///< Forward changes larger than the deviation
+    COMPRESSION_SWINGING_DOOR       ///< Forward the points of a piecewise linear fit
+} CompressionMethod;
+
+// Compression configuration
+typedef struct {
+    CompressionMethod method;       ///< Compression method
+    float deviation;                ///< Largest reconstruction error, in sensor units
+    uint32_t max_interval_s;        ///< Longest time between forwarded points in seconds, 0 for no limit
+} CompressionConfig;
+
+// Streaming state of one signal
+typedef struct {
+    bool archived;                  ///< A point has been forwarded since the last restart
+    bool held;                      ///< held_data is waiting to be forwarded or dropped
+    uint32_t archive_time;          ///< Time of the last forwarded point
+    float archive_value;            ///< Value of the last forwarded point
+    uint32_t last_timestamp;        ///< Time of the latest sample
+    float slope_low;                ///< Lower door, smallest slope from the pivot fitting every sample
+    float slope_high;               ///< Upper door, largest slope from the pivot fitting every sample
+    SensorData held_data;           ///< Latest sample, held back by the swinging door
+} Compressor;
+
+// Compression status of one sensor
+typedef struct {
+    uint32_t samples;               ///< Samples received
+    uint32_t forwarded;             ///< Points forwarded
+    uint32_t last_forwarded;        ///< Time of the last forwarded point in Unix seconds
+} CompressionStatus;
+
+/**
+ * @brief Receiver of forwarded points
+ * @param sensor Sensor that produced the point
+ * @param data Forwarded sample
+ * @param context User context
+ */
+typedef void (*CompressionSink)(const Sensor* sensor, const SensorData* data, void* context);
+
+// Function prototypes
+/**
+ * @brief Reset a compressor
+ * @param compressor Pointer to the compressor
+ */
+void compressor_init(Compressor* compressor);
+
+/**
+ * @brief Feed one sample to a compressor
+ * @param compressor Pointer to the compressor
+ * @param config Pointer to the configuration
+ * @param data Pointer to the sample
+ * @param output Array of COMPRESSION_MAX_OUTPUT samples receiving the forwarded points
+ * @return Number of points forwarded, oldest first
+ */
+uint32_t compressor_update(Compressor* compressor, const CompressionConfig* config,
+                           const SensorData* data, SensorData* output);
+
+/**
+ * @brief Take the held sample out of a compressor
+ * @param compressor Pointer to the compressor
+ * @param output Pointer to store the sample
+ * @return true if a sample was held, false otherwise
+ * @note The held sample becomes the last forwarded point.
+ */
+bool compressor_flush(Compressor* compressor, SensorData* output);
+
+/**
+ * @brief Initialize the per-sensor compressors
+ * @param default_config Pointer to the configuration of sensors without their own, or
+ * NULL for the defaults
+ * @return true if initialization successful, false otherwise
+ */
+bool compression_init(const CompressionConfig* default_config);
+
+/**
+ * @brief Release the per-sensor compressors; held samples are dropped
+ */
+void compression_cleanup(void);
+
+/**
+ * @brief Set the configuration of one sensor
+ * @param sensor_id Sensor identifier
+ * @param config Pointer to the configuration
+ * @return true if stored, false on an invalid configuration, a full table or when
+ * compression is not running
+ * @note Takes effect from the sensor's next sample.
+ */
+bool compression_configure_sensor(const char* sensor_id, const CompressionConfig* config);
+
+/**
+ * @brief Compress one sample of a sensor
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample
+ * @param sink Function receiving the forwarded points
+ * @param context User context passed to the sink
+ * @return Number of points forwarded
+ * @note The sensor must stay valid until its held sample is flushed or dropped.
+ */
+uint32_t compression_process_sample(const Sensor* sensor, const SensorData* data,
+                                    CompressionSink sink, void* context);
+
+/**
+ * @brief Forward the held sample of every sensor
+ * @param sink Function receiving the forwarded points
+ * @param context User context passed to the sink
+ * @return Number of points forwarded
+ * @note Call before shutting down so the latest value of every sensor is stored.
+ */
+uint32_t compression_flush(CompressionSink sink, void* context);
+
+/**
+ * @brief Get the compression status of a sensor
+ * @param sensor_id Sensor identifier
+ * @param status Pointer to store the status
+ * @return true if the sensor is known, false otherwise
+ */
+bool compression_get_status(const char* sensor_id, CompressionStatus* status);
+
+/**
+ * @brief Get the printable name of a compression method
+ * @param method Compression method
+ * @return Name of the method
+ */
+const char* compression_method_to_string(CompressionMethod method);
+
+/**
+ * @brief Get the default compression configuration
+ * @param config Pointer to store the configuration
+ */
+void compression_get_default_config(CompressionConfig* config);
+
+#endif // COMPRESSION_H
@@ -0,0 +1,175 @@
+/**
+ * @file correlation.h
+ * @brief Rolling cross-sensor correlation for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Tracks how the sensors of one asset move together, so that a failure showing up as a
+ * broken relationship (temperature no longer following current and flow when cooling
+ * fails) is caught even while every sensor stays within its own limits.
+ *
+ * Sensors are grouped by Sensor.location unless assigned to a group explicitly. Each
+ * group holds the latest value of every member and, once per period, folds that row
+ * into two exponentially weighted covariance matrices: a short-term one following the
+ * current behaviour and a long-term baseline. A rank-one update costs O(n^2) for n
+ * members and touches only the upper triangle, stored as rows padded to four floats so
+ * each row is updated with SSE2 on x86 and NEON on aarch64. A watched pair (baseline
+ * correlation of at least min_baseline in magnitude) whose short-term correlation
+ * departs from the baseline by break_threshold is reported as an
+ * EVENT_CORRELATION_BREAK; it is restored once the difference falls below
+ * clear_threshold.
+ *
+ * @note All registry functions are serialized by an internal mutex. RollingCovariance
+ * itself has no locking and can be embedded in other components.
+ */
+
+#ifndef CORRELATION_H
+#define CORRELATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define CORRELATION_MAX_SENSORS 1024    ///< Maximum number of distinct sensors (power of two)
+#define CORRELATION_MAX_GROUPS 64       ///< Maximum number of groups
+#define CORRELATION_MAX_MEMBERS 512     ///< Maximum number of sensors in one group
+
+// Correlation configuration
+typedef struct {
+    uint32_t period_s;              ///< Seconds between snapshots of a group
+    uint32_t short_window;          ///< Effective snapshots of the short-term matrix
+    uint32_t long_window;           ///< Effective snapshots of the baseline matrix
+    uint32_t warmup_snapshots;      ///< Snapshots a sensor needs before its pairs are watched
+    float min_baseline;             ///< Smallest baseline correlation magnitude of a watched pair
+    float break_threshold;          ///< Correlation difference at which a pair breaks
+    float clear_threshold;          ///< Correlation difference below which a pair is restored
+} CorrelationConfig;
+
+// Exponentially weighted covariance matrix of a growing set of variables
+typedef struct {
+    uint32_t variables;             ///< Variables tracked
+    uint32_t capacity;              ///< Variables the storage holds, a multiple of 4
+    uint32_t window;                ///< Effective number of observations
+    uint32_t count;                 ///< Observations folded in, saturating at window
+    float* mean;                    ///< Means, capacity entries
+    float* deviation;               ///< Scratch for the latest deviations, capacity entries
+    float* covariance;              ///< Row-major upper triangle, capacity rows of capacity floats
+} RollingCovariance;
+
+// Correlation of one sensor pair
+typedef struct {
+    float correlation;              ///< Short-term correlation, NAN if undefined
+    float baseline;                 ///< Baseline correlation, NAN if undefined
+    bool watched;                   ///< Pair is correlated enough and warmed up
+    bool broken;                    ///< Pair is currently reported as broken
+} CorrelationPair;
+
+// Function prototypes
+/**
+ * @brief Prepare an empty covariance matrix
+ * @param covariance Pointer to the matrix
+ * @param capacity Initial number of variables to allocate for
+ * @param window Effective number of observations, at least 1
+ * @return true if allocated, false otherwise
+ * @note Until window observations are folded in, every observation has equal weight.
+ */
+bool rolling_covariance_init(RollingCovariance* covariance, uint32_t capacity, uint32_t window);
+
+/**
+ * @brief Release a covariance matrix
+ * @param covariance Pointer to the matrix
+ */
+void rolling_covariance_free(RollingCovariance* covariance);
+
+/**
+ * @brief Add a variable, growing the storage when needed
+ * @param covariance Pointer to the matrix
+ * @param initial_value First value of the variable, used as its mean
+ * @return true if added, false on allocation failure
+ * @note The new variable starts with zero variance and covariances.
+ */
+bool rolling_covariance_add_variable(RollingCovariance* covariance, float initial_value);
+
+/**
+ * @brief Fold one observation of every variable into the matrix
+ * @param covariance Pointer to the matrix
+ * @param values Array of one value per variable
+ */
+void rolling_covariance_update(RollingCovariance* covariance, const float* values);
+
+/**
+ * @brief Get the correlation of two variables
+ * @param covariance Pointer to the matrix
+ * @param a First variable
+ * @param b Second variable
+ * @return Pearson correlation, NAN if either variance is zero or an index is invalid
+ */
+float rolling_covariance_correlation(const RollingCovariance* covariance, uint32_t a, uint32_t b);
+
+/**
+ * @brief Initialize the correlation groups
+ * @param config Pointer to configuration, or NULL for the defaults
+ * @return true if initialization successful, false otherwise
+ */
+bool correlation_init(const CorrelationConfig* config);
+
+/**
+ * @brief Release the correlation groups
+ */
+void correlation_cleanup(void);
+
+/**
+ * @brief Assign a sensor to a group instead of its location
+ * @param sensor_id Sensor identifier
+ * @param group Group name, or an empty string to leave the sensor out
+ * @return true if stored, false if the sensor already reported, a table is full or
+ * correlation is not running
+ */
+bool correlation_assign_group(const char* sensor_id, const char* group);
+
+/**
+ * @brief Record one sample of a sensor
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample triggered a snapshot of the group, false otherwise
+ */
+bool correlation_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Record one sample of each of several sensors
+ * @param sensors Array of sensors
+ * @param data Array of samples, one per sensor; invalid samples are ignored
+ * @param count Number of sensors
+ * @return Number of group snapshots taken
+ * @note Every group is snapshotted at most once per batch, after all its samples.
+ */
+uint32_t correlation_process_batch(const Sensor* const* sensors, const SensorData* data, uint32_t count);
+
+/**
+ * @brief Get the correlation of two sensors of the same group
+ * @param sensor_a First sensor identifier
+ * @param sensor_b Second sensor identifier
+ * @param pair Pointer to store the correlation
+ * @return true if both sensors are in the same group, false otherwise
+ */
+bool correlation_get_pair(const char* sensor_a, const char* sensor_b, CorrelationPair* pair);
+
+/**
+ * @brief Get the short-term correlation matrix of a group
+ * @param group Group name
+ * @param sensor_ids Array receiving the member identifiers, or NULL
+ * @param matrix Array receiving the row-major correlation matrix, or NULL
+ * @param capacity Most members the arrays can hold
+ * @param members Pointer to store the number of members
+ * @return true if the group exists and fits, false otherwise
+ */
+bool correlation_get_matrix(const char* group, char (*sensor_ids)[32], float* matrix,
+                            uint32_t capacity, uint32_t* members);
+
+/**
+ * @brief Get the default correlation configuration
+ * @param config Pointer to store the configuration
+ */
+void correlation_get_default_config(CorrelationConfig* config);
+
+#endif // CORRELATION_H
@@ -0,0 +1,80 @@
+/**
+ * @file event_queue.h
+ * @brief Lock-free monitoring event queue for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * A bounded multi-producer, multi-consumer ring (Vyukov's sequence-numbered cells)
+ * carrying monitoring events such as alert state transitions from the components that
+ * detect them to whoever reports or forwards them. Pushing and popping never block and
+ * never take a lock; when the ring is full the new event is dropped and counted.
+ */
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define EVENT_QUEUE_CAPACITY 1024   ///< Ring size (power of two)
+
+// Event types
+typedef enum {
+    EVENT_ALERT_TRANSITION = 0,     ///< Alert state of a sensor changed
+    EVENT_ANOMALY,                  ///< A sensor started producing anomalous samples
+    EVENT_RULE,                     ///< A rule became active or inactive
+    EVENT_CHANGE_POINT,             ///< The level of a sensor shifted or drifted
+    EVENT_CORRELATION_BREAK,        ///< Two sensors stopped or resumed moving together
+    EVENT_FORECAST_DEVIATION,       ///< A sensor departed from its seasonal forecast
+    EVENT_STATE_CHANGE              ///< The operating state of a location changed
+} MonitorEventType;
+
+// Monitoring event
+typedef struct {
+    MonitorEventType type;  ///< Kind of event
+    char sensor_id[32];     ///< Sensor the event refers to, or the rule name for EVENT_RULE, the location for EVENT_STATE_CHANGE
+    SensorType sensor_type; ///< Type of that sensor
+    uint32_t timestamp;     ///< Time of the triggering sample in Unix seconds
+    float value;            ///< Value of the triggering sample
+    int32_t from_state;     ///< Previous state, for transitions; detection method for change points
+    int32_t to_state;       ///< New state, for transitions; direction (+1 / -1) for change points and forecast deviations
+    float score;            ///< Detector-specific magnitude, 0 if unused
+    char peer_id[32];       ///< Second sensor of the pair for EVENT_CORRELATION_BREAK, empty otherwise
+} MonitorEvent;
+
+// Function prototypes
+/**
+ * @brief Empty the queue and reset its counters
+ * @note Not safe against concurrent producers or consumers; call before they start.
+ */
+void event_queue_reset(void);
+
+/**
+ * @brief Append an event
+ * @param event Pointer to the event to copy into the queue
+ * @return true if queued, false if the queue was full and the event was dropped
+ */
+bool event_queue_push(const MonitorEvent* event);
+
+/**
+ * @brief Remove the oldest event
+ * @param event Pointer to store the event
+ * @return true if an event was returned, false if the queue was empty
+ */
+bool event_queue_pop(MonitorEvent* event);
+
+/**
+ * @brief Get the number of events dropped because the queue was full
+ * @return Number of dropped events since the last reset
+ */
+uint64_t event_queue_dropped(void);
+
+/**
+ * @brief Get the printable name of an event type
+ * @param type Event type
+ * @return Name of the event type
+ */
+const char* event_queue_type_to_string(MonitorEventType type);
+
+#endif // EVENT_QUEUE_H
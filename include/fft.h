@@ -0,0 +1,130 @@
+/**
+ * @file fft.h
+ * @brief Real-input FFT and spectral features for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Transforms blocks of real samples (for example vibration) of a power-of-two size.
+ * A block of N real samples is packed into N/2 complex values, transformed with
+ * radix-4 decimation-in-time passes (plus one radix-2 pass when log2(N/2) is odd) and
+ * unpacked into the N/2 + 1 bins of the real spectrum. Window coefficients, bit-reversal
+ * indices and per-pass twiddle tables are computed once in the plan; the butterflies
+ * use SSE2 on x86 and NEON on aarch64.
+ *
+ * Nothing is allocated: a plan is a plain structure the caller owns, typically static.
+ *
+ * @note A plan holds scratch buffers and must be used by one thread at a time. Use one
+ * plan per thread to transform in parallel.
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FFT_MIN_SIZE 16             ///< Smallest transform size
+#define FFT_MAX_SIZE 8192           ///< Largest transform size
+
+// Analysis windows
+typedef enum {
+    FFT_WINDOW_RECTANGULAR = 0,     ///< No window
+    FFT_WINDOW_HANN,                ///< Hann, good general-purpose leakage
+    FFT_WINDOW_HAMMING,             ///< Hamming, lower first sidelobe than Hann
+    FFT_WINDOW_BLACKMAN_HARRIS      ///< 4-term Blackman-Harris, -92 dB sidelobes
+} FftWindow;
+
+// Spectral peak
+typedef struct {
+    float frequency_hz;     ///< Interpolated peak frequency
+    float amplitude;        ///< Interpolated amplitude of a sinusoid at that frequency
+} FftPeak;
+
+// Transform plan and scratch space
+typedef struct {
+    uint32_t size;                              ///< Number of real input samples
+    FftWindow window;                           ///< Window applied to the input
+    float window_sum;                           ///< Sum of the window coefficients
+    float window_power;                         ///< Sum of the squared window coefficients
+    float window_coeffs[FFT_MAX_SIZE];          ///< Window coefficients
+    uint16_t bit_reverse[FFT_MAX_SIZE / 2];     ///< Bit-reversed complex index
+    float twiddles[2 * FFT_MAX_SIZE];           ///< Per-pass twiddles, split re/im
+    float unpack_re[FFT_MAX_SIZE / 4 + 1];      ///< Real-unpacking twiddles, real part
+    float unpack_im[FFT_MAX_SIZE / 4 + 1];      ///< Real-unpacking twiddles, imaginary part
+    float work_re[FFT_MAX_SIZE / 2];            ///< Complex transform, real part
+    float work_im[FFT_MAX_SIZE / 2];            ///< Complex transform, imaginary part
+    float spectrum_re[FFT_MAX_SIZE / 2 + 1];    ///< Last real spectrum, real part
+    float spectrum_im[FFT_MAX_SIZE / 2 + 1];    ///< Last real spectrum, imaginary part
+} FftPlan;
+
+// Function prototypes
+/**
+ * @brief Prepare a plan
+ * @param plan Pointer to the plan
+ * @param size Number of real samples per block, a power of two in FFT_MIN_SIZE..FFT_MAX_SIZE
+ * @param window Window applied to every block
+ * @return true if the plan is ready, false if the size is not supported
+ */
+bool fft_plan_init(FftPlan* plan, uint32_t size, FftWindow window);
+
+/**
+ * @brief Transform one windowed block
+ * @param plan Pointer to the plan
+ * @param input Block of plan->size real samples
+ * @note The size / 2 + 1 bins are left in plan->spectrum_re and plan->spectrum_im,
+ * unnormalized.
+ */
+void fft_forward(FftPlan* plan, const float* input);
+
+/**
+ * @brief Transform one windowed block into a one-sided power spectrum
+ * @param plan Pointer to the plan
+ * @param input Block of plan->size real samples
+ * @param power Array of size / 2 + 1 bins to store the power in
+ * @note Bins are mean square values corrected for the window's noise bandwidth, so
+ * their sum is the mean square of the block (Parseval) for broadband signals.
+ */
+void fft_power_spectrum(FftPlan* plan, const float* input, float* power);
+
+/**
+ * @brief Get the centre frequency of a bin
+ * @param plan Pointer to the plan
+ * @param sample_rate Sample rate in Hz
+ * @param bin Bin index
+ * @return Frequency in Hz
+ */
+float fft_bin_frequency(const FftPlan* plan, float sample_rate, uint32_t bin);
+
+/**
+ * @brief Sum the power of a frequency band
+ * @param plan Pointer to the plan
+ * @param power Power spectrum from fft_power_spectrum()
+ * @param sample_rate Sample rate in Hz
+ * @param low_hz Lower band edge, inclusive
+ * @param high_hz Upper band edge, exclusive
+ * @return Mean square value of the band
+ */
+float fft_band_energy(const FftPlan* plan, const float* power, float sample_rate,
+                      float low_hz, float high_hz);
+
+/**
+ * @brief Find the strongest spectral peaks
+ * @param plan Pointer to the plan
+ * @param power Power spectrum from fft_power_spectrum()
+ * @param sample_rate Sample rate in Hz
+ * @param peaks Array to store the peaks in, strongest first
+ * @param max_peaks Capacity of the array
+ * @return Number of peaks stored
+ * @note Peaks are local maxima, refined by parabolic interpolation of the log power.
+ */
+uint32_t fft_find_peaks(const FftPlan* plan, const float* power, float sample_rate,
+                        FftPeak* peaks, uint32_t max_peaks);
+
+/**
+ * @brief Get the printable name of a window
+ * @param window Window
+ * @return Name of the window
+ */
+const char* fft_window_to_string(FftWindow window);
+
+#endif // FFT_H
@@ -0,0 +1,180 @@
+/**
+ * @file forecast.h
+ * @brief Seasonal forecasting for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Factory signals follow shift, day and week cycles, so a fixed threshold either fires
+ * every afternoon or misses a fault at night. This module forecasts each sensor with
+ * additive Holt-Winters (triple exponential) smoothing: a level, a trend per second and
+ * a seasonal offset per time-of-season slot, for example 1440 one-minute slots for a
+ * daily cycle or 10080 for a weekly one. Every sample updates the level, the trend and
+ * its own slot in O(1). A sample is scored against the forecast made before it, in
+ * units of the residual standard deviation, and the start of every run of deviating
+ * samples is published on the monitoring event queue.
+ *
+ * The first pass over the season fills each slot with the mean of its samples, and their
+ * spread seeds the residual variance. For a sensor reporting less than once per slot,
+ * the steps between consecutive slots floor it instead. The forecaster becomes ready once a whole season has elapsed; until then samples are
+ * not scored. Deviating samples update the model with their error clipped to the
+ * threshold, so a fault does not teach the model its own shape.
+ *
+ * @note All registry functions are serialized by an internal mutex. HoltWinters itself
+ * has no locking and can be embedded in other components. The seasonal arrays are
+ * allocated when a sensor first reports: 4 bytes per slot plus a bit for first-pass
+ * bookkeeping, about 41 KB per sensor for a weekly season at one-minute slots.
+ */
+
+#ifndef FORECAST_H
+#define FORECAST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define FORECAST_MAX_SENSORS 4096       ///< Maximum number of distinct sensors (power of two)
+#define FORECAST_MAX_SLOTS 10080        ///< Maximum slots per season (a week of minutes)
+
+// Forecaster configuration
+typedef struct {
+    bool enabled;               ///< Forecast sensors of this type
+    uint32_t slot_s;            ///< Seconds covered by one seasonal slot
+    uint32_t season_slots;      ///< Slots per season, at most FORECAST_MAX_SLOTS
+    float alpha;                ///< Level smoothing per sample (0-1]
+    float beta;                 ///< Trend smoothing per sample [0-1]
+    float gamma;                ///< Seasonal smoothing per sample [0-1]
+    float error_alpha;          ///< Weight of a new squared error in the residual variance (0-1]
+    float min_sigma;            ///< Smallest residual standard deviation, in sensor units
+    float threshold;            ///< |deviation| in residual standard deviations that flags a sample
+} ForecastConfig;
+
+// Streaming Holt-Winters model of one signal
+typedef struct {
+    uint32_t slot_s;            ///< Seconds per slot
+    uint32_t season_slots;      ///< Slots per season
+    float* seasonal;            ///< Seasonal offsets, season_slots entries
+    uint32_t* filled;           ///< Bitmap of slots visited in the first pass
+    double level;               ///< Level at last_timestamp
+    double trend;               ///< Trend per second
+    double seasonal_sum;        ///< Sum of the seasonal offsets once ready
+    float variance;             ///< Residual variance
+    uint32_t first_timestamp;   ///< Time of the first sample
+    uint32_t last_timestamp;    ///< Time of the latest sample
+    uint32_t fill_slot;         ///< Slot being filled in the first pass
+    uint32_t fill_count;        ///< Samples averaged into fill_slot
+    uint32_t count;             ///< Samples seen
+    bool ready;                 ///< A whole season has elapsed
+    bool deviating;             ///< Whether the previous sample deviated
+} HoltWinters;
+
+// Score of one sample, against the forecast made before it
+typedef struct {
+    float forecast;             ///< Forecast value
+    float deviation;            ///< (value - forecast) / residual standard deviation, 0 until ready
+    bool is_deviation;          ///< Whether |deviation| reached the threshold
+} ForecastScore;
+
+// Forecast status of one sensor
+typedef struct {
+    float level;                ///< Deseasonalized level
+    float trend_per_s;          ///< Trend per second
+    float seasonal;             ///< Seasonal offset of the latest sample's slot
+    float residual_std;         ///< Residual standard deviation
+    ForecastScore last_score;   ///< Score of the latest sample
+    uint32_t timestamp;         ///< Time of the latest sample in Unix seconds
+    uint32_t deviation_count;   ///< Number of deviating runs started
+    bool ready;                 ///< A whole season has elapsed
+} ForecastStatus;
+
+// Function prototypes
+/**
+ * @brief Allocate and reset a forecaster
+ * @param model Pointer to the model
+ * @param config Pointer to the configuration
+ * @return true if initialized, false on an invalid configuration or allocation failure
+ */
+bool holt_winters_init(HoltWinters* model, const ForecastConfig* config);
+
+/**
+ * @brief Release a forecaster
+ * @param model Pointer to the model
+ */
+void holt_winters_free(HoltWinters* model);
+
+/**
+ * @brief Forecast the value at a time
+ * @param model Pointer to the model
+ * @param timestamp Time in Unix seconds
+ * @return Forecast, NAN before the first sample
+ */
+float holt_winters_forecast(const HoltWinters* model, uint32_t timestamp);
+
+/**
+ * @brief Score a sample and fold it into the model
+ * @param model Pointer to the model
+ * @param config Pointer to the configuration (smoothing and threshold)
+ * @param timestamp Time of the sample in Unix seconds
+ * @param value Sample value
+ * @param score Pointer to store the score, or NULL
+ * @return true if the sample deviates from the forecast, false otherwise
+ * @note Samples not newer than the latest one are scored but not folded in.
+ */
+bool holt_winters_update(HoltWinters* model, const ForecastConfig* config, uint32_t timestamp,
+                         float value, ForecastScore* score);
+
+/**
+ * @brief Initialize the per-sensor forecasters
+ * @param default_config Pointer to the configuration of every sensor type, or NULL for
+ * the defaults
+ * @return true if initialization successful, false otherwise
+ */
+bool forecast_init(const ForecastConfig* default_config);
+
+/**
+ * @brief Release the per-sensor forecasters
+ */
+void forecast_cleanup(void);
+
+/**
+ * @brief Set the configuration of one sensor type
+ * @param type Sensor type
+ * @param config Pointer to the configuration
+ * @return true if the configuration is valid, false otherwise
+ * @note Sensors that are already running keep their season layout and pick up the
+ * new smoothing and threshold.
+ */
+bool forecast_configure_type(SensorType type, const ForecastConfig* config);
+
+/**
+ * @brief Score and fold one sample of a sensor
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample started a deviating run, false otherwise
+ */
+bool forecast_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Forecast the value of a sensor at a time
+ * @param sensor_id Sensor identifier
+ * @param timestamp Time in Unix seconds
+ * @param value Pointer to store the forecast
+ * @return true if the sensor is ready, false otherwise
+ */
+bool forecast_predict(const char* sensor_id, uint32_t timestamp, float* value);
+
+/**
+ * @brief Get the forecast status of a sensor
+ * @param sensor_id Sensor identifier
+ * @param status Pointer to store the status
+ * @return true if the sensor is known, false otherwise
+ */
+bool forecast_get_status(const char* sensor_id, ForecastStatus* status);
+
+/**
+ * @brief Get the default forecaster configuration
+ * @param config Pointer to store the configuration
+ * @note Daily season of one-minute slots for samples about a second apart.
+ */
+void forecast_get_default_config(ForecastConfig* config);
+
+#endif // FORECAST_H
@@ -0,0 +1,137 @@
+/**
+ * @file inference.h
+ * @brief Int8 neural network inference for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Runs small quantized multilayer perceptrons and autoencoders over feature vectors
+ * built from several sensors (for example temperature, current and vibration of one
+ * motor). Weights are symmetric int8 with one scale per output neuron, activations are
+ * asymmetric int8 with one scale and zero point per layer, and accumulation is exact
+ * in int32. Dot products use AVX2 or SSE2 on x86 (chosen at run time) and NEON on
+ * aarch64; every path returns identical results.
+ *
+ * All memory a model needs is planned and allocated once when it is loaded: weights,
+ * biases and two activation buffers sized for the widest layer. Running a model
+ * allocates nothing.
+ *
+ * Model file layout (little-endian):
+ *   uint32 magic ('EQNN'), uint32 version (1), uint32 input_size, uint32 layer_count,
+ *   uint32 flags (INFERENCE_FLAG_*),
+ *   float input_mean[input_size], float input_std[input_size],
+ *   float input_scale, int32 input_zero_point,
+ *   then per layer: uint32 inputs, uint32 outputs, uint32 activation,
+ *   float output_scale, int32 output_zero_point, float weight_scale[outputs],
+ *   int32 bias[outputs] (in units of input_scale * weight_scale),
+ *   int8 weights[outputs][inputs]
+ *
+ * The runtime is a library: no pipeline stage uses it, and models are produced outside
+ * this repository.
+ *
+ * @note A model holds its activation buffers and must be used by one thread at a time.
+ */
+
+#ifndef INFERENCE_H
+#define INFERENCE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define INFERENCE_MAGIC 0x4E4E5145u        ///< 'EQNN'
+#define INFERENCE_VERSION 1
+#define INFERENCE_MAX_LAYERS 16            ///< Maximum number of layers
+#define INFERENCE_MAX_WIDTH 4096           ///< Maximum number of neurons per layer
+#define INFERENCE_FLAG_AUTOENCODER 0x1u    ///< Output reconstructs the normalized input
+
+// Layer activations
+typedef enum {
+    INFERENCE_ACTIVATION_NONE = 0,  ///< Identity
+    INFERENCE_ACTIVATION_RELU       ///< max(0, x)
+} InferenceActivation;
+
+// Quantized fully connected layer
+typedef struct {
+    uint32_t inputs;                ///< Input width
+    uint32_t outputs;               ///< Output width
+    uint32_t stride;                ///< Row length of the weights, inputs padded for the kernels
+    InferenceActivation activation; ///< Activation applied to the output
+    float output_scale;             ///< Scale of the output activations
+    int32_t output_zero_point;      ///< Zero point of the output activations
+    const int8_t* weights;          ///< outputs x stride weights, padding zero
+    const int32_t* bias;            ///< Bias per output, with the input zero point folded in
+    const float* multiplier;        ///< input_scale * weight_scale / output_scale per output
+} InferenceLayer;
+
+// Loaded model
+typedef struct {
+    uint32_t input_size;            ///< Number of features
+    uint32_t output_size;           ///< Number of outputs
+    uint32_t layer_count;           ///< Number of layers
+    uint32_t flags;                 ///< INFERENCE_FLAG_* bits
+    InferenceLayer layers[INFERENCE_MAX_LAYERS]; ///< Layers in evaluation order
+    const float* input_mean;        ///< Feature means subtracted before quantization
+    const float* input_std;         ///< Feature deviations divided out before quantization
+    float input_scale;              ///< Scale of the quantized input
+    int32_t input_zero_point;       ///< Zero point of the quantized input
+    int8_t* activations[2];         ///< Ping-pong activation buffers
+    void* arena;                    ///< Single allocation holding everything above
+} InferenceModel;
+
+// Function prototypes
+/**
+ * @brief Load a model file
+ * @param model Pointer to the model to fill
+ * @param path Path of the model file
+ * @return true if the model was loaded, false if the file is missing or malformed
+ */
+bool inference_model_load(InferenceModel* model, const char* path);
+
+/**
+ * @brief Load a model from memory
+ * @param model Pointer to the model to fill
+ * @param data Model in the file layout
+ * @param size Size of the data in bytes
+ * @return true if the model was loaded, false if the data is malformed
+ * @note The data is copied; it can be released after the call.
+ */
+bool inference_model_load_buffer(InferenceModel* model, const void* data, size_t size);
+
+/**
+ * @brief Release a model
+ * @param model Pointer to the model
+ */
+void inference_model_free(InferenceModel* model);
+
+/**
+ * @brief Evaluate the model on one feature vector
+ * @param model Pointer to the model
+ * @param features Array of input_size raw feature values
+ * @param outputs Array of output_size values to store the dequantized outputs
+ * @return true if evaluated, false on invalid parameters
+ */
+bool inference_run(InferenceModel* model, const float* features, float* outputs);
+
+/**
+ * @brief Score a feature vector with an autoencoder
+ * @param model Pointer to an autoencoder model
+ * @param features Array of input_size raw feature values
+ * @param error Pointer to store the mean squared reconstruction error of the
+ * normalized features
+ * @return true if evaluated, false if the model is not an autoencoder or on invalid parameters
+ */
+bool inference_reconstruction_error(InferenceModel* model, const float* features, float* error);
+
+/**
+ * @brief Build a feature vector from the last-value cache
+ * @param sensor_ids Identifiers of the sensors providing the features, in model order
+ * @param count Number of sensors
+ * @param now Current time in Unix seconds
+ * @param max_age_s Maximum age of a usable value, 0 for any age
+ * @param features Array of count values to fill
+ * @return true if every sensor has a good, fresh value, false otherwise
+ */
+bool inference_features_from_cache(const char* const* sensor_ids, uint32_t count, uint32_t now,
+                                   uint32_t max_age_s, float* features);
+
+#endif // INFERENCE_H
@@ -0,0 +1,167 @@
+/**
+ * @file kalman.h
+ * @brief Batched Kalman filtering for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Smooths noisy sensor readings with a small Kalman filter per sensor and reports each
+ * filtered value with its uncertainty. Two models are available: a random-walk level
+ * (1 state) and a level with a random-walk slope (2 states), which follows ramps
+ * without lag. Measurement and process noise are set per sensor.
+ *
+ * Filters are held in a bank laid out as structure-of-arrays, one lane per sensor, so a
+ * single sweep predicts and updates four lanes per instruction with SSE2 on x86 and
+ * NEON on aarch64. Each lane has its own time step, and lanes without a new measurement
+ * are only predicted. The vector and scalar paths perform the same IEEE operations in
+ * the same order and return bit-identical results, so updating one lane on its own
+ * gives the same estimate as updating it in a sweep.
+ *
+ * The registry queues each sample in its sensor's lane and steps all queued lanes in one
+ * sweep when the first sample of a later timestamp arrives, so the sensors read in one
+ * pipeline tick are filtered together. Reading an estimate first folds in that sensor's
+ * queued sample, and so does a second sample of the same sensor.
+ *
+ * @note All registry functions are serialized by an internal mutex. A KalmanBank has no
+ * locking and can be embedded in other components.
+ */
+
+#ifndef KALMAN_H
+#define KALMAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define KALMAN_MAX_LANES 1024       ///< Lanes per bank, also the maximum number of sensors (power of two)
+
+// State models
+typedef enum {
+    KALMAN_MODEL_LEVEL = 0,         ///< Level following a random walk
+    KALMAN_MODEL_LEVEL_SLOPE        ///< Level and slope, the slope following a random walk
+} KalmanModel;
+
+// Filter configuration
+typedef struct {
+    KalmanModel model;              ///< State model
+    float measurement_noise;        ///< Variance of a reading, in unit^2
+    float level_noise;              ///< Level variance added per second, in unit^2/s
+    float slope_noise;              ///< Slope variance added per second, in unit^2/s^3 (slope model only)
+} KalmanConfig;
+
+// Filtered estimate of one sensor
+typedef struct {
+    float value;                    ///< Filtered value
+    float std_deviation;            ///< Standard deviation of the filtered value
+    float slope;                    ///< Estimated change per second, 0 for the level model
+    float slope_std_deviation;      ///< Standard deviation of the slope, 0 for the level model
+    uint32_t timestamp;             ///< Time of the latest measurement in Unix seconds
+    uint32_t updates;               ///< Number of measurements folded in
+} KalmanEstimate;
+
+// Structure-of-arrays filter bank
+typedef struct {
+    uint32_t lanes;                             ///< Lanes in use, starting at 0
+    float level[KALMAN_MAX_LANES];              ///< Level estimate
+    float slope[KALMAN_MAX_LANES];              ///< Slope estimate
+    float p00[KALMAN_MAX_LANES];                ///< Level variance
+    float p01[KALMAN_MAX_LANES];                ///< Level-slope covariance
+    float p11[KALMAN_MAX_LANES];                ///< Slope variance
+    float level_noise[KALMAN_MAX_LANES];        ///< Level process noise per second
+    float slope_noise[KALMAN_MAX_LANES];        ///< Slope process noise per second
+    float measurement_noise[KALMAN_MAX_LANES];  ///< Measurement variance
+    float measurement[KALMAN_MAX_LANES];        ///< Pending measurement, NaN if none
+    float dt[KALMAN_MAX_LANES];                 ///< Pending time step in seconds
+} KalmanBank;
+
+// Function prototypes
+/**
+ * @brief Empty a bank
+ * @param bank Pointer to the bank
+ */
+void kalman_bank_init(KalmanBank* bank);
+
+/**
+ * @brief Start a filter in a lane
+ * @param bank Pointer to the bank
+ * @param lane Lane index; lanes up to it become in use
+ * @param config Pointer to the configuration
+ * @param initial_value First reading
+ * @return true if started, false on an invalid lane or configuration
+ * @note The level starts at the reading with the measurement variance. With the slope
+ * model the slope starts at 0 with the variance of a slope taken from two readings one
+ * second apart.
+ */
+bool kalman_bank_start_lane(KalmanBank* bank, uint32_t lane, const KalmanConfig* config,
+                            float initial_value);
+
+/**
+ * @brief Predict and update a range of lanes
+ * @param bank Pointer to the bank
+ * @param first First lane
+ * @param count Number of lanes
+ * @note Each lane is predicted over its pending dt and updated with its pending
+ * measurement unless that is NaN. Pending measurements are then cleared to NaN and
+ * time steps to 0, so a lane with nothing pending is left unchanged.
+ */
+void kalman_bank_step(KalmanBank* bank, uint32_t first, uint32_t count);
+
+/**
+ * @brief Initialize the per-sensor filters
+ * @param default_config Pointer to the configuration of sensors without their own, or
+ * NULL for the defaults
+ * @return true if initialization successful, false otherwise
+ */
+bool kalman_init(const KalmanConfig* default_config);
+
+/**
+ * @brief Release the per-sensor filters
+ */
+void kalman_cleanup(void);
+
+/**
+ * @brief Set the configuration of one sensor
+ * @param sensor_id Sensor identifier
+ * @param config Pointer to the configuration
+ * @return true if stored, false on an invalid configuration, a full table or when the
+ * filters are not running
+ * @note A running filter keeps its state and uses the new noise from the next sample.
+ */
+bool kalman_configure_sensor(const char* sensor_id, const KalmanConfig* config);
+
+/**
+ * @brief Filter one sample of a sensor
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample was accepted into the filter, false otherwise
+ * @note The sample is queued and stepped with the rest of its tick; kalman_get_estimate()
+ * already includes it.
+ */
+bool kalman_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Filter one sample of each of several sensors in a single sweep
+ * @param sensors Array of sensors
+ * @param data Array of samples, one per sensor; invalid samples are ignored
+ * @param count Number of sensors
+ * @return Number of filters updated
+ * @note A sensor may appear more than once; its samples are folded in in array order.
+ */
+uint32_t kalman_process_batch(const Sensor* const* sensors, const SensorData* data, uint32_t count);
+
+/**
+ * @brief Get the filtered estimate of a sensor
+ * @param sensor_id Sensor identifier
+ * @param estimate Pointer to store the estimate
+ * @return true if the sensor has been filtered, false otherwise
+ */
+bool kalman_get_estimate(const char* sensor_id, KalmanEstimate* estimate);
+
+/**
+ * @brief Get the default filter configuration
+ * @param config Pointer to store the configuration
+ * @note Level and slope model for readings with about 1 unit of noise (the simulated
+ * temperature sensor), following drifts of a few hundredths of a unit per second.
+ */
+void kalman_get_default_config(KalmanConfig* config);
+
+#endif // KALMAN_H
@@ -0,0 +1,185 @@
+/**
+ * @file matrix_profile.h
+ * @brief Matrix profile motif and discord search for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * The matrix profile of a series holds, for every subsequence of `window` samples, the
+ * z-normalized Euclidean distance to its nearest non-trivial match elsewhere in the
+ * series. Its minima are motifs (a pattern that recurs, such as a machine cycle) and its
+ * maxima are discords (a stretch unlike anything else in the history).
+ *
+ * The batch computation walks the diagonals of the distance matrix in the streamlined
+ * form used by SCAMP: along a diagonal, the covariance of two subsequences is updated in
+ * O(1) from the previous one, so the whole profile costs O(n^2) with O(n) memory. Bands
+ * of adjacent diagonals are handed to worker threads in a random order, each band is
+ * stepped two diagonals per SSE2 or NEON instruction, and the computation can stop at a
+ * time budget with an approximate profile that keeps improving if computed again
+ * (anytime search, as in SCRIMP). Appending a sample with matrix_profile_update() adds
+ * the new subsequence in O(n) (STAMPI).
+ *
+ * Samples are placed on a regular grid of `period_s` seconds by linear interpolation,
+ * which undoes report-by-exception compression of the stored history within its
+ * deviation. Subsequences without shape, constant or an exactly straight interpolated
+ * line, have no match: any two of them would correlate perfectly.
+ *
+ * @note A MatrixProfile has no locking; matrix_profile_compute() runs its own worker
+ * threads and returns when they are done. Memory is 52 bytes per grid point, plus 8 bytes
+ * per point for every worker thread beyond the first during a computation, so a month
+ * of 1 Hz history takes about 135 MB with one thread and 200 MB with four.
+ */
+
+#ifndef MATRIX_PROFILE_H
+#define MATRIX_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MATRIX_PROFILE_MAX_THREADS 16   ///< Most worker threads of one computation
+#define MATRIX_PROFILE_BAND 8           ///< Diagonals handed to a worker at a time
+
+// Matrix profile configuration
+typedef struct {
+    uint32_t window;            ///< Subsequence length in grid points, at least 4
+    uint32_t exclusion;         ///< Matches closer than this many points are trivial, 0 for window / 4
+    uint32_t period_s;          ///< Seconds between grid points
+    uint32_t threads;           ///< Worker threads, 0 for one per online CPU
+    float time_budget_s;        ///< Stop a computation after this many seconds, 0 to finish it
+    uint32_t seed;              ///< Seed of the diagonal order
+} MatrixProfileConfig;
+
+// Matrix profile of one series
+typedef struct {
+    MatrixProfileConfig config; ///< Configuration, with defaults resolved
+    uint32_t length;            ///< Grid points in the series
+    uint32_t capacity;          ///< Grid points allocated
+    uint32_t start_timestamp;   ///< Time of the first grid point in Unix seconds
+    uint32_t last_timestamp;    ///< Time of the latest sample in Unix seconds
+    float last_value;           ///< Value of the latest sample
+    float* series;              ///< Grid values
+    double* mean;               ///< Mean of each subsequence
+    double* inv_norm;           ///< 1 / norm of each mean-removed subsequence, 0 if flat or straight
+    double* df;                 ///< Half the change of the sample entering each subsequence
+    double* dg;                 ///< Streamlined covariance update term of each subsequence
+    float* correlation;         ///< Best Pearson correlation of each subsequence
+    int32_t* neighbor;          ///< Index of that best match, -1 if none yet
+    uint32_t prepared;          ///< Subsequences whose statistics are computed
+    double* last_row;           ///< Covariances of the latest subsequence with the earlier ones
+    bool last_row_valid;        ///< last_row matches the profile
+    uint32_t* band_order;       ///< Random order of the diagonal bands
+    uint32_t bands;             ///< Bands of the computation in progress
+    uint32_t bands_done;        ///< Bands of it already computed
+    uint32_t profiled;          ///< Subsequences the diagonals of the computation cover
+    uint32_t covered;           ///< Subsequences the profile covers, including later updates
+} MatrixProfile;
+
+// One motif or discord
+typedef struct {
+    uint32_t index;             ///< Start of the subsequence in grid points
+    uint32_t neighbor;          ///< Start of its nearest match
+    uint32_t timestamp;         ///< Time of the subsequence in Unix seconds
+    uint32_t neighbor_timestamp;///< Time of the nearest match in Unix seconds
+    float distance;             ///< z-normalized Euclidean distance to the match
+} MatrixProfileMatch;
+
+// Function prototypes
+/**
+ * @brief Prepare an empty matrix profile
+ * @param profile Pointer to the profile
+ * @param config Pointer to the configuration, or NULL for the defaults
+ * @return true if initialized, false on an invalid configuration
+ */
+bool matrix_profile_init(MatrixProfile* profile, const MatrixProfileConfig* config);
+
+/**
+ * @brief Release a matrix profile
+ * @param profile Pointer to the profile
+ */
+void matrix_profile_free(MatrixProfile* profile);
+
+/**
+ * @brief Add a sample to the series without updating the profile
+ * @param profile Pointer to the profile
+ * @param timestamp Time of the sample in Unix seconds
+ * @param value Sample value
+ * @return true if added, false on allocation failure or a non-finite value
+ * @note Samples not newer than the latest one are ignored. Grid points between two
+ * samples are interpolated linearly.
+ */
+bool matrix_profile_append(MatrixProfile* profile, uint32_t timestamp, float value);
+
+/**
+ * @brief Append the stored history of a sensor from the chunk log
+ * @param profile Pointer to the profile
+ * @param sensor_id Sensor identifier
+ * @param from First time of the range in Unix seconds
+ * @param to Last time of the range in Unix seconds
+ * @return true if the history was read, false on error
+ * @note The chunk log must be initialized.
+ */
+bool matrix_profile_load(MatrixProfile* profile, const char* sensor_id, uint32_t from, uint32_t to);
+
+/**
+ * @brief Compute the profile of the whole series
+ * @param profile Pointer to the profile
+ * @return Fraction of the diagonal bands computed so far, 1 when exact, negative on error
+ * @note When the time budget ends a computation early, calling this again continues it.
+ * Samples added in between with matrix_profile_update() keep it; matrix_profile_append()
+ * starts a new computation.
+ */
+float matrix_profile_compute(MatrixProfile* profile);
+
+/**
+ * @brief Append a sample and extend the profile to the new subsequences
+ * @param profile Pointer to the profile
+ * @param timestamp Time of the sample in Unix seconds
+ * @param value Sample value
+ * @return true if added, false on allocation failure or a non-finite value
+ * @note Costs O(n) per new grid point. The first call after an incomplete computation
+ * also computes the covariances of the latest subsequence on the diagonals still to do,
+ * O(window) each. The next matrix_profile_compute() continues that computation.
+ */
+bool matrix_profile_update(MatrixProfile* profile, uint32_t timestamp, float value);
+
+/**
+ * @brief Get the number of subsequences in the series
+ * @param profile Pointer to the profile
+ * @return Number of subsequences, 0 while the series is shorter than the window
+ */
+uint32_t matrix_profile_subsequences(const MatrixProfile* profile);
+
+/**
+ * @brief Get the profile entry of one subsequence
+ * @param profile Pointer to the profile
+ * @param index Start of the subsequence in grid points
+ * @param match Pointer to store the subsequence and its nearest match
+ * @return true if the subsequence has a match, false otherwise or if it is flat or straight
+ */
+bool matrix_profile_get(const MatrixProfile* profile, uint32_t index, MatrixProfileMatch* match);
+
+/**
+ * @brief Find the closest non-overlapping pairs of subsequences
+ * @param profile Pointer to the profile
+ * @param matches Array receiving the motifs, closest first
+ * @param capacity Most motifs to find
+ * @return Number of motifs found
+ */
+uint32_t matrix_profile_motifs(const MatrixProfile* profile, MatrixProfileMatch* matches, uint32_t capacity);
+
+/**
+ * @brief Find the non-overlapping subsequences farthest from any match
+ * @param profile Pointer to the profile
+ * @param matches Array receiving the discords, farthest first
+ * @param capacity Most discords to find
+ * @return Number of discords found
+ */
+uint32_t matrix_profile_discords(const MatrixProfile* profile, MatrixProfileMatch* matches, uint32_t capacity);
+
+/**
+ * @brief Get the default matrix profile configuration
+ * @param config Pointer to store the configuration
+ * @note One-hour subsequences of 1 Hz samples, one thread per CPU, no time budget.
+ */
+void matrix_profile_get_default_config(MatrixProfileConfig* config);
+
+#endif // MATRIX_PROFILE_H
@@ -0,0 +1,178 @@
+/**
+ * @file operating_state.h
+ * @brief Operating state clustering for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * A machine behaves differently when idle, ramping up and at full load, so one threshold
+ * or one anomaly model for all three is either too loose or too noisy. This module
+ * learns the operating states of each asset without labels and tags every time window
+ * with one of them.
+ *
+ * Sensors are grouped by Sensor.location. Every `window_s` seconds (aligned to Unix time)
+ * each group closes a feature vector holding, per member, the mean, the standard
+ * deviation and the absolute change of its samples over the window. Distances weigh
+ * each feature by its inverse running variance, so that sensors in different units
+ * count the same, while the centroids stay in sensor units and remain valid as the
+ * variances settle. The vector is assigned to the nearest centroid of an online
+ * mini-batch k-means and buffered; every `batch_size` windows the centroids move towards
+ * the windows assigned to them with a per-centroid learning rate (Sculley's web-scale
+ * k-means), seeded by k-means++ on the first batch.
+ *
+ * `clusters` is an upper bound, not a target. Each centroid also tracks the spread of its
+ * windows per feature; two centroids that no feature separates by more than three pooled
+ * standard deviations are merged, so a machine that never leaves one condition keeps a
+ * single state instead of splitting its noise three ways. Windows more than four standard
+ * deviations from their nearest centroid on some feature start a new one once several
+ * similar ones arrive in the same batch. States are numbered by
+ * load: state 0 has the lowest standardized mean level (idle), the last one the highest
+ * (full load), and ramps, with their large changes, can form their own state in between.
+ *
+ * A group moves to a new state once `dwell_windows` consecutive windows fall nearest to
+ * it. Each such change is published as an EVENT_STATE_CHANGE, and rules can condition
+ * thresholds on `state(ID)`. Renumbering after the centroids move, and merges or
+ * replacements of the current centroid, change the reported number without an event.
+ *
+ * A group's members are the sensors of its location that report before its first window
+ * closes. A sensor of that location reporting later joins the group and restarts its
+ * learning, since the feature vector changes; until states are learned again the group
+ * reports state -1.
+ *
+ * @note All registry functions are serialized by an internal mutex. MiniBatchKMeans itself
+ * has no locking, allocates nothing and can be embedded in other components.
+ */
+
+#ifndef OPERATING_STATE_H
+#define OPERATING_STATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define OPERATING_STATE_MAX_SENSORS 1024    ///< Maximum number of distinct sensors (power of two)
+#define OPERATING_STATE_MAX_GROUPS 64       ///< Maximum number of groups
+#define OPERATING_STATE_MAX_MEMBERS 16      ///< Maximum number of sensors in one group
+#define OPERATING_STATE_FEATURES 3          ///< Features per member: mean, standard deviation, absolute change
+#define OPERATING_STATE_MAX_DIMENSIONS (OPERATING_STATE_MAX_MEMBERS * OPERATING_STATE_FEATURES)
+#define OPERATING_STATE_MAX_CLUSTERS 8      ///< Maximum number of operating states
+#define OPERATING_STATE_MAX_BATCH 64        ///< Maximum windows per mini-batch
+
+// Operating state configuration
+typedef struct {
+    uint32_t window_s;          ///< Seconds per feature window
+    uint32_t clusters;          ///< Operating states to learn, 2 to OPERATING_STATE_MAX_CLUSTERS
+    uint32_t batch_size;        ///< Windows per centroid update, clusters to OPERATING_STATE_MAX_BATCH
+    uint32_t max_count;         ///< Cap of a centroid's window count; its learning rate stays at least 1 / max_count
+    uint32_t scale_windows;     ///< Effective windows of the running feature standardization
+    uint32_t dwell_windows;     ///< Consecutive windows in another state before the group changes state
+} OperatingStateConfig;
+
+// Online mini-batch k-means over fixed storage
+typedef struct {
+    uint32_t dimensions;        ///< Features per vector
+    uint32_t stride;            ///< Floats per stored vector, dimensions rounded up to 4
+    uint32_t clusters;          ///< Number of centroids
+    uint32_t batch_size;        ///< Vectors per update
+    uint32_t batch_count;       ///< Vectors buffered
+    uint32_t max_count;         ///< Cap of the centroid counts
+    uint32_t random;            ///< State of the seeding random generator
+    bool seeded;                ///< Centroids have been seeded
+    bool active[OPERATING_STATE_MAX_CLUSTERS];      ///< Centroid is in use; merging releases one
+    uint32_t counts[OPERATING_STATE_MAX_CLUSTERS];  ///< Vectors folded into each centroid
+    uint32_t generations[OPERATING_STATE_MAX_CLUSTERS];  ///< Times each centroid has been seeded
+    float weights[OPERATING_STATE_MAX_DIMENSIONS];  ///< Weight of each feature in squared distances
+    float centroids[OPERATING_STATE_MAX_CLUSTERS * OPERATING_STATE_MAX_DIMENSIONS];  ///< Row per centroid
+    float spreads[OPERATING_STATE_MAX_CLUSTERS * OPERATING_STATE_MAX_DIMENSIONS];    ///< Mean squared deviation of each centroid's vectors, per feature
+    float batch[OPERATING_STATE_MAX_BATCH * OPERATING_STATE_MAX_DIMENSIONS];          ///< Buffered vectors
+} MiniBatchKMeans;
+
+// Operating state of one group
+typedef struct {
+    char group[64];             ///< Group (location) name
+    int32_t state;              ///< Current state, numbered by load, -1 until seeded
+    uint32_t states;            ///< Number of states learned so far
+    float distance;             ///< Distance of the latest window to its centroid, in standardized units
+    uint32_t members;           ///< Sensors in the feature vector
+    uint32_t windows;           ///< Windows closed
+    uint32_t changes;           ///< State changes
+    uint32_t timestamp;         ///< End of the latest window in Unix seconds
+} OperatingStateStatus;
+
+// Function prototypes
+/**
+ * @brief Prepare an empty clustering
+ * @param kmeans Pointer to the clustering
+ * @param dimensions Features per vector, 1 to OPERATING_STATE_MAX_DIMENSIONS
+ * @param clusters Number of centroids, 1 to OPERATING_STATE_MAX_CLUSTERS
+ * @param batch_size Vectors per update, clusters to OPERATING_STATE_MAX_BATCH
+ * @param max_count Cap of the centroid counts, at least 1
+ * @return true if initialized, false on invalid parameters
+ */
+bool kmeans_init(MiniBatchKMeans* kmeans, uint32_t dimensions, uint32_t clusters,
+                 uint32_t batch_size, uint32_t max_count);
+
+/**
+ * @brief Set the weight of each feature in squared distances
+ * @param kmeans Pointer to the clustering
+ * @param weights Array of dimensions non-negative weights
+ * @note kmeans_init() sets every weight to 1.
+ */
+void kmeans_set_weights(MiniBatchKMeans* kmeans, const float* weights);
+
+/**
+ * @brief Find the nearest centroid of a vector
+ * @param kmeans Pointer to the clustering
+ * @param vector Array of dimensions features
+ * @param distance Pointer to store the weighted Euclidean distance to the centroid, or NULL
+ * @return Index of the nearest active centroid, -1 until seeded
+ */
+int32_t kmeans_nearest(const MiniBatchKMeans* kmeans, const float* vector, float* distance);
+
+/**
+ * @brief Buffer a vector, updating the centroids when a batch is complete
+ * @param kmeans Pointer to the clustering
+ * @param vector Array of dimensions features
+ * @return true if the vector completed a batch, false otherwise
+ * @note The first batch seeds the centroids with k-means++. Each batch may seed centroids
+ * for outlying vectors and merge centroids that have grown together.
+ */
+bool kmeans_add(MiniBatchKMeans* kmeans, const float* vector);
+
+/**
+ * @brief Initialize the operating state groups
+ * @param config Pointer to configuration, or NULL for the defaults
+ * @return true if initialization successful, false otherwise
+ */
+bool operating_state_init(const OperatingStateConfig* config);
+
+/**
+ * @brief Release the operating state groups
+ */
+void operating_state_cleanup(void);
+
+/**
+ * @brief Record one sample of a sensor
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample closed a window of the group, false otherwise
+ * @note A sensor joining a group after its first window restarts the group's learning.
+ */
+bool operating_state_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the operating state of a sensor's group
+ * @param sensor_id Sensor identifier
+ * @param status Pointer to store the status
+ * @return true if the sensor is in a group, false otherwise
+ */
+bool operating_state_get(const char* sensor_id, OperatingStateStatus* status);
+
+/**
+ * @brief Get the default operating state configuration
+ * @param config Pointer to store the configuration
+ * @note One-minute windows, up to three states (idle, ramp, full load), batches of 16
+ * windows, three windows to confirm a state change.
+ */
+void operating_state_get_default_config(OperatingStateConfig* config);
+
+#endif // OPERATING_STATE_H
@@ -0,0 +1,84 @@
+/**
+ * @file pipeline.h
+ * @brief Sample processing pipeline for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Every sample, whether read from a live sensor or replayed from storage, passes through
+ * the same ordered list of stages (analytics, storage sinks, ...). A stage may stop a
+ * sample from reaching the stages after it by returning false.
+ *
+ * @note Stages are registered during start-up; pipeline_process may then be called from
+ * one acquisition thread at a time.
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define PIPELINE_MAX_STAGES 16    ///< Maximum number of registered stages
+
+/**
+ * @brief Process one sample
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample
+ * @param context Context registered with the stage
+ * @return true to pass the sample on to the next stage, false to stop it here
+ */
+typedef bool (*PipelineStageFn)(const Sensor* sensor, const SensorData* data, void* context);
+
+// Per-stage counters
+typedef struct {
+    char name[32];          ///< Stage name
+    uint64_t processed;     ///< Samples the stage received
+    uint64_t stopped;       ///< Samples the stage did not pass on
+} PipelineStageStats;
+
+// Function prototypes
+/**
+ * @brief Append a stage to the pipeline
+ * @param name Stage name used in statistics
+ * @param stage Stage function
+ * @param context Context passed to every call of the stage
+ * @return true if the stage was registered, false if the pipeline is full
+ */
+bool pipeline_register_stage(const char* name, PipelineStageFn stage, void* context);
+
+/**
+ * @brief Remove all stages and reset their counters
+ */
+void pipeline_clear(void);
+
+/**
+ * @brief Get the number of registered stages
+ * @return Number of stages
+ */
+uint32_t pipeline_get_stage_count(void);
+
+/**
+ * @brief Remove the stages registered after the first count
+ * @param count Number of stages to keep
+ * @note Undoes a partially failed registration of several stages.
+ */
+void pipeline_truncate(uint32_t count);
+
+/**
+ * @brief Run a sample through the stages in registration order
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample
+ * @return true if the sample passed every stage, false if a stage stopped it
+ */
+bool pipeline_process(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the counters of all stages
+ * @param stats Array receiving one entry per stage
+ * @param max_stages Capacity of the array
+ * @return Number of entries written
+ */
+uint32_t pipeline_get_stats(PipelineStageStats* stats, uint32_t max_stages);
+
+#endif // PIPELINE_H
@@ -0,0 +1,70 @@
+/**
+ * @file pipeline_stages.h
+ * @brief Default analytics stages for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * The live system and the replay tool run the same analytics over every sample: sliding
+ * windows, Kalman filters, alerts, anomaly detection, trends, change points, correlation,
+ * seasonal forecasts, operating states and rules. This module brings those components up,
+ * registers one pipeline stage for each, and releases them again, so that a replayed
+ * stream produces the same events as the live one. Storage sinks differ between the
+ * programs; each registers its own before the analytics stages.
+ *
+ * @note Call during start-up, before pipeline_process() runs. The built-in rules are added
+ * with the stages; further rules can be added with rules_add() afterwards.
+ */
+
+#ifndef PIPELINE_STAGES_H
+#define PIPELINE_STAGES_H
+
+#include <stdbool.h>
+#include "window_stats.h"
+#include "kalman.h"
+#include "alert.h"
+#include "anomaly.h"
+#include "trend.h"
+#include "changepoint.h"
+#include "correlation.h"
+#include "forecast.h"
+#include "operating_state.h"
+
+// Configuration of every analytics component
+typedef struct {
+    WindowStatsConfig window_stats;         ///< Sliding windows
+    KalmanConfig kalman;                    ///< Kalman filters
+    AlertConfig alert;                      ///< Default alert thresholds
+    AnomalyConfig anomaly;                  ///< Anomaly detectors
+    TrendConfig trend;                      ///< Trend fits
+    ChangepointConfig changepoint;          ///< Change-point detectors
+    CorrelationConfig correlation;          ///< Rolling correlation
+    ForecastConfig forecast;                ///< Seasonal forecasts
+    OperatingStateConfig operating_state;   ///< Operating state clustering
+} PipelineStagesConfig;
+
+// Function prototypes
+/**
+ * @brief Initialize the analytics components and append their stages to the pipeline
+ * @param config Pointer to configuration, or NULL for the defaults
+ * @return true if every component is running and registered and the rules are added,
+ * false otherwise
+ * @note On failure the components already initialized are released again and the
+ * stages this call registered are removed; stages registered before it remain.
+ */
+bool pipeline_register_default_stages(const PipelineStagesConfig* config);
+
+/**
+ * @brief Release the analytics components in reverse order of initialization
+ * @note Clears the pipeline, so no stage keeps calling into a released component.
+ */
+void pipeline_cleanup_default_stages(void);
+
+/**
+ * @brief Get the default analytics configuration
+ * @param config Pointer to store the configuration
+ * @note The default alert thresholds (40 / 45 with 1 unit of hysteresis) suit the
+ * temperature sensors; set per-sensor thresholds with alert_configure_sensor().
+ */
+void pipeline_stages_get_default_config(PipelineStagesConfig* config);
+
+#endif // PIPELINE_STAGES_H
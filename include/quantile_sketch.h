@@ -0,0 +1,82 @@
+/**
+ * @file quantile_sketch.h
+ * @brief Streaming quantile sketch for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * A merging t-digest: values are collected in a small insertion buffer and, when it
+ * fills, sorted and merged into a list of at most about QUANTILE_SKETCH_COMPRESSION
+ * weighted centroids. Centroids near the tails are kept small (arcsine scale function),
+ * so p99 and p1 stay accurate while the median is approximated more coarsely. A sketch
+ * is a fixed-size value of a few KB; sketches from different sensors, threads or time
+ * ranges combine with quantile_sketch_merge().
+ *
+ * @note Sketches are plain values owned by the caller and carry no lock.
+ */
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define QUANTILE_SKETCH_COMPRESSION 200                              ///< t-digest compression (delta)
+#define QUANTILE_SKETCH_CENTROIDS (QUANTILE_SKETCH_COMPRESSION + 8)  ///< Centroid capacity
+#define QUANTILE_SKETCH_BUFFER 128                                   ///< Insertion buffer size
+
+// Cluster of nearby values
+typedef struct {
+    float mean;             ///< Mean of the values in the centroid
+    uint32_t weight;        ///< Number of values in the centroid
+} QuantileCentroid;
+
+// Quantile sketch state
+typedef struct {
+    QuantileCentroid centroids[QUANTILE_SKETCH_CENTROIDS]; ///< Centroids sorted by mean
+    uint32_t centroid_count;    ///< Centroids in use
+    float buffer[QUANTILE_SKETCH_BUFFER]; ///< Values not yet merged into the centroids
+    uint32_t buffer_count;      ///< Values in the buffer
+    uint64_t count;             ///< Total number of values
+    float min_value;            ///< Smallest value
+    float max_value;            ///< Largest value
+} QuantileSketch;
+
+// Function prototypes
+/**
+ * @brief Reset a sketch to the empty state
+ * @param sketch Pointer to the sketch
+ */
+void quantile_sketch_init(QuantileSketch* sketch);
+
+/**
+ * @brief Add one value
+ * @param sketch Pointer to the sketch
+ * @param value Value to add; NaN is ignored
+ */
+void quantile_sketch_add(QuantileSketch* sketch, float value);
+
+/**
+ * @brief Add an array of values
+ * @param sketch Pointer to the sketch
+ * @param values Values to add; NaN is ignored
+ * @param count Number of values
+ */
+void quantile_sketch_add_batch(QuantileSketch* sketch, const float* values, size_t count);
+
+/**
+ * @brief Fold one sketch into another
+ * @param sketch Pointer to the sketch receiving the values
+ * @param other Pointer to the sketch to fold in; left unchanged
+ */
+void quantile_sketch_merge(QuantileSketch* sketch, const QuantileSketch* other);
+
+/**
+ * @brief Estimate a quantile
+ * @param sketch Pointer to the sketch; its insertion buffer is merged first
+ * @param q Quantile between 0 and 1, e.g. 0.99 for p99
+ * @return Estimated value, or 0 when the sketch is empty
+ */
+float quantile_sketch_quantile(QuantileSketch* sketch, double q);
+
+#endif // QUANTILE_SKETCH_H
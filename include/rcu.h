@@ -0,0 +1,77 @@
+/**
+ * @file rcu.h
+ * @brief Read-copy-update publication for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Shared objects such as sensor configurations are treated as immutable: a writer
+ * builds a new copy and publishes it with an atomic pointer swap, and readers pick up
+ * whichever copy is current without taking a lock. The replaced copy is retired and
+ * freed by epoch-based reclamation once no reader that could still see it remains.
+ *
+ * Readers bracket their use of a published object with rcu_read_lock() and
+ * rcu_read_unlock(); both are a few atomic operations on a per-thread record and never
+ * block. Writers retire old copies with rcu_retire(); retiring and reclaiming are
+ * serialized by an internal mutex. A thread's record is released when it exits.
+ */
+
+#ifndef RCU_H
+#define RCU_H
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define RCU_MAX_THREADS 64          ///< Maximum number of threads using read-side sections
+#define RCU_MAX_RETIRED 256         ///< Retired objects awaiting reclamation
+
+// Published pointer to an immutable object
+typedef struct {
+    _Atomic(void*) pointer;
+} RcuPointer;
+
+// Function prototypes
+/**
+ * @brief Enter a read-side critical section
+ * @note Sections may nest. Objects obtained with rcu_dereference() stay valid until
+ * the outermost rcu_read_unlock().
+ */
+void rcu_read_lock(void);
+
+/**
+ * @brief Leave a read-side critical section
+ */
+void rcu_read_unlock(void);
+
+/**
+ * @brief Get the currently published object
+ * @param rcu_pointer Pointer to the published pointer
+ * @return Current object, valid until the end of the read-side critical section
+ */
+void* rcu_dereference(RcuPointer* rcu_pointer);
+
+/**
+ * @brief Publish a new object
+ * @param rcu_pointer Pointer to the published pointer
+ * @param object Fully initialized object, not to be modified after publication
+ * @return Previously published object, to be passed to rcu_retire()
+ */
+void* rcu_publish(RcuPointer* rcu_pointer, void* object);
+
+/**
+ * @brief Free an unpublished object once no reader can still see it
+ * @param object Object returned by rcu_publish()
+ * @param free_fn Function releasing the object
+ * @note Retired objects are reclaimed by later calls to rcu_retire(); call
+ * rcu_synchronize() to wait for all of them. When RCU_MAX_RETIRED objects are pending,
+ * the call waits for readers to move on. Must not be called from inside a read-side
+ * critical section.
+ */
+void rcu_retire(void* object, void (*free_fn)(void*));
+
+/**
+ * @brief Wait until every retired object has been freed
+ * @note Must not be called from inside a read-side critical section.
+ */
+void rcu_synchronize(void);
+
+#endif // RCU_H
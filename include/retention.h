@@ -0,0 +1,77 @@
+/**
+ * @file retention.h
+ * @brief Retention and background compaction of sample storage for the Industrial
+ *        AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Every storage tier (raw samples and each rollup tier) is a sequence of time segments
+ * written by a SegmentWriter. A background thread running at idle I/O priority merges
+ * runs of small closed segments into larger ones, streaming them in time order through a
+ * small buffer, then drops the oldest segments of each tier once they exceed the tier's
+ * age or size budget. The newest segment of a tier is treated as open and is never
+ * touched.
+ */
+
+#ifndef RETENTION_H
+#define RETENTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RETENTION_MAX_TIERS 8     ///< Maximum number of managed tiers
+
+// Budget and compaction policy of one tier
+typedef struct {
+    char prefix[32];            ///< Segment file prefix of the tier
+    uint32_t max_age_s;         ///< Drop segments whose data is older than this, 0 to keep forever
+    uint32_t max_size_kb;       ///< Total size budget of the tier, 0 for unlimited
+    uint32_t compact_min_kb;    ///< Closed segments below this size are merged, 0 disables compaction
+    uint32_t compact_target_kb; ///< Upper bound on the size of a merged segment
+} RetentionTierConfig;
+
+// Retention configuration
+typedef struct {
+    char directory[128];        ///< Directory holding all segments
+    RetentionTierConfig tiers[RETENTION_MAX_TIERS]; ///< Managed tiers
+    uint32_t tier_count;        ///< Number of managed tiers
+    uint32_t interval_s;        ///< Seconds between background passes
+} RetentionConfig;
+
+// Retention counters since initialization
+typedef struct {
+    uint32_t passes;            ///< Completed retention passes
+    uint32_t segments_deleted;  ///< Segments removed by age or size budget
+    uint32_t segments_merged;   ///< Segments folded into a larger one by compaction
+    uint64_t bytes_deleted;     ///< Bytes reclaimed by deletion
+    uint32_t segment_count;     ///< Segments present after the last pass, all tiers
+} RetentionStats;
+
+// Function prototypes
+/**
+ * @brief Initialize retention and start the background compaction thread
+ * @param config Pointer to retention configuration
+ * @return true if initialization successful, false otherwise
+ */
+bool retention_init(const RetentionConfig* config);
+
+/**
+ * @brief Stop the background thread and release retention resources
+ * @note Waits for a pass in progress to finish.
+ */
+void retention_cleanup(void);
+
+/**
+ * @brief Run one compaction and retention pass on the calling thread
+ * @param now Current time in Unix seconds
+ * @return true if the pass completed without I/O errors, false otherwise
+ */
+bool retention_run_once(uint32_t now);
+
+/**
+ * @brief Get retention counters
+ * @param stats Pointer to store the counters
+ */
+void retention_get_stats(RetentionStats* stats);
+
+#endif // RETENTION_H
@@ -0,0 +1,98 @@
+/**
+ * @file rollup.h
+ * @brief Continuous downsampling rollups for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Rollups keep min, max, sum, count and last value per sensor per time bucket for
+ * a small set of tiers (1 s, 1 min and 1 h by default). Only the first tier sees raw
+ * samples; every coarser tier is fed from the buckets the tier below it closes, so the
+ * ingest cost is O(1) per sample regardless of the number of tiers. Closed buckets are
+ * appended to one segmented CSV series per tier next to the raw sample segments.
+ *
+ * @note All public functions are serialized by an internal mutex.
+ */
+
+#ifndef ROLLUP_H
+#define ROLLUP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+#include "segment_writer.h"
+
+#define ROLLUP_MAX_TIERS 4        ///< Maximum number of rollup tiers
+#define ROLLUP_MAX_SENSORS 1024   ///< Maximum number of distinct sensors (power of two)
+
+// Aggregate of all samples that fell into one bucket
+typedef struct {
+    uint32_t bucket_start;  ///< Bucket start, Unix seconds aligned to the tier period
+    float min_value;        ///< Minimum value in the bucket
+    float max_value;        ///< Maximum value in the bucket
+    double sum;             ///< Sum of all values in the bucket
+    uint32_t count;         ///< Number of samples in the bucket
+    float last_value;       ///< Most recent value in the bucket
+    uint32_t last_timestamp;///< Timestamp of the most recent value
+} RollupBucket;
+
+// Rollup tier configuration
+typedef struct {
+    uint32_t period_s;      ///< Bucket width in seconds
+    char prefix[32];        ///< Segment file prefix receiving closed buckets
+    uint32_t segment_span_s;///< Time span of one segment file in seconds
+} RollupTierConfig;
+
+// Rollup configuration
+typedef struct {
+    char directory[128];    ///< Directory holding the tier segments
+    RollupTierConfig tiers[ROLLUP_MAX_TIERS]; ///< Tiers, finest first
+    uint32_t tier_count;    ///< Number of configured tiers
+} RollupConfig;
+
+// Function prototypes
+/**
+ * @brief Initialize the rollup engine
+ * @param config Pointer to rollup configuration, or NULL for the 1 s / 1 min / 1 h default
+ *        in the "data" directory
+ * @return true if initialization successful, false otherwise
+ * @note Each tier period must be a whole multiple of the period of the tier before it.
+ */
+bool rollup_init(const RollupConfig* config);
+
+/**
+ * @brief Close all open buckets, write them out and release rollup resources
+ */
+void rollup_cleanup(void);
+
+/**
+ * @brief Fold one sample into the rollup tiers
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample was accepted, false otherwise
+ */
+bool rollup_add_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Close every bucket whose period has fully elapsed at the given time
+ * @param now Current time in Unix seconds
+ * @return true if all closed buckets were written, false on I/O error
+ * @note Lets quiet sensors publish their buckets without waiting for a new sample.
+ */
+bool rollup_flush(uint32_t now);
+
+/**
+ * @brief Get the currently open bucket of a sensor for a tier
+ * @param sensor_id Sensor identifier
+ * @param tier Tier index (0 is the finest tier)
+ * @param bucket Pointer to store the bucket
+ * @return true if the sensor has an open bucket in this tier, false otherwise
+ */
+bool rollup_get_bucket(const char* sensor_id, uint32_t tier, RollupBucket* bucket);
+
+/**
+ * @brief Get the default rollup configuration
+ * @param config Pointer to store the configuration
+ */
+void rollup_get_default_config(RollupConfig* config);
+
+#endif // ROLLUP_H
@@ -0,0 +1,182 @@
+/**
+ * @file rules.h
+ * @brief Expression rules engine for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Rules are boolean expressions over sensor values and window statistics, for example
+ * `avg_1m(TEMP001) > 40 && rate(CUR003) > 2`. Each rule is compiled once into a small
+ * stack bytecode whose inputs (operands) are resolved at compile time. When a sample
+ * arrives, only the operands that read its sensor are refreshed and only the rules
+ * using them are re-evaluated; a rule whose state changes pushes an EVENT_RULE event.
+ *
+ * Expression syntax, by increasing precedence:
+ *   a || b,  a && b,  a < b  a <= b  a > b  a >= b  a == b  a != b,
+ *   a + b  a - b,  a * b  a / b,  -a  !a,  numbers, parentheses and operands.
+ * Operands:
+ *   ID or value(ID)   last value of the sensor
+ *   rate(ID)          change per second between the last two samples
+ *   filtered(ID)      Kalman-filtered value (see kalman.h), when the filter stage runs
+ *   state(ID)         operating state of the sensor's location, 0 for the lowest load
+ *                     (see operating_state.h), when the clustering stage runs
+ *   avg_W(ID), min_W(ID), max_W(ID), std_W(ID), count_W(ID)
+ *                     statistics of a sliding window of width W (e.g. 30s, 1m, 15m, 1h),
+ *                     which must be configured in window_stats
+ * Comparisons and logical operators yield 1 or 0; a rule is active while its
+ * expression is non-zero.
+ *
+ * All rule and subscription storage is allocated at initialization; adding, evaluating
+ * and removing rules allocates nothing.
+ *
+ * @note All public functions except rule_compile() and rule_program_run(), which work on
+ * caller-owned programs, are serialized by an internal mutex.
+ */
+
+#ifndef RULES_H
+#define RULES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define RULES_MAX_RULES 1024        ///< Maximum number of rules
+#define RULES_MAX_SENSORS 1024      ///< Maximum number of distinct sensors (power of two)
+#define RULE_MAX_CODE 64            ///< Maximum instructions per rule
+#define RULE_MAX_CONSTANTS 16       ///< Maximum distinct constants per rule
+#define RULE_MAX_OPERANDS 8         ///< Maximum distinct operands per rule
+#define RULE_MAX_STACK 16           ///< Maximum evaluation stack depth
+#define RULE_MAX_NESTING (RULE_MAX_STACK * 4)  ///< Maximum nesting of parentheses and prefix operators
+
+// Operand kinds
+typedef enum {
+    RULE_OPERAND_VALUE = 0,         ///< Last value
+    RULE_OPERAND_RATE,              ///< Change per second
+    RULE_OPERAND_FILTERED,          ///< Kalman-filtered value
+    RULE_OPERAND_STATE,             ///< Operating state of the location
+    RULE_OPERAND_AVG,               ///< Window mean
+    RULE_OPERAND_MIN,               ///< Window minimum
+    RULE_OPERAND_MAX,               ///< Window maximum
+    RULE_OPERAND_STD,               ///< Window standard deviation
+    RULE_OPERAND_COUNT              ///< Window sample count
+} RuleOperandKind;
+
+// Bytecode operations
+typedef enum {
+    RULE_OP_CONST = 0,              ///< Push constants[arg]
+    RULE_OP_LOAD,                   ///< Push operand value arg
+    RULE_OP_ADD,
+    RULE_OP_SUB,
+    RULE_OP_MUL,
+    RULE_OP_DIV,
+    RULE_OP_NEG,
+    RULE_OP_LT,
+    RULE_OP_LE,
+    RULE_OP_GT,
+    RULE_OP_GE,
+    RULE_OP_EQ,
+    RULE_OP_NE,
+    RULE_OP_AND,
+    RULE_OP_OR,
+    RULE_OP_NOT
+} RuleOpcode;
+
+// One instruction
+typedef struct {
+    uint8_t opcode;                 ///< RuleOpcode
+    uint8_t arg;                    ///< Constant or operand index
+} RuleInstruction;
+
+// Input of a rule
+typedef struct {
+    RuleOperandKind kind;           ///< What is read
+    uint32_t width_s;               ///< Window width for window statistics, 0 otherwise
+    char sensor_id[32];             ///< Sensor read
+    uint32_t offset;                ///< Position in the expression, for error reports
+} RuleOperand;
+
+// Compiled expression
+typedef struct {
+    uint32_t length;                            ///< Number of instructions
+    uint32_t constant_count;                    ///< Number of constants
+    uint32_t operand_count;                     ///< Number of distinct operands
+    RuleInstruction code[RULE_MAX_CODE];        ///< Instructions
+    float constants[RULE_MAX_CONSTANTS];        ///< Constant pool
+    RuleOperand operands[RULE_MAX_OPERANDS];    ///< Operands, loaded by index
+} RuleProgram;
+
+// Rule status
+typedef struct {
+    bool active;                    ///< Expression was non-zero at the last evaluation
+    bool ready;                     ///< Every operand has a value
+    float result;                   ///< Result of the last evaluation
+    uint32_t evaluations;           ///< Number of evaluations
+    uint32_t activations;           ///< Number of transitions to active
+    uint32_t last_change;           ///< Time of the last state change in Unix seconds
+} RuleStatus;
+
+// Function prototypes
+/**
+ * @brief Compile an expression
+ * @param expression Expression text
+ * @param program Pointer to store the program
+ * @param error_offset Pointer to store the offset of the first error, or NULL
+ * @return true if compiled, false on a syntax error or when a limit is exceeded
+ */
+bool rule_compile(const char* expression, RuleProgram* program, uint32_t* error_offset);
+
+/**
+ * @brief Evaluate a program
+ * @param program Pointer to the program
+ * @param operands Array of operand_count operand values
+ * @return Result of the expression
+ */
+float rule_program_run(const RuleProgram* program, const float* operands);
+
+/**
+ * @brief Initialize the rules engine
+ * @return true if initialization successful, false otherwise
+ */
+bool rules_init(void);
+
+/**
+ * @brief Release the rules engine
+ */
+void rules_cleanup(void);
+
+/**
+ * @brief Compile and install a rule
+ * @param name Unique rule name
+ * @param expression Expression text
+ * @param error_offset Pointer to store the offset of the first error, or NULL
+ * @return true if installed, false on a compile error, an unconfigured window width,
+ * a duplicate name or when the tables are full
+ * @note Operands are seeded from the last-value cache and the sliding windows, so a
+ * rule can become ready without waiting for every sensor to report again.
+ */
+bool rules_add(const char* name, const char* expression, uint32_t* error_offset);
+
+/**
+ * @brief Remove a rule
+ * @param name Rule name
+ * @return true if the rule existed, false otherwise
+ */
+bool rules_remove(const char* name);
+
+/**
+ * @brief Refresh the operands of one sample's sensor and re-evaluate their rules
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample
+ * @return true if any rule changed state, false otherwise
+ * @note Call after the sample has been added to the sliding windows.
+ */
+bool rules_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the status of a rule
+ * @param name Rule name
+ * @param status Pointer to store the status
+ * @return true if the rule exists, false otherwise
+ */
+bool rules_get_status(const char* name, RuleStatus* status);
+
+#endif // RULES_H
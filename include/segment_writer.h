@@ -0,0 +1,97 @@
+/**
+ * @file segment_writer.h
+ * @brief Time-segmented CSV files for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * A segment writer appends records to `<directory>/<prefix>-<start>.csv`, where
+ * `<start>` is the zero-padded Unix time of the first record the segment may hold.
+ * A new segment is started when a record falls past the segment time span or the
+ * current segment reaches its size limit, so every tier of sample storage is a
+ * sequence of bounded files that the retention subsystem can merge or drop.
+ *
+ * @note A segment writer is not internally synchronized; its owner serializes access.
+ */
+
+#ifndef SEGMENT_WRITER_H
+#define SEGMENT_WRITER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SEGMENT_SUFFIX ".csv"     ///< File suffix of every segment
+
+// Segment writer state
+typedef struct {
+    char directory[128];    ///< Directory holding the segments
+    char prefix[32];        ///< Segment file prefix
+    char header[192];       ///< CSV header written at the top of each segment
+    uint32_t span_s;        ///< Time span covered by one segment in seconds
+    uint32_t max_size_kb;   ///< Size at which a segment is closed early (0 = unlimited)
+    FILE* file;             ///< Currently open segment, NULL before the first record
+    uint32_t segment_start; ///< Start time of the open segment
+    uint32_t segment_bytes; ///< Bytes written to the open segment
+    uint32_t late_records;  ///< Records written to an earlier segment than the open one
+} SegmentWriter;
+
+// Function prototypes
+/**
+ * @brief Prepare a segment writer; the directory is created if needed
+ * @param writer Pointer to the writer to initialize
+ * @param directory Directory holding the segments
+ * @param prefix Segment file prefix
+ * @param header CSV header line without trailing newline
+ * @param span_s Time span of one segment in seconds
+ * @param max_size_kb Size limit of one segment in kilobytes, 0 for none
+ * @return true if initialization successful, false otherwise
+ */
+bool segment_writer_open(SegmentWriter* writer, const char* directory, const char* prefix,
+                         const char* header, uint32_t span_s, uint32_t max_size_kb);
+
+/**
+ * @brief Append one record, rolling over to a new segment when needed
+ * @param writer Pointer to the writer
+ * @param timestamp Record time in Unix seconds
+ * @param line Record text without trailing newline
+ * @return true if the record was written, false otherwise
+ * @note A record older than the open segment is appended to the segment covering its
+ * time, so a segment only ever holds records from its start up to the start of the
+ * next one. Records within a segment are in write order, not necessarily time order.
+ */
+bool segment_writer_write(SegmentWriter* writer, uint32_t timestamp, const char* line);
+
+/**
+ * @brief Flush the open segment to the operating system
+ * @param writer Pointer to the writer
+ */
+void segment_writer_flush(SegmentWriter* writer);
+
+/**
+ * @brief Close the open segment
+ * @param writer Pointer to the writer
+ */
+void segment_writer_close(SegmentWriter* writer);
+
+/**
+ * @brief Build the path of a segment
+ * @param path Buffer receiving the path
+ * @param size Size of the buffer
+ * @param directory Segment directory
+ * @param prefix Segment file prefix
+ * @param start Segment start time in Unix seconds
+ * @return true if the path fit into the buffer, false otherwise
+ */
+bool segment_writer_path(char* path, size_t size, const char* directory, const char* prefix,
+                         uint32_t start);
+
+/**
+ * @brief Parse the start time from a segment file name
+ * @param name File name without directory
+ * @param prefix Expected segment file prefix
+ * @param start Pointer to store the segment start time
+ * @return true if the name is a segment of this prefix, false otherwise
+ */
+bool segment_writer_parse_name(const char* name, const char* prefix, uint32_t* start);
+
+#endif // SEGMENT_WRITER_H
@@ -113,6 +113,22 @@ const char* sensor_error_to_string(SensorError error);
  */
 const char* sensor_type_to_string(SensorType type);
 
+/**
+ * @brief Convert string to sensor type
+ * @param type_str String representation of the sensor type
+ * @param type Pointer to store the sensor type
+ * @return true if the string names a sensor type, false otherwise
+ */
+bool sensor_string_to_type(const char* type_str, SensorType* type);
+
+/**
+ * @brief Convert string to sensor error code
+ * @param error_str String representation of the error
+ * @param error Pointer to store the error code
+ * @return true if the string names an error, false otherwise
+ */
+bool sensor_string_to_error(const char* error_str, SensorError* error);
+
 /**
  * @brief Set the name of the sensor
  * @param sensor Pointer to the sensor structure
@@ -0,0 +1,62 @@
+/**
+ * @file sensor_table.h
+ * @brief Per-sensor lookup tables for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Most components keep one entry per sensor in a fixed array owned by the component.
+ * This module finds and claims those entries: the array is an open-addressing hash
+ * table keyed by the sensor identifier (FNV-1a, linear probing), and an entry is free
+ * while its identifier is empty. Entries are never removed, so a probe ends at the
+ * first free entry.
+ *
+ * @note No locking; callers serialize access to their own tables.
+ */
+
+#ifndef SENSOR_TABLE_H
+#define SENSOR_TABLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// View of a caller-owned entry array
+typedef struct {
+    void* entries;          ///< First entry; the array starts zeroed
+    uint32_t capacity;      ///< Number of entries (power of two)
+    size_t entry_size;      ///< Size of one entry in bytes
+    size_t id_offset;       ///< Offset of the identifier array within an entry
+    size_t id_size;         ///< Size of the identifier array, including the terminator
+} SensorTable;
+
+/**
+ * @brief Describe an array of entries with a char array member holding the identifier
+ * @param array Pointer to the first entry
+ * @param count Number of entries (power of two)
+ * @param type Entry type
+ * @param member Identifier member of the entry type
+ */
+#define SENSOR_TABLE_INIT(array, count, type, member) \
+    { (array), (count), sizeof(type), offsetof(type, member), sizeof(((type*)0)->member) }
+
+// Function prototypes
+/**
+ * @brief Hash a sensor identifier
+ * @param id Sensor identifier
+ * @return 32-bit FNV-1a hash of the identifier
+ * @note The chunk log index stores these hashes, so the function must not change.
+ */
+uint32_t sensor_table_hash(const char* id);
+
+/**
+ * @brief Find the entry of a sensor, optionally claiming a free one
+ * @param table Pointer to the table description
+ * @param id Sensor identifier; longer identifiers are truncated to the identifier array
+ * @param create Claim a free entry if the sensor has none
+ * @param created Pointer set to whether a free entry was claimed, or NULL
+ * @return Pointer to the entry, or NULL if not found, the table is full or id is empty
+ * @note A claimed entry holds the identifier and is otherwise as the caller left it.
+ */
+void* sensor_table_find(const SensorTable* table, const char* id, bool create, bool* created);
+
+#endif // SENSOR_TABLE_H
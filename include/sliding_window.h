@@ -0,0 +1,96 @@
+/**
+ * @file sliding_window.h
+ * @brief Time-based sliding window statistics for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * A sliding window reports count, mean, standard deviation, minimum and maximum of the
+ * samples of the last `width_s` seconds. The window is a fixed ring of
+ * SLIDING_WINDOW_BUCKETS sub-buckets, each `width_s / SLIDING_WINDOW_BUCKETS` seconds
+ * wide, so it slides in steps of one bucket and its memory does not depend on the
+ * sample rate. Sum and sum of squares are kept as running totals that buckets enter and
+ * leave in O(1); minimum and maximum come from monotonic deques over the closed buckets,
+ * O(1) amortized. Nothing is allocated after initialization.
+ *
+ * @note Windows are plain values owned by the caller and carry no lock.
+ */
+
+#ifndef SLIDING_WINDOW_H
+#define SLIDING_WINDOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SLIDING_WINDOW_BUCKETS 60   ///< Sub-buckets per window
+
+// Aggregate of one sub-bucket; sums are taken relative to the window's shift
+typedef struct {
+    uint32_t count;         ///< Samples in the bucket
+    float min_value;        ///< Minimum value in the bucket
+    float max_value;        ///< Maximum value in the bucket
+    double sum;             ///< Sum of shifted values
+    double sum_squares;     ///< Sum of squared shifted values
+} SlidingWindowBucket;
+
+// Sliding window state
+typedef struct {
+    uint32_t width_s;       ///< Window length in seconds
+    uint32_t bucket_s;      ///< Sub-bucket width in seconds
+    uint32_t current;       ///< Number of the open bucket (Unix time / bucket_s)
+    bool started;           ///< At least one sample has been added
+    double shift;           ///< Reference value subtracted before summing, for precision
+    SlidingWindowBucket buckets[SLIDING_WINDOW_BUCKETS]; ///< Ring indexed by bucket number
+    uint64_t count;         ///< Samples in the closed buckets of the window
+    double sum;             ///< Shifted sum over the closed buckets
+    double sum_squares;     ///< Shifted sum of squares over the closed buckets
+    uint32_t min_deque[SLIDING_WINDOW_BUCKETS]; ///< Closed bucket numbers, increasing minima
+    uint32_t max_deque[SLIDING_WINDOW_BUCKETS]; ///< Closed bucket numbers, decreasing maxima
+    uint32_t min_head;      ///< Ring position of the oldest entry of min_deque
+    uint32_t min_size;      ///< Entries in min_deque
+    uint32_t max_head;      ///< Ring position of the oldest entry of max_deque
+    uint32_t max_size;      ///< Entries in max_deque
+} SlidingWindow;
+
+// Statistics of the samples currently in a window
+typedef struct {
+    uint64_t count;         ///< Number of samples
+    double mean;            ///< Mean, 0 when empty
+    double std_deviation;   ///< Population standard deviation, 0 with fewer than two samples
+    float min_value;        ///< Minimum, 0 when empty
+    float max_value;        ///< Maximum, 0 when empty
+} SlidingWindowStats;
+
+// Function prototypes
+/**
+ * @brief Initialize an empty window
+ * @param window Pointer to the window
+ * @param width_s Window length in seconds; a multiple of SLIDING_WINDOW_BUCKETS
+ * @return true if initialization successful, false for an unsupported width
+ */
+bool sliding_window_init(SlidingWindow* window, uint32_t width_s);
+
+/**
+ * @brief Add one sample
+ * @param window Pointer to the window
+ * @param timestamp Sample time in Unix seconds
+ * @param value Sample value
+ * @note Samples older than the open bucket are counted in the open bucket.
+ */
+void sliding_window_add(SlidingWindow* window, uint32_t timestamp, float value);
+
+/**
+ * @brief Slide the window forward, dropping buckets that have left it
+ * @param window Pointer to the window
+ * @param now Current time in Unix seconds
+ */
+void sliding_window_advance(SlidingWindow* window, uint32_t now);
+
+/**
+ * @brief Get the statistics of the window as of a given time
+ * @param window Pointer to the window; slid forward to `now` first
+ * @param now Current time in Unix seconds
+ * @param stats Pointer to store the statistics
+ */
+void sliding_window_get(SlidingWindow* window, uint32_t now, SlidingWindowStats* stats);
+
+#endif // SLIDING_WINDOW_H
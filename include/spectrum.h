@@ -0,0 +1,90 @@
+/**
+ * @file spectrum.h
+ * @brief Streaming spectral analysis for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Cuts a continuous high-rate signal (one vibration channel, for example) into
+ * overlapping blocks and turns each block into a frame of spectral features: overall
+ * RMS, energy in configured frequency bands and the strongest peaks. Samples can be
+ * pushed in chunks of any size; a frame is produced every `hop` samples once the first
+ * block is full.
+ *
+ * An analyzer is a plain structure the caller owns and allocates nothing. The FFT plan
+ * is passed in, so one plan can serve every channel handled by the same thread.
+ */
+
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "fft.h"
+
+#define SPECTRUM_MAX_BANDS 8        ///< Maximum number of frequency bands
+#define SPECTRUM_MAX_PEAKS 8        ///< Maximum number of peaks per frame
+
+// Analyzer configuration
+typedef struct {
+    float sample_rate;              ///< Sample rate in Hz
+    uint32_t fft_size;              ///< Samples per block, see fft_plan_init()
+    uint32_t hop;                   ///< Samples between block starts (fft_size / 2 for 50% overlap)
+    FftWindow window;               ///< Window applied to every block
+    uint32_t band_count;            ///< Number of bands
+    float band_edges_hz[SPECTRUM_MAX_BANDS + 1]; ///< Ascending band edges, band i is [edge i, edge i+1)
+    uint32_t peak_count;            ///< Peaks to report per frame
+} SpectrumConfig;
+
+// Spectral features of one block
+typedef struct {
+    uint64_t first_sample;          ///< Index of the block's first sample in the stream
+    float rms;                      ///< RMS of the windowed block
+    float band_energy[SPECTRUM_MAX_BANDS]; ///< Mean square value per band
+    FftPeak peaks[SPECTRUM_MAX_PEAKS];     ///< Strongest peaks, strongest first
+    uint32_t peak_count;            ///< Number of peaks found
+} SpectrumFrame;
+
+// Receives every frame as it is produced
+typedef void (*SpectrumCallback)(const SpectrumFrame* frame, void* context);
+
+// Streaming analyzer of one channel
+typedef struct {
+    SpectrumConfig config;          ///< Configuration
+    float block[FFT_MAX_SIZE];      ///< Samples of the block being filled
+    uint32_t fill;                  ///< Samples in the block
+    uint64_t block_start;           ///< Stream index of the block's first sample
+    float power[FFT_MAX_SIZE / 2 + 1]; ///< Power spectrum of the latest block
+} SpectrumAnalyzer;
+
+// Function prototypes
+/**
+ * @brief Prepare an analyzer
+ * @param analyzer Pointer to the analyzer
+ * @param config Pointer to the configuration
+ * @return true if the configuration is valid, false otherwise
+ */
+bool spectrum_analyzer_init(SpectrumAnalyzer* analyzer, const SpectrumConfig* config);
+
+/**
+ * @brief Feed samples and produce the frames they complete
+ * @param analyzer Pointer to the analyzer
+ * @param plan Plan prepared for the analyzer's fft_size and window
+ * @param samples Samples following the previously pushed ones
+ * @param count Number of samples
+ * @param callback Function receiving each frame, or NULL
+ * @param context Passed to the callback
+ * @return Number of frames produced, 0 if the plan does not match the configuration
+ */
+uint32_t spectrum_analyzer_push(SpectrumAnalyzer* analyzer, FftPlan* plan, const float* samples,
+                                size_t count, SpectrumCallback callback, void* context);
+
+/**
+ * @brief Get a configuration for bearing monitoring at 25.6 kHz
+ * @param config Pointer to store the configuration
+ * @note 4096-sample Hann blocks with 50% overlap (6.25 Hz resolution, 12.5 frames/s)
+ * and bands of 10 Hz-1 kHz, 1-2 kHz, 2-5 kHz and 5-10 kHz.
+ */
+void spectrum_get_default_config(SpectrumConfig* config);
+
+#endif // SPECTRUM_H
@@ -0,0 +1,78 @@
+/**
+ * @file stream_stats.h
+ * @brief Streaming statistics accumulators for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * A StreamStats accumulator keeps count, mean, variance, minimum and maximum of a
+ * stream of values in constant memory. The variance uses Welford's update and the sum
+ * a Kahan-compensated double, so results stay accurate after billions of samples.
+ * Accumulators filled independently, for example one per thread or per time window,
+ * combine with stream_stats_merge() into the statistics of the joined stream, up to
+ * rounding.
+ *
+ * @note Accumulators are plain values owned by the caller and carry no lock; callers
+ *       sharing one between threads must serialize access themselves.
+ */
+
+#ifndef STREAM_STATS_H
+#define STREAM_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Streaming statistics accumulator
+typedef struct {
+    uint64_t count;         ///< Number of values added
+    double mean;            ///< Running mean (Welford)
+    double m2;              ///< Sum of squared deviations from the mean
+    double sum;             ///< Kahan-compensated sum of the values
+    double compensation;    ///< Low-order bits lost from sum
+    double min;             ///< Smallest value, +inf when empty
+    double max;             ///< Largest value, -inf when empty
+} StreamStats;
+
+// Function prototypes
+/**
+ * @brief Reset an accumulator to the empty state
+ * @param stats Pointer to the accumulator
+ */
+void stream_stats_init(StreamStats* stats);
+
+/**
+ * @brief Add one value
+ * @param stats Pointer to the accumulator
+ * @param value Value to add
+ */
+void stream_stats_add(StreamStats* stats, double value);
+
+/**
+ * @brief Fold one accumulator into another
+ * @param stats Pointer to the accumulator receiving the values
+ * @param other Pointer to the accumulator to fold in; left unchanged
+ * @note The result equals adding all values of both streams to a single accumulator.
+ */
+void stream_stats_merge(StreamStats* stats, const StreamStats* other);
+
+/**
+ * @brief Get the mean of the values
+ * @param stats Pointer to the accumulator
+ * @return Mean, or 0 when empty
+ */
+double stream_stats_mean(const StreamStats* stats);
+
+/**
+ * @brief Get the population variance of the values
+ * @param stats Pointer to the accumulator
+ * @return Variance, or 0 with fewer than two values
+ */
+double stream_stats_variance(const StreamStats* stats);
+
+/**
+ * @brief Get the population standard deviation of the values
+ * @param stats Pointer to the accumulator
+ * @return Standard deviation, or 0 with fewer than two values
+ */
+double stream_stats_stddev(const StreamStats* stats);
+
+#endif // STREAM_STATS_H
@@ -14,8 +14,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <time.h>
 #include "sensor.h"
+#include "stream_stats.h"
+#include "quantile_sketch.h"
 
 // Temperature sensor specific data
 typedef struct {
@@ -43,12 +46,19 @@ typedef struct {
     float min_value;      ///< Minimum recorded temperature
     float max_value;      ///< Maximum recorded temperature
     float avg_value;      ///< Average temperature
-    float std_deviation;  ///< Standard deviation of temperature
+    float std_deviation;  ///< Population standard deviation of temperature
     uint32_t sample_count;///< Total number of samples
-    uint32_t alert_count; ///< Number of alerts triggered
-    uint32_t critical_count; ///< Number of critical alerts triggered
+    uint32_t alert_count; ///< Number of alerts raised by the alert engine
+    uint32_t critical_count; ///< Number of transitions into critical by the alert engine
 } TemperatureStats;
 
+// Temperature distribution
+typedef struct {
+    float p50;            ///< Median temperature
+    float p95;            ///< 95th percentile temperature
+    float p99;            ///< 99th percentile temperature
+} TemperatureQuantiles;
+
 // Function prototypes
 /**
  * @brief Initialize a temperature sensor
@@ -80,9 +90,35 @@ void temperature_sensor_cleanup(Sensor* sensor);
  * @brief Get temperature sensor statistics
  * @param sensor Pointer to the sensor structure
  * @param stats Pointer to store the statistics
- * @note Thread-safe function
+ * @note Thread-safe function. Alert counts are state transitions taken from the alert
+ *       engine (see alert.h) and stay 0 when it is not running.
+ */
+void temperature_sensor_get_stats(const Sensor* sensor, TemperatureStats* stats);
+
+/**
+ * @brief Get the double-precision accumulator behind the temperature statistics
+ * @param sensor Pointer to the sensor structure
+ * @param stats Pointer to store the accumulator
+ * @note The copy can be merged with accumulators of other sensors or shards using
+ *       stream_stats_merge().
+ */
+void temperature_sensor_get_stream_stats(const Sensor* sensor, StreamStats* stats);
+
+/**
+ * @brief Get percentiles of all temperatures since the last statistics reset
+ * @param sensor Pointer to the sensor structure
+ * @param quantiles Pointer to store the percentiles
  */
-void temperature_sensor_get_stats(Sensor* sensor, TemperatureStats* stats);
+void temperature_sensor_get_quantiles(const Sensor* sensor, TemperatureQuantiles* quantiles);
+
+/**
+ * @brief Get the quantile sketch behind the temperature percentiles
+ * @param sensor Pointer to the sensor structure
+ * @param sketch Pointer to store the sketch
+ * @note The copy can be merged with sketches of other sensors using quantile_sketch_merge()
+ *       and queried for any quantile.
+ */
+void temperature_sensor_get_sketch(const Sensor* sensor, QuantileSketch* sketch);
 
 /**
  * @brief Reset temperature sensor statistics
@@ -95,9 +131,12 @@ void temperature_sensor_reset_stats(Sensor* sensor);
  * @brief Set temperature sensor configuration
  * @param sensor Pointer to the sensor structure
  * @param config Pointer to new configuration
- * @note Thread-safe function
+ * @return true if the configuration was published, false otherwise
+ * @note Thread-safe function. The new configuration is published as a whole with an
+ * atomic pointer swap, so a concurrent read sees either the old or the new one, never
+ * a mix; acquisition is neither paused nor locked.
  */
-void temperature_sensor_set_config(Sensor* sensor, TemperatureConfig* config);
+bool temperature_sensor_set_config(Sensor* sensor, const TemperatureConfig* config);
 
 /**
  * @brief Get current temperature sensor configuration
@@ -108,19 +147,41 @@ void temperature_sensor_set_config(Sensor* sensor, TemperatureConfig* config);
 void temperature_sensor_get_config(Sensor* sensor, TemperatureConfig* config);
 
 /**
- * @brief Calculate dew point from temperature and humidity
+ * @brief Calculate dew point from temperature and humidity (Magnus formula)
  * @param temperature Temperature in Celsius
- * @param humidity Relative humidity in percentage (0-100)
+ * @param humidity Relative humidity in percentage (0-100), clamped to 0.1-100
  * @return Calculated dew point in Celsius
  */
 float temperature_sensor_calculate_dew_point(float temperature, float humidity);
 
 /**
- * @brief Calculate heat index from temperature and humidity
+ * @brief Calculate heat index from temperature and humidity (NWS Rothfusz regression)
  * @param temperature Temperature in Celsius
  * @param humidity Relative humidity in percentage (0-100)
  * @return Calculated heat index in Celsius
  */
 float temperature_sensor_calculate_heat_index(float temperature, float humidity);
 
+/**
+ * @brief Calculate dew points for arrays of temperatures and humidities
+ * @param t Temperatures in Celsius
+ * @param rh Relative humidities in percentage (0-100), clamped to 0.1-100
+ * @param out Array receiving the dew points in Celsius
+ * @param n Number of elements
+ * @note Uses AVX2, SSE2 or NEON where available; results are bit-identical to
+ *       temperature_sensor_calculate_dew_point() on every path.
+ */
+void temperature_sensor_dew_point_batch(const float* t, const float* rh, float* out, size_t n);
+
+/**
+ * @brief Calculate heat indices for arrays of temperatures and humidities
+ * @param t Temperatures in Celsius
+ * @param rh Relative humidities in percentage (0-100)
+ * @param out Array receiving the heat indices in Celsius
+ * @param n Number of elements
+ * @note Uses AVX2, SSE2 or NEON where available; results are bit-identical to
+ *       temperature_sensor_calculate_heat_index() on every path.
+ */
+void temperature_sensor_heat_index_batch(const float* t, const float* rh, float* out, size_t n);
+
 #endif // TEMPERATURE_SENSOR_H 
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**
+ * @file trend.h
+ * @brief Trend estimation and time-to-threshold prediction for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Fits a straight line to each sensor's recent samples with recursive least squares
+ * and a forgetting factor, so older samples fade out exponentially. The fit is updated
+ * in O(1) per sample and kept relative to the latest sample, so its intercept is the
+ * current level. Extrapolating the line gives the time until the sensor reaches its
+ * alert and critical thresholds (see alert.h).
+ *
+ * @note All registry functions are serialized by an internal mutex. TrendEstimator
+ * itself has no locking and can be embedded in other components.
+ */
+
+#ifndef TREND_H
+#define TREND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define TREND_MAX_SENSORS 1024      ///< Maximum number of distinct sensors (power of two)
+
+// Estimator configuration
+typedef struct {
+    double forgetting_factor;   ///< Weight kept by the previous fit per sample (0-1]
+    uint32_t min_samples;       ///< Samples needed before predictions are made
+} TrendConfig;
+
+// Recursive least squares fit of value = level + slope * (t - reference)
+typedef struct {
+    double level;               ///< Fitted value at the reference time
+    double slope;               ///< Fitted change per second
+    double p00, p01, p11;       ///< Inverse information matrix of (level, slope)
+    uint32_t reference;         ///< Time of the latest sample in Unix seconds
+    uint32_t count;             ///< Samples fitted
+} TrendEstimator;
+
+// Trend and predictions of one sensor
+typedef struct {
+    float level;                ///< Fitted current value
+    float slope_per_s;          ///< Fitted change per second
+    float time_to_alert_s;      ///< Seconds until the alert threshold is reached, INFINITY if not approaching
+    float time_to_critical_s;   ///< Seconds until the critical threshold is reached, INFINITY if not approaching
+    uint32_t timestamp;         ///< Time of the latest sample in Unix seconds
+    bool valid;                 ///< Whether enough samples were fitted for predictions
+} TrendStatus;
+
+// Function prototypes
+/**
+ * @brief Reset an estimator
+ * @param estimator Pointer to the estimator
+ */
+void trend_estimator_init(TrendEstimator* estimator);
+
+/**
+ * @brief Fold a sample into the fit
+ * @param estimator Pointer to the estimator
+ * @param forgetting_factor Weight kept by the previous fit (0-1]
+ * @param timestamp Time of the sample in Unix seconds
+ * @param value Sample value
+ * @return true if the sample was fitted, false if it is not newer than the latest one
+ */
+bool trend_estimator_update(TrendEstimator* estimator, double forgetting_factor,
+                            uint32_t timestamp, float value);
+
+/**
+ * @brief Extrapolate the fit to a threshold
+ * @param estimator Pointer to the estimator
+ * @param threshold Value to reach
+ * @return Seconds after the latest sample until the line reaches the threshold from
+ * below, 0 if it is already above it, INFINITY if the line is not rising
+ */
+float trend_estimator_time_to(const TrendEstimator* estimator, float threshold);
+
+/**
+ * @brief Initialize the per-sensor trend estimators
+ * @param config Pointer to configuration, or NULL for the defaults
+ * @return true if initialization successful, false otherwise
+ */
+bool trend_init(const TrendConfig* config);
+
+/**
+ * @brief Release the per-sensor trend estimators
+ */
+void trend_cleanup(void);
+
+/**
+ * @brief Fold one sample into its sensor's fit
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample was fitted, false otherwise
+ */
+bool trend_process_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the trend of a sensor and its predicted time to the alert thresholds
+ * @param sensor_id Sensor identifier
+ * @param status Pointer to store the trend
+ * @return true if the sensor is known, false otherwise
+ * @note The thresholds are those of the alert engine for the sensor; without a running
+ * alert engine both predictions are INFINITY.
+ */
+bool trend_get_status(const char* sensor_id, TrendStatus* status);
+
+/**
+ * @brief Get the default estimator configuration
+ * @param config Pointer to store the configuration
+ */
+void trend_get_default_config(TrendConfig* config);
+
+#endif // TREND_H
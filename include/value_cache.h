@@ -0,0 +1,79 @@
+/**
+ * @file value_cache.h
+ * @brief Last-value cache for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Holds the most recent reading of every sensor in one cache-line-sized slot: value,
+ * timestamp, sequence number and quality. Acquisition publishes each reading as it is
+ * taken (see sensor_read_data()), and dashboards, rules and network handlers read the
+ * current state from here instead of calling into the drivers.
+ *
+ * @note Reads never block and never take a lock; each slot is a sequence lock, so a
+ * reader retries in the rare case it overlaps an update. Only the first update of a
+ * new sensor takes a mutex, to claim its slot.
+ */
+
+#ifndef VALUE_CACHE_H
+#define VALUE_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define VALUE_CACHE_MAX_SENSORS 1024  ///< Maximum number of distinct sensors (power of two)
+
+// Quality of a cached value
+typedef enum {
+    VALUE_QUALITY_NONE = 0,         ///< No reading published yet
+    VALUE_QUALITY_GOOD,             ///< Latest reading is valid and recent
+    VALUE_QUALITY_BAD,              ///< Latest reading failed or was invalid
+    VALUE_QUALITY_STALE             ///< Latest reading is valid but older than the allowed age
+} ValueQuality;
+
+// Snapshot of one sensor's last value
+typedef struct {
+    float value;            ///< Last value
+    uint32_t timestamp;     ///< Time the value was sampled in Unix seconds
+    uint32_t sequence;      ///< Number of readings published for the sensor
+    uint32_t age_s;         ///< Seconds between the sample and the time of the query
+    ValueQuality quality;   ///< Quality of the value at the time of the query
+    SensorType type;        ///< Type of the sensor
+    SensorError error;      ///< Error reported with the last reading
+} CachedValue;
+
+// Function prototypes
+/**
+ * @brief Remove all sensors from the cache
+ * @note Not safe against concurrent readers or writers; call before they start.
+ */
+void value_cache_reset(void);
+
+/**
+ * @brief Publish a reading
+ * @param sensor Pointer to the sensor that produced the reading
+ * @param data Pointer to the reading; invalid or failed readings are published with bad quality
+ * @return true if the cache holds the reading, false if the sensor table is full
+ * @note Readings older than the cached one are ignored, and republishing an identical
+ * reading does not advance the sequence number.
+ */
+bool value_cache_update(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the last value of a sensor
+ * @param sensor_id Sensor identifier
+ * @param now Current time in Unix seconds, used for the age
+ * @param max_age_s Age above which a good value is reported as stale, 0 to never
+ * @param value Pointer to store the snapshot
+ * @return true if the sensor has published a reading, false otherwise
+ */
+bool value_cache_get(const char* sensor_id, uint32_t now, uint32_t max_age_s, CachedValue* value);
+
+/**
+ * @brief Get the printable name of a value quality
+ * @param quality Value quality
+ * @return Name of the quality
+ */
+const char* value_cache_quality_to_string(ValueQuality quality);
+
+#endif // VALUE_CACHE_H
@@ -0,0 +1,99 @@
+/**
+ * @file vibration.h
+ * @brief Vibration condition indicators for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Reduces a continuous high-rate vibration or acceleration signal to one set of condition
+ * indicators per window: mean, RMS, peak, crest factor, skewness, kurtosis and envelope
+ * RMS. Every sample is read once: power sums and extremes are accumulated with SSE2 on
+ * x86 and NEON on aarch64, and the envelope filters run in the same loop.
+ *
+ * The envelope is demodulated by high-pass filtering the signal, rectifying it and
+ * low-pass filtering the result, all with one-pole filters whose state carries across
+ * windows. Envelope RMS is the RMS of the envelope about its mean, so a steady tone
+ * scores near zero while periodic impacts, such as bearing defects, raise it.
+ *
+ * An analyzer is a plain structure the caller owns and allocates nothing. Samples can be
+ * pushed in chunks of any size and are not buffered.
+ */
+
+#ifndef VIBRATION_H
+#define VIBRATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Analyzer configuration
+typedef struct {
+    float sample_rate;          ///< Sample rate in Hz
+    uint32_t window_size;       ///< Samples per feature window
+    float envelope_highpass_hz; ///< Cutoff of the high-pass applied before rectification
+    float envelope_lowpass_hz;  ///< Cutoff of the low-pass applied after rectification
+} VibrationConfig;
+
+// Condition indicators of one window
+typedef struct {
+    uint64_t first_sample;      ///< Index of the window's first sample in the stream
+    float mean;                 ///< Mean value (sensor offset or gravity)
+    float rms;                  ///< RMS about the mean
+    float peak;                 ///< Largest deviation from the mean
+    float crest_factor;         ///< peak / rms
+    float skewness;             ///< Third standardized moment
+    float kurtosis;             ///< Fourth standardized moment, 3 for Gaussian noise
+    float envelope_rms;         ///< RMS of the envelope about its mean
+} VibrationFeatures;
+
+// Receives the features of every completed window
+typedef void (*VibrationCallback)(const VibrationFeatures* features, void* context);
+
+// Streaming analyzer of one channel
+typedef struct {
+    VibrationConfig config;     ///< Configuration
+    float highpass_coeff;       ///< High-pass feedback coefficient
+    float lowpass_coeff;        ///< Low-pass smoothing coefficient
+    float highpass_state;       ///< Last high-pass output
+    float highpass_input;       ///< Last high-pass input
+    float envelope;             ///< Last envelope value
+    float shift;                ///< Value subtracted before the power sums (last window mean)
+    bool primed;                ///< Shift and filters initialized from a sample
+    uint32_t fill;              ///< Samples in the current window
+    uint64_t window_start;      ///< Stream index of the current window's first sample
+    double sums[4];             ///< Sums of (x - shift)^1..4 in the current window
+    float max_value;            ///< Largest sample of the current window
+    float min_value;            ///< Smallest sample of the current window
+    double envelope_sum;        ///< Sum of the envelope in the current window
+    double envelope_sum_sq;     ///< Sum of the squared envelope in the current window
+} VibrationAnalyzer;
+
+// Function prototypes
+/**
+ * @brief Prepare an analyzer
+ * @param analyzer Pointer to the analyzer
+ * @param config Pointer to the configuration
+ * @return true if the configuration is valid, false otherwise
+ */
+bool vibration_analyzer_init(VibrationAnalyzer* analyzer, const VibrationConfig* config);
+
+/**
+ * @brief Feed samples and produce the windows they complete
+ * @param analyzer Pointer to the analyzer
+ * @param samples Samples following the previously pushed ones
+ * @param count Number of samples
+ * @param callback Function receiving the features of each window, or NULL
+ * @param context Passed to the callback
+ * @return Number of windows completed
+ */
+uint32_t vibration_analyzer_push(VibrationAnalyzer* analyzer, const float* samples, size_t count,
+                                 VibrationCallback callback, void* context);
+
+/**
+ * @brief Get a configuration for accelerometers sampled at 25.6 kHz
+ * @param config Pointer to store the configuration
+ * @note Half-second windows (2 feature sets per second) and an envelope band of
+ * 1 kHz high-pass followed by a 1 kHz low-pass of the rectified signal.
+ */
+void vibration_get_default_config(VibrationConfig* config);
+
+#endif // VIBRATION_H
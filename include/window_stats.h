@@ -0,0 +1,77 @@
+/**
+ * @file window_stats.h
+ * @brief Per-sensor sliding window statistics for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Keeps a set of sliding windows (1 min, 15 min and 1 h by default) for every sensor
+ * that reports samples, so alerting can look at recent behaviour instead of lifetime
+ * aggregates. All per-sensor state is allocated once at initialization; adding a sample
+ * costs O(1) per window.
+ *
+ * @note All public functions are serialized by an internal mutex.
+ */
+
+#ifndef WINDOW_STATS_H
+#define WINDOW_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+#include "sliding_window.h"
+
+#define WINDOW_STATS_MAX_WINDOWS 4      ///< Maximum number of windows per sensor
+#define WINDOW_STATS_MAX_SENSORS 1024   ///< Maximum number of distinct sensors (power of two)
+
+// Window statistics configuration
+typedef struct {
+    uint32_t widths_s[WINDOW_STATS_MAX_WINDOWS]; ///< Window lengths, multiples of SLIDING_WINDOW_BUCKETS
+    uint32_t window_count;  ///< Number of configured windows
+} WindowStatsConfig;
+
+// Function prototypes
+/**
+ * @brief Initialize the per-sensor windows
+ * @param config Pointer to configuration, or NULL for 1 min / 15 min / 1 h windows
+ * @return true if initialization successful, false otherwise
+ */
+bool window_stats_init(const WindowStatsConfig* config);
+
+/**
+ * @brief Release the per-sensor windows
+ */
+void window_stats_cleanup(void);
+
+/**
+ * @brief Add one sample to every window of its sensor
+ * @param sensor Pointer to the sensor that produced the sample
+ * @param data Pointer to the sample; invalid samples are ignored
+ * @return true if the sample was accepted, false otherwise
+ */
+bool window_stats_add_sample(const Sensor* sensor, const SensorData* data);
+
+/**
+ * @brief Get the statistics of one window of a sensor
+ * @param sensor_id Sensor identifier
+ * @param window Window index in configuration order
+ * @param now Current time in Unix seconds
+ * @param stats Pointer to store the statistics
+ * @return true if the sensor and window exist, false otherwise
+ */
+bool window_stats_get(const char* sensor_id, uint32_t window, uint32_t now, SlidingWindowStats* stats);
+
+/**
+ * @brief Find the index of the window with a given length
+ * @param width_s Window length in seconds
+ * @param window Pointer to store the window index
+ * @return true if such a window is configured, false otherwise
+ */
+bool window_stats_find_window(uint32_t width_s, uint32_t* window);
+
+/**
+ * @brief Get the default window configuration
+ * @param config Pointer to store the configuration
+ */
+void window_stats_get_default_config(WindowStatsConfig* config);
+
+#endif // WINDOW_STATS_H
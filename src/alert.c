@@ -0,0 +1,232 @@
+/**
+ * @file alert.c
+ * @brief Alert state machine for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/alert.h"
+#include "../include/event_queue.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Per-sensor alert state
+typedef struct {
+    char id[32];
+    bool configured;
+    AlertConfig config;
+    AlertStatus status;
+    bool pending;
+    AlertState pending_state;
+    uint32_t pending_since;
+} AlertSensor;
+
+// Private data structure
+typedef struct {
+    AlertConfig default_config;
+    AlertSensor sensors[ALERT_MAX_SENSORS];
+} AlertPrivate;
+
+// Forward declarations of private functions
+static AlertSensor* find_sensor(const char* id, bool create);
+static AlertState target_state(const AlertConfig* config, AlertState state, float value);
+
+// Private data instance
+static AlertPrivate* private_data = NULL;
+static pthread_mutex_t alert_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool alert_init(const AlertConfig* default_config) {
+    if (!default_config || default_config->critical_threshold < default_config->alert_threshold ||
+        default_config->hysteresis < 0.0f) {
+        return false;
+    }
+
+    pthread_mutex_lock(&alert_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&alert_mutex);
+        return false;
+    }
+
+    private_data = (AlertPrivate*)calloc(1, sizeof(AlertPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&alert_mutex);
+        return false;
+    }
+    memcpy(&private_data->default_config, default_config, sizeof(AlertConfig));
+
+    pthread_mutex_unlock(&alert_mutex);
+    return true;
+}
+
+void alert_cleanup(void) {
+    pthread_mutex_lock(&alert_mutex);
+
+    if (private_data) {
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&alert_mutex);
+}
+
+bool alert_configure_sensor(const char* sensor_id, const AlertConfig* config) {
+    if (!sensor_id || !config || config->critical_threshold < config->alert_threshold ||
+        config->hysteresis < 0.0f) {
+        return false;
+    }
+
+    pthread_mutex_lock(&alert_mutex);
+
+    AlertSensor* entry = private_data ? find_sensor(sensor_id, true) : NULL;
+    if (entry) {
+        memcpy(&entry->config, config, sizeof(AlertConfig));
+        entry->configured = true;
+    }
+
+    pthread_mutex_unlock(&alert_mutex);
+    return entry != NULL;
+}
+
+bool alert_get_config(const char* sensor_id, AlertConfig* config) {
+    if (!sensor_id || !config) {
+        return false;
+    }
+
+    pthread_mutex_lock(&alert_mutex);
+
+    bool running = private_data != NULL;
+    if (running) {
+        AlertSensor* entry = find_sensor(sensor_id, false);
+        const AlertConfig* source = entry && entry->configured ? &entry->config : &private_data->default_config;
+        memcpy(config, source, sizeof(AlertConfig));
+    }
+
+    pthread_mutex_unlock(&alert_mutex);
+    return running;
+}
+
+bool alert_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data || !data->is_valid) {
+        return false;
+    }
+
+    pthread_mutex_lock(&alert_mutex);
+
+    AlertSensor* entry = private_data ? find_sensor(sensor->id, true) : NULL;
+    if (!entry) {
+        pthread_mutex_unlock(&alert_mutex);
+        return false;
+    }
+
+    const AlertConfig* config = entry->configured ? &entry->config : &private_data->default_config;
+    AlertState state = entry->status.state;
+    AlertState target = target_state(config, state, data->value);
+
+    bool transition = false;
+    if (target == state) {
+        entry->pending = false;
+    } else {
+        // Debounce: the new state has to hold for the dwell time of its direction. A
+        // timestamp before the pending start, after a clock step, restarts the dwell.
+        if (!entry->pending || entry->pending_state != target || data->timestamp < entry->pending_since) {
+            entry->pending = true;
+            entry->pending_state = target;
+            entry->pending_since = data->timestamp;
+        }
+        uint32_t dwell = target > state ? config->raise_dwell_s : config->clear_dwell_s;
+        transition = data->timestamp - entry->pending_since >= dwell;
+    }
+
+    entry->status.samples++;
+    if ((transition ? target : state) == ALERT_STATE_CRITICAL) {
+        entry->status.critical_samples++;
+    }
+    if (!transition) {
+        pthread_mutex_unlock(&alert_mutex);
+        return false;
+    }
+
+    entry->pending = false;
+    entry->status.state = target;
+    entry->status.since = data->timestamp;
+    if (state == ALERT_STATE_NORMAL) {
+        entry->status.alert_count++;
+    }
+    if (target == ALERT_STATE_CRITICAL) {
+        entry->status.critical_count++;
+    }
+
+    MonitorEvent event;
+    memset(&event, 0, sizeof(event));
+    event.type = EVENT_ALERT_TRANSITION;
+    memcpy(event.sensor_id, sensor->id, sizeof(event.sensor_id) - 1);
+    event.sensor_type = sensor->type;
+    event.timestamp = data->timestamp;
+    event.value = data->value;
+    event.from_state = state;
+    event.to_state = target;
+    event_queue_push(&event);
+
+    pthread_mutex_unlock(&alert_mutex);
+    return true;
+}
+
+bool alert_get_status(const char* sensor_id, AlertStatus* status) {
+    if (!sensor_id || !status) {
+        return false;
+    }
+
+    pthread_mutex_lock(&alert_mutex);
+
+    AlertSensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    if (entry) {
+        memcpy(status, &entry->status, sizeof(AlertStatus));
+    }
+
+    pthread_mutex_unlock(&alert_mutex);
+    return entry != NULL;
+}
+
+const char* alert_state_to_string(AlertState state) {
+    switch (state) {
+        case ALERT_STATE_NORMAL:
+            return "Normal";
+        case ALERT_STATE_ALERT:
+            return "Alert";
+        case ALERT_STATE_CRITICAL:
+            return "Critical";
+        default:
+            return "Unknown";
+    }
+}
+
+// Private helper functions
+static AlertState target_state(const AlertConfig* config, AlertState state, float value) {
+    // Rising uses the thresholds themselves, falling the thresholds minus the hysteresis
+    AlertState rising = ALERT_STATE_NORMAL;
+    if (value > config->critical_threshold) {
+        rising = ALERT_STATE_CRITICAL;
+    } else if (value > config->alert_threshold) {
+        rising = ALERT_STATE_ALERT;
+    }
+    if (rising > state) {
+        return rising;
+    }
+
+    AlertState falling = ALERT_STATE_NORMAL;
+    if (value >= config->critical_threshold - config->hysteresis) {
+        falling = ALERT_STATE_CRITICAL;
+    } else if (value >= config->alert_threshold - config->hysteresis) {
+        falling = ALERT_STATE_ALERT;
+    }
+    return falling < state ? falling : state;
+}
+
+static AlertSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, ALERT_MAX_SENSORS,
+                                          AlertSensor, id);
+    return (AlertSensor*)sensor_table_find(&table, id, create, NULL);
+}
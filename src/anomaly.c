@@ -0,0 +1,213 @@
+/**
+ * @file anomaly.c
+ * @brief Online anomaly detection for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/anomaly.h"
+#include "../include/event_queue.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#define MAD_TO_SIGMA 1.4826f        // MAD of a normal distribution times this is its sigma
+
+// Per-sensor detector
+typedef struct {
+    char id[32];
+    AnomalyStatus status;
+} AnomalySensor;
+
+// Private data structure
+typedef struct {
+    AnomalyConfig config;
+    AnomalySensor sensors[ANOMALY_MAX_SENSORS];
+} AnomalyPrivate;
+
+// Forward declarations of private functions
+static AnomalySensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static AnomalyPrivate* private_data = NULL;
+static pthread_mutex_t anomaly_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void anomaly_detector_init(AnomalyDetector* detector) {
+    if (detector) {
+        memset(detector, 0, sizeof(AnomalyDetector));
+    }
+}
+
+bool anomaly_detector_update(AnomalyDetector* detector, const AnomalyConfig* config,
+                             float value, AnomalyScore* score) {
+    if (!detector || !config) {
+        return false;
+    }
+
+    if (detector->count == 0) {
+        detector->mean = value;
+        detector->median = value;
+        detector->variance = 0.0f;
+        detector->mad = 0.0f;
+        detector->count = 1;
+        detector->anomalous = false;
+        if (score) {
+            memset(score, 0, sizeof(AnomalyScore));
+        }
+        return false;
+    }
+
+    // Score against the model before this sample
+    float deviation = value - detector->mean;
+    float stddev = sqrtf(detector->variance);
+    float z_score = stddev > 0.0f ? deviation / stddev : 0.0f;
+    float robust_deviation = value - detector->median;
+    float robust_scale = fmaxf(MAD_TO_SIGMA * detector->mad, config->min_scale);
+    float robust_z = robust_deviation / robust_scale;
+    bool is_anomaly = detector->count >= config->warmup_samples &&
+                      (fabsf(z_score) > config->z_threshold ||
+                       fabsf(robust_z) > config->robust_threshold);
+
+    // EWMA mean and variance
+    float increment = config->alpha * deviation;
+    detector->mean += increment;
+    detector->variance = (1.0f - config->alpha) * (detector->variance + deviation * increment);
+
+    // Median and MAD move a fraction of the spread towards each sample, which converges
+    // on the 50th percentile of the value and of its absolute deviation. The fraction
+    // starts at 1/count so that the estimates settle within the warm-up.
+    float rate = fmaxf(config->median_step, 1.0f / (float)detector->count);
+    float step = rate * fmaxf(fmaxf(MAD_TO_SIGMA * detector->mad, stddev), config->min_scale);
+    detector->median += robust_deviation > 0.0f ? step : (robust_deviation < 0.0f ? -step : 0.0f);
+    float absolute_deviation = fabsf(robust_deviation);
+    detector->mad += absolute_deviation > detector->mad ? step : -step;
+    if (detector->mad < 0.0f) {
+        detector->mad = 0.0f;
+    }
+
+    detector->count++;
+    detector->anomalous = is_anomaly;
+
+    if (score) {
+        score->z_score = z_score;
+        score->robust_z = robust_z;
+        score->is_anomaly = is_anomaly;
+    }
+    return is_anomaly;
+}
+
+bool anomaly_init(const AnomalyConfig* config) {
+    AnomalyConfig defaults;
+    if (!config) {
+        anomaly_get_default_config(&defaults);
+        config = &defaults;
+    }
+    if (config->alpha <= 0.0f || config->alpha > 1.0f || config->median_step <= 0.0f ||
+        config->min_scale <= 0.0f) {
+        return false;
+    }
+
+    pthread_mutex_lock(&anomaly_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&anomaly_mutex);
+        return false;
+    }
+
+    private_data = (AnomalyPrivate*)calloc(1, sizeof(AnomalyPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&anomaly_mutex);
+        return false;
+    }
+    memcpy(&private_data->config, config, sizeof(AnomalyConfig));
+
+    pthread_mutex_unlock(&anomaly_mutex);
+    return true;
+}
+
+void anomaly_cleanup(void) {
+    pthread_mutex_lock(&anomaly_mutex);
+
+    if (private_data) {
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&anomaly_mutex);
+}
+
+bool anomaly_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data || !data->is_valid) {
+        return false;
+    }
+
+    pthread_mutex_lock(&anomaly_mutex);
+
+    AnomalySensor* entry = private_data ? find_sensor(sensor->id, true) : NULL;
+    if (!entry) {
+        pthread_mutex_unlock(&anomaly_mutex);
+        return false;
+    }
+
+    AnomalyDetector* detector = &entry->status.detector;
+    bool was_anomalous = detector->anomalous;
+    bool is_anomaly = anomaly_detector_update(detector, &private_data->config, data->value,
+                                              &entry->status.last_score);
+
+    // Publish the start of each anomalous run, not every anomalous sample
+    bool started = is_anomaly && !was_anomalous;
+    if (started) {
+        entry->status.anomaly_count++;
+
+        MonitorEvent event;
+        memset(&event, 0, sizeof(event));
+        event.type = EVENT_ANOMALY;
+        memcpy(event.sensor_id, sensor->id, sizeof(event.sensor_id) - 1);
+        event.sensor_type = sensor->type;
+        event.timestamp = data->timestamp;
+        event.value = data->value;
+        event.score = entry->status.last_score.robust_z;
+        event_queue_push(&event);
+    }
+
+    pthread_mutex_unlock(&anomaly_mutex);
+    return started;
+}
+
+bool anomaly_get_status(const char* sensor_id, AnomalyStatus* status) {
+    if (!sensor_id || !status) {
+        return false;
+    }
+
+    pthread_mutex_lock(&anomaly_mutex);
+
+    AnomalySensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    if (entry) {
+        memcpy(status, &entry->status, sizeof(AnomalyStatus));
+    }
+
+    pthread_mutex_unlock(&anomaly_mutex);
+    return entry != NULL;
+}
+
+void anomaly_get_default_config(AnomalyConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->alpha = 0.05f;
+    config->median_step = 0.02f;
+    config->min_scale = 0.01f;
+    config->z_threshold = 4.0f;
+    config->robust_threshold = 5.0f;
+    config->warmup_samples = 30;
+}
+
+// Private helper functions
+static AnomalySensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, ANOMALY_MAX_SENSORS,
+                                          AnomalySensor, id);
+    return (AnomalySensor*)sensor_table_find(&table, id, create, NULL);
+}
@@ -0,0 +1,518 @@
+/**
+ * @file arrow_export.c
+ * @brief Apache Arrow IPC export of sample history for the Industrial AI-Powered Edge
+ *        Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * The Arrow IPC file layout is: "ARROW1" magic, a schema message, one message per record
+ * batch, a footer listing the batches, the footer length and the magic again. Message
+ * and footer metadata are FlatBuffers; the small builder below lays each object out
+ * front to back and patches forward offsets once the referenced object is written,
+ * which is all the Arrow schema needs.
+ */
+
+#include "../include/arrow_export.h"
+#include "../include/chunk_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Arrow format constants (Schema.fbs / Message.fbs / File.fbs)
+#define ARROW_METADATA_V5 4
+#define ARROW_HEADER_SCHEMA 1
+#define ARROW_HEADER_RECORD_BATCH 3
+#define ARROW_TYPE_FLOATING_POINT 3
+#define ARROW_TYPE_UTF8 5
+#define ARROW_TYPE_TIMESTAMP 10
+#define ARROW_PRECISION_SINGLE 1
+#define ARROW_TIME_UNIT_SECOND 0
+#define ARROW_BUFFER_ALIGNMENT 64
+#define ARROW_COLUMN_COUNT 3
+#define ARROW_BUFFER_COUNT 7
+#define ARROW_MAX_BATCHES 65536
+
+// FlatBuffer under construction
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} FbBuilder;
+
+// Scalar or offset field of a table
+typedef struct {
+    uint16_t id;            // Field index in the schema
+    uint8_t size;           // 1, 2, 4 or 8 bytes; offsets are 4
+    uint64_t value;         // Scalar value, ignored for offsets
+    bool is_offset;         // Offset to be patched once the target is written
+} FbField;
+
+// FlatBuffer structs of the Arrow schema, little-endian on disk
+typedef struct {
+    int64_t length;
+    int64_t null_count;
+} ArrowFieldNode;
+
+typedef struct {
+    int64_t offset;
+    int64_t length;
+} ArrowBuffer;
+
+typedef struct {
+    int64_t offset;
+    int32_t metadata_length;
+    int32_t padding;
+    int64_t body_length;
+} ArrowBlock;
+
+// Export state
+typedef struct {
+    FILE* file;
+    uint64_t position;
+    bool failed;
+    uint32_t rows;
+    int64_t* timestamps;
+    float* values;
+    int32_t* id_offsets;
+    char* id_data;
+    size_t id_capacity;
+    ArrowBlock* blocks;
+    uint32_t block_count;
+    uint64_t total_rows;
+} ArrowWriter;
+
+// Forward declarations of private functions
+static size_t fb_reserve(FbBuilder* builder, size_t length);
+static void fb_align(FbBuilder* builder, size_t alignment, size_t lookahead);
+static size_t fb_table(FbBuilder* builder, const FbField* fields, int count, size_t* offset_slots);
+static size_t fb_string(FbBuilder* builder, const char* text);
+static size_t fb_offset_vector(FbBuilder* builder, uint32_t count, size_t* element_slots);
+static size_t fb_struct_vector(FbBuilder* builder, const void* elements, uint32_t count, size_t size);
+static void fb_patch(FbBuilder* builder, size_t slot, size_t target);
+static size_t build_schema(FbBuilder* builder);
+static bool write_bytes(ArrowWriter* writer, const void* data, size_t length);
+static bool write_padding(ArrowWriter* writer, size_t length);
+static bool write_message(ArrowWriter* writer, const FbBuilder* metadata, ArrowBlock* block);
+static bool write_schema(ArrowWriter* writer);
+static bool write_batch(ArrowWriter* writer);
+static bool write_footer(ArrowWriter* writer);
+static bool collect_samples(const char* sensor_id, SensorType type, const uint32_t* timestamps,
+                            const float* values, uint32_t count, void* context);
+static size_t pad_to(size_t value, size_t alignment);
+
+bool arrow_export_chunk_log(const char* path, const char* sensor_id, uint32_t from, uint32_t to,
+                            ArrowExportStats* stats) {
+    if (!path || from > to) {
+        return false;
+    }
+
+    ArrowWriter writer;
+    memset(&writer, 0, sizeof(writer));
+    writer.id_capacity = (size_t)ARROW_EXPORT_BATCH_ROWS * 16;
+    writer.timestamps = (int64_t*)malloc(ARROW_EXPORT_BATCH_ROWS * sizeof(int64_t));
+    writer.values = (float*)malloc(ARROW_EXPORT_BATCH_ROWS * sizeof(float));
+    writer.id_offsets = (int32_t*)malloc((ARROW_EXPORT_BATCH_ROWS + 1) * sizeof(int32_t));
+    writer.id_data = (char*)malloc(writer.id_capacity);
+    writer.blocks = (ArrowBlock*)malloc(ARROW_MAX_BATCHES * sizeof(ArrowBlock));
+    writer.file = fopen(path, "wb");
+
+    bool result = writer.timestamps && writer.values && writer.id_offsets && writer.id_data &&
+                  writer.blocks && writer.file;
+    if (result) {
+        setvbuf(writer.file, NULL, _IOFBF, 1 << 20);
+        writer.id_offsets[0] = 0;
+
+        static const char magic[8] = { 'A', 'R', 'R', 'O', 'W', '1', 0, 0 };
+        result = write_bytes(&writer, magic, sizeof(magic)) && write_schema(&writer) &&
+                 chunk_log_query(sensor_id, from, to, collect_samples, &writer) &&
+                 !writer.failed && (writer.rows == 0 || write_batch(&writer)) &&
+                 write_footer(&writer);
+    }
+
+    if (writer.file && fclose(writer.file) != 0) {
+        result = false;
+    }
+    if (!result && writer.file) {
+        remove(path);
+    }
+
+    if (stats) {
+        stats->rows = writer.total_rows;
+        stats->batches = writer.block_count;
+        stats->bytes = writer.position;
+    }
+
+    free(writer.timestamps);
+    free(writer.values);
+    free(writer.id_offsets);
+    free(writer.id_data);
+    free(writer.blocks);
+    return result;
+}
+
+// Private helper functions
+static size_t pad_to(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static size_t fb_reserve(FbBuilder* builder, size_t length) {
+    if (builder->size + length > builder->capacity) {
+        size_t capacity = builder->capacity ? builder->capacity : 512;
+        while (capacity < builder->size + length) {
+            capacity *= 2;
+        }
+        uint8_t* data = (uint8_t*)realloc(builder->data, capacity);
+        if (!data) {
+            builder->failed = true;
+            return 0;
+        }
+        builder->data = data;
+        builder->capacity = capacity;
+    }
+
+    size_t position = builder->size;
+    memset(builder->data + position, 0, length);
+    builder->size += length;
+    return position;
+}
+
+static void fb_align(FbBuilder* builder, size_t alignment, size_t lookahead) {
+    // Pad so that the object starting `lookahead` bytes from here is aligned
+    size_t target = pad_to(builder->size + lookahead, alignment) - lookahead;
+    if (target > builder->size) {
+        fb_reserve(builder, target - builder->size);
+    }
+}
+
+static size_t fb_table(FbBuilder* builder, const FbField* fields, int count, size_t* offset_slots) {
+    uint16_t layout[16];
+    uint16_t max_id = 0;
+    size_t table_alignment = 4;
+    size_t cursor = 4;
+
+    // Inline layout after the vtable offset: widest fields first, each naturally aligned
+    for (uint8_t size = 8; size >= 1; size /= 2) {
+        for (int i = 0; i < count; i++) {
+            if (fields[i].size != size) {
+                continue;
+            }
+            cursor = pad_to(cursor, size);
+            layout[i] = (uint16_t)cursor;
+            cursor += size;
+            if (size > table_alignment) {
+                table_alignment = size;
+            }
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (fields[i].id > max_id) {
+            max_id = fields[i].id;
+        }
+    }
+    size_t table_size = pad_to(cursor, 4);
+
+    // vtable: its own size, the table size, then one slot per field id
+    size_t vtable_size = 4 + 2 * ((size_t)max_id + 1);
+    fb_align(builder, 2, 0);
+    size_t vtable = fb_reserve(builder, vtable_size);
+    fb_align(builder, table_alignment, 0);
+    size_t table = fb_reserve(builder, table_size);
+    if (builder->failed) {
+        return 0;
+    }
+
+    uint16_t header[2] = { (uint16_t)vtable_size, (uint16_t)table_size };
+    memcpy(builder->data + vtable, header, sizeof(header));
+    int32_t vtable_offset = (int32_t)(table - vtable);
+    memcpy(builder->data + table, &vtable_offset, sizeof(vtable_offset));
+
+    int slot = 0;
+    for (int i = 0; i < count; i++) {
+        uint16_t field_offset = layout[i];
+        memcpy(builder->data + vtable + 4 + 2 * fields[i].id, &field_offset, sizeof(field_offset));
+        if (fields[i].is_offset) {
+            offset_slots[slot++] = table + layout[i];
+        } else {
+            memcpy(builder->data + table + layout[i], &fields[i].value, fields[i].size);
+        }
+    }
+
+    return table;
+}
+
+static size_t fb_string(FbBuilder* builder, const char* text) {
+    uint32_t length = (uint32_t)strlen(text);
+    fb_align(builder, 4, 0);
+    size_t position = fb_reserve(builder, 4 + length + 1);
+    if (!builder->failed) {
+        memcpy(builder->data + position, &length, sizeof(length));
+        memcpy(builder->data + position + 4, text, length);
+    }
+    return position;
+}
+
+static size_t fb_offset_vector(FbBuilder* builder, uint32_t count, size_t* element_slots) {
+    fb_align(builder, 4, 0);
+    size_t position = fb_reserve(builder, 4 + 4 * (size_t)count);
+    if (!builder->failed) {
+        memcpy(builder->data + position, &count, sizeof(count));
+        for (uint32_t i = 0; i < count; i++) {
+            element_slots[i] = position + 4 + 4 * (size_t)i;
+        }
+    }
+    return position;
+}
+
+static size_t fb_struct_vector(FbBuilder* builder, const void* elements, uint32_t count, size_t size) {
+    // Elements of the Arrow structs hold int64 members and must be 8-byte aligned
+    fb_align(builder, 8, 4);
+    size_t position = fb_reserve(builder, 4 + size * count);
+    if (!builder->failed) {
+        memcpy(builder->data + position, &count, sizeof(count));
+        if (count > 0) {
+            memcpy(builder->data + position + 4, elements, size * count);
+        }
+    }
+    return position;
+}
+
+static void fb_patch(FbBuilder* builder, size_t slot, size_t target) {
+    if (builder->failed) {
+        return;
+    }
+    uint32_t offset = (uint32_t)(target - slot);
+    memcpy(builder->data + slot, &offset, sizeof(offset));
+}
+
+static size_t build_schema(FbBuilder* builder) {
+    static const char* names[ARROW_COLUMN_COUNT] = { "timestamp", "sensor_id", "value" };
+    static const uint8_t types[ARROW_COLUMN_COUNT] = {
+        ARROW_TYPE_TIMESTAMP, ARROW_TYPE_UTF8, ARROW_TYPE_FLOATING_POINT
+    };
+
+    size_t slots[1];
+    FbField schema_fields[] = {
+        { .id = 0, .size = 2, .value = 0 },                 // endianness: Little
+        { .id = 1, .size = 4, .is_offset = true }           // fields
+    };
+    size_t schema = fb_table(builder, schema_fields, 2, slots);
+    size_t element_slots[ARROW_COLUMN_COUNT];
+    fb_patch(builder, slots[0], fb_offset_vector(builder, ARROW_COLUMN_COUNT, element_slots));
+
+    for (int column = 0; column < ARROW_COLUMN_COUNT; column++) {
+        size_t field_slots[3];
+        FbField field_fields[] = {
+            { .id = 0, .size = 4, .is_offset = true },      // name
+            { .id = 1, .size = 1, .value = 0 },             // nullable
+            { .id = 2, .size = 1, .value = types[column] }, // type_type
+            { .id = 3, .size = 4, .is_offset = true },      // type
+            { .id = 5, .size = 4, .is_offset = true }       // children
+        };
+        size_t field = fb_table(builder, field_fields, 5, field_slots);
+        fb_patch(builder, element_slots[column], field);
+        fb_patch(builder, field_slots[0], fb_string(builder, names[column]));
+
+        size_t type_slots[1];
+        size_t type;
+        if (types[column] == ARROW_TYPE_TIMESTAMP) {
+            FbField timestamp_fields[] = {
+                { .id = 0, .size = 2, .value = ARROW_TIME_UNIT_SECOND },
+                { .id = 1, .size = 4, .is_offset = true }   // timezone
+            };
+            type = fb_table(builder, timestamp_fields, 2, type_slots);
+            fb_patch(builder, type_slots[0], fb_string(builder, "UTC"));
+        } else if (types[column] == ARROW_TYPE_FLOATING_POINT) {
+            FbField float_fields[] = {
+                { .id = 0, .size = 2, .value = ARROW_PRECISION_SINGLE }
+            };
+            type = fb_table(builder, float_fields, 1, type_slots);
+        } else {
+            type = fb_table(builder, NULL, 0, type_slots);
+        }
+        fb_patch(builder, field_slots[1], type);
+        fb_patch(builder, field_slots[2], fb_offset_vector(builder, 0, NULL));
+    }
+
+    return schema;
+}
+
+static bool write_bytes(ArrowWriter* writer, const void* data, size_t length) {
+    if (length > 0 && fwrite(data, 1, length, writer->file) != length) {
+        writer->failed = true;
+        return false;
+    }
+    writer->position += length;
+    return true;
+}
+
+static bool write_padding(ArrowWriter* writer, size_t length) {
+    static const uint8_t zeros[ARROW_BUFFER_ALIGNMENT] = { 0 };
+    return write_bytes(writer, zeros, length);
+}
+
+static bool write_message(ArrowWriter* writer, const FbBuilder* metadata, ArrowBlock* block) {
+    uint32_t continuation = 0xFFFFFFFFu;
+    // Pad the metadata so the body that follows starts on a buffer alignment boundary
+    size_t body_start = pad_to(writer->position + 8 + metadata->size, ARROW_BUFFER_ALIGNMENT);
+    int32_t length = (int32_t)(body_start - writer->position - 8);
+
+    if (block) {
+        block->offset = (int64_t)writer->position;
+        block->metadata_length = length + 8;
+        block->padding = 0;
+    }
+
+    return write_bytes(writer, &continuation, sizeof(continuation)) &&
+           write_bytes(writer, &length, sizeof(length)) &&
+           write_bytes(writer, metadata->data, metadata->size) &&
+           write_padding(writer, (size_t)length - metadata->size);
+}
+
+static bool write_schema(ArrowWriter* writer) {
+    FbBuilder builder = { 0 };
+    size_t root = fb_reserve(&builder, 4);
+    size_t slots[1];
+
+    FbField message_fields[] = {
+        { .id = 0, .size = 2, .value = ARROW_METADATA_V5 },
+        { .id = 1, .size = 1, .value = ARROW_HEADER_SCHEMA },
+        { .id = 2, .size = 4, .is_offset = true },
+        { .id = 3, .size = 8, .value = 0 }                 // bodyLength
+    };
+    size_t message = fb_table(&builder, message_fields, 4, slots);
+    fb_patch(&builder, root, message);
+    fb_patch(&builder, slots[0], build_schema(&builder));
+
+    bool result = !builder.failed && write_message(writer, &builder, NULL);
+    free(builder.data);
+    return result;
+}
+
+static bool write_batch(ArrowWriter* writer) {
+    uint32_t rows = writer->rows;
+    size_t id_bytes = (size_t)writer->id_offsets[rows];
+    size_t sizes[ARROW_BUFFER_COUNT] = {
+        0, rows * sizeof(int64_t),                          // timestamp: validity, data
+        0, (rows + 1) * sizeof(int32_t), id_bytes,          // sensor_id: validity, offsets, data
+        0, rows * sizeof(float)                             // value: validity, data
+    };
+    const void* sources[ARROW_BUFFER_COUNT] = {
+        NULL, writer->timestamps, NULL, writer->id_offsets, writer->id_data, NULL, writer->values
+    };
+
+    // Body layout: every buffer starts on a 64-byte boundary
+    ArrowBuffer buffers[ARROW_BUFFER_COUNT];
+    int64_t body_length = 0;
+    for (int i = 0; i < ARROW_BUFFER_COUNT; i++) {
+        buffers[i].offset = body_length;
+        buffers[i].length = (int64_t)sizes[i];
+        body_length += (int64_t)pad_to(sizes[i], ARROW_BUFFER_ALIGNMENT);
+    }
+    ArrowFieldNode nodes[ARROW_COLUMN_COUNT];
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        nodes[i].length = rows;
+        nodes[i].null_count = 0;
+    }
+
+    FbBuilder builder = { 0 };
+    size_t root = fb_reserve(&builder, 4);
+    size_t message_slots[1];
+    FbField message_fields[] = {
+        { .id = 0, .size = 2, .value = ARROW_METADATA_V5 },
+        { .id = 1, .size = 1, .value = ARROW_HEADER_RECORD_BATCH },
+        { .id = 2, .size = 4, .is_offset = true },
+        { .id = 3, .size = 8, .value = (uint64_t)body_length }
+    };
+    size_t message = fb_table(&builder, message_fields, 4, message_slots);
+    fb_patch(&builder, root, message);
+
+    size_t batch_slots[2];
+    FbField batch_fields[] = {
+        { .id = 0, .size = 8, .value = rows },              // length
+        { .id = 1, .size = 4, .is_offset = true },          // nodes
+        { .id = 2, .size = 4, .is_offset = true }           // buffers
+    };
+    size_t batch = fb_table(&builder, batch_fields, 3, batch_slots);
+    fb_patch(&builder, message_slots[0], batch);
+    fb_patch(&builder, batch_slots[0],
+             fb_struct_vector(&builder, nodes, ARROW_COLUMN_COUNT, sizeof(ArrowFieldNode)));
+    fb_patch(&builder, batch_slots[1],
+             fb_struct_vector(&builder, buffers, ARROW_BUFFER_COUNT, sizeof(ArrowBuffer)));
+
+    bool result = !builder.failed && writer->block_count < ARROW_MAX_BATCHES;
+    if (result) {
+        ArrowBlock* block = &writer->blocks[writer->block_count];
+        result = write_message(writer, &builder, block);
+        for (int i = 0; result && i < ARROW_BUFFER_COUNT; i++) {
+            result = write_bytes(writer, sources[i], sizes[i]) &&
+                     write_padding(writer, pad_to(sizes[i], ARROW_BUFFER_ALIGNMENT) - sizes[i]);
+        }
+        block->body_length = body_length;
+        writer->block_count++;
+    }
+    free(builder.data);
+
+    writer->total_rows += rows;
+    writer->rows = 0;
+    return result;
+}
+
+static bool write_footer(ArrowWriter* writer) {
+    FbBuilder builder = { 0 };
+    size_t root = fb_reserve(&builder, 4);
+    size_t slots[2];
+
+    FbField footer_fields[] = {
+        { .id = 0, .size = 2, .value = ARROW_METADATA_V5 },
+        { .id = 1, .size = 4, .is_offset = true },          // schema
+        { .id = 3, .size = 4, .is_offset = true }           // recordBatches
+    };
+    size_t footer = fb_table(&builder, footer_fields, 3, slots);
+    fb_patch(&builder, root, footer);
+    fb_patch(&builder, slots[0], build_schema(&builder));
+    fb_patch(&builder, slots[1],
+             fb_struct_vector(&builder, writer->blocks, writer->block_count, sizeof(ArrowBlock)));
+
+    int32_t length = (int32_t)builder.size;
+    static const char magic[6] = { 'A', 'R', 'R', 'O', 'W', '1' };
+    bool result = !builder.failed && write_bytes(writer, builder.data, builder.size) &&
+                  write_bytes(writer, &length, sizeof(length)) &&
+                  write_bytes(writer, magic, sizeof(magic));
+    free(builder.data);
+    return result;
+}
+
+static bool collect_samples(const char* sensor_id, SensorType type, const uint32_t* timestamps,
+                            const float* values, uint32_t count, void* context) {
+    ArrowWriter* writer = (ArrowWriter*)context;
+    size_t id_length = strlen(sensor_id);
+    (void)type;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t row = writer->rows;
+        size_t id_offset = (size_t)writer->id_offsets[row];
+
+        if (id_offset + id_length > writer->id_capacity) {
+            char* grown = (char*)realloc(writer->id_data, writer->id_capacity * 2);
+            if (!grown) {
+                writer->failed = true;
+                return false;
+            }
+            writer->id_data = grown;
+            writer->id_capacity *= 2;
+        }
+
+        writer->timestamps[row] = timestamps[i];
+        writer->values[row] = values[i];
+        memcpy(writer->id_data + id_offset, sensor_id, id_length);
+        writer->id_offsets[row + 1] = (int32_t)(id_offset + id_length);
+        writer->rows++;
+
+        if (writer->rows == ARROW_EXPORT_BATCH_ROWS && !write_batch(writer)) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file changepoint.c
+ * @brief Streaming change-point detection for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/changepoint.h"
+#include "../include/event_queue.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#define CHANGEPOINT_SENSOR_TYPES (SENSOR_TYPE_MAGNETIC + 1)
+
+// Per-sensor detector
+typedef struct {
+    char id[32];
+    ChangepointStatus status;
+} ChangepointSensor;
+
+// Private data structure
+typedef struct {
+    ChangepointConfig configs[CHANGEPOINT_SENSOR_TYPES];
+    ChangepointSensor sensors[CHANGEPOINT_MAX_SENSORS];
+} ChangepointPrivate;
+
+// Forward declarations of private functions
+static bool validate_config(const ChangepointConfig* config);
+static void restart_detectors(ChangepointDetector* detector);
+static ChangepointSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static ChangepointPrivate* private_data = NULL;
+static pthread_mutex_t changepoint_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void changepoint_detector_init(ChangepointDetector* detector) {
+    if (detector) {
+        memset(detector, 0, sizeof(ChangepointDetector));
+    }
+}
+
+bool changepoint_detector_update(ChangepointDetector* detector, const ChangepointConfig* config,
+                                 float value, ChangepointResult* result) {
+    if (!detector || !config || !isfinite(value)) {
+        return false;
+    }
+
+    // Learn the reference (Welford) before detecting anything
+    if (!detector->ready) {
+        detector->count++;
+        double delta = value - detector->warmup_mean;
+        detector->warmup_mean += delta / detector->count;
+        detector->warmup_m2 += delta * (value - detector->warmup_mean);
+        if (detector->count >= config->warmup_samples) {
+            detector->reference = (float)detector->warmup_mean;
+            detector->sigma = fmaxf((float)sqrt(detector->warmup_m2 / detector->count),
+                                    config->min_sigma);
+            detector->ready = true;
+            restart_detectors(detector);
+        }
+        return false;
+    }
+
+    detector->count++;
+    float z = (value - detector->reference) / detector->sigma;
+
+    // Two-sided CUSUM, with the mean of each excursion kept for the shift estimate
+    detector->cusum_high = fmaxf(0.0f, detector->cusum_high + z - config->cusum_k);
+    if (detector->cusum_high > 0.0f) {
+        detector->high_run++;
+        detector->high_sum += z;
+    } else {
+        detector->high_run = 0;
+        detector->high_sum = 0.0f;
+    }
+    detector->cusum_low = fmaxf(0.0f, detector->cusum_low - z - config->cusum_k);
+    if (detector->cusum_low > 0.0f) {
+        detector->low_run++;
+        detector->low_sum += z;
+    } else {
+        detector->low_run = 0;
+        detector->low_sum = 0.0f;
+    }
+
+    // Two-sided Page-Hinkley against the running mean since the reference was learned
+    detector->ph_count++;
+    detector->ph_sum += z;
+    double deviation = z - detector->ph_sum / detector->ph_count;
+    detector->ph_up += deviation - config->ph_delta;
+    if (detector->ph_up < detector->ph_up_min) {
+        detector->ph_up_min = detector->ph_up;
+        detector->ph_up_min_count = detector->ph_count;
+        detector->ph_up_min_sum = detector->ph_sum;
+    }
+    detector->ph_down += deviation + config->ph_delta;
+    if (detector->ph_down > detector->ph_down_max) {
+        detector->ph_down_max = detector->ph_down;
+        detector->ph_down_max_count = detector->ph_count;
+        detector->ph_down_max_sum = detector->ph_sum;
+    }
+
+    ChangepointResult change;
+    memset(&change, 0, sizeof(change));
+    if (detector->cusum_high > config->cusum_h) {
+        change.method = CHANGEPOINT_METHOD_CUSUM;
+        change.direction = 1;
+        change.shift = detector->high_sum / (float)detector->high_run;
+    } else if (detector->cusum_low > config->cusum_h) {
+        change.method = CHANGEPOINT_METHOD_CUSUM;
+        change.direction = -1;
+        change.shift = detector->low_sum / (float)detector->low_run;
+    } else if (detector->ph_up - detector->ph_up_min > config->ph_lambda) {
+        // Mean of the samples since the statistic left its minimum
+        change.method = CHANGEPOINT_METHOD_PAGE_HINKLEY;
+        change.direction = 1;
+        change.shift = (float)((detector->ph_sum - detector->ph_up_min_sum) /
+                               (detector->ph_count - detector->ph_up_min_count));
+    } else if (detector->ph_down_max - detector->ph_down > config->ph_lambda) {
+        change.method = CHANGEPOINT_METHOD_PAGE_HINKLEY;
+        change.direction = -1;
+        change.shift = (float)((detector->ph_sum - detector->ph_down_max_sum) /
+                               (detector->ph_count - detector->ph_down_max_count));
+    } else {
+        return false;
+    }
+    change.reference = detector->reference;
+
+    // Re-learn the reference from the new regime
+    detector->ready = false;
+    detector->count = 0;
+    detector->warmup_mean = 0.0;
+    detector->warmup_m2 = 0.0;
+
+    if (result) {
+        memcpy(result, &change, sizeof(ChangepointResult));
+    }
+    return true;
+}
+
+bool changepoint_init(const ChangepointConfig* default_config) {
+    ChangepointConfig defaults;
+    if (!default_config) {
+        changepoint_get_default_config(&defaults);
+        default_config = &defaults;
+    }
+    if (!validate_config(default_config)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&changepoint_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&changepoint_mutex);
+        return false;
+    }
+
+    private_data = (ChangepointPrivate*)calloc(1, sizeof(ChangepointPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&changepoint_mutex);
+        return false;
+    }
+    for (uint32_t i = 0; i < CHANGEPOINT_SENSOR_TYPES; i++) {
+        memcpy(&private_data->configs[i], default_config, sizeof(ChangepointConfig));
+    }
+
+    pthread_mutex_unlock(&changepoint_mutex);
+    return true;
+}
+
+void changepoint_cleanup(void) {
+    pthread_mutex_lock(&changepoint_mutex);
+
+    if (private_data) {
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&changepoint_mutex);
+}
+
+bool changepoint_configure_type(SensorType type, const ChangepointConfig* config) {
+    if ((uint32_t)type >= CHANGEPOINT_SENSOR_TYPES || !config || !validate_config(config)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&changepoint_mutex);
+
+    bool configured = private_data != NULL;
+    if (configured) {
+        memcpy(&private_data->configs[type], config, sizeof(ChangepointConfig));
+    }
+
+    pthread_mutex_unlock(&changepoint_mutex);
+    return configured;
+}
+
+bool changepoint_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data || !data->is_valid || (uint32_t)sensor->type >= CHANGEPOINT_SENSOR_TYPES) {
+        return false;
+    }
+
+    pthread_mutex_lock(&changepoint_mutex);
+
+    const ChangepointConfig* config = private_data ? &private_data->configs[sensor->type] : NULL;
+    ChangepointSensor* entry = config && config->enabled ? find_sensor(sensor->id, true) : NULL;
+    if (!entry) {
+        pthread_mutex_unlock(&changepoint_mutex);
+        return false;
+    }
+
+    ChangepointResult change;
+    bool changed = changepoint_detector_update(&entry->status.detector, config, data->value, &change);
+    if (changed) {
+        memcpy(&entry->status.last_change, &change, sizeof(ChangepointResult));
+        entry->status.last_change_time = data->timestamp;
+        entry->status.change_count++;
+
+        MonitorEvent event;
+        memset(&event, 0, sizeof(event));
+        event.type = EVENT_CHANGE_POINT;
+        memcpy(event.sensor_id, sensor->id, sizeof(event.sensor_id) - 1);
+        event.sensor_type = sensor->type;
+        event.timestamp = data->timestamp;
+        event.value = data->value;
+        event.from_state = (int32_t)change.method;
+        event.to_state = change.direction;
+        event.score = change.shift;
+        event_queue_push(&event);
+    }
+
+    pthread_mutex_unlock(&changepoint_mutex);
+    return changed;
+}
+
+bool changepoint_get_status(const char* sensor_id, ChangepointStatus* status) {
+    if (!sensor_id || !status) {
+        return false;
+    }
+
+    pthread_mutex_lock(&changepoint_mutex);
+
+    ChangepointSensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    if (entry) {
+        memcpy(status, &entry->status, sizeof(ChangepointStatus));
+    }
+
+    pthread_mutex_unlock(&changepoint_mutex);
+    return entry != NULL;
+}
+
+const char* changepoint_method_to_string(ChangepointMethod method) {
+    switch (method) {
+        case CHANGEPOINT_METHOD_NONE:
+            return "None";
+        case CHANGEPOINT_METHOD_CUSUM:
+            return "CUSUM";
+        case CHANGEPOINT_METHOD_PAGE_HINKLEY:
+            return "Page-Hinkley";
+        default:
+            return "Unknown";
+    }
+}
+
+void changepoint_get_default_config(ChangepointConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->enabled = true;
+    config->warmup_samples = 300;
+    config->min_sigma = 0.01f;
+    config->cusum_k = 0.5f;
+    config->cusum_h = 12.0f;
+    config->ph_delta = 0.1f;
+    config->ph_lambda = 50.0f;
+}
+
+// Private helper functions
+static bool validate_config(const ChangepointConfig* config) {
+    return config->warmup_samples >= 2 && config->min_sigma > 0.0f && config->cusum_k >= 0.0f &&
+           config->cusum_h > 0.0f && config->ph_delta >= 0.0f && config->ph_lambda > 0.0f;
+}
+
+static void restart_detectors(ChangepointDetector* detector) {
+    detector->cusum_high = 0.0f;
+    detector->cusum_low = 0.0f;
+    detector->high_run = 0;
+    detector->low_run = 0;
+    detector->high_sum = 0.0f;
+    detector->low_sum = 0.0f;
+    detector->ph_count = 0;
+    detector->ph_sum = 0.0;
+    detector->ph_up = 0.0;
+    detector->ph_up_min = 0.0;
+    detector->ph_up_min_count = 0;
+    detector->ph_up_min_sum = 0.0;
+    detector->ph_down = 0.0;
+    detector->ph_down_max = 0.0;
+    detector->ph_down_max_count = 0;
+    detector->ph_down_max_sum = 0.0;
+}
+
+static ChangepointSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, CHANGEPOINT_MAX_SENSORS,
+                                          ChangepointSensor, id);
+    return (ChangepointSensor*)sensor_table_find(&table, id, create, NULL);
+}
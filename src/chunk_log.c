@@ -0,0 +1,625 @@
+/**
+ * @file chunk_log.c
+ * @brief Multiplexed append-only sample log for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/chunk_log.h"
+#include "../include/sensor_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#define CHAIN_TABLE_SIZE (CHUNK_LOG_MAX_SENSORS * 2)
+
+// Per-sensor sample buffer
+typedef struct {
+    char id[32];
+    SensorType type;
+    uint32_t count;
+    uint32_t* timestamps;
+    float* values;
+} ChunkLogSensor;
+
+// Chunks of one sensor hash, linked through the index in append order
+typedef struct {
+    bool used;
+    uint32_t hash;
+    int32_t first;
+    int32_t last;
+} ChunkChain;
+
+// Private data structure
+typedef struct {
+    ChunkLogConfig config;
+    int data_fd;
+    int index_fd;
+    uint64_t data_end;
+    ChunkIndexEntry* entries;
+    int32_t* next;
+    uint32_t entry_count;
+    uint32_t entry_capacity;
+    uint32_t skipped_chunks;
+    ChunkChain chains[CHAIN_TABLE_SIZE];
+    ChunkLogSensor sensors[CHUNK_LOG_MAX_SENSORS];
+    uint8_t* chunk_buffer;
+    uint32_t* filter_timestamps;
+    float* filter_values;
+} ChunkLogPrivate;
+
+// Forward declarations of private functions
+static bool load_index(void);
+static bool add_entry(const ChunkIndexEntry* entry);
+static ChunkChain* find_chain(uint32_t hash, bool create);
+static ChunkLogSensor* find_sensor(const char* id, bool create);
+static bool write_chunk(ChunkLogSensor* sensor);
+static bool read_chunk(const ChunkIndexEntry* entry, ChunkHeader** header, bool* intact);
+static bool emit_samples(const char* sensor_id, SensorType type, const uint32_t* timestamps,
+                         const float* values, uint32_t count, uint32_t from, uint32_t to,
+                         ChunkLogCallback callback, void* context);
+static uint32_t chunk_size(uint32_t count);
+static void crc32_build_table(void);
+static uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t length);
+
+// Private data instance
+static ChunkLogPrivate* private_data = NULL;
+static pthread_mutex_t chunk_log_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t crc32_table[256];
+static pthread_once_t crc32_table_once = PTHREAD_ONCE_INIT;
+
+void chunk_log_get_default_config(ChunkLogConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(ChunkLogConfig));
+    strncpy(config->data_file, "data/samples.dat", sizeof(config->data_file) - 1);
+    strncpy(config->index_file, "data/samples.idx", sizeof(config->index_file) - 1);
+    config->chunk_samples = 256;
+    config->max_buffer_age_s = 300;
+}
+
+bool chunk_log_init(const ChunkLogConfig* config) {
+    if (!config || config->chunk_samples == 0 || config->chunk_samples > CHUNK_LOG_MAX_SAMPLES) {
+        return false;
+    }
+
+    pthread_mutex_lock(&chunk_log_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&chunk_log_mutex);
+        return false;
+    }
+
+    // Allocate private data
+    private_data = (ChunkLogPrivate*)calloc(1, sizeof(ChunkLogPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&chunk_log_mutex);
+        return false;
+    }
+    memcpy(&private_data->config, config, sizeof(ChunkLogConfig));
+
+    private_data->chunk_buffer = (uint8_t*)malloc(chunk_size(CHUNK_LOG_MAX_SAMPLES));
+    private_data->filter_timestamps = (uint32_t*)malloc(CHUNK_LOG_MAX_SAMPLES * sizeof(uint32_t));
+    private_data->filter_values = (float*)malloc(CHUNK_LOG_MAX_SAMPLES * sizeof(float));
+    if (config->read_only) {
+        // A missing index is rebuilt in memory from the data file
+        private_data->data_fd = open(config->data_file, O_RDONLY);
+        private_data->index_fd = open(config->index_file, O_RDONLY);
+    } else {
+        private_data->data_fd = open(config->data_file, O_RDWR | O_CREAT, 0644);
+        private_data->index_fd = open(config->index_file, O_RDWR | O_CREAT, 0644);
+    }
+
+    if (!private_data->chunk_buffer || !private_data->filter_timestamps ||
+        !private_data->filter_values || private_data->data_fd < 0 ||
+        (private_data->index_fd < 0 && !config->read_only) || !load_index()) {
+        if (private_data->data_fd >= 0) {
+            close(private_data->data_fd);
+        }
+        if (private_data->index_fd >= 0) {
+            close(private_data->index_fd);
+        }
+        free(private_data->entries);
+        free(private_data->next);
+        free(private_data->chunk_buffer);
+        free(private_data->filter_timestamps);
+        free(private_data->filter_values);
+        free(private_data);
+        private_data = NULL;
+        pthread_mutex_unlock(&chunk_log_mutex);
+        return false;
+    }
+
+    pthread_mutex_unlock(&chunk_log_mutex);
+    return true;
+}
+
+void chunk_log_cleanup(void) {
+    pthread_mutex_lock(&chunk_log_mutex);
+
+    if (private_data) {
+        for (uint32_t i = 0; i < CHUNK_LOG_MAX_SENSORS; i++) {
+            ChunkLogSensor* sensor = &private_data->sensors[i];
+            if (sensor->id[0] != '\0') {
+                if (sensor->count > 0) {
+                    write_chunk(sensor);
+                }
+                free(sensor->timestamps);
+                free(sensor->values);
+            }
+        }
+
+        if (!private_data->config.read_only) {
+            fsync(private_data->data_fd);
+            fsync(private_data->index_fd);
+        }
+        close(private_data->data_fd);
+        if (private_data->index_fd >= 0) {
+            close(private_data->index_fd);
+        }
+
+        free(private_data->entries);
+        free(private_data->next);
+        free(private_data->chunk_buffer);
+        free(private_data->filter_timestamps);
+        free(private_data->filter_values);
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&chunk_log_mutex);
+}
+
+bool chunk_log_append(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data || !data->is_valid) {
+        return false;
+    }
+
+    pthread_mutex_lock(&chunk_log_mutex);
+
+    if (!private_data || private_data->config.read_only) {
+        pthread_mutex_unlock(&chunk_log_mutex);
+        return false;
+    }
+
+    ChunkLogSensor* entry = find_sensor(sensor->id, true);
+    if (!entry) {
+        pthread_mutex_unlock(&chunk_log_mutex);
+        return false;
+    }
+    entry->type = sensor->type;
+
+    // A full buffer means the last write failed; retry it and reject the sample if it
+    // fails again, so the buffer is never indexed past chunk_samples
+    if (entry->count >= private_data->config.chunk_samples && !write_chunk(entry)) {
+        pthread_mutex_unlock(&chunk_log_mutex);
+        return false;
+    }
+
+    entry->timestamps[entry->count] = data->timestamp;
+    entry->values[entry->count] = data->value;
+    entry->count++;
+
+    bool result = true;
+    uint32_t max_age = private_data->config.max_buffer_age_s;
+    if (entry->count >= private_data->config.chunk_samples ||
+        (max_age > 0 && data->timestamp >= entry->timestamps[0] + max_age)) {
+        result = write_chunk(entry);
+    }
+
+    pthread_mutex_unlock(&chunk_log_mutex);
+    return result;
+}
+
+bool chunk_log_flush(uint32_t now) {
+    pthread_mutex_lock(&chunk_log_mutex);
+
+    if (!private_data) {
+        pthread_mutex_unlock(&chunk_log_mutex);
+        return false;
+    }
+
+    bool result = true;
+    uint32_t max_age = private_data->config.max_buffer_age_s;
+    for (uint32_t i = 0; i < CHUNK_LOG_MAX_SENSORS; i++) {
+        ChunkLogSensor* sensor = &private_data->sensors[i];
+        if (max_age > 0 && sensor->count > 0 && now >= sensor->timestamps[0] + max_age) {
+            if (!write_chunk(sensor)) {
+                result = false;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&chunk_log_mutex);
+    return result;
+}
+
+bool chunk_log_query(const char* sensor_id, uint32_t from, uint32_t to,
+                     ChunkLogCallback callback, void* context) {
+    if (!callback || from > to) {
+        return false;
+    }
+
+    pthread_mutex_lock(&chunk_log_mutex);
+
+    if (!private_data) {
+        pthread_mutex_unlock(&chunk_log_mutex);
+        return false;
+    }
+
+    // Walk either one sensor's chain or the whole index in file order
+    int32_t position = 0;
+    if (sensor_id) {
+        ChunkChain* chain = find_chain(sensor_table_hash(sensor_id), false);
+        position = chain ? chain->first : -1;
+    } else if (private_data->entry_count == 0) {
+        position = -1;
+    }
+
+    bool result = true;
+    while (result && position >= 0) {
+        const ChunkIndexEntry* entry = &private_data->entries[position];
+
+        if (entry->t_max >= from && entry->t_min <= to) {
+            ChunkHeader* header;
+            bool intact;
+            if (!read_chunk(entry, &header, &intact)) {
+                result = false;
+                break;
+            }
+            // A damaged chunk is skipped and counted rather than decoded as data; different
+            // sensors may share a hash, so the header carries the full identifier
+            if (!intact) {
+                private_data->skipped_chunks++;
+            } else if (!sensor_id || strncmp(header->sensor_id, sensor_id, sizeof(header->sensor_id)) == 0) {
+                const uint32_t* timestamps = (const uint32_t*)(header + 1);
+                const float* values = (const float*)(timestamps + header->count);
+                result = emit_samples(header->sensor_id, (SensorType)header->sensor_type,
+                                      timestamps, values, header->count, from, to,
+                                      callback, context);
+            }
+        }
+
+        if (sensor_id) {
+            position = private_data->next[position];
+        } else {
+            position = (uint32_t)position + 1 < private_data->entry_count ? position + 1 : -1;
+        }
+    }
+
+    // Samples not yet written out
+    if (result) {
+        for (uint32_t i = 0; result && i < CHUNK_LOG_MAX_SENSORS; i++) {
+            ChunkLogSensor* sensor = &private_data->sensors[i];
+            if (sensor->count == 0 ||
+                (sensor_id && strncmp(sensor->id, sensor_id, sizeof(sensor->id) - 1) != 0)) {
+                continue;
+            }
+            result = emit_samples(sensor->id, sensor->type, sensor->timestamps, sensor->values,
+                                  sensor->count, from, to, callback, context);
+        }
+    }
+
+    pthread_mutex_unlock(&chunk_log_mutex);
+    return result;
+}
+
+uint32_t chunk_log_chunk_count(void) {
+    pthread_mutex_lock(&chunk_log_mutex);
+    uint32_t count = private_data ? private_data->entry_count : 0;
+    pthread_mutex_unlock(&chunk_log_mutex);
+    return count;
+}
+
+uint32_t chunk_log_skipped_chunks(void) {
+    pthread_mutex_lock(&chunk_log_mutex);
+    uint32_t count = private_data ? private_data->skipped_chunks : 0;
+    pthread_mutex_unlock(&chunk_log_mutex);
+    return count;
+}
+
+bool chunk_log_verify_chunk(const ChunkHeader* header, const void* payload) {
+    if (!header || header->magic != CHUNK_LOG_MAGIC || header->version != CHUNK_LOG_VERSION ||
+        header->count == 0 || header->count > CHUNK_LOG_MAX_SAMPLES) {
+        return false;
+    }
+
+    size_t length = chunk_size(header->count) - sizeof(ChunkHeader);
+    return !payload || crc32_update(0, (const uint8_t*)payload, length) == header->crc;
+}
+
+// Private helper functions
+static uint32_t chunk_size(uint32_t count) {
+    return (uint32_t)sizeof(ChunkHeader) + count * (uint32_t)(sizeof(uint32_t) + sizeof(float));
+}
+
+static bool load_index(void) {
+    off_t data_size = lseek(private_data->data_fd, 0, SEEK_END);
+    off_t index_size = private_data->index_fd >= 0 ? lseek(private_data->index_fd, 0, SEEK_END) : 0;
+    if (data_size < 0 || index_size < 0) {
+        return false;
+    }
+
+    uint32_t stored = (uint32_t)((uint64_t)index_size / sizeof(ChunkIndexEntry));
+    ChunkIndexEntry* stored_entries = NULL;
+    if (stored > 0) {
+        stored_entries = (ChunkIndexEntry*)malloc((size_t)stored * sizeof(ChunkIndexEntry));
+        if (!stored_entries ||
+            pread(private_data->index_fd, stored_entries, (size_t)stored * sizeof(ChunkIndexEntry), 0) !=
+                (ssize_t)((size_t)stored * sizeof(ChunkIndexEntry))) {
+            free(stored_entries);
+            return false;
+        }
+    }
+
+    // Keep the index prefix that describes consecutive chunks present in the data file
+    uint64_t end = 0;
+    uint32_t kept = 0;
+    while (kept < stored) {
+        const ChunkIndexEntry* entry = &stored_entries[kept];
+        if (entry->offset != end || entry->count == 0 || entry->count > CHUNK_LOG_MAX_SAMPLES ||
+            end + chunk_size(entry->count) > (uint64_t)data_size) {
+            break;
+        }
+        if (!add_entry(entry)) {
+            free(stored_entries);
+            return false;
+        }
+        end += chunk_size(entry->count);
+        kept++;
+    }
+    free(stored_entries);
+
+    // Recover chunks written after the last index entry reached the disk
+    uint32_t recovered = 0;
+    while (end + sizeof(ChunkHeader) <= (uint64_t)data_size) {
+        ChunkHeader header;
+        if (pread(private_data->data_fd, &header, sizeof(header), (off_t)end) != (ssize_t)sizeof(header) ||
+            !chunk_log_verify_chunk(&header, NULL) ||
+            end + chunk_size(header.count) > (uint64_t)data_size) {
+            break;
+        }
+
+        size_t payload = chunk_size(header.count) - sizeof(ChunkHeader);
+        if (pread(private_data->data_fd, private_data->chunk_buffer, payload,
+                  (off_t)(end + sizeof(ChunkHeader))) != (ssize_t)payload ||
+            !chunk_log_verify_chunk(&header, private_data->chunk_buffer)) {
+            break;
+        }
+
+        header.sensor_id[sizeof(header.sensor_id) - 1] = '\0';
+        ChunkIndexEntry entry = {
+            .sensor_hash = sensor_table_hash(header.sensor_id),
+            .t_min = header.t_min,
+            .t_max = header.t_max,
+            .count = header.count,
+            .offset = end
+        };
+        if (!add_entry(&entry)) {
+            return false;
+        }
+        end += chunk_size(header.count);
+        recovered++;
+    }
+
+    private_data->data_end = end;
+    if (private_data->config.read_only) {
+        return true;
+    }
+
+    // Drop a torn tail and bring the index file in line with the data file
+    if (end < (uint64_t)data_size && ftruncate(private_data->data_fd, (off_t)end) != 0) {
+        return false;
+    }
+    if (kept < stored || recovered > 0) {
+        size_t bytes = (size_t)recovered * sizeof(ChunkIndexEntry);
+        off_t offset = (off_t)((uint64_t)kept * sizeof(ChunkIndexEntry));
+        if (ftruncate(private_data->index_fd, offset) != 0 ||
+            (bytes > 0 && pwrite(private_data->index_fd, &private_data->entries[kept], bytes, offset) !=
+                              (ssize_t)bytes)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool add_entry(const ChunkIndexEntry* entry) {
+    if (private_data->entry_count == private_data->entry_capacity) {
+        uint32_t capacity = private_data->entry_capacity ? private_data->entry_capacity * 2 : 1024;
+        ChunkIndexEntry* entries = (ChunkIndexEntry*)realloc(private_data->entries,
+                                                             capacity * sizeof(ChunkIndexEntry));
+        if (!entries) {
+            return false;
+        }
+        private_data->entries = entries;
+
+        int32_t* next = (int32_t*)realloc(private_data->next, capacity * sizeof(int32_t));
+        if (!next) {
+            return false;
+        }
+        private_data->next = next;
+        private_data->entry_capacity = capacity;
+    }
+
+    ChunkChain* chain = find_chain(entry->sensor_hash, true);
+    if (!chain) {
+        return false;
+    }
+
+    int32_t position = (int32_t)private_data->entry_count++;
+    private_data->entries[position] = *entry;
+    private_data->next[position] = -1;
+
+    if (chain->last >= 0) {
+        private_data->next[chain->last] = position;
+    } else {
+        chain->first = position;
+    }
+    chain->last = position;
+
+    return true;
+}
+
+static ChunkChain* find_chain(uint32_t hash, bool create) {
+    uint32_t mask = CHAIN_TABLE_SIZE - 1;
+
+    for (uint32_t probe = 0; probe < CHAIN_TABLE_SIZE; probe++) {
+        ChunkChain* chain = &private_data->chains[(hash + probe) & mask];
+        if (!chain->used) {
+            if (!create) {
+                return NULL;
+            }
+            chain->used = true;
+            chain->hash = hash;
+            chain->first = -1;
+            chain->last = -1;
+            return chain;
+        }
+        if (chain->hash == hash) {
+            return chain;
+        }
+    }
+
+    return NULL;
+}
+
+static ChunkLogSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, CHUNK_LOG_MAX_SENSORS,
+                                          ChunkLogSensor, id);
+    bool created;
+    ChunkLogSensor* sensor = (ChunkLogSensor*)sensor_table_find(&table, id, create, &created);
+    if (created) {
+        // Buffers are allocated once, the first time a sensor is seen; without them the
+        // entry is released again, which is safe as nothing was claimed after it
+        uint32_t capacity = private_data->config.chunk_samples;
+        sensor->timestamps = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+        sensor->values = (float*)malloc(capacity * sizeof(float));
+        if (!sensor->timestamps || !sensor->values) {
+            free(sensor->timestamps);
+            free(sensor->values);
+            sensor->timestamps = NULL;
+            sensor->values = NULL;
+            sensor->id[0] = '\0';
+            return NULL;
+        }
+        sensor->count = 0;
+    }
+    return sensor;
+}
+
+static bool write_chunk(ChunkLogSensor* sensor) {
+    uint32_t count = sensor->count;
+    uint32_t size = chunk_size(count);
+    ChunkHeader* header = (ChunkHeader*)private_data->chunk_buffer;
+    uint32_t* timestamps = (uint32_t*)(header + 1);
+    float* values = (float*)(timestamps + count);
+
+    memset(header, 0, sizeof(ChunkHeader));
+    header->magic = CHUNK_LOG_MAGIC;
+    header->version = CHUNK_LOG_VERSION;
+    header->count = (uint16_t)count;
+    memcpy(header->sensor_id, sensor->id, sizeof(header->sensor_id) - 1);
+    header->sensor_type = (uint32_t)sensor->type;
+    header->t_min = UINT32_MAX;
+    header->t_max = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (sensor->timestamps[i] < header->t_min) {
+            header->t_min = sensor->timestamps[i];
+        }
+        if (sensor->timestamps[i] > header->t_max) {
+            header->t_max = sensor->timestamps[i];
+        }
+    }
+    memcpy(timestamps, sensor->timestamps, count * sizeof(uint32_t));
+    memcpy(values, sensor->values, count * sizeof(float));
+    header->crc = crc32_update(0, (const uint8_t*)timestamps, size - sizeof(ChunkHeader));
+
+    // Data first, then the index entry that makes the chunk visible
+    if (pwrite(private_data->data_fd, header, size, (off_t)private_data->data_end) != (ssize_t)size) {
+        return false;
+    }
+
+    ChunkIndexEntry entry = {
+        .sensor_hash = sensor_table_hash(sensor->id),
+        .t_min = header->t_min,
+        .t_max = header->t_max,
+        .count = count,
+        .offset = private_data->data_end
+    };
+    off_t index_offset = (off_t)((uint64_t)private_data->entry_count * sizeof(ChunkIndexEntry));
+    if (pwrite(private_data->index_fd, &entry, sizeof(entry), index_offset) != (ssize_t)sizeof(entry)) {
+        return false;
+    }
+
+    private_data->data_end += size;
+    sensor->count = 0;
+    return add_entry(&entry);
+}
+
+static bool read_chunk(const ChunkIndexEntry* entry, ChunkHeader** header, bool* intact) {
+    uint32_t size = chunk_size(entry->count);
+    ssize_t read = pread(private_data->data_fd, private_data->chunk_buffer, size, (off_t)entry->offset);
+    if (read < 0) {
+        return false;
+    }
+
+    // A short read, a header that does not match its index entry or a payload failing its
+    // CRC leaves the chunk unusable, but not the rest of the log
+    *header = (ChunkHeader*)private_data->chunk_buffer;
+    *intact = read == (ssize_t)size && (*header)->count == entry->count &&
+              chunk_log_verify_chunk(*header, *header + 1);
+    if (*intact) {
+        (*header)->sensor_id[sizeof((*header)->sensor_id) - 1] = '\0';
+    }
+    return true;
+}
+
+static bool emit_samples(const char* sensor_id, SensorType type, const uint32_t* timestamps,
+                         const float* values, uint32_t count, uint32_t from, uint32_t to,
+                         ChunkLogCallback callback, void* context) {
+    uint32_t matched = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (timestamps[i] >= from && timestamps[i] <= to) {
+            private_data->filter_timestamps[matched] = timestamps[i];
+            private_data->filter_values[matched] = values[i];
+            matched++;
+        }
+    }
+
+    if (matched == 0) {
+        return true;
+    }
+    if (matched == count) {
+        return callback(sensor_id, type, timestamps, values, count, context);
+    }
+    return callback(sensor_id, type, private_data->filter_timestamps, private_data->filter_values,
+                    matched, context);
+}
+
+static void crc32_build_table(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; bit++) {
+            value = (value & 1u) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+        }
+        crc32_table[i] = value;
+    }
+}
+
+static uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t length) {
+    // chunk_log_verify_chunk() runs outside the mutex, so the table is built exactly once
+    pthread_once(&crc32_table_once, crc32_build_table);
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = crc32_table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
@@ -0,0 +1,328 @@
+/**
+ * @file compression.c
+ * @brief Report-by-exception compression for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * The swinging door keeps the range of slopes [slope_low, slope_high] of the lines
+ * from the pivot that pass within the deviation of every sample since the pivot. A
+ * sample whose own slope from the pivot lies in that range can end the segment, so it
+ * is held and the range narrowed by its own constraint. A sample outside the range
+ * closes the doors: the held sample, whose line was valid for every sample before it,
+ * is forwarded and becomes the pivot. Each step is O(1) and keeps no history.
+ */
+
+#include "../include/compression.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+// Per-sensor compressor
+typedef struct {
+    char id[32];
+    const Sensor* sensor;
+    CompressionConfig config;
+    Compressor compressor;
+    CompressionStatus status;
+} CompressionSensor;
+
+// Private data structure
+typedef struct {
+    CompressionConfig default_config;
+    CompressionSensor sensors[COMPRESSION_MAX_SENSORS];
+} CompressionPrivate;
+
+// Forward declarations of private functions
+static void archive(Compressor* compressor, const SensorData* data);
+static bool validate_config(const CompressionConfig* config);
+static CompressionSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static CompressionPrivate* private_data = NULL;
+static pthread_mutex_t compression_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void compressor_init(Compressor* compressor) {
+    if (!compressor) {
+        return;
+    }
+
+    memset(compressor, 0, sizeof(Compressor));
+    compressor->slope_low = -INFINITY;
+    compressor->slope_high = INFINITY;
+}
+
+uint32_t compressor_update(Compressor* compressor, const CompressionConfig* config,
+                           const SensorData* data, SensorData* output) {
+    if (!compressor || !config || !data || !output) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+
+    // A sample held by the swinging door is released when another method takes over
+    if (compressor->held && config->method != COMPRESSION_SWINGING_DOOR) {
+        output[count++] = compressor->held_data;
+        archive(compressor, &compressor->held_data);
+    }
+
+    if (config->method == COMPRESSION_NONE) {
+        output[count++] = *data;
+        compressor->archived = false;
+        return count;
+    }
+
+    // Invalid samples are exceptions themselves and break the signal
+    if (!data->is_valid || !isfinite(data->value)) {
+        if (compressor->held) {
+            output[count++] = compressor->held_data;
+            compressor->held = false;
+        }
+        output[count++] = *data;
+        compressor->archived = false;
+        return count;
+    }
+
+    // First sample, or time going backwards: restart from this sample
+    if (!compressor->archived || data->timestamp < compressor->last_timestamp) {
+        if (compressor->held) {
+            output[count++] = compressor->held_data;
+        }
+        output[count++] = *data;
+        archive(compressor, data);
+        return count;
+    }
+
+    uint32_t elapsed = data->timestamp - compressor->archive_time;
+    bool overdue = config->max_interval_s > 0 && elapsed >= config->max_interval_s;
+
+    if (config->method == COMPRESSION_DEADBAND) {
+        if (overdue || fabsf(data->value - compressor->archive_value) > config->deviation) {
+            output[count++] = *data;
+            archive(compressor, data);
+        } else {
+            compressor->last_timestamp = data->timestamp;
+        }
+        return count;
+    }
+
+    // A repeated reading at the pivot's time has no slope and nothing is held
+    if (elapsed == 0) {
+        if (fabsf(data->value - compressor->archive_value) > config->deviation) {
+            output[count++] = *data;
+            archive(compressor, data);
+        }
+        return count;
+    }
+
+    // Swinging door: forward the held sample when this one falls outside the doors
+    float slope = (data->value - compressor->archive_value) / (float)elapsed;
+    if (compressor->held && (slope < compressor->slope_low || slope > compressor->slope_high)) {
+        output[count++] = compressor->held_data;
+        archive(compressor, &compressor->held_data);
+        elapsed = data->timestamp - compressor->archive_time;
+        overdue = config->max_interval_s > 0 && elapsed >= config->max_interval_s;
+    }
+
+    if (overdue || elapsed == 0) {
+        output[count++] = *data;
+        archive(compressor, data);
+        return count;
+    }
+
+    float offset = data->value - compressor->archive_value;
+    compressor->slope_low = fmaxf(compressor->slope_low, (offset - config->deviation) / (float)elapsed);
+    compressor->slope_high = fminf(compressor->slope_high, (offset + config->deviation) / (float)elapsed);
+    compressor->held_data = *data;
+    compressor->held = true;
+    compressor->last_timestamp = data->timestamp;
+
+    return count;
+}
+
+bool compressor_flush(Compressor* compressor, SensorData* output) {
+    if (!compressor || !output || !compressor->held) {
+        return false;
+    }
+
+    *output = compressor->held_data;
+    archive(compressor, &compressor->held_data);
+    return true;
+}
+
+bool compression_init(const CompressionConfig* default_config) {
+    CompressionConfig defaults;
+    if (!default_config) {
+        compression_get_default_config(&defaults);
+        default_config = &defaults;
+    }
+    if (!validate_config(default_config)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&compression_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&compression_mutex);
+        return false;
+    }
+
+    private_data = (CompressionPrivate*)calloc(1, sizeof(CompressionPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&compression_mutex);
+        return false;
+    }
+    memcpy(&private_data->default_config, default_config, sizeof(CompressionConfig));
+
+    pthread_mutex_unlock(&compression_mutex);
+    return true;
+}
+
+void compression_cleanup(void) {
+    pthread_mutex_lock(&compression_mutex);
+
+    if (private_data) {
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&compression_mutex);
+}
+
+bool compression_configure_sensor(const char* sensor_id, const CompressionConfig* config) {
+    if (!sensor_id || !config || !validate_config(config)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&compression_mutex);
+
+    CompressionSensor* entry = private_data ? find_sensor(sensor_id, true) : NULL;
+    if (entry) {
+        memcpy(&entry->config, config, sizeof(CompressionConfig));
+    }
+
+    pthread_mutex_unlock(&compression_mutex);
+    return entry != NULL;
+}
+
+uint32_t compression_process_sample(const Sensor* sensor, const SensorData* data,
+                                    CompressionSink sink, void* context) {
+    if (!sensor || !data || !sink) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&compression_mutex);
+
+    CompressionSensor* entry = private_data ? find_sensor(sensor->id, true) : NULL;
+    if (!entry) {
+        pthread_mutex_unlock(&compression_mutex);
+        return 0;
+    }
+
+    SensorData output[COMPRESSION_MAX_OUTPUT];
+    uint32_t count = compressor_update(&entry->compressor, &entry->config, data, output);
+    entry->sensor = sensor;
+    entry->status.samples++;
+    for (uint32_t i = 0; i < count; i++) {
+        sink(sensor, &output[i], context);
+        entry->status.forwarded++;
+        entry->status.last_forwarded = output[i].timestamp;
+    }
+
+    pthread_mutex_unlock(&compression_mutex);
+    return count;
+}
+
+uint32_t compression_flush(CompressionSink sink, void* context) {
+    if (!sink) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&compression_mutex);
+
+    uint32_t count = 0;
+    if (private_data) {
+        for (uint32_t i = 0; i < COMPRESSION_MAX_SENSORS; i++) {
+            CompressionSensor* entry = &private_data->sensors[i];
+            SensorData output;
+            if (entry->id[0] != '\0' && entry->sensor && compressor_flush(&entry->compressor, &output)) {
+                sink(entry->sensor, &output, context);
+                entry->status.forwarded++;
+                entry->status.last_forwarded = output.timestamp;
+                count++;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&compression_mutex);
+    return count;
+}
+
+bool compression_get_status(const char* sensor_id, CompressionStatus* status) {
+    if (!sensor_id || !status) {
+        return false;
+    }
+
+    pthread_mutex_lock(&compression_mutex);
+
+    CompressionSensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    if (entry) {
+        memcpy(status, &entry->status, sizeof(CompressionStatus));
+    }
+
+    pthread_mutex_unlock(&compression_mutex);
+    return entry != NULL;
+}
+
+const char* compression_method_to_string(CompressionMethod method) {
+    switch (method) {
+        case COMPRESSION_NONE:
+            return "None";
+        case COMPRESSION_DEADBAND:
+            return "Deadband";
+        case COMPRESSION_SWINGING_DOOR:
+            return "Swinging door";
+        default:
+            return "Unknown";
+    }
+}
+
+void compression_get_default_config(CompressionConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->method = COMPRESSION_SWINGING_DOOR;
+    config->deviation = 1.0f;
+    config->max_interval_s = 600;
+}
+
+// Private helper functions
+static void archive(Compressor* compressor, const SensorData* data) {
+    compressor->archived = true;
+    compressor->held = false;
+    compressor->archive_time = data->timestamp;
+    compressor->archive_value = data->value;
+    compressor->last_timestamp = data->timestamp;
+    compressor->slope_low = -INFINITY;
+    compressor->slope_high = INFINITY;
+}
+
+static bool validate_config(const CompressionConfig* config) {
+    return (config->method == COMPRESSION_NONE || config->method == COMPRESSION_DEADBAND ||
+            config->method == COMPRESSION_SWINGING_DOOR) &&
+           config->deviation >= 0.0f && isfinite(config->deviation);
+}
+
+static CompressionSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, COMPRESSION_MAX_SENSORS,
+                                          CompressionSensor, id);
+    bool created;
+    CompressionSensor* entry = (CompressionSensor*)sensor_table_find(&table, id, create, &created);
+    if (created) {
+        memcpy(&entry->config, &private_data->default_config, sizeof(CompressionConfig));
+        compressor_init(&entry->compressor);
+    }
+    return entry;
+}
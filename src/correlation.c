@@ -0,0 +1,708 @@
+/**
+ * @file correlation.c
+ * @brief Rolling cross-sensor correlation for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * With weight a = 1 / min(count, window), deviation d = x - mean (before the update),
+ * the exponentially weighted covariance follows
+ *   mean += a d,   C = (1 - a) (C + a d d')
+ * Only the upper triangle is read. Each row i is updated from the start of the 4-float
+ * block holding column i, so the few lower-triangle entries in that block are updated
+ * by the same formula and stay symmetric. Padding columns see zero deviations and stay
+ * zero, so the vector loops need no tail handling.
+ */
+
+#include "../include/correlation.h"
+#include "../include/event_queue.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CORRELATION_SSE2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define CORRELATION_NEON 1
+#endif
+
+#define GROUP_NONE -1       // Sensor has not reported yet
+#define GROUP_EXCLUDED -2   // Sensor has no group
+
+// Per-sensor membership
+typedef struct {
+    bool assigned;
+    char id[32];
+    char group[64];
+    int32_t group_index;
+    uint32_t member;
+} CorrelationSensor;
+
+// Member of a group
+typedef struct {
+    char id[32];
+    SensorType type;
+    uint32_t snapshots;
+} CorrelationMember;
+
+// Sensors correlated with each other
+typedef struct {
+    bool used;
+    char name[64];
+    uint32_t members;
+    uint32_t capacity;
+    uint32_t next_snapshot;
+    CorrelationMember* member_info;
+    float* values;
+    float* inv_short;
+    float* inv_long;
+    uint8_t* broken;
+    RollingCovariance short_term;
+    RollingCovariance long_term;
+} CorrelationGroup;
+
+// Private data structure
+typedef struct {
+    CorrelationConfig config;
+    CorrelationSensor sensors[CORRELATION_MAX_SENSORS];
+    CorrelationGroup groups[CORRELATION_MAX_GROUPS];
+} CorrelationPrivate;
+
+// Forward declarations of private functions
+static void update_means(RollingCovariance* covariance, const float* values, float* alpha, float* keep);
+static void update_row(RollingCovariance* covariance, uint32_t i, float alpha, float keep);
+static bool record_sample(const Sensor* sensor, const SensorData* data);
+static bool add_member(CorrelationGroup* group, const Sensor* sensor, float value, uint32_t* member);
+static bool grow_group(CorrelationGroup* group, uint32_t capacity);
+static void snapshot_group(CorrelationGroup* group, uint32_t timestamp);
+static void scan_row(CorrelationGroup* group, uint32_t i, uint32_t timestamp);
+static void check_pairs(CorrelationGroup* group, uint32_t i, uint32_t first, uint32_t end,
+                        uint32_t timestamp);
+static void push_break_event(const CorrelationGroup* group, uint32_t a, uint32_t b, uint32_t timestamp,
+                             float correlation, float baseline, bool broken);
+static void free_group(CorrelationGroup* group);
+static CorrelationGroup* find_group(const char* name, bool create);
+static CorrelationSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static CorrelationPrivate* private_data = NULL;
+static pthread_mutex_t correlation_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool rolling_covariance_init(RollingCovariance* covariance, uint32_t capacity, uint32_t window) {
+    if (!covariance || window == 0) {
+        return false;
+    }
+
+    memset(covariance, 0, sizeof(RollingCovariance));
+    covariance->window = window;
+    capacity = capacity < 4 ? 4 : (capacity + 3) & ~3u;
+
+    covariance->mean = (float*)calloc(capacity, sizeof(float));
+    covariance->deviation = (float*)calloc(capacity, sizeof(float));
+    covariance->covariance = (float*)calloc((size_t)capacity * capacity, sizeof(float));
+    if (!covariance->mean || !covariance->deviation || !covariance->covariance) {
+        rolling_covariance_free(covariance);
+        return false;
+    }
+    covariance->capacity = capacity;
+    return true;
+}
+
+void rolling_covariance_free(RollingCovariance* covariance) {
+    if (!covariance) {
+        return;
+    }
+
+    free(covariance->mean);
+    free(covariance->deviation);
+    free(covariance->covariance);
+    covariance->mean = NULL;
+    covariance->deviation = NULL;
+    covariance->covariance = NULL;
+    covariance->variables = 0;
+    covariance->capacity = 0;
+}
+
+bool rolling_covariance_add_variable(RollingCovariance* covariance, float initial_value) {
+    if (!covariance || !covariance->mean) {
+        return false;
+    }
+
+    if (covariance->variables == covariance->capacity) {
+        uint32_t old_capacity = covariance->capacity;
+        uint32_t capacity = old_capacity * 2;
+        float* mean = (float*)calloc(capacity, sizeof(float));
+        float* deviation = (float*)calloc(capacity, sizeof(float));
+        float* matrix = (float*)calloc((size_t)capacity * capacity, sizeof(float));
+        if (!mean || !deviation || !matrix) {
+            free(mean);
+            free(deviation);
+            free(matrix);
+            return false;
+        }
+
+        memcpy(mean, covariance->mean, old_capacity * sizeof(float));
+        for (uint32_t i = 0; i < old_capacity; i++) {
+            memcpy(matrix + (size_t)i * capacity, covariance->covariance + (size_t)i * old_capacity,
+                   old_capacity * sizeof(float));
+        }
+        free(covariance->mean);
+        free(covariance->deviation);
+        free(covariance->covariance);
+        covariance->mean = mean;
+        covariance->deviation = deviation;
+        covariance->covariance = matrix;
+        covariance->capacity = capacity;
+    }
+
+    covariance->mean[covariance->variables++] = initial_value;
+    return true;
+}
+
+void rolling_covariance_update(RollingCovariance* covariance, const float* values) {
+    if (!covariance || !values || covariance->variables == 0) {
+        return;
+    }
+
+    float alpha;
+    float keep;
+    update_means(covariance, values, &alpha, &keep);
+    for (uint32_t i = 0; i < covariance->variables; i++) {
+        update_row(covariance, i, alpha, keep);
+    }
+}
+
+float rolling_covariance_correlation(const RollingCovariance* covariance, uint32_t a, uint32_t b) {
+    if (!covariance || a >= covariance->variables || b >= covariance->variables) {
+        return NAN;
+    }
+    if (a > b) {
+        uint32_t swap = a;
+        a = b;
+        b = swap;
+    }
+
+    const float* matrix = covariance->covariance;
+    size_t stride = covariance->capacity;
+    float var_a = matrix[a * stride + a];
+    float var_b = matrix[b * stride + b];
+    if (var_a <= 0.0f || var_b <= 0.0f) {
+        return NAN;
+    }
+    return matrix[a * stride + b] / sqrtf(var_a * var_b);
+}
+
+bool correlation_init(const CorrelationConfig* config) {
+    CorrelationConfig defaults;
+    if (!config) {
+        correlation_get_default_config(&defaults);
+        config = &defaults;
+    }
+    if (config->period_s == 0 || config->short_window == 0 || config->long_window == 0 ||
+        config->clear_threshold > config->break_threshold) {
+        return false;
+    }
+
+    pthread_mutex_lock(&correlation_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&correlation_mutex);
+        return false;
+    }
+
+    private_data = (CorrelationPrivate*)calloc(1, sizeof(CorrelationPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&correlation_mutex);
+        return false;
+    }
+    memcpy(&private_data->config, config, sizeof(CorrelationConfig));
+
+    pthread_mutex_unlock(&correlation_mutex);
+    return true;
+}
+
+void correlation_cleanup(void) {
+    pthread_mutex_lock(&correlation_mutex);
+
+    if (private_data) {
+        for (uint32_t i = 0; i < CORRELATION_MAX_GROUPS; i++) {
+            free_group(&private_data->groups[i]);
+        }
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&correlation_mutex);
+}
+
+bool correlation_assign_group(const char* sensor_id, const char* group) {
+    if (!sensor_id || !group) {
+        return false;
+    }
+
+    pthread_mutex_lock(&correlation_mutex);
+
+    CorrelationSensor* entry = private_data ? find_sensor(sensor_id, true) : NULL;
+    bool assigned = entry && entry->group_index == GROUP_NONE;
+    if (assigned) {
+        entry->assigned = true;
+        strncpy(entry->group, group, sizeof(entry->group) - 1);
+        entry->group[sizeof(entry->group) - 1] = '\0';
+    }
+
+    pthread_mutex_unlock(&correlation_mutex);
+    return assigned;
+}
+
+bool correlation_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data) {
+        return false;
+    }
+
+    pthread_mutex_lock(&correlation_mutex);
+    bool snapshot = private_data && record_sample(sensor, data);
+    pthread_mutex_unlock(&correlation_mutex);
+
+    return snapshot;
+}
+
+uint32_t correlation_process_batch(const Sensor* const* sensors, const SensorData* data, uint32_t count) {
+    if (!sensors || !data) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&correlation_mutex);
+
+    uint32_t snapshots = 0;
+    if (private_data) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (sensors[i] && record_sample(sensors[i], &data[i])) {
+                snapshots++;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&correlation_mutex);
+    return snapshots;
+}
+
+bool correlation_get_pair(const char* sensor_a, const char* sensor_b, CorrelationPair* pair) {
+    if (!sensor_a || !sensor_b || !pair) {
+        return false;
+    }
+
+    pthread_mutex_lock(&correlation_mutex);
+
+    CorrelationSensor* a = private_data ? find_sensor(sensor_a, false) : NULL;
+    CorrelationSensor* b = private_data ? find_sensor(sensor_b, false) : NULL;
+    bool found = a && b && a->group_index >= 0 && a->group_index == b->group_index;
+    if (found) {
+        const CorrelationGroup* group = &private_data->groups[a->group_index];
+        uint32_t first = a->member < b->member ? a->member : b->member;
+        uint32_t second = a->member < b->member ? b->member : a->member;
+        uint32_t warmup = private_data->config.warmup_snapshots;
+
+        pair->correlation = rolling_covariance_correlation(&group->short_term, first, second);
+        pair->baseline = rolling_covariance_correlation(&group->long_term, first, second);
+        pair->watched = group->member_info[first].snapshots >= warmup &&
+                        group->member_info[second].snapshots >= warmup &&
+                        fabsf(pair->baseline) >= private_data->config.min_baseline;
+        pair->broken = group->broken[(size_t)first * group->capacity + second] != 0;
+    }
+
+    pthread_mutex_unlock(&correlation_mutex);
+    return found;
+}
+
+bool correlation_get_matrix(const char* group_name, char (*sensor_ids)[32], float* matrix,
+                            uint32_t capacity, uint32_t* members) {
+    if (!group_name || !members) {
+        return false;
+    }
+
+    pthread_mutex_lock(&correlation_mutex);
+
+    CorrelationGroup* group = private_data ? find_group(group_name, false) : NULL;
+    bool found = group && group->members <= capacity;
+    if (group) {
+        *members = group->members;
+    }
+    if (found) {
+        uint32_t n = group->members;
+        for (uint32_t i = 0; i < n; i++) {
+            if (sensor_ids) {
+                memcpy(sensor_ids[i], group->member_info[i].id, sizeof(sensor_ids[i]));
+            }
+            if (matrix) {
+                for (uint32_t j = 0; j < n; j++) {
+                    matrix[(size_t)i * n + j] = rolling_covariance_correlation(&group->short_term, i, j);
+                }
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&correlation_mutex);
+    return found;
+}
+
+void correlation_get_default_config(CorrelationConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->period_s = 1;
+    config->short_window = 60;
+    config->long_window = 3600;
+    config->warmup_snapshots = 300;
+    config->min_baseline = 0.6f;
+    config->break_threshold = 0.5f;
+    config->clear_threshold = 0.25f;
+}
+
+// Private helper functions
+static void update_means(RollingCovariance* covariance, const float* values, float* alpha, float* keep) {
+    if (covariance->count < covariance->window) {
+        covariance->count++;
+    }
+    *alpha = 1.0f / (float)covariance->count;
+    *keep = 1.0f - *alpha;
+
+    float* mean = covariance->mean;
+    float* deviation = covariance->deviation;
+    for (uint32_t i = 0; i < covariance->variables; i++) {
+        float d = values[i] - mean[i];
+        deviation[i] = d;
+        mean[i] += *alpha * d;
+    }
+}
+
+static void update_row(RollingCovariance* covariance, uint32_t i, float alpha, float keep) {
+    float* row = covariance->covariance + (size_t)i * covariance->capacity;
+    const float* deviation = covariance->deviation;
+    float scale = alpha * deviation[i];
+    uint32_t columns = (covariance->variables + 3) & ~3u;
+    uint32_t j = i & ~3u;
+
+#if defined(CORRELATION_SSE2)
+    __m128 vscale = _mm_set1_ps(scale);
+    __m128 vkeep = _mm_set1_ps(keep);
+    for (; j < columns; j += 4) {
+        __m128 c = _mm_loadu_ps(row + j);
+        c = _mm_mul_ps(_mm_add_ps(c, _mm_mul_ps(vscale, _mm_loadu_ps(deviation + j))), vkeep);
+        _mm_storeu_ps(row + j, c);
+    }
+#elif defined(CORRELATION_NEON)
+    float32x4_t vscale = vdupq_n_f32(scale);
+    float32x4_t vkeep = vdupq_n_f32(keep);
+    for (; j < columns; j += 4) {
+        float32x4_t c = vld1q_f32(row + j);
+        c = vmulq_f32(vaddq_f32(c, vmulq_f32(vscale, vld1q_f32(deviation + j))), vkeep);
+        vst1q_f32(row + j, c);
+    }
+#endif
+
+    for (; j < columns; j++) {
+        row[j] = (row[j] + scale * deviation[j]) * keep;
+    }
+}
+
+static bool record_sample(const Sensor* sensor, const SensorData* data) {
+    if (!data->is_valid || !isfinite(data->value)) {
+        return false;
+    }
+
+    CorrelationSensor* entry = find_sensor(sensor->id, true);
+    if (!entry || entry->group_index == GROUP_EXCLUDED) {
+        return false;
+    }
+
+    CorrelationGroup* group = NULL;
+    if (entry->group_index == GROUP_NONE) {
+        const char* name = entry->assigned ? entry->group : sensor->location;
+        group = name[0] ? find_group(name, true) : NULL;
+        if (!group) {
+            entry->group_index = GROUP_EXCLUDED;
+            return false;
+        }
+    } else {
+        group = &private_data->groups[entry->group_index];
+    }
+
+    // The first sample of a new period closes the previous one
+    bool snapshot = false;
+    uint32_t period = private_data->config.period_s;
+    if (group->members > 0 && data->timestamp >= group->next_snapshot) {
+        snapshot_group(group, data->timestamp);
+        group->next_snapshot = data->timestamp - (data->timestamp - group->next_snapshot) % period + period;
+        snapshot = true;
+    }
+
+    if (entry->group_index == GROUP_NONE) {
+        if (group->members == 0) {
+            group->next_snapshot = data->timestamp + period;
+        }
+        if (!add_member(group, sensor, data->value, &entry->member)) {
+            entry->group_index = GROUP_EXCLUDED;
+            return snapshot;
+        }
+        entry->group_index = (int32_t)(group - private_data->groups);
+    }
+
+    group->values[entry->member] = data->value;
+    return snapshot;
+}
+
+static bool add_member(CorrelationGroup* group, const Sensor* sensor, float value, uint32_t* member) {
+    if (group->members >= CORRELATION_MAX_MEMBERS) {
+        return false;
+    }
+    if (!rolling_covariance_add_variable(&group->short_term, value) ||
+        !rolling_covariance_add_variable(&group->long_term, value)) {
+        // Keep both matrices the same size
+        if (group->short_term.variables > group->members) {
+            group->short_term.variables--;
+        }
+        return false;
+    }
+    if (group->short_term.capacity > group->capacity && !grow_group(group, group->short_term.capacity)) {
+        group->short_term.variables--;
+        group->long_term.variables--;
+        return false;
+    }
+
+    *member = group->members++;
+    CorrelationMember* info = &group->member_info[*member];
+    strncpy(info->id, sensor->id, sizeof(info->id) - 1);
+    info->id[sizeof(info->id) - 1] = '\0';
+    info->type = sensor->type;
+    info->snapshots = 0;
+    return true;
+}
+
+static bool grow_group(CorrelationGroup* group, uint32_t capacity) {
+    CorrelationMember* member_info = (CorrelationMember*)calloc(capacity, sizeof(CorrelationMember));
+    float* values = (float*)calloc(capacity, sizeof(float));
+    float* inv_short = (float*)calloc(capacity, sizeof(float));
+    float* inv_long = (float*)calloc(capacity, sizeof(float));
+    uint8_t* broken = (uint8_t*)calloc((size_t)capacity * capacity, sizeof(uint8_t));
+    if (!member_info || !values || !inv_short || !inv_long || !broken) {
+        free(member_info);
+        free(values);
+        free(inv_short);
+        free(inv_long);
+        free(broken);
+        return false;
+    }
+
+    if (group->capacity > 0) {
+        memcpy(member_info, group->member_info, group->capacity * sizeof(CorrelationMember));
+        memcpy(values, group->values, group->capacity * sizeof(float));
+        for (uint32_t i = 0; i < group->capacity; i++) {
+            memcpy(broken + (size_t)i * capacity, group->broken + (size_t)i * group->capacity,
+                   group->capacity);
+        }
+    }
+    free(group->member_info);
+    free(group->values);
+    free(group->inv_short);
+    free(group->inv_long);
+    free(group->broken);
+    group->member_info = member_info;
+    group->values = values;
+    group->inv_short = inv_short;
+    group->inv_long = inv_long;
+    group->broken = broken;
+    group->capacity = capacity;
+    return true;
+}
+
+static void snapshot_group(CorrelationGroup* group, uint32_t timestamp) {
+    const CorrelationConfig* config = &private_data->config;
+    uint32_t n = group->members;
+
+    float alpha_short, keep_short, alpha_long, keep_long;
+    update_means(&group->short_term, group->values, &alpha_short, &keep_short);
+    update_means(&group->long_term, group->values, &alpha_long, &keep_long);
+
+    // Inverse standard deviations from the diagonals the row updates are about to
+    // produce, zero for members not warmed up or constant
+    const float* short_deviation = group->short_term.deviation;
+    const float* long_deviation = group->long_term.deviation;
+    size_t short_stride = group->short_term.capacity;
+    size_t long_stride = group->long_term.capacity;
+    for (uint32_t i = 0; i < n; i++) {
+        group->member_info[i].snapshots++;
+        float var_short = (group->short_term.covariance[i * short_stride + i] +
+                           alpha_short * short_deviation[i] * short_deviation[i]) * keep_short;
+        float var_long = (group->long_term.covariance[i * long_stride + i] +
+                          alpha_long * long_deviation[i] * long_deviation[i]) * keep_long;
+        bool ready = group->member_info[i].snapshots >= config->warmup_snapshots &&
+                     var_short > 0.0f && var_long > 0.0f;
+        group->inv_short[i] = ready ? 1.0f / sqrtf(var_short) : 0.0f;
+        group->inv_long[i] = ready ? 1.0f / sqrtf(var_long) : 0.0f;
+    }
+
+    // Each row is scanned right after its update, while it is still in cache
+    for (uint32_t i = 0; i < n; i++) {
+        update_row(&group->short_term, i, alpha_short, keep_short);
+        update_row(&group->long_term, i, alpha_long, keep_long);
+        scan_row(group, i, timestamp);
+    }
+}
+
+static void scan_row(CorrelationGroup* group, uint32_t i, uint32_t timestamp) {
+    uint32_t n = group->members;
+    uint32_t j = i + 1;
+
+#if defined(CORRELATION_SSE2) || defined(CORRELATION_NEON)
+    // Only blocks with a pair about to break or already broken take the scalar check
+    const CorrelationConfig* config = &private_data->config;
+    const float* row_short = group->short_term.covariance + (size_t)i * group->short_term.capacity;
+    const float* row_long = group->long_term.covariance + (size_t)i * group->long_term.capacity;
+    const uint8_t* row_broken = group->broken + (size_t)i * group->capacity;
+#endif
+
+#if defined(CORRELATION_SSE2)
+    __m128 short_i = _mm_set1_ps(group->inv_short[i]);
+    __m128 long_i = _mm_set1_ps(group->inv_long[i]);
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 min_baseline = _mm_set1_ps(config->min_baseline);
+    __m128 break_threshold = _mm_set1_ps(config->break_threshold);
+    for (; j + 4 <= n; j += 4) {
+        __m128 baseline = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(row_long + j), long_i),
+                                     _mm_loadu_ps(group->inv_long + j));
+        __m128 correlation = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(row_short + j), short_i),
+                                        _mm_loadu_ps(group->inv_short + j));
+        __m128 difference = _mm_andnot_ps(sign, _mm_sub_ps(correlation, baseline));
+        __m128 breaking = _mm_and_ps(_mm_cmpge_ps(_mm_andnot_ps(sign, baseline), min_baseline),
+                                     _mm_cmpge_ps(difference, break_threshold));
+        uint32_t broken;
+        memcpy(&broken, row_broken + j, sizeof(broken));
+        if (_mm_movemask_ps(breaking) || broken) {
+            check_pairs(group, i, j, j + 4, timestamp);
+        }
+    }
+#elif defined(CORRELATION_NEON)
+    float32x4_t short_i = vdupq_n_f32(group->inv_short[i]);
+    float32x4_t long_i = vdupq_n_f32(group->inv_long[i]);
+    float32x4_t min_baseline = vdupq_n_f32(config->min_baseline);
+    float32x4_t break_threshold = vdupq_n_f32(config->break_threshold);
+    for (; j + 4 <= n; j += 4) {
+        float32x4_t baseline = vmulq_f32(vmulq_f32(vld1q_f32(row_long + j), long_i),
+                                         vld1q_f32(group->inv_long + j));
+        float32x4_t correlation = vmulq_f32(vmulq_f32(vld1q_f32(row_short + j), short_i),
+                                            vld1q_f32(group->inv_short + j));
+        float32x4_t difference = vabsq_f32(vsubq_f32(correlation, baseline));
+        uint32x4_t breaking = vandq_u32(vcgeq_f32(vabsq_f32(baseline), min_baseline),
+                                        vcgeq_f32(difference, break_threshold));
+        uint32_t broken;
+        memcpy(&broken, row_broken + j, sizeof(broken));
+        if (vmaxvq_u32(breaking) || broken) {
+            check_pairs(group, i, j, j + 4, timestamp);
+        }
+    }
+#endif
+
+    check_pairs(group, i, j, n, timestamp);
+}
+
+static void check_pairs(CorrelationGroup* group, uint32_t i, uint32_t first, uint32_t end,
+                        uint32_t timestamp) {
+    const CorrelationConfig* config = &private_data->config;
+    const float* row_short = group->short_term.covariance + (size_t)i * group->short_term.capacity;
+    const float* row_long = group->long_term.covariance + (size_t)i * group->long_term.capacity;
+    uint8_t* row_broken = group->broken + (size_t)i * group->capacity;
+
+    // Members not warmed up have zero inverse deviations, so their pairs are not watched
+    for (uint32_t j = first; j < end; j++) {
+        float baseline = row_long[j] * group->inv_long[i] * group->inv_long[j];
+        float correlation = row_short[j] * group->inv_short[i] * group->inv_short[j];
+        float difference = fabsf(correlation - baseline);
+        bool watched = fabsf(baseline) >= config->min_baseline;
+
+        if (!row_broken[j] && watched && difference >= config->break_threshold) {
+            row_broken[j] = 1;
+            push_break_event(group, i, j, timestamp, correlation, baseline, true);
+        } else if (row_broken[j] && (!watched || difference <= config->clear_threshold)) {
+            row_broken[j] = 0;
+            push_break_event(group, i, j, timestamp, correlation, baseline, false);
+        }
+    }
+}
+
+static void push_break_event(const CorrelationGroup* group, uint32_t a, uint32_t b, uint32_t timestamp,
+                             float correlation, float baseline, bool broken) {
+    MonitorEvent event;
+    memset(&event, 0, sizeof(event));
+    event.type = EVENT_CORRELATION_BREAK;
+    memcpy(event.sensor_id, group->member_info[a].id, sizeof(event.sensor_id));
+    memcpy(event.peer_id, group->member_info[b].id, sizeof(event.peer_id));
+    event.sensor_type = group->member_info[a].type;
+    event.timestamp = timestamp;
+    event.value = baseline;
+    event.from_state = broken ? 0 : 1;
+    event.to_state = broken ? 1 : 0;
+    event.score = correlation;
+    event_queue_push(&event);
+}
+
+static void free_group(CorrelationGroup* group) {
+    if (!group->used) {
+        return;
+    }
+
+    rolling_covariance_free(&group->short_term);
+    rolling_covariance_free(&group->long_term);
+    free(group->member_info);
+    free(group->values);
+    free(group->inv_short);
+    free(group->inv_long);
+    free(group->broken);
+    memset(group, 0, sizeof(CorrelationGroup));
+}
+
+static CorrelationGroup* find_group(const char* name, bool create) {
+    CorrelationGroup* free_slot = NULL;
+    for (uint32_t i = 0; i < CORRELATION_MAX_GROUPS; i++) {
+        CorrelationGroup* group = &private_data->groups[i];
+        if (!group->used) {
+            if (!free_slot) {
+                free_slot = group;
+            }
+            continue;
+        }
+        if (strncmp(group->name, name, sizeof(group->name) - 1) == 0) {
+            return group;
+        }
+    }
+    if (!create || !free_slot) {
+        return NULL;
+    }
+
+    const CorrelationConfig* config = &private_data->config;
+    memset(free_slot, 0, sizeof(CorrelationGroup));
+    if (!rolling_covariance_init(&free_slot->short_term, 4, config->short_window) ||
+        !rolling_covariance_init(&free_slot->long_term, 4, config->long_window) ||
+        !grow_group(free_slot, free_slot->short_term.capacity)) {
+        free_slot->used = true;
+        free_group(free_slot);
+        return NULL;
+    }
+    free_slot->used = true;
+    strncpy(free_slot->name, name, sizeof(free_slot->name) - 1);
+    return free_slot;
+}
+
+static CorrelationSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, CORRELATION_MAX_SENSORS,
+                                          CorrelationSensor, id);
+    bool created;
+    CorrelationSensor* entry = (CorrelationSensor*)sensor_table_find(&table, id, create, &created);
+    if (created) {
+        entry->group_index = GROUP_NONE;
+    }
+    return entry;
+}
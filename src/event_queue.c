@@ -0,0 +1,121 @@
+/**
+ * @file event_queue.c
+ * @brief Lock-free monitoring event queue for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/event_queue.h"
+#include <stdatomic.h>
+#include <string.h>
+
+// Ring cell; `sequence` tells producers and consumers whose turn the cell is. It is
+// stored relative to the cell index so that the zero-initialized queue is ready to use.
+typedef struct {
+    _Atomic size_t sequence;
+    MonitorEvent event;
+} EventCell;
+
+// Private data structure
+typedef struct {
+    EventCell cells[EVENT_QUEUE_CAPACITY];
+    _Alignas(64) _Atomic size_t enqueue_position;
+    _Alignas(64) _Atomic size_t dequeue_position;
+    _Atomic uint64_t dropped;
+} EventQueuePrivate;
+
+// Private data instance
+static EventQueuePrivate private_data;
+
+void event_queue_reset(void) {
+    for (size_t i = 0; i < EVENT_QUEUE_CAPACITY; i++) {
+        atomic_store_explicit(&private_data.cells[i].sequence, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&private_data.enqueue_position, 0, memory_order_relaxed);
+    atomic_store_explicit(&private_data.dequeue_position, 0, memory_order_relaxed);
+    atomic_store_explicit(&private_data.dropped, 0, memory_order_relaxed);
+}
+
+bool event_queue_push(const MonitorEvent* event) {
+    if (!event) {
+        return false;
+    }
+
+    size_t position = atomic_load_explicit(&private_data.enqueue_position, memory_order_relaxed);
+    for (;;) {
+        size_t index = position & (EVENT_QUEUE_CAPACITY - 1);
+        EventCell* cell = &private_data.cells[index];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire) + index;
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&private_data.enqueue_position, &position,
+                                                      position + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                memcpy(&cell->event, event, sizeof(MonitorEvent));
+                atomic_store_explicit(&cell->sequence, position + 1 - index, memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            // The cell still holds an event from the previous lap: full
+            atomic_fetch_add_explicit(&private_data.dropped, 1, memory_order_relaxed);
+            return false;
+        } else {
+            position = atomic_load_explicit(&private_data.enqueue_position, memory_order_relaxed);
+        }
+    }
+}
+
+bool event_queue_pop(MonitorEvent* event) {
+    if (!event) {
+        return false;
+    }
+
+    size_t position = atomic_load_explicit(&private_data.dequeue_position, memory_order_relaxed);
+    for (;;) {
+        size_t index = position & (EVENT_QUEUE_CAPACITY - 1);
+        EventCell* cell = &private_data.cells[index];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire) + index;
+        intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&private_data.dequeue_position, &position,
+                                                      position + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                memcpy(event, &cell->event, sizeof(MonitorEvent));
+                atomic_store_explicit(&cell->sequence, position + EVENT_QUEUE_CAPACITY - index,
+                                      memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = atomic_load_explicit(&private_data.dequeue_position, memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t event_queue_dropped(void) {
+    return atomic_load_explicit(&private_data.dropped, memory_order_relaxed);
+}
+
+const char* event_queue_type_to_string(MonitorEventType type) {
+    switch (type) {
+        case EVENT_ALERT_TRANSITION:
+            return "Alert Transition";
+        case EVENT_ANOMALY:
+            return "Anomaly";
+        case EVENT_RULE:
+            return "Rule";
+        case EVENT_CHANGE_POINT:
+            return "Change Point";
+        case EVENT_CORRELATION_BREAK:
+            return "Correlation Break";
+        case EVENT_FORECAST_DEVIATION:
+            return "Forecast Deviation";
+        case EVENT_STATE_CHANGE:
+            return "State Change";
+        default:
+            return "Unknown";
+    }
+}
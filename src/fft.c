@@ -0,0 +1,397 @@
+/**
+ * @file fft.c
+ * @brief Real-input FFT and spectral features for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * The complex transform works on split real/imaginary arrays so that four butterflies
+ * map onto one vector operation. Each radix-4 pass fuses two radix-2 passes: with the
+ * input in radix-2 bit-reversed order, a pass of quarter size m combines the elements
+ * j, j + m, j + 2m and j + 3m of every group of 4m using twiddles W(2m)^j and
+ * W(4m)^j, which are stored contiguously per pass.
+ */
+
+#include "../include/fft.h"
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FFT_SSE2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define FFT_NEON 1
+#endif
+
+#define FFT_PI 3.14159265358979323846
+
+// Forward declarations of private functions
+static void radix2_pass(float* re, float* im, uint32_t count);
+static void radix4_pass(float* re, float* im, uint32_t count, uint32_t m, const float* twiddles);
+static void radix4_pass_scalar(float* re, float* im, uint32_t count, uint32_t m,
+                               const float* twiddles);
+static double window_coefficient(FftWindow window, uint32_t n, uint32_t size);
+static uint32_t log2_exact(uint32_t value);
+
+bool fft_plan_init(FftPlan* plan, uint32_t size, FftWindow window) {
+    if (!plan || size < FFT_MIN_SIZE || size > FFT_MAX_SIZE || (size & (size - 1)) != 0 ||
+        window > FFT_WINDOW_BLACKMAN_HARRIS) {
+        return false;
+    }
+
+    plan->size = size;
+    plan->window = window;
+
+    // Window and its sums, accumulated in double
+    double sum = 0.0;
+    double power = 0.0;
+    for (uint32_t n = 0; n < size; n++) {
+        double w = window_coefficient(window, n, size);
+        plan->window_coeffs[n] = (float)w;
+        sum += w;
+        power += w * w;
+    }
+    plan->window_sum = (float)sum;
+    plan->window_power = (float)power;
+
+    // Bit reversal of the complex index
+    uint32_t count = size / 2;
+    uint32_t bits = log2_exact(count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t reversed = 0;
+        for (uint32_t b = 0; b < bits; b++) {
+            reversed |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        plan->bit_reverse[i] = (uint16_t)reversed;
+    }
+
+    // Radix-4 pass twiddles: per pass w1 = W(2m)^j and w2 = W(4m)^j, each as re[m], im[m]
+    float* twiddles = plan->twiddles;
+    for (uint32_t m = (bits & 1u) ? 2 : 1; 4 * m <= count; m *= 4) {
+        for (uint32_t j = 0; j < m; j++) {
+            double a1 = -2.0 * FFT_PI * j / (2.0 * m);
+            double a2 = -2.0 * FFT_PI * j / (4.0 * m);
+            twiddles[j] = (float)cos(a1);
+            twiddles[m + j] = (float)sin(a1);
+            twiddles[2 * m + j] = (float)cos(a2);
+            twiddles[3 * m + j] = (float)sin(a2);
+        }
+        twiddles += 4 * m;
+    }
+
+    // Twiddles W(N)^k that unpack the half-size complex transform into the real spectrum
+    for (uint32_t k = 0; k <= count / 2; k++) {
+        double angle = -2.0 * FFT_PI * k / size;
+        plan->unpack_re[k] = (float)cos(angle);
+        plan->unpack_im[k] = (float)sin(angle);
+    }
+
+    return true;
+}
+
+void fft_forward(FftPlan* plan, const float* input) {
+    if (!plan || !input) {
+        return;
+    }
+
+    uint32_t count = plan->size / 2;
+    float* re = plan->work_re;
+    float* im = plan->work_im;
+
+    // Window, pack pairs of real samples into complex values and bit-reverse in one pass
+    const float* window = plan->window_coeffs;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t target = plan->bit_reverse[i];
+        re[target] = input[2 * i] * window[2 * i];
+        im[target] = input[2 * i + 1] * window[2 * i + 1];
+    }
+
+    // Complex transform of size count
+    uint32_t m = 1;
+    if (log2_exact(count) & 1u) {
+        radix2_pass(re, im, count);
+        m = 2;
+    }
+    const float* twiddles = plan->twiddles;
+    for (; 4 * m <= count; m *= 4) {
+        radix4_pass(re, im, count, m, twiddles);
+        twiddles += 4 * m;
+    }
+
+    // Unpack: X[k] = E[k] + W(N)^k O[k] and X[count - k] = conj(E[k] - W(N)^k O[k])
+    float* out_re = plan->spectrum_re;
+    float* out_im = plan->spectrum_im;
+    out_re[0] = re[0] + im[0];
+    out_im[0] = 0.0f;
+    out_re[count] = re[0] - im[0];
+    out_im[count] = 0.0f;
+    for (uint32_t k = 1; k <= count / 2; k++) {
+        uint32_t mirror = count - k;
+        float even_re = 0.5f * (re[k] + re[mirror]);
+        float even_im = 0.5f * (im[k] - im[mirror]);
+        float odd_re = 0.5f * (im[k] + im[mirror]);
+        float odd_im = -0.5f * (re[k] - re[mirror]);
+        float w_re = plan->unpack_re[k];
+        float w_im = plan->unpack_im[k];
+        float rotated_re = w_re * odd_re - w_im * odd_im;
+        float rotated_im = w_re * odd_im + w_im * odd_re;
+        out_re[k] = even_re + rotated_re;
+        out_im[k] = even_im + rotated_im;
+        out_re[mirror] = even_re - rotated_re;
+        out_im[mirror] = -(even_im - rotated_im);
+    }
+}
+
+void fft_power_spectrum(FftPlan* plan, const float* input, float* power) {
+    if (!plan || !input || !power) {
+        return;
+    }
+
+    fft_forward(plan, input);
+
+    // One-sided mean square per bin; DC and Nyquist have no mirror image
+    uint32_t bins = plan->size / 2;
+    float scale = 2.0f / ((float)plan->size * plan->window_power);
+    for (uint32_t k = 0; k <= bins; k++) {
+        float re = plan->spectrum_re[k];
+        float im = plan->spectrum_im[k];
+        power[k] = (re * re + im * im) * scale;
+    }
+    power[0] *= 0.5f;
+    power[bins] *= 0.5f;
+}
+
+float fft_bin_frequency(const FftPlan* plan, float sample_rate, uint32_t bin) {
+    if (!plan || plan->size == 0) {
+        return 0.0f;
+    }
+    return (float)bin * sample_rate / (float)plan->size;
+}
+
+float fft_band_energy(const FftPlan* plan, const float* power, float sample_rate,
+                      float low_hz, float high_hz) {
+    if (!plan || !power || sample_rate <= 0.0f || high_hz <= low_hz) {
+        return 0.0f;
+    }
+
+    float resolution = sample_rate / (float)plan->size;
+    uint32_t bins = plan->size / 2;
+    double low = ceil(low_hz / resolution);
+    double high = ceil(high_hz / resolution);
+    uint32_t first = low < 0.0 ? 0 : (uint32_t)low;
+    uint32_t last = high > bins + 1.0 ? bins + 1 : (uint32_t)high;
+
+    double energy = 0.0;
+    for (uint32_t k = first; k < last; k++) {
+        energy += power[k];
+    }
+    return (float)energy;
+}
+
+uint32_t fft_find_peaks(const FftPlan* plan, const float* power, float sample_rate,
+                        FftPeak* peaks, uint32_t max_peaks) {
+    if (!plan || !power || !peaks || max_peaks == 0) {
+        return 0;
+    }
+
+    uint32_t bins = plan->size / 2;
+    float resolution = sample_rate / (float)plan->size;
+    // Peak power of a unit-amplitude sinusoid centred on a bin
+    float unit_power = plan->window_sum * plan->window_sum /
+                       (2.0f * (float)plan->size * plan->window_power);
+    uint32_t found = 0;
+
+    for (uint32_t k = 1; k < bins; k++) {
+        float centre = power[k];
+        if (centre <= 0.0f || centre <= power[k - 1] || centre < power[k + 1]) {
+            continue;
+        }
+
+        // Parabola through the log power of the peak bin and its neighbours
+        float left = logf(fmaxf(power[k - 1], FLT_MIN));
+        float middle = logf(centre);
+        float right = logf(fmaxf(power[k + 1], FLT_MIN));
+        float curvature = left - 2.0f * middle + right;
+        float offset = curvature < 0.0f ? 0.5f * (left - right) / curvature : 0.0f;
+        float amplitude = sqrtf(expf(middle - 0.25f * (left - right) * offset) / unit_power);
+        if (found == max_peaks && amplitude <= peaks[found - 1].amplitude) {
+            continue;
+        }
+
+        // Insert, keeping the strongest first
+        uint32_t position = found < max_peaks ? found++ : max_peaks - 1;
+        while (position > 0 && peaks[position - 1].amplitude < amplitude) {
+            peaks[position] = peaks[position - 1];
+            position--;
+        }
+        peaks[position].frequency_hz = ((float)k + offset) * resolution;
+        peaks[position].amplitude = amplitude;
+    }
+
+    return found;
+}
+
+const char* fft_window_to_string(FftWindow window) {
+    switch (window) {
+        case FFT_WINDOW_RECTANGULAR:
+            return "Rectangular";
+        case FFT_WINDOW_HANN:
+            return "Hann";
+        case FFT_WINDOW_HAMMING:
+            return "Hamming";
+        case FFT_WINDOW_BLACKMAN_HARRIS:
+            return "Blackman-Harris";
+        default:
+            return "Unknown";
+    }
+}
+
+// Private helper functions
+static uint32_t log2_exact(uint32_t value) {
+    uint32_t bits = 0;
+    while ((1u << bits) < value) {
+        bits++;
+    }
+    return bits;
+}
+
+static double window_coefficient(FftWindow window, uint32_t n, uint32_t size) {
+    // Periodic windows, as used for spectral analysis
+    double x = 2.0 * FFT_PI * n / size;
+    switch (window) {
+        case FFT_WINDOW_HANN:
+            return 0.5 - 0.5 * cos(x);
+        case FFT_WINDOW_HAMMING:
+            return 0.54 - 0.46 * cos(x);
+        case FFT_WINDOW_BLACKMAN_HARRIS:
+            return 0.35875 - 0.48829 * cos(x) + 0.14128 * cos(2.0 * x) - 0.01168 * cos(3.0 * x);
+        case FFT_WINDOW_RECTANGULAR:
+        default:
+            return 1.0;
+    }
+}
+
+static void radix2_pass(float* re, float* im, uint32_t count) {
+    for (uint32_t k = 0; k < count; k += 2) {
+        float a_re = re[k], a_im = im[k];
+        float b_re = re[k + 1], b_im = im[k + 1];
+        re[k] = a_re + b_re;
+        im[k] = a_im + b_im;
+        re[k + 1] = a_re - b_re;
+        im[k + 1] = a_im - b_im;
+    }
+}
+
+static void radix4_pass_scalar(float* re, float* im, uint32_t count, uint32_t m,
+                               const float* twiddles) {
+    const float* w1_re = twiddles;
+    const float* w1_im = twiddles + m;
+    const float* w2_re = twiddles + 2 * m;
+    const float* w2_im = twiddles + 3 * m;
+
+    for (uint32_t group = 0; group < count; group += 4 * m) {
+        for (uint32_t j = 0; j < m; j++) {
+            uint32_t a = group + j, b = a + m, c = b + m, d = c + m;
+
+            // First radix-2 level: b and d rotated by W(2m)^j
+            float b_re = re[b] * w1_re[j] - im[b] * w1_im[j];
+            float b_im = re[b] * w1_im[j] + im[b] * w1_re[j];
+            float d_re = re[d] * w1_re[j] - im[d] * w1_im[j];
+            float d_im = re[d] * w1_im[j] + im[d] * w1_re[j];
+            float a1_re = re[a] + b_re, a1_im = im[a] + b_im;
+            float b1_re = re[a] - b_re, b1_im = im[a] - b_im;
+            float c1_re = re[c] + d_re, c1_im = im[c] + d_im;
+            float d1_re = re[c] - d_re, d1_im = im[c] - d_im;
+
+            // Second level: c by W(4m)^j, d by W(4m)^(j+m) = -i W(4m)^j
+            float c2_re = c1_re * w2_re[j] - c1_im * w2_im[j];
+            float c2_im = c1_re * w2_im[j] + c1_im * w2_re[j];
+            float d2_re = d1_re * w2_im[j] + d1_im * w2_re[j];
+            float d2_im = d1_im * w2_im[j] - d1_re * w2_re[j];
+
+            re[a] = a1_re + c2_re;
+            im[a] = a1_im + c2_im;
+            re[c] = a1_re - c2_re;
+            im[c] = a1_im - c2_im;
+            re[b] = b1_re + d2_re;
+            im[b] = b1_im + d2_im;
+            re[d] = b1_re - d2_re;
+            im[d] = b1_im - d2_im;
+        }
+    }
+}
+
+#if defined(FFT_SSE2) || defined(FFT_NEON)
+
+#if defined(FFT_SSE2)
+typedef __m128 FftVector;
+#define VLOAD(p) _mm_loadu_ps(p)
+#define VSTORE(p, v) _mm_storeu_ps((p), (v))
+#define VADD(a, b) _mm_add_ps((a), (b))
+#define VSUB(a, b) _mm_sub_ps((a), (b))
+#define VMUL(a, b) _mm_mul_ps((a), (b))
+#else
+typedef float32x4_t FftVector;
+#define VLOAD(p) vld1q_f32(p)
+#define VSTORE(p, v) vst1q_f32((p), (v))
+#define VADD(a, b) vaddq_f32((a), (b))
+#define VSUB(a, b) vsubq_f32((a), (b))
+#define VMUL(a, b) vmulq_f32((a), (b))
+#endif
+
+static void radix4_pass(float* re, float* im, uint32_t count, uint32_t m, const float* twiddles) {
+    if (m < 4) {
+        radix4_pass_scalar(re, im, count, m, twiddles);
+        return;
+    }
+
+    // Same operations as radix4_pass_scalar(), four values of j at a time
+    const float* w1_re = twiddles;
+    const float* w1_im = twiddles + m;
+    const float* w2_re = twiddles + 2 * m;
+    const float* w2_im = twiddles + 3 * m;
+
+    for (uint32_t group = 0; group < count; group += 4 * m) {
+        for (uint32_t j = 0; j < m; j += 4) {
+            uint32_t a = group + j, b = a + m, c = b + m, d = c + m;
+            FftVector tw1_re = VLOAD(w1_re + j), tw1_im = VLOAD(w1_im + j);
+            FftVector tw2_re = VLOAD(w2_re + j), tw2_im = VLOAD(w2_im + j);
+            FftVector a_re = VLOAD(re + a), a_im = VLOAD(im + a);
+            FftVector br = VLOAD(re + b), bi = VLOAD(im + b);
+            FftVector cr = VLOAD(re + c), ci = VLOAD(im + c);
+            FftVector dr = VLOAD(re + d), di = VLOAD(im + d);
+
+            FftVector b_re = VSUB(VMUL(br, tw1_re), VMUL(bi, tw1_im));
+            FftVector b_im = VADD(VMUL(br, tw1_im), VMUL(bi, tw1_re));
+            FftVector d_re = VSUB(VMUL(dr, tw1_re), VMUL(di, tw1_im));
+            FftVector d_im = VADD(VMUL(dr, tw1_im), VMUL(di, tw1_re));
+            FftVector a1_re = VADD(a_re, b_re), a1_im = VADD(a_im, b_im);
+            FftVector b1_re = VSUB(a_re, b_re), b1_im = VSUB(a_im, b_im);
+            FftVector c1_re = VADD(cr, d_re), c1_im = VADD(ci, d_im);
+            FftVector d1_re = VSUB(cr, d_re), d1_im = VSUB(ci, d_im);
+
+            FftVector c2_re = VSUB(VMUL(c1_re, tw2_re), VMUL(c1_im, tw2_im));
+            FftVector c2_im = VADD(VMUL(c1_re, tw2_im), VMUL(c1_im, tw2_re));
+            FftVector d2_re = VADD(VMUL(d1_re, tw2_im), VMUL(d1_im, tw2_re));
+            FftVector d2_im = VSUB(VMUL(d1_im, tw2_im), VMUL(d1_re, tw2_re));
+
+            VSTORE(re + a, VADD(a1_re, c2_re));
+            VSTORE(im + a, VADD(a1_im, c2_im));
+            VSTORE(re + c, VSUB(a1_re, c2_re));
+            VSTORE(im + c, VSUB(a1_im, c2_im));
+            VSTORE(re + b, VADD(b1_re, d2_re));
+            VSTORE(im + b, VADD(b1_im, d2_im));
+            VSTORE(re + d, VSUB(b1_re, d2_re));
+            VSTORE(im + d, VSUB(b1_im, d2_im));
+        }
+    }
+}
+
+#else
+
+static void radix4_pass(float* re, float* im, uint32_t count, uint32_t m, const float* twiddles) {
+    radix4_pass_scalar(re, im, count, m, twiddles);
+}
+
+#endif
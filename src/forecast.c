@@ -0,0 +1,446 @@
+/**
+ * @file forecast.c
+ * @brief Seasonal forecasting for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Additive Holt-Winters in error-correction form, for a sample x at time t, dt seconds
+ * after the previous one, in slot k = (t / slot_s) mod season_slots:
+ *   forecast  f = level + trend dt + seasonal[k] - mean(seasonal)
+ *   error     e = x - f, clipped to the threshold once ready
+ *   level'    = level + trend dt + alpha e
+ *   trend'    = trend + beta ((level' - level) / dt - trend)
+ *   seasonal[k] += gamma (1 - alpha) e
+ * The seasonal sum is tracked incrementally so the mean costs O(1). Slots are aligned
+ * to Unix time, so a daily season always starts at midnight UTC.
+ */
+
+#include "../include/forecast.h"
+#include "../include/event_queue.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#define FORECAST_SENSOR_TYPES (SENSOR_TYPE_MAGNETIC + 1)
+
+// Per-sensor forecaster
+typedef struct {
+    char id[32];
+    HoltWinters model;
+    ForecastStatus status;
+} ForecastSensor;
+
+// Private data structure
+typedef struct {
+    ForecastConfig configs[FORECAST_SENSOR_TYPES];
+    ForecastSensor sensors[FORECAST_MAX_SENSORS];
+} ForecastPrivate;
+
+// Forward declarations of private functions
+static uint32_t slot_of(const HoltWinters* model, uint32_t timestamp);
+static void finish_first_season(HoltWinters* model);
+static bool edge_value(const HoltWinters* model, uint32_t first, uint32_t count, double at, double* value);
+static bool validate_config(const ForecastConfig* config);
+static ForecastSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static ForecastPrivate* private_data = NULL;
+static pthread_mutex_t forecast_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool holt_winters_init(HoltWinters* model, const ForecastConfig* config) {
+    if (!model || !config || !validate_config(config)) {
+        return false;
+    }
+
+    memset(model, 0, sizeof(HoltWinters));
+    model->seasonal = (float*)calloc(config->season_slots, sizeof(float));
+    model->filled = (uint32_t*)calloc((config->season_slots + 31) / 32, sizeof(uint32_t));
+    if (!model->seasonal || !model->filled) {
+        holt_winters_free(model);
+        return false;
+    }
+    model->slot_s = config->slot_s;
+    model->season_slots = config->season_slots;
+    return true;
+}
+
+void holt_winters_free(HoltWinters* model) {
+    if (!model) {
+        return;
+    }
+
+    free(model->seasonal);
+    free(model->filled);
+    model->seasonal = NULL;
+    model->filled = NULL;
+}
+
+float holt_winters_forecast(const HoltWinters* model, uint32_t timestamp) {
+    if (!model || !model->seasonal || model->count == 0) {
+        return NAN;
+    }
+
+    double dt = (double)timestamp - (double)model->last_timestamp;
+    double seasonal = model->seasonal[slot_of(model, timestamp)];
+    if (model->ready) {
+        seasonal -= model->seasonal_sum / model->season_slots;
+    }
+    return (float)(model->level + model->trend * dt + seasonal);
+}
+
+bool holt_winters_update(HoltWinters* model, const ForecastConfig* config, uint32_t timestamp,
+                         float value, ForecastScore* score) {
+    if (!model || !model->seasonal || !config) {
+        return false;
+    }
+
+    uint32_t slot = slot_of(model, timestamp);
+    if (model->count == 0) {
+        model->level = value;
+        model->first_timestamp = timestamp;
+        model->last_timestamp = timestamp;
+        model->filled[slot / 32] |= 1u << (slot % 32);
+        model->fill_slot = slot;
+        model->fill_count = 1;
+        model->count = 1;
+        if (score) {
+            score->forecast = value;
+            score->deviation = 0.0f;
+            score->is_deviation = false;
+        }
+        return false;
+    }
+
+    // Score against the forecast made before the sample
+    float forecast = holt_winters_forecast(model, timestamp);
+    float error = value - forecast;
+    float sigma = fmaxf(sqrtf(model->variance), config->min_sigma);
+    float deviation = model->ready ? error / sigma : 0.0f;
+    bool is_deviation = model->ready && fabsf(deviation) >= config->threshold;
+    if (score) {
+        score->forecast = forecast;
+        score->deviation = deviation;
+        score->is_deviation = is_deviation;
+    }
+    model->deviating = is_deviation;
+
+    if (timestamp <= model->last_timestamp) {
+        return is_deviation;
+    }
+
+    double dt = (double)(timestamp - model->last_timestamp);
+    double predicted_level = model->level + model->trend * dt;
+    bool first_visit = !model->ready && !(model->filled[slot / 32] & (1u << (slot % 32)));
+    bool filling = !model->ready && slot == model->fill_slot && model->fill_count > 0;
+
+    if (first_visit) {
+        // First pass: the slot starts at this sample's offset from the level
+        model->filled[slot / 32] |= 1u << (slot % 32);
+        model->seasonal[slot] = (float)(value - predicted_level);
+        model->fill_slot = slot;
+        model->fill_count = 1;
+        model->level = predicted_level;
+    } else if (filling) {
+        // ...and averages the rest of its samples; their spread seeds the residual variance
+        model->fill_count++;
+        model->seasonal[slot] += (float)((value - predicted_level - model->seasonal[slot]) / model->fill_count);
+        model->variance += config->error_alpha * (error * error - model->variance);
+        model->level = predicted_level;
+    } else {
+        float clipped = is_deviation ? copysignf(config->threshold * sigma, error) : error;
+        double level = predicted_level + config->alpha * clipped;
+        model->trend += config->beta * ((level - model->level) / dt - model->trend);
+        model->level = level;
+
+        float step = config->gamma * (1.0f - config->alpha) * clipped;
+        model->seasonal[slot] += step;
+        if (model->ready) {
+            model->seasonal_sum += step;
+        }
+        model->variance += config->error_alpha * (clipped * clipped - model->variance);
+        model->fill_count = 0;
+    }
+
+    model->last_timestamp = timestamp;
+    model->count++;
+    if (!model->ready &&
+        (uint64_t)(timestamp - model->first_timestamp) >= (uint64_t)model->slot_s * model->season_slots) {
+        finish_first_season(model);
+    }
+
+    return is_deviation;
+}
+
+bool forecast_init(const ForecastConfig* default_config) {
+    ForecastConfig defaults;
+    if (!default_config) {
+        forecast_get_default_config(&defaults);
+        default_config = &defaults;
+    }
+    if (!validate_config(default_config)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&forecast_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&forecast_mutex);
+        return false;
+    }
+
+    private_data = (ForecastPrivate*)calloc(1, sizeof(ForecastPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&forecast_mutex);
+        return false;
+    }
+    for (uint32_t i = 0; i < FORECAST_SENSOR_TYPES; i++) {
+        memcpy(&private_data->configs[i], default_config, sizeof(ForecastConfig));
+    }
+
+    pthread_mutex_unlock(&forecast_mutex);
+    return true;
+}
+
+void forecast_cleanup(void) {
+    pthread_mutex_lock(&forecast_mutex);
+
+    if (private_data) {
+        for (uint32_t i = 0; i < FORECAST_MAX_SENSORS; i++) {
+            holt_winters_free(&private_data->sensors[i].model);
+        }
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&forecast_mutex);
+}
+
+bool forecast_configure_type(SensorType type, const ForecastConfig* config) {
+    if ((uint32_t)type >= FORECAST_SENSOR_TYPES || !config || !validate_config(config)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&forecast_mutex);
+
+    bool stored = private_data != NULL;
+    if (stored) {
+        memcpy(&private_data->configs[type], config, sizeof(ForecastConfig));
+    }
+
+    pthread_mutex_unlock(&forecast_mutex);
+    return stored;
+}
+
+bool forecast_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data || !data->is_valid || !isfinite(data->value) ||
+        (uint32_t)sensor->type >= FORECAST_SENSOR_TYPES) {
+        return false;
+    }
+
+    pthread_mutex_lock(&forecast_mutex);
+
+    const ForecastConfig* config = private_data ? &private_data->configs[sensor->type] : NULL;
+    ForecastSensor* entry = config && config->enabled ? find_sensor(sensor->id, true) : NULL;
+    if (entry && !entry->model.seasonal && !holt_winters_init(&entry->model, config)) {
+        entry = NULL;
+    }
+    if (!entry) {
+        pthread_mutex_unlock(&forecast_mutex);
+        return false;
+    }
+
+    HoltWinters* model = &entry->model;
+    bool was_deviating = model->deviating;
+    bool is_deviation = holt_winters_update(model, config, data->timestamp, data->value,
+                                            &entry->status.last_score);
+
+    ForecastStatus* status = &entry->status;
+    status->level = (float)model->level;
+    status->trend_per_s = (float)model->trend;
+    status->seasonal = model->seasonal[(data->timestamp / model->slot_s) % model->season_slots];
+    if (model->ready) {
+        status->seasonal -= (float)(model->seasonal_sum / model->season_slots);
+    }
+    status->residual_std = fmaxf(sqrtf(model->variance), config->min_sigma);
+    status->timestamp = data->timestamp;
+    status->ready = model->ready;
+
+    // Publish the start of each deviating run, not every deviating sample
+    bool started = is_deviation && !was_deviating;
+    if (started) {
+        status->deviation_count++;
+
+        MonitorEvent event;
+        memset(&event, 0, sizeof(event));
+        event.type = EVENT_FORECAST_DEVIATION;
+        memcpy(event.sensor_id, sensor->id, sizeof(event.sensor_id) - 1);
+        event.sensor_type = sensor->type;
+        event.timestamp = data->timestamp;
+        event.value = data->value;
+        event.to_state = status->last_score.deviation > 0.0f ? 1 : -1;
+        event.score = status->last_score.deviation;
+        event_queue_push(&event);
+    }
+
+    pthread_mutex_unlock(&forecast_mutex);
+    return started;
+}
+
+bool forecast_predict(const char* sensor_id, uint32_t timestamp, float* value) {
+    if (!sensor_id || !value) {
+        return false;
+    }
+
+    pthread_mutex_lock(&forecast_mutex);
+
+    ForecastSensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    bool ready = entry && entry->model.ready;
+    if (ready) {
+        *value = holt_winters_forecast(&entry->model, timestamp);
+    }
+
+    pthread_mutex_unlock(&forecast_mutex);
+    return ready;
+}
+
+bool forecast_get_status(const char* sensor_id, ForecastStatus* status) {
+    if (!sensor_id || !status) {
+        return false;
+    }
+
+    pthread_mutex_lock(&forecast_mutex);
+
+    ForecastSensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    if (entry) {
+        memcpy(status, &entry->status, sizeof(ForecastStatus));
+    }
+
+    pthread_mutex_unlock(&forecast_mutex);
+    return entry != NULL;
+}
+
+void forecast_get_default_config(ForecastConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->enabled = true;
+    config->slot_s = 60;
+    config->season_slots = 1440;
+    config->alpha = 0.02f;
+    config->beta = 0.00001f;
+    config->gamma = 0.005f;
+    config->error_alpha = 0.01f;
+    config->min_sigma = 0.01f;
+    config->threshold = 5.0f;
+}
+
+// Private helper functions
+static uint32_t slot_of(const HoltWinters* model, uint32_t timestamp) {
+    return (timestamp / model->slot_s) % model->season_slots;
+}
+
+static void finish_first_season(HoltWinters* model) {
+    uint32_t slots = model->season_slots;
+    uint32_t start = slot_of(model, model->first_timestamp);
+
+    // A season wraps around, so a jump between where it ends and where it starts is trend
+    // that the first pass folded into the seasonal offsets. Each end is extrapolated to the
+    // wrap from a line through its edge slots, so the seasonal slope there cancels out.
+    uint32_t edge = slots / 64 > 4 ? slots / 64 : 4;
+    double trend = 0.0;
+    double head;
+    double tail;
+    if (2 * edge <= slots && edge_value(model, start, edge, 0.0, &head) &&
+        edge_value(model, start + slots - edge, edge, (double)edge, &tail)) {
+        trend = (tail - head) / ((double)slots * model->slot_s);
+    }
+
+    // Remove that ramp, then move the seasonal mean into the level so the offsets sum to zero
+    double sum = 0.0;
+    for (uint32_t i = 0; i < slots; i++) {
+        uint32_t slot = (start + i) % slots;
+        model->seasonal[slot] = (float)(model->seasonal[slot] - trend * ((double)i * model->slot_s));
+        sum += model->seasonal[slot];
+    }
+
+    // A sensor reporting less than once per slot never averaged two samples, so nothing fed
+    // the residual variance. Half the mean squared step between consecutive filled slots
+    // estimates its noise and floors the variance.
+    double steps = 0.0;
+    uint32_t pairs = 0;
+    int64_t previous = -1;
+    for (uint32_t i = 0; i < slots; i++) {
+        uint32_t slot = (start + i) % slots;
+        if (!(model->filled[slot / 32] & (1u << (slot % 32)))) {
+            continue;
+        }
+        if (previous >= 0) {
+            double step = (double)model->seasonal[slot] - model->seasonal[previous];
+            steps += step * step;
+            pairs++;
+        }
+        previous = slot;
+    }
+    if (pairs > 0 && steps / (2.0 * pairs) > model->variance) {
+        model->variance = (float)(steps / (2.0 * pairs));
+    }
+    double mean = sum / slots;
+    for (uint32_t i = 0; i < slots; i++) {
+        model->seasonal[i] = (float)(model->seasonal[i] - mean);
+    }
+    model->level += mean + trend * (double)(model->last_timestamp - model->first_timestamp);
+    model->trend = trend;
+    model->seasonal_sum = 0.0;
+    model->fill_count = 0;
+    model->ready = true;
+}
+
+static bool edge_value(const HoltWinters* model, uint32_t first, uint32_t count, double at, double* value) {
+    // Least-squares line through the filled slots first .. first + count - 1, evaluated at
+    // offset `at` slots from the first; slot centres sit at offsets 0.5, 1.5, ...
+    double n = 0.0;
+    double sx = 0.0;
+    double sy = 0.0;
+    double sxx = 0.0;
+    double sxy = 0.0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t slot = (first + i) % model->season_slots;
+        if (!(model->filled[slot / 32] & (1u << (slot % 32)))) {
+            continue;
+        }
+        double x = i + 0.5;
+        double y = model->seasonal[slot];
+        n += 1.0;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double denominator = n * sxx - sx * sx;
+    if (n < 2.0 || denominator <= 0.0) {
+        return false;
+    }
+
+    double slope = (n * sxy - sx * sy) / denominator;
+    *value = (sy - slope * sx) / n + slope * at;
+    return true;
+}
+
+static bool validate_config(const ForecastConfig* config) {
+    return config->slot_s > 0 && config->season_slots > 0 &&
+           config->season_slots <= FORECAST_MAX_SLOTS &&
+           config->alpha > 0.0f && config->alpha <= 1.0f &&
+           config->beta >= 0.0f && config->beta <= 1.0f &&
+           config->gamma >= 0.0f && config->gamma <= 1.0f &&
+           config->error_alpha > 0.0f && config->error_alpha <= 1.0f &&
+           config->min_sigma > 0.0f && config->threshold > 0.0f;
+}
+
+static ForecastSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, FORECAST_MAX_SENSORS,
+                                          ForecastSensor, id);
+    return (ForecastSensor*)sensor_table_find(&table, id, create, NULL);
+}
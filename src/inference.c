@@ -0,0 +1,408 @@
+/**
+ * @file inference.c
+ * @brief Int8 neural network inference for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * A layer computes acc[o] = sum_i w[o][i] * x[i] + bias[o] in int32, where the bias
+ * already contains -input_zero_point * sum_i w[o][i], and requantizes it to
+ * round(acc[o] * multiplier[o]) + output_zero_point. Weight rows are padded with zeros
+ * to a multiple of INFERENCE_ROW_ALIGN so the dot product kernels need no tail code.
+ */
+
+#include "../include/inference.h"
+#include "../include/value_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define INFERENCE_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define INFERENCE_NEON 1
+#endif
+
+#define INFERENCE_ROW_ALIGN 32      // Weight row padding in int8 elements
+#define INFERENCE_ARENA_ALIGN 64    // Alignment of every array in the arena
+#define INFERENCE_MAX_FILE_SIZE (64u * 1024u * 1024u)
+
+// Cursor over a serialized model
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+} ModelReader;
+
+// Forward declarations of private functions
+static bool read_bytes(ModelReader* reader, void* out, size_t size);
+static const void* skip_bytes(ModelReader* reader, size_t size);
+static size_t align_up(size_t value, size_t alignment);
+static void run_layer(const InferenceLayer* layer, const int8_t* input, int8_t* output);
+static int32_t (*select_dot(void))(const int8_t*, const int8_t*, uint32_t);
+#if defined(INFERENCE_X86)
+static int32_t dot_sse2(const int8_t* a, const int8_t* b, uint32_t n);
+static int32_t dot_avx2(const int8_t* a, const int8_t* b, uint32_t n);
+#elif defined(INFERENCE_NEON)
+static int32_t dot_neon(const int8_t* a, const int8_t* b, uint32_t n);
+#else
+static int32_t dot_scalar(const int8_t* a, const int8_t* b, uint32_t n);
+#endif
+
+bool inference_model_load(InferenceModel* model, const char* path) {
+    if (!model || !path) {
+        return false;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    bool loaded = false;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    if (size > 0 && (unsigned long)size <= INFERENCE_MAX_FILE_SIZE && fseek(file, 0, SEEK_SET) == 0) {
+        void* data = malloc((size_t)size);
+        if (data) {
+            if (fread(data, 1, (size_t)size, file) == (size_t)size) {
+                loaded = inference_model_load_buffer(model, data, (size_t)size);
+            }
+            free(data);
+        }
+    }
+
+    fclose(file);
+    return loaded;
+}
+
+bool inference_model_load_buffer(InferenceModel* model, const void* data, size_t size) {
+    if (!model || !data) {
+        return false;
+    }
+    memset(model, 0, sizeof(InferenceModel));
+
+    // First pass: validate the header and layer shapes and plan the arena
+    ModelReader reader = { (const uint8_t*)data, size, 0 };
+    uint32_t header[5];
+    if (!read_bytes(&reader, header, sizeof(header)) || header[0] != INFERENCE_MAGIC ||
+        header[1] != INFERENCE_VERSION || header[2] == 0 || header[2] > INFERENCE_MAX_WIDTH ||
+        header[3] == 0 || header[3] > INFERENCE_MAX_LAYERS) {
+        return false;
+    }
+    uint32_t input_size = header[2];
+    uint32_t layer_count = header[3];
+
+    if (!skip_bytes(&reader, 2 * input_size * sizeof(float) + sizeof(float) + sizeof(int32_t))) {
+        return false;
+    }
+
+    size_t arena_size = 2 * align_up(input_size * sizeof(float), INFERENCE_ARENA_ALIGN);
+    uint32_t width = input_size;
+    uint32_t max_stride = (uint32_t)align_up(input_size, INFERENCE_ROW_ALIGN);
+    for (uint32_t l = 0; l < layer_count; l++) {
+        uint32_t shape[3];
+        if (!read_bytes(&reader, shape, sizeof(shape)) || shape[0] != width || shape[1] == 0 ||
+            shape[1] > INFERENCE_MAX_WIDTH || shape[2] > INFERENCE_ACTIVATION_RELU) {
+            return false;
+        }
+        uint32_t outputs = shape[1];
+        uint32_t stride = (uint32_t)align_up(shape[0], INFERENCE_ROW_ALIGN);
+        if (!skip_bytes(&reader, sizeof(float) + sizeof(int32_t) + outputs * sizeof(float) +
+                                 outputs * sizeof(int32_t) + (size_t)outputs * shape[0])) {
+            return false;
+        }
+        arena_size += align_up((size_t)outputs * stride, INFERENCE_ARENA_ALIGN);
+        arena_size += align_up(outputs * sizeof(int32_t), INFERENCE_ARENA_ALIGN);
+        arena_size += align_up(outputs * sizeof(float), INFERENCE_ARENA_ALIGN);
+        if (align_up(outputs, INFERENCE_ROW_ALIGN) > max_stride) {
+            max_stride = (uint32_t)align_up(outputs, INFERENCE_ROW_ALIGN);
+        }
+        width = outputs;
+    }
+    if (reader.offset != size) {
+        return false;
+    }
+    if ((header[4] & INFERENCE_FLAG_AUTOENCODER) && width != input_size) {
+        return false;
+    }
+    arena_size += 2 * align_up(max_stride, INFERENCE_ARENA_ALIGN);
+
+    uint8_t* arena = (uint8_t*)aligned_alloc(INFERENCE_ARENA_ALIGN,
+                                             align_up(arena_size, INFERENCE_ARENA_ALIGN));
+    if (!arena) {
+        return false;
+    }
+    memset(arena, 0, arena_size);
+    model->arena = arena;
+    model->input_size = input_size;
+    model->output_size = width;
+    model->layer_count = layer_count;
+    model->flags = header[4];
+
+    // Second pass: copy into the arena, padding weight rows and folding the zero point
+    reader.offset = sizeof(header);
+    size_t used = 0;
+    float* mean = (float*)(arena + used);
+    used += align_up(input_size * sizeof(float), INFERENCE_ARENA_ALIGN);
+    float* std = (float*)(arena + used);
+    used += align_up(input_size * sizeof(float), INFERENCE_ARENA_ALIGN);
+    read_bytes(&reader, mean, input_size * sizeof(float));
+    read_bytes(&reader, std, input_size * sizeof(float));
+    read_bytes(&reader, &model->input_scale, sizeof(float));
+    read_bytes(&reader, &model->input_zero_point, sizeof(int32_t));
+    model->input_mean = mean;
+    model->input_std = std;
+
+    bool valid = model->input_scale > 0.0f && model->input_zero_point >= -128 &&
+                 model->input_zero_point <= 127;
+    for (uint32_t i = 0; i < input_size; i++) {
+        valid = valid && std[i] > 0.0f;
+    }
+
+    float input_scale = model->input_scale;
+    int32_t input_zero_point = model->input_zero_point;
+    for (uint32_t l = 0; l < layer_count && valid; l++) {
+        InferenceLayer* layer = &model->layers[l];
+        uint32_t shape[3];
+        read_bytes(&reader, shape, sizeof(shape));
+        layer->inputs = shape[0];
+        layer->outputs = shape[1];
+        layer->activation = (InferenceActivation)shape[2];
+        layer->stride = (uint32_t)align_up(shape[0], INFERENCE_ROW_ALIGN);
+        read_bytes(&reader, &layer->output_scale, sizeof(float));
+        read_bytes(&reader, &layer->output_zero_point, sizeof(int32_t));
+        valid = layer->output_scale > 0.0f && layer->output_zero_point >= -128 &&
+                layer->output_zero_point <= 127;
+
+        int8_t* weights = (int8_t*)(arena + used);
+        used += align_up((size_t)layer->outputs * layer->stride, INFERENCE_ARENA_ALIGN);
+        int32_t* bias = (int32_t*)(arena + used);
+        used += align_up(layer->outputs * sizeof(int32_t), INFERENCE_ARENA_ALIGN);
+        float* multiplier = (float*)(arena + used);
+        used += align_up(layer->outputs * sizeof(float), INFERENCE_ARENA_ALIGN);
+
+        const float* weight_scale = (const float*)skip_bytes(&reader, layer->outputs * sizeof(float));
+        const uint8_t* raw_bias = (const uint8_t*)skip_bytes(&reader, layer->outputs * sizeof(int32_t));
+        const int8_t* raw_weights = (const int8_t*)skip_bytes(&reader, (size_t)layer->outputs * layer->inputs);
+        for (uint32_t o = 0; o < layer->outputs; o++) {
+            float scale;
+            int32_t raw;
+            memcpy(&scale, weight_scale + o, sizeof(float));
+            memcpy(&raw, raw_bias + o * sizeof(int32_t), sizeof(int32_t));
+            memcpy(weights + (size_t)o * layer->stride, raw_weights + (size_t)o * layer->inputs,
+                   layer->inputs);
+
+            int64_t row_sum = 0;
+            for (uint32_t i = 0; i < layer->inputs; i++) {
+                row_sum += raw_weights[(size_t)o * layer->inputs + i];
+            }
+            int64_t folded = (int64_t)raw - (int64_t)input_zero_point * row_sum;
+            valid = valid && scale > 0.0f && folded >= INT32_MIN && folded <= INT32_MAX;
+            bias[o] = (int32_t)folded;
+            multiplier[o] = input_scale * scale / layer->output_scale;
+        }
+        layer->weights = weights;
+        layer->bias = bias;
+        layer->multiplier = multiplier;
+
+        input_scale = layer->output_scale;
+        input_zero_point = layer->output_zero_point;
+    }
+
+    model->activations[0] = (int8_t*)(arena + used);
+    used += align_up(max_stride, INFERENCE_ARENA_ALIGN);
+    model->activations[1] = (int8_t*)(arena + used);
+
+    if (!valid) {
+        inference_model_free(model);
+        return false;
+    }
+    return true;
+}
+
+void inference_model_free(InferenceModel* model) {
+    if (model) {
+        free(model->arena);
+        memset(model, 0, sizeof(InferenceModel));
+    }
+}
+
+bool inference_run(InferenceModel* model, const float* features, float* outputs) {
+    if (!model || !model->arena || !features || !outputs) {
+        return false;
+    }
+
+    // Normalize and quantize the features
+    int8_t* input = model->activations[0];
+    float inverse_scale = 1.0f / model->input_scale;
+    for (uint32_t i = 0; i < model->input_size; i++) {
+        float normalized = (features[i] - model->input_mean[i]) / model->input_std[i];
+        float quantized = nearbyintf(normalized * inverse_scale) + (float)model->input_zero_point;
+        input[i] = (int8_t)fminf(fmaxf(quantized, -128.0f), 127.0f);
+    }
+
+    for (uint32_t l = 0; l < model->layer_count; l++) {
+        run_layer(&model->layers[l], model->activations[l & 1u], model->activations[(l + 1) & 1u]);
+    }
+
+    // Dequantize the last layer
+    const InferenceLayer* last = &model->layers[model->layer_count - 1];
+    const int8_t* result = model->activations[model->layer_count & 1u];
+    for (uint32_t o = 0; o < model->output_size; o++) {
+        outputs[o] = (float)(result[o] - last->output_zero_point) * last->output_scale;
+    }
+
+    return true;
+}
+
+bool inference_reconstruction_error(InferenceModel* model, const float* features, float* error) {
+    if (!model || !features || !error || !(model->flags & INFERENCE_FLAG_AUTOENCODER)) {
+        return false;
+    }
+
+    float reconstruction[INFERENCE_MAX_WIDTH];
+    if (!inference_run(model, features, reconstruction)) {
+        return false;
+    }
+
+    double sum = 0.0;
+    for (uint32_t i = 0; i < model->input_size; i++) {
+        float normalized = (features[i] - model->input_mean[i]) / model->input_std[i];
+        float difference = reconstruction[i] - normalized;
+        sum += (double)difference * difference;
+    }
+    *error = (float)(sum / model->input_size);
+    return true;
+}
+
+bool inference_features_from_cache(const char* const* sensor_ids, uint32_t count, uint32_t now,
+                                   uint32_t max_age_s, float* features) {
+    if (!sensor_ids || !features) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        CachedValue value;
+        if (!sensor_ids[i] || !value_cache_get(sensor_ids[i], now, max_age_s, &value) ||
+            value.quality != VALUE_QUALITY_GOOD) {
+            return false;
+        }
+        features[i] = value.value;
+    }
+    return true;
+}
+
+// Private helper functions
+static bool read_bytes(ModelReader* reader, void* out, size_t size) {
+    const void* source = skip_bytes(reader, size);
+    if (!source) {
+        return false;
+    }
+    memcpy(out, source, size);
+    return true;
+}
+
+static const void* skip_bytes(ModelReader* reader, size_t size) {
+    if (size > reader->size - reader->offset) {
+        return NULL;
+    }
+    const void* position = reader->data + reader->offset;
+    reader->offset += size;
+    return position;
+}
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static void run_layer(const InferenceLayer* layer, const int8_t* input, int8_t* output) {
+    static int32_t (*dot)(const int8_t*, const int8_t*, uint32_t) = NULL;
+    if (!dot) {
+        dot = select_dot();
+    }
+
+    double lowest = layer->activation == INFERENCE_ACTIVATION_RELU ? layer->output_zero_point : -128.0;
+    for (uint32_t o = 0; o < layer->outputs; o++) {
+        int32_t accumulator = dot(layer->weights + (size_t)o * layer->stride, input, layer->stride) +
+                              layer->bias[o];
+        double value = nearbyint((double)accumulator * layer->multiplier[o]) + layer->output_zero_point;
+        output[o] = (int8_t)fmin(fmax(value, lowest), 127.0);
+    }
+}
+
+static int32_t (*select_dot(void))(const int8_t*, const int8_t*, uint32_t) {
+#if defined(INFERENCE_X86)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? dot_avx2 : dot_sse2;
+#elif defined(INFERENCE_NEON)
+    return dot_neon;
+#else
+    return dot_scalar;
+#endif
+}
+
+#ifdef INFERENCE_X86
+__attribute__((target("sse2")))
+static int32_t dot_sse2(const int8_t* a, const int8_t* b, uint32_t n) {
+    __m128i sum = _mm_setzero_si128();
+    for (uint32_t i = 0; i < n; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        // Sign-extend to int16 by duplicating each byte and shifting arithmetically
+        __m128i a_low = _mm_srai_epi16(_mm_unpacklo_epi8(va, va), 8);
+        __m128i a_high = _mm_srai_epi16(_mm_unpackhi_epi8(va, va), 8);
+        __m128i b_low = _mm_srai_epi16(_mm_unpacklo_epi8(vb, vb), 8);
+        __m128i b_high = _mm_srai_epi16(_mm_unpackhi_epi8(vb, vb), 8);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(a_low, b_low));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(a_high, b_high));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx2")))
+static int32_t dot_avx2(const int8_t* a, const int8_t* b, uint32_t n) {
+    __m256i sum = _mm256_setzero_si256();
+    for (uint32_t i = 0; i < n; i += 32) {
+        __m256i a_low = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(a + i)));
+        __m256i a_high = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(a + i + 16)));
+        __m256i b_low = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(b + i)));
+        __m256i b_high = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(b + i + 16)));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a_low, b_low));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a_high, b_high));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+}
+#endif
+
+#ifdef INFERENCE_NEON
+static int32_t dot_neon(const int8_t* a, const int8_t* b, uint32_t n) {
+    int32x4_t sum = vdupq_n_s32(0);
+    for (uint32_t i = 0; i < n; i += 16) {
+        int8x16_t va = vld1q_s8(a + i);
+        int8x16_t vb = vld1q_s8(b + i);
+        sum = vpadalq_s16(sum, vmull_s8(vget_low_s8(va), vget_low_s8(vb)));
+        sum = vpadalq_s16(sum, vmull_high_s8(va, vb));
+    }
+    return vaddvq_s32(sum);
+}
+#endif
+
+#if !defined(INFERENCE_X86) && !defined(INFERENCE_NEON)
+static int32_t dot_scalar(const int8_t* a, const int8_t* b, uint32_t n) {
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        sum += (int32_t)a[i] * (int32_t)b[i];
+    }
+    return sum;
+}
+#endif
@@ -0,0 +1,441 @@
+/**
+ * @file kalman.c
+ * @brief Batched Kalman filtering for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * With state (level, slope), transition [1 dt; 0 1], process noise
+ * diag(level_noise, slope_noise) * dt and measurement of the level, one step is:
+ *   predict  x0 += dt x1
+ *            P00 += dt (2 P01 + dt P11) + q0 dt,  P01 += dt P11,  P11 += q1 dt
+ *   update   S = P00 + R,  K = (P00, P01) / S,  x += K (z - x0),
+ *            P00 -= K0 P00,  P01 -= K0 P01,  P11 -= K1 P01
+ * The level model is the same step with slope, P01, P11 and q1 held at zero. A missing
+ * measurement zeroes the gain instead of branching, so vector lanes stay independent.
+ * Contraction into fused multiply-add is disabled for this file so the vector and
+ * scalar paths round identically.
+ */
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#include "../include/kalman.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define KALMAN_SSE2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define KALMAN_NEON 1
+#endif
+
+// Per-sensor filter
+typedef struct {
+    bool started;
+    char id[32];
+    uint32_t lane;
+    KalmanConfig config;
+    uint32_t last_timestamp;
+    uint32_t updates;
+} KalmanSensor;
+
+// Private data structure
+typedef struct {
+    KalmanConfig default_config;
+    KalmanBank bank;
+    KalmanSensor sensors[KALMAN_MAX_LANES];
+    uint32_t tick;          // Timestamp of the samples being queued
+    uint32_t pending;       // Lanes holding a queued measurement
+} KalmanPrivate;
+
+// Forward declarations of private functions
+static void step_scalar(KalmanBank* bank, uint32_t lane);
+static bool validate_config(const KalmanConfig* config);
+static void apply_noise(KalmanBank* bank, uint32_t lane, const KalmanConfig* config);
+static bool queue_sample(KalmanSensor* entry, const SensorData* data);
+static void step_lane(uint32_t lane);
+static void step_pending(void);
+static KalmanSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static KalmanPrivate* private_data = NULL;
+static pthread_mutex_t kalman_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void kalman_bank_init(KalmanBank* bank) {
+    if (!bank) {
+        return;
+    }
+
+    memset(bank, 0, sizeof(KalmanBank));
+    for (uint32_t i = 0; i < KALMAN_MAX_LANES; i++) {
+        bank->measurement[i] = NAN;
+    }
+}
+
+bool kalman_bank_start_lane(KalmanBank* bank, uint32_t lane, const KalmanConfig* config,
+                            float initial_value) {
+    if (!bank || lane >= KALMAN_MAX_LANES || !config || !validate_config(config) ||
+        !isfinite(initial_value)) {
+        return false;
+    }
+
+    bool slope_model = config->model == KALMAN_MODEL_LEVEL_SLOPE;
+    bank->level[lane] = initial_value;
+    bank->slope[lane] = 0.0f;
+    bank->p00[lane] = config->measurement_noise;
+    bank->p01[lane] = 0.0f;
+    bank->p11[lane] = slope_model ? 2.0f * config->measurement_noise : 0.0f;
+    apply_noise(bank, lane, config);
+    bank->measurement[lane] = NAN;
+    bank->dt[lane] = 0.0f;
+    if (bank->lanes <= lane) {
+        bank->lanes = lane + 1;
+    }
+    return true;
+}
+
+void kalman_bank_step(KalmanBank* bank, uint32_t first, uint32_t count) {
+    if (!bank || first >= KALMAN_MAX_LANES) {
+        return;
+    }
+    if (count > KALMAN_MAX_LANES - first) {
+        count = KALMAN_MAX_LANES - first;
+    }
+
+    uint32_t i = first;
+    uint32_t end = first + count;
+
+#if defined(KALMAN_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 nan = _mm_set1_ps(NAN);
+    for (; i + 4 <= end; i += 4) {
+        __m128 dt = _mm_loadu_ps(bank->dt + i);
+        __m128 z = _mm_loadu_ps(bank->measurement + i);
+        __m128 x1 = _mm_loadu_ps(bank->slope + i);
+        __m128 p01 = _mm_loadu_ps(bank->p01 + i);
+        __m128 p11 = _mm_loadu_ps(bank->p11 + i);
+
+        // Predict
+        __m128 x0 = _mm_add_ps(_mm_loadu_ps(bank->level + i), _mm_mul_ps(dt, x1));
+        __m128 p11dt = _mm_mul_ps(dt, p11);
+        __m128 pp00 = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(bank->p00 + i),
+                                            _mm_mul_ps(dt, _mm_add_ps(_mm_add_ps(p01, p01), p11dt))),
+                                 _mm_mul_ps(_mm_loadu_ps(bank->level_noise + i), dt));
+        __m128 pp01 = _mm_add_ps(p01, p11dt);
+        __m128 pp11 = _mm_add_ps(p11, _mm_mul_ps(_mm_loadu_ps(bank->slope_noise + i), dt));
+
+        // Update, with zero gain where no measurement is pending
+        __m128 measured = _mm_cmpord_ps(z, z);
+        __m128 y = _mm_and_ps(measured, _mm_sub_ps(z, x0));
+        __m128 s = _mm_add_ps(pp00, _mm_loadu_ps(bank->measurement_noise + i));
+        __m128 k0 = _mm_and_ps(measured, _mm_div_ps(pp00, s));
+        __m128 k1 = _mm_and_ps(measured, _mm_div_ps(pp01, s));
+
+        _mm_storeu_ps(bank->level + i, _mm_add_ps(x0, _mm_mul_ps(k0, y)));
+        _mm_storeu_ps(bank->slope + i, _mm_add_ps(x1, _mm_mul_ps(k1, y)));
+        _mm_storeu_ps(bank->p00 + i, _mm_sub_ps(pp00, _mm_mul_ps(k0, pp00)));
+        _mm_storeu_ps(bank->p01 + i, _mm_sub_ps(pp01, _mm_mul_ps(k0, pp01)));
+        _mm_storeu_ps(bank->p11 + i, _mm_sub_ps(pp11, _mm_mul_ps(k1, pp01)));
+        _mm_storeu_ps(bank->measurement + i, nan);
+        _mm_storeu_ps(bank->dt + i, zero);
+    }
+#elif defined(KALMAN_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t nan = vdupq_n_f32(NAN);
+    for (; i + 4 <= end; i += 4) {
+        float32x4_t dt = vld1q_f32(bank->dt + i);
+        float32x4_t z = vld1q_f32(bank->measurement + i);
+        float32x4_t x1 = vld1q_f32(bank->slope + i);
+        float32x4_t p01 = vld1q_f32(bank->p01 + i);
+        float32x4_t p11 = vld1q_f32(bank->p11 + i);
+
+        // Predict
+        float32x4_t x0 = vaddq_f32(vld1q_f32(bank->level + i), vmulq_f32(dt, x1));
+        float32x4_t p11dt = vmulq_f32(dt, p11);
+        float32x4_t pp00 = vaddq_f32(vaddq_f32(vld1q_f32(bank->p00 + i),
+                                               vmulq_f32(dt, vaddq_f32(vaddq_f32(p01, p01), p11dt))),
+                                     vmulq_f32(vld1q_f32(bank->level_noise + i), dt));
+        float32x4_t pp01 = vaddq_f32(p01, p11dt);
+        float32x4_t pp11 = vaddq_f32(p11, vmulq_f32(vld1q_f32(bank->slope_noise + i), dt));
+
+        // Update, with zero gain where no measurement is pending
+        uint32x4_t measured = vceqq_f32(z, z);
+        float32x4_t y = vreinterpretq_f32_u32(vandq_u32(measured, vreinterpretq_u32_f32(vsubq_f32(z, x0))));
+        float32x4_t s = vaddq_f32(pp00, vld1q_f32(bank->measurement_noise + i));
+        float32x4_t k0 = vreinterpretq_f32_u32(vandq_u32(measured, vreinterpretq_u32_f32(vdivq_f32(pp00, s))));
+        float32x4_t k1 = vreinterpretq_f32_u32(vandq_u32(measured, vreinterpretq_u32_f32(vdivq_f32(pp01, s))));
+
+        vst1q_f32(bank->level + i, vaddq_f32(x0, vmulq_f32(k0, y)));
+        vst1q_f32(bank->slope + i, vaddq_f32(x1, vmulq_f32(k1, y)));
+        vst1q_f32(bank->p00 + i, vsubq_f32(pp00, vmulq_f32(k0, pp00)));
+        vst1q_f32(bank->p01 + i, vsubq_f32(pp01, vmulq_f32(k0, pp01)));
+        vst1q_f32(bank->p11 + i, vsubq_f32(pp11, vmulq_f32(k1, pp01)));
+        vst1q_f32(bank->measurement + i, nan);
+        vst1q_f32(bank->dt + i, zero);
+    }
+#endif
+
+    for (; i < end; i++) {
+        step_scalar(bank, i);
+    }
+}
+
+bool kalman_init(const KalmanConfig* default_config) {
+    KalmanConfig defaults;
+    if (!default_config) {
+        kalman_get_default_config(&defaults);
+        default_config = &defaults;
+    }
+    if (!validate_config(default_config)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&kalman_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&kalman_mutex);
+        return false;
+    }
+
+    private_data = (KalmanPrivate*)calloc(1, sizeof(KalmanPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&kalman_mutex);
+        return false;
+    }
+    memcpy(&private_data->default_config, default_config, sizeof(KalmanConfig));
+    kalman_bank_init(&private_data->bank);
+
+    pthread_mutex_unlock(&kalman_mutex);
+    return true;
+}
+
+void kalman_cleanup(void) {
+    pthread_mutex_lock(&kalman_mutex);
+
+    if (private_data) {
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&kalman_mutex);
+}
+
+bool kalman_configure_sensor(const char* sensor_id, const KalmanConfig* config) {
+    if (!sensor_id || !config || !validate_config(config)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&kalman_mutex);
+
+    KalmanSensor* entry = private_data ? find_sensor(sensor_id, true) : NULL;
+    if (entry) {
+        memcpy(&entry->config, config, sizeof(KalmanConfig));
+        if (entry->started) {
+            // A queued measurement is folded in with the noise it arrived under
+            step_lane(entry->lane);
+            apply_noise(&private_data->bank, entry->lane, config);
+        }
+    }
+
+    pthread_mutex_unlock(&kalman_mutex);
+    return entry != NULL;
+}
+
+bool kalman_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data) {
+        return false;
+    }
+
+    pthread_mutex_lock(&kalman_mutex);
+
+    bool updated = false;
+    if (private_data) {
+        // The samples of one tick are stepped in a single sweep once the next tick starts
+        if (data->timestamp != private_data->tick) {
+            step_pending();
+            private_data->tick = data->timestamp;
+        }
+        KalmanSensor* entry = find_sensor(sensor->id, true);
+        updated = entry && queue_sample(entry, data);
+    }
+
+    pthread_mutex_unlock(&kalman_mutex);
+    return updated;
+}
+
+uint32_t kalman_process_batch(const Sensor* const* sensors, const SensorData* data, uint32_t count) {
+    if (!sensors || !data) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&kalman_mutex);
+
+    if (!private_data) {
+        pthread_mutex_unlock(&kalman_mutex);
+        return 0;
+    }
+
+    uint32_t updated = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        KalmanSensor* entry = sensors[i] ? find_sensor(sensors[i]->id, true) : NULL;
+        if (entry && queue_sample(entry, &data[i])) {
+            updated++;
+        }
+    }
+    step_pending();
+
+    pthread_mutex_unlock(&kalman_mutex);
+    return updated;
+}
+
+bool kalman_get_estimate(const char* sensor_id, KalmanEstimate* estimate) {
+    if (!sensor_id || !estimate) {
+        return false;
+    }
+
+    pthread_mutex_lock(&kalman_mutex);
+
+    KalmanSensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    bool found = entry && entry->started;
+    if (found) {
+        const KalmanBank* bank = &private_data->bank;
+        uint32_t lane = entry->lane;
+        step_lane(lane);
+        estimate->value = bank->level[lane];
+        estimate->std_deviation = sqrtf(fmaxf(bank->p00[lane], 0.0f));
+        estimate->slope = bank->slope[lane];
+        estimate->slope_std_deviation = sqrtf(fmaxf(bank->p11[lane], 0.0f));
+        estimate->timestamp = entry->last_timestamp;
+        estimate->updates = entry->updates;
+    }
+
+    pthread_mutex_unlock(&kalman_mutex);
+    return found;
+}
+
+void kalman_get_default_config(KalmanConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->model = KALMAN_MODEL_LEVEL_SLOPE;
+    config->measurement_noise = 0.35f;
+    config->level_noise = 1e-4f;
+    config->slope_noise = 1e-6f;
+}
+
+// Private helper functions
+static void step_scalar(KalmanBank* bank, uint32_t lane) {
+    float dt = bank->dt[lane];
+    float z = bank->measurement[lane];
+    float x1 = bank->slope[lane];
+    float p01 = bank->p01[lane];
+    float p11 = bank->p11[lane];
+
+    // Same operations in the same order as the vector kernels
+    float x0 = bank->level[lane] + dt * x1;
+    float p11dt = dt * p11;
+    float pp00 = (bank->p00[lane] + dt * ((p01 + p01) + p11dt)) + bank->level_noise[lane] * dt;
+    float pp01 = p01 + p11dt;
+    float pp11 = p11 + bank->slope_noise[lane] * dt;
+
+    float y = 0.0f;
+    float k0 = 0.0f;
+    float k1 = 0.0f;
+    if (z == z) {
+        float s = pp00 + bank->measurement_noise[lane];
+        y = z - x0;
+        k0 = pp00 / s;
+        k1 = pp01 / s;
+    }
+
+    bank->level[lane] = x0 + k0 * y;
+    bank->slope[lane] = x1 + k1 * y;
+    bank->p00[lane] = pp00 - k0 * pp00;
+    bank->p01[lane] = pp01 - k0 * pp01;
+    bank->p11[lane] = pp11 - k1 * pp01;
+    bank->measurement[lane] = NAN;
+    bank->dt[lane] = 0.0f;
+}
+
+static bool validate_config(const KalmanConfig* config) {
+    return (config->model == KALMAN_MODEL_LEVEL || config->model == KALMAN_MODEL_LEVEL_SLOPE) &&
+           config->measurement_noise > 0.0f && config->level_noise >= 0.0f &&
+           config->slope_noise >= 0.0f;
+}
+
+static void apply_noise(KalmanBank* bank, uint32_t lane, const KalmanConfig* config) {
+    bank->level_noise[lane] = config->level_noise;
+    bank->slope_noise[lane] = config->model == KALMAN_MODEL_LEVEL_SLOPE ? config->slope_noise : 0.0f;
+    bank->measurement_noise[lane] = config->measurement_noise;
+}
+
+static bool queue_sample(KalmanSensor* entry, const SensorData* data) {
+    if (!data->is_valid || !isfinite(data->value)) {
+        return false;
+    }
+
+    KalmanBank* bank = &private_data->bank;
+    if (!entry->started) {
+        if (!kalman_bank_start_lane(bank, entry->lane, &entry->config, data->value)) {
+            return false;
+        }
+        entry->started = true;
+        entry->last_timestamp = data->timestamp;
+        entry->updates = 1;
+        return true;
+    }
+
+    // A lane holds one measurement; an earlier one still queued is folded in first, so
+    // it keeps both its value and its share of the elapsed time
+    step_lane(entry->lane);
+
+    // Older samples add no elapsed time
+    uint32_t elapsed = data->timestamp > entry->last_timestamp ? data->timestamp - entry->last_timestamp : 0;
+    bank->measurement[entry->lane] = data->value;
+    bank->dt[entry->lane] = (float)elapsed;
+    if (data->timestamp > entry->last_timestamp) {
+        entry->last_timestamp = data->timestamp;
+    }
+    entry->updates++;
+    private_data->pending++;
+    return true;
+}
+
+static void step_lane(uint32_t lane) {
+    KalmanBank* bank = &private_data->bank;
+    if (bank->measurement[lane] == bank->measurement[lane]) {
+        // The scalar step matches the sweep bit for bit
+        kalman_bank_step(bank, lane, 1);
+        private_data->pending--;
+    }
+}
+
+static void step_pending(void) {
+    if (private_data->pending > 0) {
+        kalman_bank_step(&private_data->bank, 0, private_data->bank.lanes);
+        private_data->pending = 0;
+    }
+}
+
+static KalmanSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, KALMAN_MAX_LANES,
+                                          KalmanSensor, id);
+    bool created;
+    KalmanSensor* entry = (KalmanSensor*)sensor_table_find(&table, id, create, &created);
+    if (created) {
+        // Entries keep their lane for the lifetime of the filters
+        entry->lane = private_data->bank.lanes++;
+        memcpy(&entry->config, &private_data->default_config, sizeof(KalmanConfig));
+    }
+    return entry;
+}
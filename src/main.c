@@ -11,12 +11,38 @@
 #include <signal.h>
 #include <time.h>
 #include <string.h>
+#include <math.h>
 #include "../include/sensor.h"
 #include "../include/temperature_sensor.h"
+#include "../include/rollup.h"
+#include "../include/segment_writer.h"
+#include "../include/retention.h"
+#include "../include/chunk_log.h"
+#include "../include/pipeline.h"
+#include "../include/pipeline_stages.h"
+#include "../include/window_stats.h"
+#include "../include/alert.h"
+#include "../include/event_queue.h"
+#include "../include/value_cache.h"
+#include "../include/anomaly.h"
+#include "../include/trend.h"
+#include "../include/rules.h"
+#include "../include/changepoint.h"
+#include "../include/kalman.h"
+#include "../include/compression.h"
+#include "../include/correlation.h"
+#include "../include/forecast.h"
+#include "../include/operating_state.h"
 
 #define SAMPLE_INTERVAL_SECONDS 1
-#define LOG_FILE "sensor_data.csv"
+#define DATA_DIR "data"
+#define LOG_PREFIX "sensor_data"
+#define LOCATIONS_FILE DATA_DIR "/locations.csv"
+#define LOG_SEGMENT_SPAN_S 3600
+#define LOG_SEGMENT_MAX_KB (64 * 1024)
+#define RETENTION_INTERVAL_S 300
 #define MAX_SAMPLES 1000
+#define CURRENT_VALUE_MAX_AGE_S 5
 
 // Global flag for graceful shutdown
 static volatile int running = 1;
@@ -27,27 +53,130 @@ static void handle_signal(int signum) {
     running = 0;
 }
 
-// Function to log sensor data to file
-static void log_sensor_data(const Sensor* sensor, const SensorData* data, FILE* log_file) {
-    if (!sensor || !data || !log_file) {
+// Function to log sensor data to the segmented data log
+static void log_sensor_data(const Sensor* sensor, const SensorData* data, SegmentWriter* log_writer) {
+    if (!sensor || !data || !log_writer) {
         return;
     }
     
-    time_t now = time(NULL);
-    struct tm* timeinfo = localtime(&now);
+    // Compressed samples reach the log late, so each record carries its sample time
+    time_t sample_time = (time_t)data->timestamp;
+    struct tm* timeinfo = localtime(&sample_time);
     char timestamp[32];
     strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", timeinfo);
     
-    fprintf(log_file, "%s,%s,%s,%.2f,%s,%s,%s\n",
-            timestamp,
-            sensor->id,
-            sensor_type_to_string(sensor->type),
-            data->value,
-            data->unit,
-            data->is_valid ? "Valid" : "Invalid",
-            data->error == SENSOR_ERROR_NONE ? "No Error" : sensor_error_to_string(data->error));
+    char line[256];
+    snprintf(line, sizeof(line), "%s,%s,%s,%.2f,%s,%s,%s",
+             timestamp,
+             sensor->id,
+             sensor_type_to_string(sensor->type),
+             data->value,
+             data->unit,
+             data->is_valid ? "Valid" : "Invalid",
+             data->error == SENSOR_ERROR_NONE ? "No Error" : sensor_error_to_string(data->error));
     
-    fflush(log_file);
+    segment_writer_write(log_writer, data->timestamp, line);
+    segment_writer_flush(log_writer);
+}
+
+// Function to record the location of each sensor next to the data log, so that a replay
+// of the log groups the sensors as the live system does
+static bool write_sensor_locations(const Sensor* sensors, size_t count) {
+    FILE* file = fopen(LOCATIONS_FILE, "w");
+    if (!file) {
+        return false;
+    }
+
+    fprintf(file, "Sensor ID,Location\n");
+    for (size_t i = 0; i < count; i++) {
+        fprintf(file, "%s,%s\n", sensors[i].id, sensors[i].location);
+    }
+    return fclose(file) == 0;
+}
+
+// Compression sink storing forwarded samples in the data log and the chunk log
+static void store_sample(const Sensor* sensor, const SensorData* data, void* context) {
+    log_sensor_data(sensor, data, (SegmentWriter*)context);
+    chunk_log_append(sensor, data);
+}
+
+// Pipeline stage passing only the samples needed to reconstruct each signal to storage
+static bool compression_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    compression_process_sample(sensor, data, store_sample, context);
+    return true;
+}
+
+// Pipeline stage folding samples into the rollup tiers
+static bool rollup_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    rollup_add_sample(sensor, data);
+    return true;
+}
+
+// Function to format a predicted time to a threshold
+static const char* format_time_to(float seconds, char* buffer, size_t size) {
+    if (isinf(seconds)) {
+        snprintf(buffer, size, "not approaching");
+    } else {
+        snprintf(buffer, size, "in %.0f s", seconds);
+    }
+    return buffer;
+}
+
+// Function to print and discard all pending monitoring events
+static void print_events(void) {
+    MonitorEvent event;
+    while (event_queue_pop(&event)) {
+        switch (event.type) {
+            case EVENT_ALERT_TRANSITION:
+                printf("[ALERT] %s: %s -> %s at %.2f\n", event.sensor_id,
+                       alert_state_to_string((AlertState)event.from_state),
+                       alert_state_to_string((AlertState)event.to_state), event.value);
+                break;
+            case EVENT_ANOMALY:
+                printf("[ANOMALY] %s: %.2f (robust z %.1f)\n", event.sensor_id, event.value, event.score);
+                break;
+            case EVENT_CHANGE_POINT:
+                printf("[CHANGE] %s: %s %+.1f sigma (%s) at %.2f\n", event.sensor_id,
+                       event.to_state > 0 ? "rise" : "fall", event.score,
+                       changepoint_method_to_string((ChangepointMethod)event.from_state), event.value);
+                break;
+            case EVENT_CORRELATION_BREAK:
+                printf("[CORRELATION] %s / %s: %s (r %.2f, baseline %.2f)\n", event.sensor_id,
+                       event.peer_id, event.to_state ? "broken" : "restored", event.score, event.value);
+                break;
+            case EVENT_FORECAST_DEVIATION:
+                printf("[FORECAST] %s: %.2f %s forecast (%+.1f sigma)\n", event.sensor_id, event.value,
+                       event.to_state > 0 ? "above" : "below", event.score);
+                break;
+            case EVENT_STATE_CHANGE:
+                printf("[STATE] %s: state %d -> %d (load %+.2f, distance %.2f)\n", event.sensor_id,
+                       event.from_state, event.to_state, event.value, event.score);
+                break;
+            case EVENT_RULE:
+                printf("[RULE] %s: %s\n", event.sensor_id, event.to_state ? "active" : "cleared");
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Function to build the retention policy of the data log and rollup tiers
+static void get_retention_config(RetentionConfig* config) {
+    static const RetentionTierConfig tiers[] = {
+        // prefix            max age           max size      compact min / target
+        { "sensor_data",     7 * 86400,        512 * 1024,   4 * 1024,  LOG_SEGMENT_MAX_KB },
+        { "sensor_data_1s",  30 * 86400,       1024 * 1024,  4 * 1024,  LOG_SEGMENT_MAX_KB },
+        { "sensor_data_1m",  2 * 365 * 86400,  0,            1024,      16 * 1024 },
+        { "sensor_data_1h",  0,                0,            1024,      16 * 1024 }
+    };
+
+    memset(config, 0, sizeof(RetentionConfig));
+    strncpy(config->directory, DATA_DIR, sizeof(config->directory) - 1);
+    config->tier_count = sizeof(tiers) / sizeof(tiers[0]);
+    memcpy(config->tiers, tiers, sizeof(tiers));
+    config->interval_s = RETENTION_INTERVAL_S;
 }
 
 // Function to print sensor statistics
@@ -60,14 +189,84 @@ static void print_sensor_stats(const Sensor* sensor) {
     temperature_sensor_get_stats(sensor, &stats);
     
     printf("\nSensor Statistics:\n");
+
+    CachedValue current;
+    if (value_cache_get(sensor->id, (uint32_t)time(NULL), CURRENT_VALUE_MAX_AGE_S, &current)) {
+        printf("  Current: %.2f°C (%s, %u s old, #%u)\n", current.value,
+               value_cache_quality_to_string(current.quality), current.age_s, current.sequence);
+    }
+    KalmanEstimate filtered;
+    if (kalman_get_estimate(sensor->id, &filtered)) {
+        printf("  Filtered: %.2f ± %.2f°C (%+.3f°C/min)\n", filtered.value, filtered.std_deviation,
+               filtered.slope * 60.0f);
+    }
     printf("  Samples: %u\n", stats.sample_count);
+    CompressionStatus compression;
+    if (compression_get_status(sensor->id, &compression) && compression.forwarded > 0) {
+        printf("  Stored: %u of %u samples (%.1fx)\n", compression.forwarded, compression.samples,
+               (float)compression.samples / (float)compression.forwarded);
+    }
     printf("  Min Value: %.2f°C\n", stats.min_value);
     printf("  Max Value: %.2f°C\n", stats.max_value);
     printf("  Average: %.2f°C\n", stats.avg_value);
+    printf("  Std Deviation: %.2f°C\n", stats.std_deviation);
+
+    TemperatureQuantiles quantiles;
+    temperature_sensor_get_quantiles(sensor, &quantiles);
+    printf("  P50 / P95 / P99: %.2f / %.2f / %.2f°C\n", quantiles.p50, quantiles.p95, quantiles.p99);
     printf("  Alerts: %u\n", stats.alert_count);
     printf("  Critical: %u\n", stats.critical_count);
-    printf("  Error Rate: %.2f%%\n", 
-           stats.sample_count > 0 ? (float)stats.critical_count / stats.sample_count * 100.0f : 0.0f);
+    AlertStatus alert;
+    if (alert_get_status(sensor->id, &alert) && alert.samples > 0) {
+        printf("  Critical Samples: %.2f%%\n", (float)alert.critical_samples / alert.samples * 100.0f);
+    }
+
+    AnomalyStatus anomaly;
+    if (anomaly_get_status(sensor->id, &anomaly)) {
+        printf("  Anomalies: %u (last z %.2f, robust z %.2f)\n", anomaly.anomaly_count,
+               anomaly.last_score.z_score, anomaly.last_score.robust_z);
+    }
+
+    TrendStatus trend;
+    if (trend_get_status(sensor->id, &trend) && trend.valid) {
+        char alert_time[32];
+        char critical_time[32];
+        printf("  Trend: %+.3f°C/min, alert %s, critical %s\n", trend.slope_per_s * 60.0f,
+               format_time_to(trend.time_to_alert_s, alert_time, sizeof(alert_time)),
+               format_time_to(trend.time_to_critical_s, critical_time, sizeof(critical_time)));
+    }
+
+    ChangepointStatus changepoint;
+    if (changepoint_get_status(sensor->id, &changepoint) && changepoint.change_count > 0) {
+        printf("  Level Changes: %u (last %+.1f sigma from %.2f°C, %s)\n", changepoint.change_count,
+               changepoint.last_change.shift, changepoint.last_change.reference,
+               changepoint_method_to_string(changepoint.last_change.method));
+    }
+
+    ForecastStatus forecast;
+    if (forecast_get_status(sensor->id, &forecast) && forecast.ready) {
+        printf("  Forecast: %.2f°C (residual σ %.2f, %u deviations)\n", forecast.last_score.forecast,
+               forecast.residual_std, forecast.deviation_count);
+    }
+
+    OperatingStateStatus operating_state;
+    if (operating_state_get(sensor->id, &operating_state) && operating_state.state >= 0) {
+        printf("  Operating State: %d of %u at %s (%u windows, %u changes)\n", operating_state.state,
+               operating_state.states, operating_state.group, operating_state.windows,
+               operating_state.changes);
+    }
+
+    WindowStatsConfig window_config;
+    window_stats_get_default_config(&window_config);
+    uint32_t now = (uint32_t)time(NULL);
+    for (uint32_t i = 0; i < window_config.window_count; i++) {
+        SlidingWindowStats window;
+        if (window_stats_get(sensor->id, i, now, &window) && window.count > 0) {
+            printf("  Last %4u s: avg %.2f°C, std %.2f°C, min %.2f°C, max %.2f°C\n",
+                   window_config.widths_s[i], window.mean, window.std_deviation,
+                   window.min_value, window.max_value);
+        }
+    }
 }
 
 int main() {
@@ -78,16 +277,37 @@ int main() {
     signal(SIGINT, handle_signal);
     signal(SIGTERM, handle_signal);
 
-    // Open log file
-    FILE* log_file = fopen(LOG_FILE, "w");
-    if (!log_file) {
-        printf("Error: Could not open log file %s\n", LOG_FILE);
+    // Open segmented data log
+    SegmentWriter log_writer;
+    if (!segment_writer_open(&log_writer, DATA_DIR, LOG_PREFIX,
+                             "Timestamp,Sensor ID,Sensor Type,Value,Unit,Valid,Error",
+                             LOG_SEGMENT_SPAN_S, LOG_SEGMENT_MAX_KB)) {
+        printf("Error: Could not open data log in %s\n", DATA_DIR);
         return 1;
     }
-    
-    // Write CSV header
-    fprintf(log_file, "Timestamp,Sensor ID,Sensor Type,Value,Unit,Valid,Error\n");
-    fflush(log_file);
+
+    // Open the multiplexed per-sensor chunk log
+    int exit_code = 1;
+    ChunkLogConfig chunk_config;
+    chunk_log_get_default_config(&chunk_config);
+    if (!chunk_log_init(&chunk_config)) {
+        printf("Error: Could not open chunk log %s\n", chunk_config.data_file);
+        goto close_data_log;
+    }
+
+    // Initialize 1s/1m/1h rollup tiers next to the raw data log
+    if (!rollup_init(NULL)) {
+        printf("Error: Could not initialize rollup tiers\n");
+        goto cleanup_chunk_log;
+    }
+
+    // Start background retention and compaction of all tiers
+    RetentionConfig retention_config;
+    get_retention_config(&retention_config);
+    if (!retention_init(&retention_config)) {
+        printf("Error: Could not start retention\n");
+        goto cleanup_rollup;
+    }
 
     // Initialize temperature sensor configuration
     TemperatureConfig temp_config = {
@@ -107,8 +327,36 @@ int main() {
     if (!temperature_sensor_init(&temp_sensor, "TEMP001", &temp_config)) {
         printf("Failed to initialize temperature sensor: %s\n", 
                sensor_error_to_string(temp_sensor.last_error));
-        fclose(log_file);
-        return 1;
+        goto cleanup_retention;
+    }
+    if (!write_sensor_locations(&temp_sensor, 1)) {
+        printf("Warning: Could not write sensor locations to %s\n", LOCATIONS_FILE);
+    }
+
+    // Report-by-exception compression in front of the data log and the chunk log
+    if (!compression_init(NULL)) {
+        printf("Error: Could not initialize compression\n");
+        goto cleanup_sensor;
+    }
+
+    // Storage sinks, then the analytics shared with replay, in the order every sample
+    // visits them; rollups aggregate every sample while the logs keep the compressed points
+    if (!pipeline_register_stage("rollup", rollup_stage, NULL) ||
+        !pipeline_register_stage("compression", compression_stage, &log_writer)) {
+        printf("Error: Could not register the storage stages\n");
+        pipeline_clear();
+        goto cleanup_compression;
+    }
+
+    // Analytics, with the alert states raised on the temperature thresholds
+    PipelineStagesConfig stages_config;
+    pipeline_stages_get_default_config(&stages_config);
+    stages_config.alert.alert_threshold = temp_config.alert_threshold;
+    stages_config.alert.critical_threshold = temp_config.critical_threshold;
+    if (!pipeline_register_default_stages(&stages_config)) {
+        printf("Error: Could not initialize the analytics stages\n");
+        pipeline_clear();
+        goto cleanup_compression;
     }
 
     printf("Temperature sensor initialized successfully\n");
@@ -125,8 +373,17 @@ int main() {
 
     // Main monitoring loop
     uint32_t sample_count = 0;
+    uint32_t log_segment = (uint32_t)time(NULL) / LOG_SEGMENT_SPAN_S;
     while (running) {
         SensorData sensor_data;
+
+        // Release the samples compression holds back before the data log moves on to the
+        // next segment, so that they are stored in the segment covering their time
+        uint32_t segment = (uint32_t)time(NULL) / LOG_SEGMENT_SPAN_S;
+        if (segment != log_segment) {
+            compression_flush(store_sample, &log_writer);
+            log_segment = segment;
+        }
         
         // Read sensor data
         if (temperature_sensor_read(&temp_sensor, &sensor_data)) {
@@ -140,8 +397,9 @@ int main() {
             }
             printf("\n");
             
-            // Log data to file
-            log_sensor_data(&temp_sensor, &sensor_data, log_file);
+            // Hand the sample to the processing pipeline
+            pipeline_process(&temp_sensor, &sensor_data);
+            print_events();
             
             // Print statistics every 100 samples
             sample_count++;
@@ -153,6 +411,12 @@ int main() {
                    sensor_error_to_string(temp_sensor.last_error));
         }
 
+        // Write out the chunks and close the rollup buckets of sensors that have gone
+        // quiet, compression holding back a steady signal included
+        uint32_t now = (uint32_t)time(NULL);
+        chunk_log_flush(now);
+        rollup_flush(now);
+
         // Wait for next sample
         sleep(SAMPLE_INTERVAL_SECONDS);
     }
@@ -162,10 +426,28 @@ int main() {
     // Print final statistics
     print_sensor_stats(&temp_sensor);
     
-    // Cleanup
+    // Store the samples still held back by compression
+    compression_flush(store_sample, &log_writer);
+    exit_code = 0;
+
+    // Release everything in reverse order of initialization; a failed step above
+    // enters the chain just below the last component it brought up
+    pipeline_cleanup_default_stages();
+cleanup_compression:
+    compression_cleanup();
+cleanup_sensor:
     temperature_sensor_cleanup(&temp_sensor);
-    fclose(log_file);
+cleanup_retention:
+    retention_cleanup();
+cleanup_rollup:
+    rollup_cleanup();
+cleanup_chunk_log:
+    chunk_log_cleanup();
+close_data_log:
+    segment_writer_close(&log_writer);
     
-    printf("Done by ELYES\n");
-    return 0;
+    if (exit_code == 0) {
+        printf("Done by ELYES\n");
+    }
+    return exit_code;
 } 
\ No newline at end of file
@@ -0,0 +1,829 @@
+/**
+ * @file matrix_profile.c
+ * @brief Matrix profile motif and discord search for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * For subsequences i and j of length m with means mu, the covariance
+ *   c(i, j) = sum_t (T[i+t] - mu[i]) (T[j+t] - mu[j])
+ * steps along a diagonal as
+ *   c(i+1, j+1) = c(i, j) + df[i+1] dg[j+1] + df[j+1] dg[i+1]
+ * with df[i] = (T[i+m-1] - T[i-1]) / 2 and dg[i] = (T[i+m-1] - mu[i]) + (T[i-1] - mu[i-1]).
+ * The profile keeps the best Pearson correlation r = c / (|i| |j|) of each subsequence;
+ * its distance is sqrt(2 m (1 - r)). Covariances are accumulated in double precision.
+ */
+
+#include "../include/matrix_profile.h"
+#include "../include/chunk_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MATRIX_PROFILE_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define MATRIX_PROFILE_NEON 1
+#endif
+
+// Steps the full rows [first, end) of a band of diagonals
+typedef void (*BandRows)(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                         double* covariance, float* correlation, int32_t* neighbor);
+
+// Worker of one computation
+typedef struct {
+    MatrixProfile* profile;
+    atomic_uint* next;
+    BandRows rows;
+    struct timespec deadline;
+    bool has_deadline;
+    float* correlation;
+    int32_t* neighbor;
+    pthread_t thread;
+    bool started;
+} MatrixProfileWorker;
+
+// Forward declarations of private functions
+static bool add_point(MatrixProfile* profile, float value);
+static bool reserve(MatrixProfile* profile, uint32_t capacity);
+static void prepare_statistics(MatrixProfile* profile);
+static bool bends(const float* series, uint32_t t);
+static double direct_covariance(const MatrixProfile* profile, uint32_t a, uint32_t b);
+static void update_pair(float* correlation, int32_t* neighbor, uint32_t i, uint32_t j, double r);
+static void compute_band(MatrixProfile* profile, uint32_t k0, BandRows rows, float* correlation, int32_t* neighbor);
+static void store_band(float* correlation, int32_t* neighbor, uint32_t i, uint32_t j, const float* values);
+static BandRows select_band_rows(void);
+#if defined(MATRIX_PROFILE_X86)
+static void band_rows_sse2(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                           double* covariance, float* correlation, int32_t* neighbor);
+static void band_rows_avx2(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                           double* covariance, float* correlation, int32_t* neighbor);
+#elif defined(MATRIX_PROFILE_NEON)
+static void band_rows_neon(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                           double* covariance, float* correlation, int32_t* neighbor);
+#else
+static void band_rows_scalar(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                             double* covariance, float* correlation, int32_t* neighbor);
+#endif
+static void* worker_run(void* arg);
+static bool deadline_passed(const MatrixProfileWorker* worker);
+static void start_computation(MatrixProfile* profile, uint32_t subsequences);
+static void extend_row(MatrixProfile* profile, uint32_t i);
+static bool load_chunk(const char* sensor_id, SensorType type, const uint32_t* timestamps,
+                       const float* values, uint32_t count, void* context);
+static uint32_t find_matches(const MatrixProfile* profile, MatrixProfileMatch* matches,
+                             uint32_t capacity, bool discords);
+
+bool matrix_profile_init(MatrixProfile* profile, const MatrixProfileConfig* config) {
+    MatrixProfileConfig defaults;
+    if (!config) {
+        matrix_profile_get_default_config(&defaults);
+        config = &defaults;
+    }
+    if (!profile || config->window < 4 || config->period_s == 0 || config->time_budget_s < 0.0f ||
+        config->threads > MATRIX_PROFILE_MAX_THREADS) {
+        return false;
+    }
+
+    memset(profile, 0, sizeof(MatrixProfile));
+    memcpy(&profile->config, config, sizeof(MatrixProfileConfig));
+    if (profile->config.exclusion == 0) {
+        profile->config.exclusion = config->window / 4;
+    }
+    if (profile->config.threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        profile->config.threads = cpus < 1 ? 1 : (cpus > MATRIX_PROFILE_MAX_THREADS ? MATRIX_PROFILE_MAX_THREADS : (uint32_t)cpus);
+    }
+    if (profile->config.seed == 0) {
+        profile->config.seed = 1;
+    }
+    return true;
+}
+
+void matrix_profile_free(MatrixProfile* profile) {
+    if (!profile) {
+        return;
+    }
+
+    free(profile->series);
+    free(profile->mean);
+    free(profile->inv_norm);
+    free(profile->df);
+    free(profile->dg);
+    free(profile->correlation);
+    free(profile->neighbor);
+    free(profile->last_row);
+    free(profile->band_order);
+    memset(profile, 0, sizeof(MatrixProfile));
+}
+
+bool matrix_profile_append(MatrixProfile* profile, uint32_t timestamp, float value) {
+    if (!profile || !isfinite(value)) {
+        return false;
+    }
+
+    if (profile->length == 0) {
+        profile->start_timestamp = timestamp;
+        profile->last_timestamp = timestamp;
+        profile->last_value = value;
+        return add_point(profile, value);
+    }
+    if (timestamp <= profile->last_timestamp) {
+        return true;
+    }
+
+    // Interpolate the grid points up to this sample
+    uint64_t grid = (uint64_t)profile->start_timestamp + (uint64_t)profile->length * profile->config.period_s;
+    float span = (float)(timestamp - profile->last_timestamp);
+    for (; grid <= timestamp; grid += profile->config.period_s) {
+        float fraction = (float)(grid - profile->last_timestamp) / span;
+        if (!add_point(profile, profile->last_value + (value - profile->last_value) * fraction)) {
+            return false;
+        }
+    }
+    profile->last_timestamp = timestamp;
+    profile->last_value = value;
+    return true;
+}
+
+bool matrix_profile_load(MatrixProfile* profile, const char* sensor_id, uint32_t from, uint32_t to) {
+    if (!profile || !sensor_id) {
+        return false;
+    }
+
+    return chunk_log_query(sensor_id, from, to, load_chunk, profile);
+}
+
+float matrix_profile_compute(MatrixProfile* profile) {
+    if (!profile) {
+        return -1.0f;
+    }
+
+    uint32_t subsequences = matrix_profile_subsequences(profile);
+    prepare_statistics(profile);
+    if (profile->covered != subsequences) {
+        start_computation(profile, subsequences);
+        if (profile->covered != subsequences) {
+            return -1.0f;
+        }
+    }
+    if (profile->bands_done >= profile->bands) {
+        return 1.0f;
+    }
+
+    // Worker 0 runs in the calling thread on the profile itself; the others get their own
+    // profile arrays, merged once they are done
+    atomic_uint next;
+    atomic_init(&next, profile->bands_done);
+    MatrixProfileWorker workers[MATRIX_PROFILE_MAX_THREADS];
+    uint32_t worker_count = profile->config.threads;
+    if (worker_count > profile->bands - profile->bands_done) {
+        worker_count = profile->bands - profile->bands_done;
+    }
+
+    BandRows rows = select_band_rows();
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double budget = profile->config.time_budget_s;
+    struct timespec deadline = now;
+    deadline.tv_sec += (time_t)budget;
+    deadline.tv_nsec += (long)((budget - floor(budget)) * 1e9);
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    for (uint32_t w = 0; w < worker_count; w++) {
+        MatrixProfileWorker* worker = &workers[w];
+        memset(worker, 0, sizeof(MatrixProfileWorker));
+        worker->profile = profile;
+        worker->next = &next;
+        worker->deadline = deadline;
+        worker->has_deadline = budget > 0.0;
+        worker->rows = rows;
+        if (w == 0) {
+            worker->correlation = profile->correlation;
+            worker->neighbor = profile->neighbor;
+            continue;
+        }
+
+        worker->correlation = (float*)malloc(subsequences * sizeof(float));
+        worker->neighbor = (int32_t*)malloc(subsequences * sizeof(int32_t));
+        if (!worker->correlation || !worker->neighbor) {
+            free(worker->correlation);
+            free(worker->neighbor);
+            worker_count = w;
+            break;
+        }
+        for (uint32_t i = 0; i < subsequences; i++) {
+            worker->correlation[i] = -INFINITY;
+            worker->neighbor[i] = -1;
+        }
+        worker->started = pthread_create(&worker->thread, NULL, worker_run, worker) == 0;
+    }
+
+    worker_run(&workers[0]);
+
+    for (uint32_t w = 1; w < worker_count; w++) {
+        MatrixProfileWorker* worker = &workers[w];
+        if (worker->started) {
+            pthread_join(worker->thread, NULL);
+        }
+        for (uint32_t i = 0; i < subsequences; i++) {
+            if (worker->correlation[i] > profile->correlation[i]) {
+                profile->correlation[i] = worker->correlation[i];
+                profile->neighbor[i] = worker->neighbor[i];
+            }
+        }
+        free(worker->correlation);
+        free(worker->neighbor);
+    }
+
+    // Every band taken from the counter was finished
+    uint32_t taken = atomic_load(&next);
+    profile->bands_done = taken < profile->bands ? taken : profile->bands;
+    if (profile->profiled == subsequences) {
+        // Otherwise matrix_profile_update() keeps the latest row
+        profile->last_row_valid = profile->bands_done == profile->bands;
+    }
+    return (float)profile->bands_done / (float)profile->bands;
+}
+
+bool matrix_profile_update(MatrixProfile* profile, uint32_t timestamp, float value) {
+    if (!profile) {
+        return false;
+    }
+
+    uint32_t before = matrix_profile_subsequences(profile);
+    bool last_row_valid = profile->last_row_valid;
+    if (!matrix_profile_append(profile, timestamp, value)) {
+        return false;
+    }
+    profile->last_row_valid = last_row_valid;
+
+    uint32_t after = matrix_profile_subsequences(profile);
+    prepare_statistics(profile);
+    for (uint32_t i = before; i < after; i++) {
+        extend_row(profile, i);
+
+        // A complete profile stays complete, and an incomplete computation can continue
+        if (profile->covered == i) {
+            profile->covered = i + 1;
+        }
+    }
+    return true;
+}
+
+uint32_t matrix_profile_subsequences(const MatrixProfile* profile) {
+    if (!profile || profile->length < profile->config.window) {
+        return 0;
+    }
+    return profile->length - profile->config.window + 1;
+}
+
+bool matrix_profile_get(const MatrixProfile* profile, uint32_t index, MatrixProfileMatch* match) {
+    if (!profile || !match || index >= matrix_profile_subsequences(profile) || profile->neighbor[index] < 0 ||
+        profile->inv_norm[index] == 0.0) {
+        return false;
+    }
+
+    double r = profile->correlation[index] < 1.0f ? profile->correlation[index] : 1.0;
+    match->index = index;
+    match->neighbor = (uint32_t)profile->neighbor[index];
+    match->timestamp = profile->start_timestamp + index * profile->config.period_s;
+    match->neighbor_timestamp = profile->start_timestamp + match->neighbor * profile->config.period_s;
+    match->distance = (float)sqrt(2.0 * profile->config.window * (1.0 - r));
+    return true;
+}
+
+uint32_t matrix_profile_motifs(const MatrixProfile* profile, MatrixProfileMatch* matches, uint32_t capacity) {
+    return find_matches(profile, matches, capacity, false);
+}
+
+uint32_t matrix_profile_discords(const MatrixProfile* profile, MatrixProfileMatch* matches, uint32_t capacity) {
+    return find_matches(profile, matches, capacity, true);
+}
+
+void matrix_profile_get_default_config(MatrixProfileConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->window = 3600;
+    config->exclusion = 0;
+    config->period_s = 1;
+    config->threads = 0;
+    config->time_budget_s = 0.0f;
+    config->seed = 1;
+}
+
+// Private helper functions
+static bool add_point(MatrixProfile* profile, float value) {
+    if (profile->length == profile->capacity) {
+        if (profile->capacity > UINT32_MAX / 2 ||
+            !reserve(profile, profile->capacity ? profile->capacity * 2 : 4096)) {
+            return false;
+        }
+    }
+
+    profile->series[profile->length++] = value;
+    profile->last_row_valid = false;
+    return true;
+}
+
+static bool reserve(MatrixProfile* profile, uint32_t capacity) {
+    // Arrays grown before a failure keep their larger size, which is harmless
+    float* series = (float*)realloc(profile->series, capacity * sizeof(float));
+    if (!series) {
+        return false;
+    }
+    profile->series = series;
+
+    double** doubles[] = { &profile->mean, &profile->inv_norm, &profile->df, &profile->dg, &profile->last_row };
+    for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+        double* grown = (double*)realloc(*doubles[i], capacity * sizeof(double));
+        if (!grown) {
+            return false;
+        }
+        *doubles[i] = grown;
+    }
+
+    float* correlation = (float*)realloc(profile->correlation, capacity * sizeof(float));
+    if (!correlation) {
+        return false;
+    }
+    profile->correlation = correlation;
+    int32_t* neighbor = (int32_t*)realloc(profile->neighbor, capacity * sizeof(int32_t));
+    if (!neighbor) {
+        return false;
+    }
+    profile->neighbor = neighbor;
+
+    profile->capacity = capacity;
+    return true;
+}
+
+static void prepare_statistics(MatrixProfile* profile) {
+    uint32_t m = profile->config.window;
+    uint32_t subsequences = matrix_profile_subsequences(profile);
+    const float* series = profile->series;
+    double m2 = 0.0;
+    uint32_t bend = 0;
+
+    for (uint32_t i = profile->prepared; i < subsequences; i++) {
+        // Latest point inside the subsequence where the series is not a straight line
+        if (i == profile->prepared) {
+            bend = i;
+            for (uint32_t t = i + 1; t + 1 < i + m; t++) {
+                if (bends(series, t)) {
+                    bend = t;
+                }
+            }
+        } else if (bends(series, i + m - 2)) {
+            bend = i + m - 2;
+        }
+
+        double mean;
+        if (i == profile->prepared || i % m == 0) {
+            // Exact at the start and once per window, so rounding cannot build up
+            double sum = 0.0;
+            for (uint32_t t = 0; t < m; t++) {
+                sum += series[i + t];
+            }
+            mean = sum / m;
+            m2 = 0.0;
+            for (uint32_t t = 0; t < m; t++) {
+                double deviation = series[i + t] - mean;
+                m2 += deviation * deviation;
+            }
+        } else {
+            // Sliding Welford update
+            double entering = series[i + m - 1];
+            double leaving = series[i - 1];
+            mean = profile->mean[i - 1] + (entering - leaving) / m;
+            m2 += (entering - leaving) * (entering - mean + leaving - profile->mean[i - 1]);
+        }
+
+        // A flat or straight subsequence has no shape to match: any two straight ones
+        // correlate exactly, which interpolation across a compressed stretch produces
+        profile->mean[i] = mean;
+        profile->inv_norm[i] = m2 > 1e-12 * m * (mean * mean + 1.0) && bend > i ? 1.0 / sqrt(m2) : 0.0;
+        if (i == 0) {
+            profile->df[i] = 0.0;
+            profile->dg[i] = 0.0;
+        } else {
+            profile->df[i] = ((double)series[i + m - 1] - series[i - 1]) / 2.0;
+            profile->dg[i] = (series[i + m - 1] - mean) + (series[i - 1] - profile->mean[i - 1]);
+        }
+    }
+
+    if (subsequences > profile->prepared) {
+        profile->prepared = subsequences;
+    }
+}
+
+static bool bends(const float* series, uint32_t t) {
+    // Interpolated grid points are straight to within a few rounding steps of a float
+    double a = series[t - 1], b = series[t], c = series[t + 1];
+    return fabs(a - 2.0 * b + c) > 1e-6 * (fabs(a) + fabs(b) + fabs(c));
+}
+
+static double direct_covariance(const MatrixProfile* profile, uint32_t a, uint32_t b) {
+    const float* series = profile->series;
+    double mean_a = profile->mean[a];
+    double mean_b = profile->mean[b];
+    double sum = 0.0;
+    for (uint32_t t = 0; t < profile->config.window; t++) {
+        sum += (series[a + t] - mean_a) * (series[b + t] - mean_b);
+    }
+    return sum;
+}
+
+static void update_pair(float* correlation, int32_t* neighbor, uint32_t i, uint32_t j, double r) {
+    float value = (float)r;
+    if (value > correlation[i]) {
+        correlation[i] = value;
+        neighbor[i] = (int32_t)j;
+    }
+    if (value > correlation[j]) {
+        correlation[j] = value;
+        neighbor[j] = (int32_t)i;
+    }
+}
+
+static void compute_band(MatrixProfile* profile, uint32_t k0, BandRows rows, float* correlation, int32_t* neighbor) {
+    // Subsequences added by matrix_profile_update() since the computation started have their rows already
+    uint32_t subsequences = profile->profiled;
+    bool latest = subsequences == matrix_profile_subsequences(profile);
+    uint32_t lanes = subsequences - k0 < MATRIX_PROFILE_BAND ? subsequences - k0 : MATRIX_PROFILE_BAND;
+    const double* df = profile->df;
+    const double* dg = profile->dg;
+    const double* inv_norm = profile->inv_norm;
+    double covariance[MATRIX_PROFILE_BAND] = { 0.0 };
+
+    // Row 0 starts every diagonal directly
+    for (uint32_t b = 0; b < lanes; b++) {
+        covariance[b] = direct_covariance(profile, 0, k0 + b);
+        update_pair(correlation, neighbor, 0, k0 + b, covariance[b] * inv_norm[0] * inv_norm[k0 + b]);
+    }
+
+    // Rows where every diagonal of a full band is still inside the matrix
+    uint32_t i = 1;
+    if (lanes == MATRIX_PROFILE_BAND) {
+        i = subsequences - (k0 + MATRIX_PROFILE_BAND - 1);
+        rows(profile, k0, 1, i, covariance, correlation, neighbor);
+    }
+
+    // The remaining rows of each diagonal, which end one after another
+    for (uint32_t b = 0; b < lanes; b++) {
+        uint32_t k = k0 + b;
+        for (uint32_t row = i; row + k < subsequences; row++) {
+            covariance[b] += df[row] * dg[row + k] + df[row + k] * dg[row];
+            update_pair(correlation, neighbor, row, row + k, covariance[b] * inv_norm[row] * inv_norm[row + k]);
+        }
+
+        // The last cell of diagonal k pairs the latest subsequence with subsequence n - 1 - k
+        if (latest) {
+            profile->last_row[subsequences - 1 - k] = covariance[b];
+        }
+    }
+}
+
+static void store_band(float* correlation, int32_t* neighbor, uint32_t i, uint32_t j, const float* values) {
+    for (uint32_t b = 0; b < MATRIX_PROFILE_BAND; b++) {
+        if (values[b] > correlation[j + b]) {
+            correlation[j + b] = values[b];
+            neighbor[j + b] = (int32_t)i;
+        }
+        if (values[b] > correlation[i]) {
+            correlation[i] = values[b];
+            neighbor[i] = (int32_t)(j + b);
+        }
+    }
+}
+
+static BandRows select_band_rows(void) {
+#if defined(MATRIX_PROFILE_X86)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? band_rows_avx2 : band_rows_sse2;
+#elif defined(MATRIX_PROFILE_NEON)
+    return band_rows_neon;
+#else
+    return band_rows_scalar;
+#endif
+}
+
+#if defined(MATRIX_PROFILE_X86)
+__attribute__((target("sse2")))
+static void band_rows_sse2(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                           double* covariance, float* correlation, int32_t* neighbor) {
+    const double* df = profile->df;
+    const double* dg = profile->dg;
+    const double* inv_norm = profile->inv_norm;
+    __m128d c0 = _mm_loadu_pd(&covariance[0]);
+    __m128d c1 = _mm_loadu_pd(&covariance[2]);
+    __m128d c2 = _mm_loadu_pd(&covariance[4]);
+    __m128d c3 = _mm_loadu_pd(&covariance[6]);
+
+    for (uint32_t i = first; i < end; i++) {
+        uint32_t j = i + k0;
+        __m128d df_i = _mm_set1_pd(df[i]);
+        __m128d dg_i = _mm_set1_pd(dg[i]);
+        __m128d norm_i = _mm_set1_pd(inv_norm[i]);
+        c0 = _mm_add_pd(c0, _mm_add_pd(_mm_mul_pd(df_i, _mm_loadu_pd(&dg[j])), _mm_mul_pd(_mm_loadu_pd(&df[j]), dg_i)));
+        c1 = _mm_add_pd(c1, _mm_add_pd(_mm_mul_pd(df_i, _mm_loadu_pd(&dg[j + 2])), _mm_mul_pd(_mm_loadu_pd(&df[j + 2]), dg_i)));
+        c2 = _mm_add_pd(c2, _mm_add_pd(_mm_mul_pd(df_i, _mm_loadu_pd(&dg[j + 4])), _mm_mul_pd(_mm_loadu_pd(&df[j + 4]), dg_i)));
+        c3 = _mm_add_pd(c3, _mm_add_pd(_mm_mul_pd(df_i, _mm_loadu_pd(&dg[j + 6])), _mm_mul_pd(_mm_loadu_pd(&df[j + 6]), dg_i)));
+        __m128d r0 = _mm_mul_pd(_mm_mul_pd(c0, norm_i), _mm_loadu_pd(&inv_norm[j]));
+        __m128d r1 = _mm_mul_pd(_mm_mul_pd(c1, norm_i), _mm_loadu_pd(&inv_norm[j + 2]));
+        __m128d r2 = _mm_mul_pd(_mm_mul_pd(c2, norm_i), _mm_loadu_pd(&inv_norm[j + 4]));
+        __m128d r3 = _mm_mul_pd(_mm_mul_pd(c3, norm_i), _mm_loadu_pd(&inv_norm[j + 6]));
+
+        // One compare per four columns and one for the row; stores only where a match improves
+        __m128 low = _mm_movelh_ps(_mm_cvtpd_ps(r0), _mm_cvtpd_ps(r1));
+        __m128 high = _mm_movelh_ps(_mm_cvtpd_ps(r2), _mm_cvtpd_ps(r3));
+        __m128 best = _mm_max_ps(low, high);
+        best = _mm_max_ps(best, _mm_movehl_ps(best, best));
+        best = _mm_max_ss(best, _mm_shuffle_ps(best, best, _MM_SHUFFLE(1, 1, 1, 1)));
+        if (_mm_movemask_ps(_mm_or_ps(_mm_cmpgt_ps(low, _mm_loadu_ps(&correlation[j])),
+                                      _mm_cmpgt_ps(high, _mm_loadu_ps(&correlation[j + 4])))) != 0 ||
+            _mm_cvtss_f32(best) > correlation[i]) {
+            float values[MATRIX_PROFILE_BAND];
+            _mm_storeu_ps(&values[0], low);
+            _mm_storeu_ps(&values[4], high);
+            store_band(correlation, neighbor, i, j, values);
+        }
+    }
+
+    _mm_storeu_pd(&covariance[0], c0);
+    _mm_storeu_pd(&covariance[2], c1);
+    _mm_storeu_pd(&covariance[4], c2);
+    _mm_storeu_pd(&covariance[6], c3);
+}
+
+__attribute__((target("avx2")))
+static void band_rows_avx2(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                           double* covariance, float* correlation, int32_t* neighbor) {
+    const double* df = profile->df;
+    const double* dg = profile->dg;
+    const double* inv_norm = profile->inv_norm;
+    __m256d c0 = _mm256_loadu_pd(&covariance[0]);
+    __m256d c1 = _mm256_loadu_pd(&covariance[4]);
+
+    for (uint32_t i = first; i < end; i++) {
+        uint32_t j = i + k0;
+        __m256d df_i = _mm256_set1_pd(df[i]);
+        __m256d dg_i = _mm256_set1_pd(dg[i]);
+        __m256d norm_i = _mm256_set1_pd(inv_norm[i]);
+        c0 = _mm256_add_pd(c0, _mm256_add_pd(_mm256_mul_pd(df_i, _mm256_loadu_pd(&dg[j])),
+                                             _mm256_mul_pd(_mm256_loadu_pd(&df[j]), dg_i)));
+        c1 = _mm256_add_pd(c1, _mm256_add_pd(_mm256_mul_pd(df_i, _mm256_loadu_pd(&dg[j + 4])),
+                                             _mm256_mul_pd(_mm256_loadu_pd(&df[j + 4]), dg_i)));
+        __m256d r0 = _mm256_mul_pd(_mm256_mul_pd(c0, norm_i), _mm256_loadu_pd(&inv_norm[j]));
+        __m256d r1 = _mm256_mul_pd(_mm256_mul_pd(c1, norm_i), _mm256_loadu_pd(&inv_norm[j + 4]));
+
+        __m256 values = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(r0)), _mm256_cvtpd_ps(r1), 1);
+        __m128 best = _mm_max_ps(_mm256_castps256_ps128(values), _mm256_extractf128_ps(values, 1));
+        best = _mm_max_ps(best, _mm_movehl_ps(best, best));
+        best = _mm_max_ss(best, _mm_shuffle_ps(best, best, _MM_SHUFFLE(1, 1, 1, 1)));
+        if (_mm256_movemask_ps(_mm256_cmp_ps(values, _mm256_loadu_ps(&correlation[j]), _CMP_GT_OQ)) != 0 ||
+            _mm_cvtss_f32(best) > correlation[i]) {
+            float stored[MATRIX_PROFILE_BAND];
+            _mm256_storeu_ps(stored, values);
+            store_band(correlation, neighbor, i, j, stored);
+        }
+    }
+
+    _mm256_storeu_pd(&covariance[0], c0);
+    _mm256_storeu_pd(&covariance[4], c1);
+}
+#elif defined(MATRIX_PROFILE_NEON)
+static void band_rows_neon(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                           double* covariance, float* correlation, int32_t* neighbor) {
+    const double* df = profile->df;
+    const double* dg = profile->dg;
+    const double* inv_norm = profile->inv_norm;
+    float64x2_t c[4];
+    for (uint32_t v = 0; v < 4; v++) {
+        c[v] = vld1q_f64(&covariance[2 * v]);
+    }
+
+    for (uint32_t i = first; i < end; i++) {
+        uint32_t j = i + k0;
+        float64x2_t df_i = vdupq_n_f64(df[i]);
+        float64x2_t dg_i = vdupq_n_f64(dg[i]);
+        float64x2_t norm_i = vdupq_n_f64(inv_norm[i]);
+        float64x2_t r[4];
+        for (uint32_t v = 0; v < 4; v++) {
+            float64x2_t step = vaddq_f64(vmulq_f64(df_i, vld1q_f64(&dg[j + 2 * v])),
+                                         vmulq_f64(vld1q_f64(&df[j + 2 * v]), dg_i));
+            c[v] = vaddq_f64(c[v], step);
+            r[v] = vmulq_f64(vmulq_f64(c[v], norm_i), vld1q_f64(&inv_norm[j + 2 * v]));
+        }
+
+        float32x4_t low = vcombine_f32(vcvt_f32_f64(r[0]), vcvt_f32_f64(r[1]));
+        float32x4_t high = vcombine_f32(vcvt_f32_f64(r[2]), vcvt_f32_f64(r[3]));
+        uint32x4_t better = vorrq_u32(vcgtq_f32(low, vld1q_f32(&correlation[j])),
+                                      vcgtq_f32(high, vld1q_f32(&correlation[j + 4])));
+        if (vmaxvq_u32(better) != 0 || vmaxvq_f32(vmaxq_f32(low, high)) > correlation[i]) {
+            float values[MATRIX_PROFILE_BAND];
+            vst1q_f32(&values[0], low);
+            vst1q_f32(&values[4], high);
+            store_band(correlation, neighbor, i, j, values);
+        }
+    }
+
+    for (uint32_t v = 0; v < 4; v++) {
+        vst1q_f64(&covariance[2 * v], c[v]);
+    }
+}
+#else
+static void band_rows_scalar(const MatrixProfile* profile, uint32_t k0, uint32_t first, uint32_t end,
+                             double* covariance, float* correlation, int32_t* neighbor) {
+    const double* df = profile->df;
+    const double* dg = profile->dg;
+    const double* inv_norm = profile->inv_norm;
+    for (uint32_t i = first; i < end; i++) {
+        uint32_t j = i + k0;
+        for (uint32_t b = 0; b < MATRIX_PROFILE_BAND; b++) {
+            covariance[b] += df[i] * dg[j + b] + df[j + b] * dg[i];
+            update_pair(correlation, neighbor, i, j + b, covariance[b] * inv_norm[i] * inv_norm[j + b]);
+        }
+    }
+}
+#endif
+
+static void* worker_run(void* arg) {
+    MatrixProfileWorker* worker = (MatrixProfileWorker*)arg;
+    MatrixProfile* profile = worker->profile;
+
+    // The deadline is checked before taking a band, so every band taken is finished
+    while (!deadline_passed(worker)) {
+        uint32_t position = atomic_fetch_add(worker->next, 1);
+        if (position >= profile->bands) {
+            break;
+        }
+        uint32_t k0 = profile->config.exclusion + profile->band_order[position] * MATRIX_PROFILE_BAND;
+        compute_band(profile, k0, worker->rows, worker->correlation, worker->neighbor);
+    }
+    return NULL;
+}
+
+static bool deadline_passed(const MatrixProfileWorker* worker) {
+    if (!worker->has_deadline) {
+        return false;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec > worker->deadline.tv_sec ||
+           (now.tv_sec == worker->deadline.tv_sec && now.tv_nsec >= worker->deadline.tv_nsec);
+}
+
+static void start_computation(MatrixProfile* profile, uint32_t subsequences) {
+    uint32_t exclusion = profile->config.exclusion;
+    uint32_t bands = subsequences > exclusion ?
+                     (subsequences - exclusion + MATRIX_PROFILE_BAND - 1) / MATRIX_PROFILE_BAND : 0;
+
+    for (uint32_t i = 0; i < subsequences; i++) {
+        profile->correlation[i] = -INFINITY;
+        profile->neighbor[i] = -1;
+    }
+    profile->profiled = subsequences;
+    profile->covered = subsequences;
+    profile->bands_done = 0;
+    profile->bands = bands;
+    profile->last_row_valid = false;
+
+    free(profile->band_order);
+    profile->band_order = bands > 0 ? (uint32_t*)malloc(bands * sizeof(uint32_t)) : NULL;
+    if (!profile->band_order) {
+        // Nothing to compute, or retry from scratch on the next call
+        if (bands > 0) {
+            profile->profiled = 0;
+            profile->covered = 0;
+            profile->bands = 0;
+        }
+        return;
+    }
+
+    // Random band order (Fisher-Yates with xorshift32), so a stopped computation has
+    // sampled the whole matrix evenly
+    uint32_t state = profile->config.seed;
+    for (uint32_t b = 0; b < bands; b++) {
+        profile->band_order[b] = b;
+    }
+    for (uint32_t b = bands; b > 1; b--) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        uint32_t other = state % b;
+        uint32_t swap = profile->band_order[b - 1];
+        profile->band_order[b - 1] = profile->band_order[other];
+        profile->band_order[other] = swap;
+    }
+}
+
+static void extend_row(MatrixProfile* profile, uint32_t i) {
+    uint32_t exclusion = profile->config.exclusion;
+    profile->correlation[i] = -INFINITY;
+    profile->neighbor[i] = -1;
+    if (i < exclusion) {
+        profile->last_row_valid = true;
+        return;
+    }
+
+    // Row i from row i - 1, one diagonal step per entry, or directly if that is missing
+    double* row = profile->last_row;
+    uint32_t last = i - exclusion;
+    if (!profile->last_row_valid && i > exclusion && i == profile->profiled) {
+        // An interrupted computation ended the diagonals it finished in row i - 1; only
+        // those of the bands still to do are computed directly
+        for (uint32_t b = profile->bands_done; b < profile->bands; b++) {
+            uint32_t k0 = exclusion + profile->band_order[b] * MATRIX_PROFILE_BAND;
+            for (uint32_t k = k0; k < k0 + MATRIX_PROFILE_BAND && k < i; k++) {
+                row[i - 1 - k] = direct_covariance(profile, i - 1, i - 1 - k);
+            }
+        }
+        profile->last_row_valid = true;
+    }
+    if (profile->last_row_valid) {
+        for (uint32_t j = last; j > 0; j--) {
+            row[j] = row[j - 1] + profile->df[i] * profile->dg[j] + profile->df[j] * profile->dg[i];
+        }
+        row[0] = direct_covariance(profile, i, 0);
+    } else {
+        for (uint32_t j = 0; j <= last; j++) {
+            row[j] = direct_covariance(profile, i, j);
+        }
+    }
+    profile->last_row_valid = true;
+
+    double norm_i = profile->inv_norm[i];
+    for (uint32_t j = 0; j <= last; j++) {
+        update_pair(profile->correlation, profile->neighbor, i, j, row[j] * norm_i * profile->inv_norm[j]);
+    }
+}
+
+static bool load_chunk(const char* sensor_id, SensorType type, const uint32_t* timestamps,
+                       const float* values, uint32_t count, void* context) {
+    (void)sensor_id;
+    (void)type;
+    MatrixProfile* profile = (MatrixProfile*)context;
+    for (uint32_t i = 0; i < count; i++) {
+        if (isfinite(values[i]) && !matrix_profile_append(profile, timestamps[i], values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t find_matches(const MatrixProfile* profile, MatrixProfileMatch* matches,
+                             uint32_t capacity, bool discords) {
+    uint32_t subsequences = matrix_profile_subsequences(profile);
+    if (!matches || capacity == 0 || subsequences == 0) {
+        return 0;
+    }
+
+    uint8_t* taken = (uint8_t*)calloc(subsequences, 1);
+    if (!taken) {
+        return 0;
+    }
+
+    // Repeatedly take the best remaining subsequence and rule out everything that
+    // overlaps it (and, for a motif, its match)
+    uint32_t window = profile->config.window;
+    uint32_t found = 0;
+    while (found < capacity) {
+        int64_t best = -1;
+        for (uint32_t i = 0; i < subsequences; i++) {
+            int32_t match = profile->neighbor[i];
+            if (taken[i] || match < 0 || profile->inv_norm[i] == 0.0 || (!discords && taken[match])) {
+                continue;
+            }
+            if (best < 0 || (discords ? profile->correlation[i] < profile->correlation[best]
+                                      : profile->correlation[i] > profile->correlation[best])) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+
+        matrix_profile_get(profile, (uint32_t)best, &matches[found++]);
+        uint32_t centres[2] = { (uint32_t)best, (uint32_t)profile->neighbor[best] };
+        for (uint32_t c = 0; c < (discords ? 1u : 2u); c++) {
+            uint32_t from = centres[c] >= window ? centres[c] - window + 1 : 0;
+            uint32_t to = centres[c] + window < subsequences ? centres[c] + window : subsequences;
+            memset(&taken[from], 1, to - from);
+        }
+    }
+
+    free(taken);
+    return found;
+}
@@ -0,0 +1,875 @@
+/**
+ * @file operating_state.c
+ * @brief Operating state clustering for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Vectors are stored in rows of `stride` floats whose padding, like the padding weights,
+ * stays zero, so the distance and update loops run whole 4-float blocks with no tail
+ * handling. A mini-batch is first assigned to the centroids as they were before it, then
+ * each window moves its centroid by (x - c) / count, which keeps every centroid the mean
+ * of the windows it received until count reaches max_count and an exponential average
+ * afterwards.
+ *
+ * Online k-means cannot create a cluster for conditions it has not seen yet: a machine
+ * idle for the whole first batch gets three idle centroids, each fitted to a third of its
+ * noise. Centroids therefore also keep the mean squared deviation (spread) of their
+ * windows per feature, averaged like the centroid itself, and separations are measured
+ * in the standard deviations those give rather than in the running variances: k-means
+ * splits of pure noise end up about two pooled standard deviations apart on their best
+ * feature, distinct states tens.
+ *
+ * Before each update, outliers (more than OUTLIER_SEPARATION from their nearest centroid
+ * on some feature) that have similar outliers in the batch seed a new centroid at their
+ * mean, with the parent's spread as a first estimate. A lone outlier, such as the window
+ * a step change falls into, seeds nothing. The new centroid takes a free slot or replaces
+ * one that has received fewer than a batch of windows; distinct states are never merged
+ * to make room. Outliers stay out of the update, so a state without a centroid cannot
+ * drag or widen its neighbour. After the update, centroids closer than MERGE_SEPARATION
+ * on every feature are merged. Spreads have a floor of a small fraction of the running
+ * variance, so a feature that barely moves within a state does not make every window an
+ * outlier.
+ */
+
+#include "../include/operating_state.h"
+#include "../include/event_queue.h"
+#include "../include/sensor_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <pthread.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define OPERATING_STATE_SSE2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define OPERATING_STATE_NEON 1
+#endif
+
+#define GROUP_NONE -1       // Sensor has not reported yet
+#define GROUP_EXCLUDED -2   // Sensor has no group
+
+#define MERGE_SEPARATION 3.0f       // Standard deviations within which centroids are merged
+#define OUTLIER_SEPARATION 4.0f     // Standard deviations beyond which a window is an outlier
+#define SPREAD_FLOOR 0.01f          // Smallest spread, as a fraction of the running variance
+
+// Per-sensor membership
+typedef struct {
+    char id[32];
+    int32_t group_index;
+    uint32_t member;
+} StateSensor;
+
+// Window accumulators of one member, relative to its first sample in the window
+typedef struct {
+    char id[32];
+    SensorType type;
+    uint32_t count;
+    float first;
+    float last;
+    float previous_last;
+    float previous_mean;
+    double sum;
+    double sum_squares;
+} StateMember;
+
+// Sensors clustered together
+typedef struct {
+    bool used;
+    bool frozen;
+    char name[64];
+    uint32_t members;
+    StateMember member_info[OPERATING_STATE_MAX_MEMBERS];
+    uint32_t window_end;
+    uint32_t windows;
+    uint32_t learned;
+    float scale_mean[OPERATING_STATE_MAX_DIMENSIONS];
+    float scale_variance[OPERATING_STATE_MAX_DIMENSIONS];
+    MiniBatchKMeans kmeans;
+    uint8_t rank[OPERATING_STATE_MAX_CLUSTERS];
+    int32_t cluster;
+    uint32_t cluster_generation;
+    int32_t candidate;
+    uint32_t candidate_windows;
+    int32_t state;
+    float distance;
+    uint32_t changes;
+    uint32_t timestamp;
+} StateGroup;
+
+// Private data structure
+typedef struct {
+    OperatingStateConfig config;
+    StateSensor sensors[OPERATING_STATE_MAX_SENSORS];
+    StateGroup groups[OPERATING_STATE_MAX_GROUPS];
+} OperatingStatePrivate;
+
+// Forward declarations of private functions
+static float squared_distance(const float* a, const float* b, const float* weights, uint32_t stride);
+static void move_towards(float* centroid, const float* vector, float rate, uint32_t stride);
+static int32_t nearest_centroid(const MiniBatchKMeans* kmeans, const float* vector, float* distance);
+static float separation(const MiniBatchKMeans* kmeans, const float* a, const float* b,
+                        const float* spread_a, const float* spread_b);
+static bool closest_pair(const MiniBatchKMeans* kmeans, uint32_t* first, uint32_t* second, float* closest);
+static void seed_centroids(MiniBatchKMeans* kmeans);
+static void seed_outliers(MiniBatchKMeans* kmeans);
+static void update_centroids(MiniBatchKMeans* kmeans);
+static void merge_centroids(MiniBatchKMeans* kmeans);
+static void merge_pair(MiniBatchKMeans* kmeans, uint32_t first, uint32_t second);
+static uint32_t next_random(MiniBatchKMeans* kmeans);
+static bool record_sample(const Sensor* sensor, const SensorData* data);
+static void close_window(StateGroup* group);
+static void follow_cluster(StateGroup* group, int32_t cluster, float load);
+static void rank_clusters(StateGroup* group);
+static void push_state_event(const StateGroup* group, int32_t from_state, float load);
+static StateGroup* find_group(const char* name, bool create);
+static StateSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static OperatingStatePrivate* private_data = NULL;
+static pthread_mutex_t operating_state_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool kmeans_init(MiniBatchKMeans* kmeans, uint32_t dimensions, uint32_t clusters,
+                 uint32_t batch_size, uint32_t max_count) {
+    if (!kmeans || dimensions == 0 || dimensions > OPERATING_STATE_MAX_DIMENSIONS ||
+        clusters == 0 || clusters > OPERATING_STATE_MAX_CLUSTERS ||
+        batch_size < clusters || batch_size > OPERATING_STATE_MAX_BATCH || max_count == 0) {
+        return false;
+    }
+
+    memset(kmeans, 0, sizeof(MiniBatchKMeans));
+    kmeans->dimensions = dimensions;
+    kmeans->stride = (dimensions + 3) & ~3u;
+    kmeans->clusters = clusters;
+    kmeans->batch_size = batch_size;
+    kmeans->max_count = max_count;
+    kmeans->random = 2463534242u;
+    for (uint32_t d = 0; d < dimensions; d++) {
+        kmeans->weights[d] = 1.0f;
+    }
+    return true;
+}
+
+void kmeans_set_weights(MiniBatchKMeans* kmeans, const float* weights) {
+    if (!kmeans || !weights) {
+        return;
+    }
+
+    memcpy(kmeans->weights, weights, kmeans->dimensions * sizeof(float));
+}
+
+int32_t kmeans_nearest(const MiniBatchKMeans* kmeans, const float* vector, float* distance) {
+    if (!kmeans || !vector || !kmeans->seeded) {
+        return -1;
+    }
+
+    float padded[OPERATING_STATE_MAX_DIMENSIONS];
+    memcpy(padded, vector, kmeans->dimensions * sizeof(float));
+    memset(padded + kmeans->dimensions, 0, (kmeans->stride - kmeans->dimensions) * sizeof(float));
+
+    float squared;
+    int32_t nearest = nearest_centroid(kmeans, padded, &squared);
+    if (distance) {
+        *distance = sqrtf(squared);
+    }
+    return nearest;
+}
+
+bool kmeans_add(MiniBatchKMeans* kmeans, const float* vector) {
+    if (!kmeans || !vector || kmeans->stride == 0) {
+        return false;
+    }
+
+    // Row padding was zeroed by kmeans_init() and is never written
+    memcpy(kmeans->batch + (size_t)kmeans->batch_count * kmeans->stride, vector,
+           kmeans->dimensions * sizeof(float));
+    if (++kmeans->batch_count < kmeans->batch_size) {
+        return false;
+    }
+
+    if (!kmeans->seeded) {
+        seed_centroids(kmeans);
+        kmeans->seeded = true;
+    }
+    seed_outliers(kmeans);
+    update_centroids(kmeans);
+    merge_centroids(kmeans);
+    kmeans->batch_count = 0;
+    return true;
+}
+
+bool operating_state_init(const OperatingStateConfig* config) {
+    OperatingStateConfig defaults;
+    if (!config) {
+        operating_state_get_default_config(&defaults);
+        config = &defaults;
+    }
+    if (config->window_s == 0 || config->clusters < 2 || config->clusters > OPERATING_STATE_MAX_CLUSTERS ||
+        config->batch_size < config->clusters || config->batch_size > OPERATING_STATE_MAX_BATCH ||
+        config->max_count == 0 || config->scale_windows == 0 || config->dwell_windows == 0) {
+        return false;
+    }
+
+    pthread_mutex_lock(&operating_state_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&operating_state_mutex);
+        return false;
+    }
+
+    private_data = (OperatingStatePrivate*)calloc(1, sizeof(OperatingStatePrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&operating_state_mutex);
+        return false;
+    }
+    memcpy(&private_data->config, config, sizeof(OperatingStateConfig));
+
+    pthread_mutex_unlock(&operating_state_mutex);
+    return true;
+}
+
+void operating_state_cleanup(void) {
+    pthread_mutex_lock(&operating_state_mutex);
+
+    free(private_data);
+    private_data = NULL;
+
+    pthread_mutex_unlock(&operating_state_mutex);
+}
+
+bool operating_state_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data) {
+        return false;
+    }
+
+    pthread_mutex_lock(&operating_state_mutex);
+    bool closed = private_data && record_sample(sensor, data);
+    pthread_mutex_unlock(&operating_state_mutex);
+
+    return closed;
+}
+
+bool operating_state_get(const char* sensor_id, OperatingStateStatus* status) {
+    if (!sensor_id || !status) {
+        return false;
+    }
+
+    pthread_mutex_lock(&operating_state_mutex);
+
+    StateSensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    bool found = entry && entry->group_index >= 0;
+    if (found) {
+        const StateGroup* group = &private_data->groups[entry->group_index];
+        memcpy(status->group, group->name, sizeof(status->group));
+        status->state = group->state;
+        status->states = 0;
+        for (uint32_t c = 0; group->kmeans.seeded && c < group->kmeans.clusters; c++) {
+            status->states += group->kmeans.active[c] ? 1 : 0;
+        }
+        status->distance = group->distance;
+        status->members = group->members;
+        status->windows = group->windows;
+        status->changes = group->changes;
+        status->timestamp = group->timestamp;
+    }
+
+    pthread_mutex_unlock(&operating_state_mutex);
+    return found;
+}
+
+void operating_state_get_default_config(OperatingStateConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->window_s = 60;
+    config->clusters = 3;
+    config->batch_size = 16;
+    config->max_count = 100;
+    config->scale_windows = 1440;
+    config->dwell_windows = 3;
+}
+
+// Private helper functions
+static float squared_distance(const float* a, const float* b, const float* weights, uint32_t stride) {
+#if defined(OPERATING_STATE_SSE2)
+    __m128 sum = _mm_setzero_ps();
+    for (uint32_t i = 0; i < stride; i += 4) {
+        __m128 difference = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(weights + i), _mm_mul_ps(difference, difference)));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+#elif defined(OPERATING_STATE_NEON)
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    for (uint32_t i = 0; i < stride; i += 4) {
+        float32x4_t difference = vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+        sum = vmlaq_f32(sum, vld1q_f32(weights + i), vmulq_f32(difference, difference));
+    }
+    return vaddvq_f32(sum);
+#else
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < stride; i++) {
+        float difference = a[i] - b[i];
+        sum += weights[i] * difference * difference;
+    }
+    return sum;
+#endif
+}
+
+static void move_towards(float* centroid, const float* vector, float rate, uint32_t stride) {
+#if defined(OPERATING_STATE_SSE2)
+    __m128 step = _mm_set1_ps(rate);
+    for (uint32_t i = 0; i < stride; i += 4) {
+        __m128 c = _mm_loadu_ps(centroid + i);
+        c = _mm_add_ps(c, _mm_mul_ps(step, _mm_sub_ps(_mm_loadu_ps(vector + i), c)));
+        _mm_storeu_ps(centroid + i, c);
+    }
+#elif defined(OPERATING_STATE_NEON)
+    float32x4_t step = vdupq_n_f32(rate);
+    for (uint32_t i = 0; i < stride; i += 4) {
+        float32x4_t c = vld1q_f32(centroid + i);
+        vst1q_f32(centroid + i, vmlaq_f32(c, step, vsubq_f32(vld1q_f32(vector + i), c)));
+    }
+#else
+    for (uint32_t i = 0; i < stride; i++) {
+        centroid[i] += rate * (vector[i] - centroid[i]);
+    }
+#endif
+}
+
+static int32_t nearest_centroid(const MiniBatchKMeans* kmeans, const float* vector, float* distance) {
+    uint32_t stride = kmeans->stride;
+    int32_t nearest = 0;
+    float best = FLT_MAX;
+    for (uint32_t c = 0; c < kmeans->clusters; c++) {
+        if (!kmeans->active[c]) {
+            continue;
+        }
+        float squared = squared_distance(vector, kmeans->centroids + (size_t)c * stride, kmeans->weights, stride);
+        if (squared < best) {
+            best = squared;
+            nearest = (int32_t)c;
+        }
+    }
+    *distance = best;
+    return nearest;
+}
+
+static float separation(const MiniBatchKMeans* kmeans, const float* a, const float* b,
+                        const float* spread_a, const float* spread_b) {
+    // Largest squared difference on one feature in units of the pooled spread; features
+    // without weight are constant and left out
+    float largest = 0.0f;
+    for (uint32_t d = 0; d < kmeans->dimensions; d++) {
+        if (kmeans->weights[d] <= 0.0f) {
+            continue;
+        }
+        float difference = a[d] - b[d];
+        float pooled = (spread_a ? spread_a[d] : 0.0f) + (spread_b ? spread_b[d] : 0.0f);
+        float floor = SPREAD_FLOOR / kmeans->weights[d];
+        float squared = difference * difference / (pooled > floor ? pooled : floor);
+        if (squared > largest) {
+            largest = squared;
+        }
+    }
+    return largest;
+}
+
+static bool closest_pair(const MiniBatchKMeans* kmeans, uint32_t* first, uint32_t* second, float* closest) {
+    uint32_t stride = kmeans->stride;
+    bool found = false;
+    *closest = FLT_MAX;
+    for (uint32_t a = 0; a < kmeans->clusters; a++) {
+        for (uint32_t b = a + 1; kmeans->active[a] && b < kmeans->clusters; b++) {
+            if (!kmeans->active[b]) {
+                continue;
+            }
+            float squared = separation(kmeans, kmeans->centroids + (size_t)a * stride,
+                                       kmeans->centroids + (size_t)b * stride,
+                                       kmeans->spreads + (size_t)a * stride,
+                                       kmeans->spreads + (size_t)b * stride);
+            if (squared < *closest) {
+                *closest = squared;
+                *first = a;
+                *second = b;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+static void seed_centroids(MiniBatchKMeans* kmeans) {
+    // k-means++: each further centroid is a batch vector drawn with probability
+    // proportional to its squared distance from the centroids chosen so far
+    uint32_t stride = kmeans->stride;
+    uint32_t count = kmeans->batch_count;
+    float spread[OPERATING_STATE_MAX_BATCH];
+
+    uint32_t chosen = next_random(kmeans) % count;
+    memcpy(kmeans->centroids, kmeans->batch + (size_t)chosen * stride, stride * sizeof(float));
+    for (uint32_t v = 0; v < count; v++) {
+        spread[v] = squared_distance(kmeans->batch + (size_t)v * stride, kmeans->centroids,
+                                     kmeans->weights, stride);
+    }
+
+    for (uint32_t c = 1; c < kmeans->clusters; c++) {
+        float total = 0.0f;
+        for (uint32_t v = 0; v < count; v++) {
+            total += spread[v];
+        }
+
+        chosen = next_random(kmeans) % count;
+        if (total > 0.0f) {
+            float target = (float)(next_random(kmeans) >> 8) * (1.0f / 16777216.0f) * total;
+            for (chosen = 0; chosen + 1 < count; chosen++) {
+                target -= spread[chosen];
+                if (target < 0.0f && spread[chosen] > 0.0f) {
+                    break;
+                }
+            }
+        }
+
+        float* centroid = kmeans->centroids + (size_t)c * stride;
+        memcpy(centroid, kmeans->batch + (size_t)chosen * stride, stride * sizeof(float));
+        for (uint32_t v = 0; v < count; v++) {
+            float squared = squared_distance(kmeans->batch + (size_t)v * stride, centroid,
+                                             kmeans->weights, stride);
+            if (squared < spread[v]) {
+                spread[v] = squared;
+            }
+        }
+    }
+
+    // Every centroid starts with the spread of the whole batch; merging takes care of
+    // seeds that turn out to share a state
+    float* spreads = kmeans->spreads;
+    for (uint32_t d = 0; d < kmeans->dimensions; d++) {
+        double sum = 0.0;
+        double sum_squares = 0.0;
+        for (uint32_t v = 0; v < count; v++) {
+            double x = kmeans->batch[(size_t)v * stride + d];
+            sum += x;
+            sum_squares += x * x;
+        }
+        double mean = sum / count;
+        double variance = sum_squares / count - mean * mean;
+        spreads[d] = variance > 0.0 ? (float)variance : 0.0f;
+    }
+    for (uint32_t c = 0; c < kmeans->clusters; c++) {
+        memcpy(spreads + (size_t)c * stride, spreads, stride * sizeof(float));
+        kmeans->active[c] = true;
+        kmeans->generations[c]++;
+    }
+}
+
+static void seed_outliers(MiniBatchKMeans* kmeans) {
+    uint32_t stride = kmeans->stride;
+    int32_t parents[OPERATING_STATE_MAX_BATCH];
+    float outlying[OPERATING_STATE_MAX_BATCH];
+    const float threshold = OUTLIER_SEPARATION * OUTLIER_SEPARATION;
+
+    // Each pass seeds at most one centroid, which takes its outliers in
+    for (uint32_t pass = 0; pass < kmeans->batch_count; pass++) {
+        for (uint32_t v = 0; v < kmeans->batch_count; v++) {
+            float squared;
+            const float* vector = kmeans->batch + (size_t)v * stride;
+            parents[v] = nearest_centroid(kmeans, vector, &squared);
+            outlying[v] = separation(kmeans, vector, kmeans->centroids + (size_t)parents[v] * stride,
+                                     NULL, kmeans->spreads + (size_t)parents[v] * stride);
+        }
+
+        // The outlier with the most similar outliers around it
+        int32_t chosen = -1;
+        uint32_t most = 0;
+        for (uint32_t v = 0; v < kmeans->batch_count; v++) {
+            if (outlying[v] <= threshold) {
+                continue;
+            }
+            const float* vector = kmeans->batch + (size_t)v * stride;
+            const float* spread = kmeans->spreads + (size_t)parents[v] * stride;
+            uint32_t companions = 0;
+            for (uint32_t w = 0; w < kmeans->batch_count; w++) {
+                if (w != v && outlying[w] > threshold &&
+                    separation(kmeans, vector, kmeans->batch + (size_t)w * stride, spread, spread) <
+                    MERGE_SEPARATION * MERGE_SEPARATION) {
+                    companions++;
+                }
+            }
+            if (companions > most) {
+                most = companions;
+                chosen = (int32_t)v;
+            }
+        }
+        if (chosen < 0) {
+            return;
+        }
+
+        // A free slot, or else the centroid with the fewest windows, if fewer than a batch;
+        // a centroid seeded in this batch is kept
+        uint32_t slot = kmeans->clusters;
+        uint32_t fewest = kmeans->batch_size;
+        for (uint32_t c = 0; c < kmeans->clusters; c++) {
+            if (!kmeans->active[c]) {
+                slot = c;
+                break;
+            }
+            if (kmeans->counts[c] > 0 && kmeans->counts[c] < fewest && (int32_t)c != parents[chosen]) {
+                fewest = kmeans->counts[c];
+                slot = c;
+            }
+        }
+        if (slot == kmeans->clusters) {
+            return;
+        }
+
+        // Start at the mean of the outlier and its companions, with the parent's spread
+        float* centroid = kmeans->centroids + (size_t)slot * stride;
+        const float* vector = kmeans->batch + (size_t)chosen * stride;
+        const float* spread = kmeans->spreads + (size_t)parents[chosen] * stride;
+        float members = 1.0f;
+        memcpy(centroid, vector, stride * sizeof(float));
+        for (uint32_t w = 0; w < kmeans->batch_count; w++) {
+            const float* other = kmeans->batch + (size_t)w * stride;
+            if (w != (uint32_t)chosen && outlying[w] > threshold &&
+                separation(kmeans, vector, other, spread, spread) < MERGE_SEPARATION * MERGE_SEPARATION) {
+                members += 1.0f;
+                move_towards(centroid, other, 1.0f / members, stride);
+            }
+        }
+        memcpy(kmeans->spreads + (size_t)slot * stride, spread, stride * sizeof(float));
+        kmeans->counts[slot] = 0;
+        kmeans->active[slot] = true;
+        kmeans->generations[slot]++;
+    }
+}
+
+static void update_centroids(MiniBatchKMeans* kmeans) {
+    uint32_t stride = kmeans->stride;
+    uint8_t assigned[OPERATING_STATE_MAX_BATCH];
+    float squared;
+
+    // Outliers left over by seed_outliers() are not assigned
+    for (uint32_t v = 0; v < kmeans->batch_count; v++) {
+        const float* vector = kmeans->batch + (size_t)v * stride;
+        int32_t c = nearest_centroid(kmeans, vector, &squared);
+        bool outlier = separation(kmeans, vector, kmeans->centroids + (size_t)c * stride, NULL,
+                                  kmeans->spreads + (size_t)c * stride) >
+                       OUTLIER_SEPARATION * OUTLIER_SEPARATION;
+        assigned[v] = outlier ? UINT8_MAX : (uint8_t)c;
+    }
+
+    for (uint32_t v = 0; v < kmeans->batch_count; v++) {
+        uint32_t c = assigned[v];
+        if (c == UINT8_MAX) {
+            continue;
+        }
+        const float* vector = kmeans->batch + (size_t)v * stride;
+        float* centroid = kmeans->centroids + (size_t)c * stride;
+        float* spread = kmeans->spreads + (size_t)c * stride;
+        if (kmeans->counts[c] < kmeans->max_count) {
+            kmeans->counts[c]++;
+        }
+
+        // The spread's initial estimate counts as one window
+        float spread_rate = 1.0f / (float)(kmeans->counts[c] + 1);
+        for (uint32_t d = 0; d < kmeans->dimensions; d++) {
+            float difference = vector[d] - centroid[d];
+            spread[d] += spread_rate * (difference * difference - spread[d]);
+        }
+        move_towards(centroid, vector, 1.0f / (float)kmeans->counts[c], stride);
+    }
+}
+
+static void merge_centroids(MiniBatchKMeans* kmeans) {
+    uint32_t first;
+    uint32_t second;
+    float closest;
+    while (closest_pair(kmeans, &first, &second, &closest) &&
+           closest < MERGE_SEPARATION * MERGE_SEPARATION) {
+        merge_pair(kmeans, first, second);
+    }
+}
+
+static void merge_pair(MiniBatchKMeans* kmeans, uint32_t first, uint32_t second) {
+    // Count-weighted mean, and the spread of the union of both centroids' windows
+    uint32_t stride = kmeans->stride;
+    float* centroid = kmeans->centroids + (size_t)first * stride;
+    float* spread = kmeans->spreads + (size_t)first * stride;
+    const float* other = kmeans->centroids + (size_t)second * stride;
+    const float* other_spread = kmeans->spreads + (size_t)second * stride;
+    uint32_t total = kmeans->counts[first] + kmeans->counts[second];
+    float share = total > 0 ? (float)kmeans->counts[second] / (float)total : 0.5f;
+
+    for (uint32_t d = 0; d < kmeans->dimensions; d++) {
+        float difference = other[d] - centroid[d];
+        spread[d] += share * (other_spread[d] - spread[d]) + share * (1.0f - share) * difference * difference;
+        centroid[d] += share * difference;
+    }
+    kmeans->counts[first] = total < kmeans->max_count ? total : kmeans->max_count;
+    kmeans->counts[second] = 0;
+    kmeans->active[second] = false;
+}
+
+static uint32_t next_random(MiniBatchKMeans* kmeans) {
+    // Xorshift32
+    uint32_t x = kmeans->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    kmeans->random = x;
+    return x;
+}
+
+static bool record_sample(const Sensor* sensor, const SensorData* data) {
+    if (!data->is_valid || !isfinite(data->value)) {
+        return false;
+    }
+
+    StateSensor* entry = find_sensor(sensor->id, true);
+    if (!entry || entry->group_index == GROUP_EXCLUDED) {
+        return false;
+    }
+
+    StateGroup* group = NULL;
+    if (entry->group_index == GROUP_NONE) {
+        group = sensor->location[0] ? find_group(sensor->location, true) : NULL;
+        if (!group) {
+            entry->group_index = GROUP_EXCLUDED;
+            return false;
+        }
+    } else {
+        group = &private_data->groups[entry->group_index];
+    }
+
+    // The first sample of a new window closes the previous one
+    bool closed = false;
+    uint32_t window = private_data->config.window_s;
+    if (group->members > 0 && data->timestamp >= group->window_end) {
+        close_window(group);
+        group->window_end = (data->timestamp / window + 1) * window;
+        closed = true;
+    }
+
+    if (entry->group_index == GROUP_NONE) {
+        if (group->members >= OPERATING_STATE_MAX_MEMBERS) {
+            entry->group_index = GROUP_EXCLUDED;
+            return closed;
+        }
+        if (group->members == 0) {
+            group->window_end = (data->timestamp / window + 1) * window;
+        }
+
+        // A late member changes the feature vector, so the next window starts learning anew
+        group->frozen = false;
+
+        StateMember* member = &group->member_info[group->members];
+        memcpy(member->id, entry->id, sizeof(member->id));
+        member->type = sensor->type;
+        member->previous_last = data->value;
+        member->previous_mean = data->value;
+        entry->member = group->members++;
+        entry->group_index = (int32_t)(group - private_data->groups);
+    }
+
+    StateMember* member = &group->member_info[entry->member];
+    if (member->count == 0) {
+        member->first = data->value;
+    }
+    double offset = (double)data->value - member->first;
+    member->sum += offset;
+    member->sum_squares += offset * offset;
+    member->last = data->value;
+    member->count++;
+    return closed;
+}
+
+static void close_window(StateGroup* group) {
+    const OperatingStateConfig* config = &private_data->config;
+    if (!group->frozen) {
+        group->frozen = true;
+        group->learned = 0;
+        group->cluster = -1;
+        group->state = -1;
+        memset(group->scale_mean, 0, sizeof(group->scale_mean));
+        memset(group->scale_variance, 0, sizeof(group->scale_variance));
+        kmeans_init(&group->kmeans, group->members * OPERATING_STATE_FEATURES, config->clusters,
+                    config->batch_size, config->max_count);
+    }
+
+    // Mean, standard deviation and size of the change since the previous window of each
+    // member; ramps up and down share one state
+    float features[OPERATING_STATE_MAX_DIMENSIONS];
+    for (uint32_t m = 0; m < group->members; m++) {
+        StateMember* member = &group->member_info[m];
+        float* feature = features + m * OPERATING_STATE_FEATURES;
+        if (member->count > 0) {
+            double mean = member->sum / member->count;
+            double variance = member->sum_squares / member->count - mean * mean;
+            feature[0] = (float)(member->first + mean);
+            feature[1] = variance > 0.0 ? (float)sqrt(variance) : 0.0f;
+            feature[2] = fabsf(member->last - member->previous_last);
+            member->previous_last = member->last;
+            member->previous_mean = feature[0];
+        } else {
+            feature[0] = member->previous_mean;
+            feature[1] = 0.0f;
+            feature[2] = 0.0f;
+        }
+        member->count = 0;
+        member->sum = 0.0;
+        member->sum_squares = 0.0;
+    }
+
+    // Weigh each feature by its inverse running variance; features that have not varied
+    // (relative to their magnitude) are left out
+    float weights[OPERATING_STATE_MAX_DIMENSIONS];
+    uint32_t dimensions = group->kmeans.dimensions;
+    uint32_t span = group->learned < config->scale_windows ? group->learned + 1 : config->scale_windows;
+    float alpha = 1.0f / (float)span;
+    float load = 0.0f;
+    for (uint32_t d = 0; d < dimensions; d++) {
+        float mean = group->scale_mean[d];
+        float deviation = features[d] - mean;
+        mean += alpha * deviation;
+        float variance = (1.0f - alpha) * (group->scale_variance[d] + alpha * deviation * deviation);
+        group->scale_mean[d] = mean;
+        group->scale_variance[d] = variance;
+
+        weights[d] = variance > 1e-8f * mean * mean + 1e-12f ? 1.0f / variance : 0.0f;
+        if (d % OPERATING_STATE_FEATURES == 0) {
+            load += (features[d] - mean) * sqrtf(weights[d]);
+        }
+    }
+    load /= (float)group->members;
+    kmeans_set_weights(&group->kmeans, weights);
+
+    group->windows++;
+    group->learned++;
+    group->timestamp = group->window_end;
+    if (kmeans_add(&group->kmeans, features)) {
+        rank_clusters(group);
+    }
+
+    int32_t cluster = kmeans_nearest(&group->kmeans, features, &group->distance);
+    if (cluster >= 0) {
+        follow_cluster(group, cluster, load);
+    }
+}
+
+static void follow_cluster(StateGroup* group, int32_t cluster, float load) {
+    const MiniBatchKMeans* kmeans = &group->kmeans;
+
+    // Take the first cluster, and follow a merged or replaced one, without an event
+    if (group->cluster < 0 || !kmeans->active[group->cluster] ||
+        kmeans->generations[group->cluster] != group->cluster_generation) {
+        group->cluster = cluster;
+        group->cluster_generation = kmeans->generations[cluster];
+        group->candidate_windows = 0;
+    } else if (cluster == group->cluster) {
+        group->candidate_windows = 0;
+    } else {
+        if (group->candidate_windows == 0 || cluster != group->candidate) {
+            group->candidate = cluster;
+            group->candidate_windows = 0;
+        }
+        if (++group->candidate_windows >= private_data->config.dwell_windows) {
+            int32_t previous = group->rank[group->cluster];
+            group->cluster = cluster;
+            group->cluster_generation = kmeans->generations[cluster];
+            group->candidate_windows = 0;
+            group->state = group->rank[cluster];
+            group->changes++;
+            push_state_event(group, previous, load);
+        }
+    }
+    group->state = group->rank[group->cluster];
+}
+
+static void rank_clusters(StateGroup* group) {
+    // Number the clusters by the standardized level of their members
+    const MiniBatchKMeans* kmeans = &group->kmeans;
+    float load[OPERATING_STATE_MAX_CLUSTERS];
+    uint8_t order[OPERATING_STATE_MAX_CLUSTERS];
+
+    uint32_t ranked = 0;
+    for (uint32_t c = 0; c < kmeans->clusters; c++) {
+        if (!kmeans->active[c]) {
+            continue;
+        }
+        const float* centroid = kmeans->centroids + (size_t)c * kmeans->stride;
+        load[c] = 0.0f;
+        for (uint32_t m = 0; m < group->members; m++) {
+            uint32_t d = m * OPERATING_STATE_FEATURES;
+            load[c] += (centroid[d] - group->scale_mean[d]) * sqrtf(kmeans->weights[d]);
+        }
+
+        // Insertion sort, ascending load
+        uint32_t position = ranked++;
+        while (position > 0 && load[order[position - 1]] > load[c]) {
+            order[position] = order[position - 1];
+            position--;
+        }
+        order[position] = (uint8_t)c;
+    }
+
+    for (uint32_t position = 0; position < ranked; position++) {
+        group->rank[order[position]] = (uint8_t)position;
+    }
+}
+
+static void push_state_event(const StateGroup* group, int32_t from_state, float load) {
+    MonitorEvent event;
+    memset(&event, 0, sizeof(event));
+    event.type = EVENT_STATE_CHANGE;
+    memcpy(event.sensor_id, group->name, sizeof(event.sensor_id) - 1);
+    event.sensor_type = group->member_info[0].type;
+    event.timestamp = group->timestamp;
+    event.value = load;
+    event.from_state = from_state;
+    event.to_state = group->state;
+    event.score = group->distance;
+    event_queue_push(&event);
+}
+
+static StateGroup* find_group(const char* name, bool create) {
+    StateGroup* free_slot = NULL;
+    for (uint32_t i = 0; i < OPERATING_STATE_MAX_GROUPS; i++) {
+        StateGroup* group = &private_data->groups[i];
+        if (!group->used) {
+            if (!free_slot) {
+                free_slot = group;
+            }
+            continue;
+        }
+        if (strncmp(group->name, name, sizeof(group->name) - 1) == 0) {
+            return group;
+        }
+    }
+    if (!create || !free_slot) {
+        return NULL;
+    }
+
+    memset(free_slot, 0, sizeof(StateGroup));
+    free_slot->used = true;
+    free_slot->cluster = -1;
+    free_slot->state = -1;
+    snprintf(free_slot->name, sizeof(free_slot->name), "%s", name);
+    return free_slot;
+}
+
+static StateSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, OPERATING_STATE_MAX_SENSORS,
+                                          StateSensor, id);
+    bool created;
+    StateSensor* entry = (StateSensor*)sensor_table_find(&table, id, create, &created);
+    if (created) {
+        entry->group_index = GROUP_NONE;
+    }
+    return entry;
+}
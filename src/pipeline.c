@@ -0,0 +1,80 @@
+/**
+ * @file pipeline.c
+ * @brief Sample processing pipeline for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/pipeline.h"
+#include <string.h>
+
+// Registered stage
+typedef struct {
+    PipelineStageFn stage;
+    void* context;
+    PipelineStageStats stats;
+} PipelineStage;
+
+// Stage table
+static PipelineStage stages[PIPELINE_MAX_STAGES];
+static uint32_t stage_count = 0;
+
+bool pipeline_register_stage(const char* name, PipelineStageFn stage, void* context) {
+    if (!name || !stage || stage_count >= PIPELINE_MAX_STAGES) {
+        return false;
+    }
+
+    PipelineStage* entry = &stages[stage_count];
+    memset(entry, 0, sizeof(PipelineStage));
+    entry->stage = stage;
+    entry->context = context;
+    strncpy(entry->stats.name, name, sizeof(entry->stats.name) - 1);
+    stage_count++;
+
+    return true;
+}
+
+void pipeline_clear(void) {
+    memset(stages, 0, sizeof(stages));
+    stage_count = 0;
+}
+
+uint32_t pipeline_get_stage_count(void) {
+    return stage_count;
+}
+
+void pipeline_truncate(uint32_t count) {
+    if (count < stage_count) {
+        memset(&stages[count], 0, (stage_count - count) * sizeof(PipelineStage));
+        stage_count = count;
+    }
+}
+
+bool pipeline_process(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < stage_count; i++) {
+        PipelineStage* entry = &stages[i];
+        entry->stats.processed++;
+        if (!entry->stage(sensor, data, entry->context)) {
+            entry->stats.stopped++;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32_t pipeline_get_stats(PipelineStageStats* stats, uint32_t max_stages) {
+    if (!stats) {
+        return 0;
+    }
+
+    uint32_t count = stage_count < max_stages ? stage_count : max_stages;
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(&stats[i], &stages[i].stats, sizeof(PipelineStageStats));
+    }
+    return count;
+}
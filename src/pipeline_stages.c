@@ -0,0 +1,216 @@
+/**
+ * @file pipeline_stages.c
+ * @brief Default analytics stages for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/pipeline_stages.h"
+#include "../include/pipeline.h"
+#include "../include/rules.h"
+
+// Expression rules evaluated whenever a sensor they read reports
+static const struct {
+    const char* name;
+    const char* expression;
+} default_rules[] = {
+    { "TEMP001_heating",   "avg_1m(TEMP001) > 35 && rate(TEMP001) > 0.5" },
+    { "TEMP001_warm",      "filtered(TEMP001) > 38" },
+    { "TEMP001_unstable",  "std_15m(TEMP001) > 3 || max_1m(TEMP001) - min_1m(TEMP001) > 10" },
+    { "TEMP001_idle_warm", "state(TEMP001) == 0 && filtered(TEMP001) > 30" }
+};
+
+// Forward declarations of private functions
+static bool window_stats_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool kalman_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool alert_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool anomaly_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool trend_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool changepoint_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool correlation_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool forecast_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool operating_state_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool rules_stage(const Sensor* sensor, const SensorData* data, void* context);
+
+bool pipeline_register_default_stages(const PipelineStagesConfig* config) {
+    PipelineStagesConfig default_config;
+    if (!config) {
+        pipeline_stages_get_default_config(&default_config);
+        config = &default_config;
+    }
+
+    // Each failure enters the unwind chain just below the last component brought up
+    if (!window_stats_init(&config->window_stats)) {
+        return false;
+    }
+    if (!alert_init(&config->alert)) {
+        goto cleanup_window_stats;
+    }
+    if (!anomaly_init(&config->anomaly)) {
+        goto cleanup_alert;
+    }
+    if (!trend_init(&config->trend)) {
+        goto cleanup_anomaly;
+    }
+    if (!rules_init()) {
+        goto cleanup_trend;
+    }
+    if (!changepoint_init(&config->changepoint)) {
+        goto cleanup_rules;
+    }
+    if (!kalman_init(&config->kalman)) {
+        goto cleanup_changepoint;
+    }
+    if (!correlation_init(&config->correlation)) {
+        goto cleanup_kalman;
+    }
+    if (!forecast_init(&config->forecast)) {
+        goto cleanup_correlation;
+    }
+    if (!operating_state_init(&config->operating_state)) {
+        goto cleanup_forecast;
+    }
+
+    // Filters and windows come first so that the detectors and rules after them read
+    // values that already include the current sample; a failure removes the stages
+    // registered so far, leaving those registered before this call
+    uint32_t first_stage = pipeline_get_stage_count();
+    if (pipeline_register_stage("window_stats", window_stats_stage, NULL) &&
+        pipeline_register_stage("kalman", kalman_stage, NULL) &&
+        pipeline_register_stage("alert", alert_stage, NULL) &&
+        pipeline_register_stage("anomaly", anomaly_stage, NULL) &&
+        pipeline_register_stage("trend", trend_stage, NULL) &&
+        pipeline_register_stage("changepoint", changepoint_stage, NULL) &&
+        pipeline_register_stage("correlation", correlation_stage, NULL) &&
+        pipeline_register_stage("forecast", forecast_stage, NULL) &&
+        pipeline_register_stage("operating_state", operating_state_stage, NULL) &&
+        pipeline_register_stage("rules", rules_stage, NULL)) {
+        // Expression rules over the last values, sliding windows and operating states
+        uint32_t error_offset = 0;
+        size_t i = 0;
+        while (i < sizeof(default_rules) / sizeof(default_rules[0]) &&
+               rules_add(default_rules[i].name, default_rules[i].expression, &error_offset)) {
+            i++;
+        }
+        if (i == sizeof(default_rules) / sizeof(default_rules[0])) {
+            return true;
+        }
+    }
+
+    pipeline_truncate(first_stage);
+    operating_state_cleanup();
+cleanup_forecast:
+    forecast_cleanup();
+cleanup_correlation:
+    correlation_cleanup();
+cleanup_kalman:
+    kalman_cleanup();
+cleanup_changepoint:
+    changepoint_cleanup();
+cleanup_rules:
+    rules_cleanup();
+cleanup_trend:
+    trend_cleanup();
+cleanup_anomaly:
+    anomaly_cleanup();
+cleanup_alert:
+    alert_cleanup();
+cleanup_window_stats:
+    window_stats_cleanup();
+    return false;
+}
+
+void pipeline_cleanup_default_stages(void) {
+    pipeline_clear();
+    operating_state_cleanup();
+    forecast_cleanup();
+    correlation_cleanup();
+    kalman_cleanup();
+    changepoint_cleanup();
+    rules_cleanup();
+    trend_cleanup();
+    anomaly_cleanup();
+    alert_cleanup();
+    window_stats_cleanup();
+}
+
+void pipeline_stages_get_default_config(PipelineStagesConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    window_stats_get_default_config(&config->window_stats);
+    kalman_get_default_config(&config->kalman);
+    config->alert.alert_threshold = 40.0f;
+    config->alert.critical_threshold = 45.0f;
+    config->alert.hysteresis = 1.0f;
+    config->alert.raise_dwell_s = 5;
+    config->alert.clear_dwell_s = 30;
+    anomaly_get_default_config(&config->anomaly);
+    trend_get_default_config(&config->trend);
+    changepoint_get_default_config(&config->changepoint);
+    correlation_get_default_config(&config->correlation);
+    forecast_get_default_config(&config->forecast);
+    operating_state_get_default_config(&config->operating_state);
+}
+
+// Private helper functions
+static bool window_stats_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    window_stats_add_sample(sensor, data);
+    return true;
+}
+
+static bool kalman_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    kalman_process_sample(sensor, data);
+    return true;
+}
+
+static bool alert_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    alert_process_sample(sensor, data);
+    return true;
+}
+
+static bool anomaly_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    anomaly_process_sample(sensor, data);
+    return true;
+}
+
+static bool trend_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    trend_process_sample(sensor, data);
+    return true;
+}
+
+static bool changepoint_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    changepoint_process_sample(sensor, data);
+    return true;
+}
+
+static bool correlation_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    correlation_process_sample(sensor, data);
+    return true;
+}
+
+static bool forecast_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    forecast_process_sample(sensor, data);
+    return true;
+}
+
+static bool operating_state_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    operating_state_process_sample(sensor, data);
+    return true;
+}
+
+static bool rules_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    rules_process_sample(sensor, data);
+    return true;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file quantile_sketch.c
+ * @brief Streaming quantile sketch for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/quantile_sketch.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MERGE_CAPACITY (2 * (QUANTILE_SKETCH_CENTROIDS + QUANTILE_SKETCH_BUFFER))
+
+// Forward declarations of private functions
+static void compress(QuantileSketch* sketch, const QuantileSketch* other);
+static uint32_t append_items(QuantileCentroid* items, uint32_t count, const QuantileSketch* sketch);
+static double scale_k(double q);
+static double scale_q(double k);
+static int compare_centroids(const void* a, const void* b);
+
+void quantile_sketch_init(QuantileSketch* sketch) {
+    if (!sketch) {
+        return;
+    }
+
+    sketch->centroid_count = 0;
+    sketch->buffer_count = 0;
+    sketch->count = 0;
+    sketch->min_value = 0.0f;
+    sketch->max_value = 0.0f;
+}
+
+void quantile_sketch_add(QuantileSketch* sketch, float value) {
+    if (!sketch || isnan(value)) {
+        return;
+    }
+
+    if (sketch->count == 0 || value < sketch->min_value) {
+        sketch->min_value = value;
+    }
+    if (sketch->count == 0 || value > sketch->max_value) {
+        sketch->max_value = value;
+    }
+    sketch->count++;
+
+    sketch->buffer[sketch->buffer_count++] = value;
+    if (sketch->buffer_count == QUANTILE_SKETCH_BUFFER) {
+        compress(sketch, NULL);
+    }
+}
+
+void quantile_sketch_add_batch(QuantileSketch* sketch, const float* values, size_t count) {
+    if (!sketch || !values) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        quantile_sketch_add(sketch, values[i]);
+    }
+}
+
+void quantile_sketch_merge(QuantileSketch* sketch, const QuantileSketch* other) {
+    if (!sketch || !other || other->count == 0) {
+        return;
+    }
+
+    if (sketch->count == 0 || other->min_value < sketch->min_value) {
+        sketch->min_value = other->min_value;
+    }
+    if (sketch->count == 0 || other->max_value > sketch->max_value) {
+        sketch->max_value = other->max_value;
+    }
+    sketch->count += other->count;
+
+    compress(sketch, other);
+}
+
+float quantile_sketch_quantile(QuantileSketch* sketch, double q) {
+    if (!sketch || sketch->count == 0) {
+        return 0.0f;
+    }
+    if (sketch->buffer_count > 0) {
+        compress(sketch, NULL);
+    }
+
+    if (q <= 0.0) {
+        return sketch->min_value;
+    }
+    if (q >= 1.0) {
+        return sketch->max_value;
+    }
+
+    const QuantileCentroid* c = sketch->centroids;
+    uint32_t n = sketch->centroid_count;
+    double total = (double)sketch->count;
+    double index = q * total;
+
+    if (n == 1) {
+        return c[0].mean;
+    }
+
+    // Each centroid is taken to sit at the middle of its weight; interpolate between
+    // neighbouring centres, and between the extremes and the outermost centres
+    double first_half = c[0].weight / 2.0;
+    if (index < first_half) {
+        return (float)(sketch->min_value + (c[0].mean - sketch->min_value) * index / first_half);
+    }
+
+    double last_half = c[n - 1].weight / 2.0;
+    if (index > total - last_half) {
+        double fraction = (index - (total - last_half)) / last_half;
+        return (float)(c[n - 1].mean + (sketch->max_value - c[n - 1].mean) * fraction);
+    }
+
+    double position = first_half;
+    for (uint32_t i = 0; i + 1 < n; i++) {
+        double step = (c[i].weight + c[i + 1].weight) / 2.0;
+        if (index <= position + step) {
+            double fraction = (index - position) / step;
+            return (float)(c[i].mean + (c[i + 1].mean - c[i].mean) * fraction);
+        }
+        position += step;
+    }
+
+    return c[n - 1].mean;
+}
+
+// Private helper functions
+static double scale_k(double q) {
+    // k1 scale function: centroid size shrinks towards both tails
+    return QUANTILE_SKETCH_COMPRESSION / (2.0 * M_PI) * asin(2.0 * q - 1.0);
+}
+
+static double scale_q(double k) {
+    double limit = QUANTILE_SKETCH_COMPRESSION / 4.0;
+    if (k >= limit) {
+        return 1.0;
+    }
+    return (sin(k * 2.0 * M_PI / QUANTILE_SKETCH_COMPRESSION) + 1.0) / 2.0;
+}
+
+static int compare_centroids(const void* a, const void* b) {
+    float left = ((const QuantileCentroid*)a)->mean;
+    float right = ((const QuantileCentroid*)b)->mean;
+    return (left > right) - (left < right);
+}
+
+static uint32_t append_items(QuantileCentroid* items, uint32_t count, const QuantileSketch* sketch) {
+    memcpy(items + count, sketch->centroids, sketch->centroid_count * sizeof(QuantileCentroid));
+    count += sketch->centroid_count;
+    for (uint32_t i = 0; i < sketch->buffer_count; i++) {
+        items[count].mean = sketch->buffer[i];
+        items[count].weight = 1;
+        count++;
+    }
+    return count;
+}
+
+static void compress(QuantileSketch* sketch, const QuantileSketch* other) {
+    QuantileCentroid items[MERGE_CAPACITY];
+    uint32_t count = append_items(items, 0, sketch);
+    if (other) {
+        count = append_items(items, count, other);
+    }
+    sketch->buffer_count = 0;
+    if (count == 0) {
+        sketch->centroid_count = 0;
+        return;
+    }
+
+    qsort(items, count, sizeof(QuantileCentroid), compare_centroids);
+
+    double total = 0.0;
+    for (uint32_t i = 0; i < count; i++) {
+        total += items[i].weight;
+    }
+
+    // Greedily grow each centroid while it spans less than one unit of k
+    uint32_t output = 0;
+    double so_far = 0.0;
+    double limit = total * scale_q(scale_k(0.0) + 1.0);
+    QuantileCentroid current = items[0];
+
+    for (uint32_t i = 1; i < count; i++) {
+        double proposed = (double)current.weight + items[i].weight;
+        // The last slot absorbs everything left should rounding ever exceed the bound
+        if (so_far + proposed <= limit || output == QUANTILE_SKETCH_CENTROIDS - 1) {
+            double mean = current.mean + (items[i].mean - (double)current.mean) * items[i].weight / proposed;
+            current.mean = (float)mean;
+            current.weight += items[i].weight;
+        } else {
+            so_far += current.weight;
+            sketch->centroids[output++] = current;
+            limit = total * scale_q(scale_k(so_far / total) + 1.0);
+            current = items[i];
+        }
+    }
+    sketch->centroids[output++] = current;
+    sketch->centroid_count = output;
+}
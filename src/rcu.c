@@ -0,0 +1,184 @@
+/**
+ * @file rcu.c
+ * @brief Read-copy-update publication for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/rcu.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sched.h>
+
+// Per-thread reader record; `state` is the epoch the thread entered its read section
+// in, shifted left by one, with the low bit set while the section is active
+typedef struct {
+    _Alignas(64) _Atomic uint64_t state;
+    _Atomic bool used;
+} RcuThread;
+
+// Object waiting for the readers of its epoch to finish
+typedef struct {
+    void* object;
+    void (*free_fn)(void*);
+    uint64_t epoch;
+} RcuRetired;
+
+// Private data structure
+typedef struct {
+    RcuThread threads[RCU_MAX_THREADS];
+    _Alignas(64) _Atomic uint64_t epoch;
+    RcuRetired retired[RCU_MAX_RETIRED];
+    size_t retired_count;
+} RcuPrivate;
+
+// Forward declarations of private functions
+static RcuThread* current_thread(void);
+static void release_thread(void* record);
+static void create_thread_key(void);
+static void try_advance_epoch(void);
+static void reclaim(void);
+
+// Private data instance
+static RcuPrivate private_data;
+static pthread_mutex_t rcu_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t thread_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_key;
+static _Thread_local RcuThread* thread_record = NULL;
+static _Thread_local unsigned int thread_depth = 0;
+
+void rcu_read_lock(void) {
+    if (thread_depth++ > 0) {
+        return;
+    }
+
+    RcuThread* record = current_thread();
+    uint64_t epoch = atomic_load_explicit(&private_data.epoch, memory_order_relaxed);
+    atomic_store_explicit(&record->state, epoch << 1 | 1u, memory_order_seq_cst);
+    // Order the announcement before any load of a published pointer
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+void rcu_read_unlock(void) {
+    if (thread_depth == 0 || --thread_depth > 0) {
+        return;
+    }
+
+    atomic_store_explicit(&thread_record->state, 0, memory_order_release);
+}
+
+void* rcu_dereference(RcuPointer* rcu_pointer) {
+    return rcu_pointer ? atomic_load_explicit(&rcu_pointer->pointer, memory_order_acquire) : NULL;
+}
+
+void* rcu_publish(RcuPointer* rcu_pointer, void* object) {
+    if (!rcu_pointer) {
+        return NULL;
+    }
+    return atomic_exchange_explicit(&rcu_pointer->pointer, object, memory_order_acq_rel);
+}
+
+void rcu_retire(void* object, void (*free_fn)(void*)) {
+    if (!object || !free_fn) {
+        return;
+    }
+
+    pthread_mutex_lock(&rcu_mutex);
+
+    reclaim();
+    while (private_data.retired_count == RCU_MAX_RETIRED) {
+        pthread_mutex_unlock(&rcu_mutex);
+        sched_yield();
+        pthread_mutex_lock(&rcu_mutex);
+        reclaim();
+    }
+
+    RcuRetired* entry = &private_data.retired[private_data.retired_count++];
+    entry->object = object;
+    entry->free_fn = free_fn;
+    entry->epoch = atomic_load_explicit(&private_data.epoch, memory_order_seq_cst);
+
+    pthread_mutex_unlock(&rcu_mutex);
+}
+
+void rcu_synchronize(void) {
+    pthread_mutex_lock(&rcu_mutex);
+
+    reclaim();
+    while (private_data.retired_count > 0) {
+        pthread_mutex_unlock(&rcu_mutex);
+        sched_yield();
+        pthread_mutex_lock(&rcu_mutex);
+        reclaim();
+    }
+
+    pthread_mutex_unlock(&rcu_mutex);
+}
+
+// Private helper functions
+static void create_thread_key(void) {
+    pthread_key_create(&thread_key, release_thread);
+}
+
+static void release_thread(void* record) {
+    RcuThread* thread = (RcuThread*)record;
+    atomic_store_explicit(&thread->state, 0, memory_order_release);
+    atomic_store_explicit(&thread->used, false, memory_order_release);
+}
+
+static RcuThread* current_thread(void) {
+    if (thread_record) {
+        return thread_record;
+    }
+
+    pthread_once(&thread_key_once, create_thread_key);
+
+    // Claim a free record; a thread keeps it until it exits
+    for (;;) {
+        for (size_t i = 0; i < RCU_MAX_THREADS; i++) {
+            bool expected = false;
+            if (atomic_compare_exchange_strong(&private_data.threads[i].used, &expected, true)) {
+                thread_record = &private_data.threads[i];
+                pthread_setspecific(thread_key, thread_record);
+                return thread_record;
+            }
+        }
+        sched_yield();
+    }
+}
+
+static void try_advance_epoch(void) {
+    uint64_t epoch = atomic_load_explicit(&private_data.epoch, memory_order_seq_cst);
+
+    // The epoch moves on only once every active reader has observed it
+    for (size_t i = 0; i < RCU_MAX_THREADS; i++) {
+        uint64_t state = atomic_load_explicit(&private_data.threads[i].state, memory_order_seq_cst);
+        if ((state & 1u) && (state >> 1) != epoch) {
+            return;
+        }
+    }
+
+    atomic_compare_exchange_strong(&private_data.epoch, &epoch, epoch + 1);
+}
+
+static void reclaim(void) {
+    if (private_data.retired_count == 0) {
+        return;
+    }
+
+    try_advance_epoch();
+    uint64_t epoch = atomic_load_explicit(&private_data.epoch, memory_order_seq_cst);
+
+    // Two epoch changes after retirement no reader can still hold the object
+    size_t kept = 0;
+    for (size_t i = 0; i < private_data.retired_count; i++) {
+        RcuRetired* entry = &private_data.retired[i];
+        if (entry->epoch + 2 <= epoch) {
+            entry->free_fn(entry->object);
+        } else {
+            private_data.retired[kept++] = *entry;
+        }
+    }
+    private_data.retired_count = kept;
+}
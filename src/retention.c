@@ -0,0 +1,403 @@
+/**
+ * @file retention.c
+ * @brief Retention and background compaction of sample storage for the Industrial
+ *        AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/retention.h"
+#include "../include/segment_writer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#endif
+
+// Linux I/O priority encoding (see ioprio_set(2))
+#define IOPRIO_WHO_PROCESS 1
+#define IOPRIO_CLASS_IDLE 3
+#define IOPRIO_CLASS_SHIFT 13
+
+// One segment file found on disk
+typedef struct {
+    uint32_t start;
+    uint64_t size;
+} SegmentInfo;
+
+// Private data structure
+typedef struct {
+    RetentionConfig config;
+    RetentionStats stats;
+    pthread_t thread;
+    pthread_mutex_t pass_mutex;
+    pthread_mutex_t wait_mutex;
+    pthread_cond_t wait_cond;
+    bool stop;
+} RetentionPrivate;
+
+// Forward declarations of private functions
+static void* retention_thread(void* arg);
+static void lower_thread_priority(void);
+static bool run_tier(const RetentionTierConfig* tier, uint32_t now, uint32_t* remaining);
+static int list_segments(const char* prefix, SegmentInfo** segments);
+static bool compact_segments(const RetentionTierConfig* tier, SegmentInfo* segments, int count);
+static bool merge_run(const char* prefix, const SegmentInfo* run, int count);
+static bool delete_segment(const char* prefix, const SegmentInfo* segment);
+static int compare_segments(const void* a, const void* b);
+
+// Private data instance
+static RetentionPrivate* private_data = NULL;
+
+bool retention_init(const RetentionConfig* config) {
+    if (!config || config->tier_count == 0 || config->tier_count > RETENTION_MAX_TIERS ||
+        config->interval_s == 0 || private_data) {
+        return false;
+    }
+
+    // Allocate private data
+    private_data = (RetentionPrivate*)calloc(1, sizeof(RetentionPrivate));
+    if (!private_data) {
+        return false;
+    }
+    memcpy(&private_data->config, config, sizeof(RetentionConfig));
+
+    pthread_mutex_init(&private_data->pass_mutex, NULL);
+    pthread_mutex_init(&private_data->wait_mutex, NULL);
+    pthread_cond_init(&private_data->wait_cond, NULL);
+    private_data->stop = false;
+
+    if (pthread_create(&private_data->thread, NULL, retention_thread, private_data) != 0) {
+        pthread_cond_destroy(&private_data->wait_cond);
+        pthread_mutex_destroy(&private_data->wait_mutex);
+        pthread_mutex_destroy(&private_data->pass_mutex);
+        free(private_data);
+        private_data = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+void retention_cleanup(void) {
+    if (!private_data) {
+        return;
+    }
+
+    pthread_mutex_lock(&private_data->wait_mutex);
+    private_data->stop = true;
+    pthread_cond_signal(&private_data->wait_cond);
+    pthread_mutex_unlock(&private_data->wait_mutex);
+
+    pthread_join(private_data->thread, NULL);
+
+    pthread_cond_destroy(&private_data->wait_cond);
+    pthread_mutex_destroy(&private_data->wait_mutex);
+    pthread_mutex_destroy(&private_data->pass_mutex);
+    free(private_data);
+    private_data = NULL;
+}
+
+bool retention_run_once(uint32_t now) {
+    if (!private_data) {
+        return false;
+    }
+
+    pthread_mutex_lock(&private_data->pass_mutex);
+
+    bool result = true;
+    uint32_t remaining = 0;
+    for (uint32_t i = 0; i < private_data->config.tier_count; i++) {
+        if (!run_tier(&private_data->config.tiers[i], now, &remaining)) {
+            result = false;
+        }
+    }
+    private_data->stats.segment_count = remaining;
+    private_data->stats.passes++;
+
+    pthread_mutex_unlock(&private_data->pass_mutex);
+    return result;
+}
+
+void retention_get_stats(RetentionStats* stats) {
+    if (!private_data || !stats) {
+        return;
+    }
+
+    pthread_mutex_lock(&private_data->pass_mutex);
+    memcpy(stats, &private_data->stats, sizeof(RetentionStats));
+    pthread_mutex_unlock(&private_data->pass_mutex);
+}
+
+// Private helper functions
+static void* retention_thread(void* arg) {
+    RetentionPrivate* data = (RetentionPrivate*)arg;
+
+    lower_thread_priority();
+
+    pthread_mutex_lock(&data->wait_mutex);
+    while (!data->stop) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += data->config.interval_s;
+
+        while (!data->stop &&
+               pthread_cond_timedwait(&data->wait_cond, &data->wait_mutex, &deadline) != ETIMEDOUT) {
+            // Spurious wakeup or stop request
+        }
+        if (data->stop) {
+            break;
+        }
+
+        pthread_mutex_unlock(&data->wait_mutex);
+        retention_run_once((uint32_t)time(NULL));
+        pthread_mutex_lock(&data->wait_mutex);
+    }
+    pthread_mutex_unlock(&data->wait_mutex);
+
+    return NULL;
+}
+
+static void lower_thread_priority(void) {
+#ifdef __linux__
+    // Both calls apply to the calling thread only; failures leave default priority
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+    setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 19);
+#endif
+}
+
+static bool run_tier(const RetentionTierConfig* tier, uint32_t now, uint32_t* remaining) {
+    SegmentInfo* segments = NULL;
+    int count = list_segments(tier->prefix, &segments);
+    if (count < 0) {
+        return false;
+    }
+
+    bool result = true;
+
+    // Merge small closed segments first so that budgets see the compacted layout
+    if (tier->compact_min_kb > 0 && count > 2) {
+        result = compact_segments(tier, segments, count);
+        free(segments);
+        segments = NULL;
+        count = list_segments(tier->prefix, &segments);
+        if (count < 0) {
+            return false;
+        }
+    }
+
+    // Age budget: a closed segment ends where the next one starts
+    int first = 0;
+    if (tier->max_age_s > 0) {
+        while (first < count - 1 && segments[first + 1].start + (uint64_t)tier->max_age_s <= now) {
+            if (!delete_segment(tier->prefix, &segments[first])) {
+                result = false;
+            }
+            first++;
+        }
+    }
+
+    // Size budget: drop the oldest closed segments until the tier fits
+    if (tier->max_size_kb > 0) {
+        uint64_t total = 0;
+        for (int i = first; i < count; i++) {
+            total += segments[i].size;
+        }
+        while (first < count - 1 && total > (uint64_t)tier->max_size_kb * 1024u) {
+            total -= segments[first].size;
+            if (!delete_segment(tier->prefix, &segments[first])) {
+                result = false;
+            }
+            first++;
+        }
+    }
+
+    *remaining += (uint32_t)(count - first);
+    free(segments);
+    return result;
+}
+
+static int list_segments(const char* prefix, SegmentInfo** segments) {
+    DIR* dir = opendir(private_data->config.directory);
+    if (!dir) {
+        return -1;
+    }
+
+    int count = 0;
+    int capacity = 0;
+    SegmentInfo* list = NULL;
+    struct dirent* entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        uint32_t start;
+        if (!segment_writer_parse_name(entry->d_name, prefix, &start)) {
+            continue;
+        }
+
+        char path[256];
+        struct stat st;
+        if (!segment_writer_path(path, sizeof(path), private_data->config.directory, prefix, start) ||
+            stat(path, &st) != 0) {
+            continue;
+        }
+
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            SegmentInfo* grown = (SegmentInfo*)realloc(list, (size_t)capacity * sizeof(SegmentInfo));
+            if (!grown) {
+                free(list);
+                closedir(dir);
+                return -1;
+            }
+            list = grown;
+        }
+        list[count].start = start;
+        list[count].size = (uint64_t)st.st_size;
+        count++;
+    }
+    closedir(dir);
+
+    if (count > 0) {
+        qsort(list, (size_t)count, sizeof(SegmentInfo), compare_segments);
+    }
+
+    *segments = list;
+    return count;
+}
+
+static bool compact_segments(const RetentionTierConfig* tier, SegmentInfo* segments, int count) {
+    uint64_t min_bytes = (uint64_t)tier->compact_min_kb * 1024u;
+    uint64_t target_bytes = (uint64_t)tier->compact_target_kb * 1024u;
+    bool result = true;
+
+    // Greedily grow runs of consecutive small segments, excluding the open one
+    int run_start = 0;
+    while (run_start < count - 1) {
+        if (segments[run_start].size >= min_bytes) {
+            run_start++;
+            continue;
+        }
+
+        uint64_t run_bytes = segments[run_start].size;
+        int run_end = run_start + 1;
+        while (run_end < count - 1 && segments[run_end].size < min_bytes &&
+               run_bytes + segments[run_end].size <= target_bytes) {
+            run_bytes += segments[run_end].size;
+            run_end++;
+        }
+
+        if (run_end - run_start > 1) {
+            if (merge_run(tier->prefix, &segments[run_start], run_end - run_start)) {
+                private_data->stats.segments_merged += (uint32_t)(run_end - run_start - 1);
+            } else {
+                result = false;
+            }
+        }
+        run_start = run_end;
+    }
+
+    return result;
+}
+
+static bool merge_run(const char* prefix, const SegmentInfo* run, int count) {
+    const char* directory = private_data->config.directory;
+
+    // Write the merged segment under a temporary name
+    char first_path[256];
+    char temp_path[272];
+    segment_writer_path(first_path, sizeof(first_path), directory, prefix, run[0].start);
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", first_path);
+
+    FILE* out = fopen(temp_path, "w");
+    if (!out) {
+        return false;
+    }
+
+    // Segments of a run cover consecutive time spans, so copying them in order keeps the
+    // records in time order. Lines are streamed through a small buffer so that memory
+    // does not grow with the run; only the header of the first segment is kept.
+    bool result = true;
+    for (int i = 0; result && i < count; i++) {
+        char path[256];
+        segment_writer_path(path, sizeof(path), directory, prefix, run[i].start);
+        FILE* in = fopen(path, "r");
+        if (!in) {
+            result = false;
+            break;
+        }
+
+        char buffer[1024];
+        bool skip = i > 0;
+        bool line_start = true;
+        while (result && fgets(buffer, sizeof(buffer), in)) {
+            size_t length = strlen(buffer);
+            bool line_end = buffer[length - 1] == '\n';
+            if (skip || (line_start && length == 1 && line_end)) {
+                // Header of a later segment or an empty line
+                skip = skip && !line_end;
+            } else {
+                result = fputs(buffer, out) >= 0;
+            }
+            line_start = line_end;
+        }
+        if (ferror(in)) {
+            result = false;
+        }
+        // A torn last line still ends with a newline in the merged segment
+        if (result && !line_start && !skip) {
+            result = fputc('\n', out) != EOF;
+        }
+        fclose(in);
+    }
+    if (fclose(out) != 0) {
+        result = false;
+    }
+
+    if (!result) {
+        remove(temp_path);
+        return false;
+    }
+
+    // Replace the first segment atomically, then drop the rest. A crash in between
+    // leaves duplicate records rather than losing any.
+    if (rename(temp_path, first_path) != 0) {
+        remove(temp_path);
+        return false;
+    }
+    for (int i = 1; i < count; i++) {
+        char path[256];
+        segment_writer_path(path, sizeof(path), directory, prefix, run[i].start);
+        remove(path);
+    }
+
+    return true;
+}
+
+static bool delete_segment(const char* prefix, const SegmentInfo* segment) {
+    char path[256];
+    if (!segment_writer_path(path, sizeof(path), private_data->config.directory, prefix,
+                             segment->start)) {
+        return false;
+    }
+    if (remove(path) != 0) {
+        return false;
+    }
+
+    private_data->stats.segments_deleted++;
+    private_data->stats.bytes_deleted += segment->size;
+    return true;
+}
+
+static int compare_segments(const void* a, const void* b) {
+    uint32_t left = ((const SegmentInfo*)a)->start;
+    uint32_t right = ((const SegmentInfo*)b)->start;
+    return (left > right) - (left < right);
+}
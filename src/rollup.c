@@ -0,0 +1,303 @@
+/**
+ * @file rollup.c
+ * @brief Continuous downsampling rollups for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/rollup.h"
+#include "../include/sensor_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Per-sensor rollup state
+typedef struct {
+    char id[32];
+    SensorType type;
+    bool open[ROLLUP_MAX_TIERS];
+    RollupBucket buckets[ROLLUP_MAX_TIERS];
+} RollupSensor;
+
+// Private data structure
+typedef struct {
+    RollupConfig config;
+    SegmentWriter writers[ROLLUP_MAX_TIERS];
+    RollupSensor sensors[ROLLUP_MAX_SENSORS];
+    bool write_failed;
+} RollupPrivate;
+
+// Forward declarations of private functions
+static RollupSensor* find_sensor(const char* id, bool create);
+static void merge_bucket(RollupSensor* entry, uint32_t tier, const RollupBucket* source);
+static void close_bucket(RollupSensor* entry, uint32_t tier);
+static void write_bucket(uint32_t tier, const RollupSensor* entry, const RollupBucket* bucket);
+
+// Private data instance
+static RollupPrivate* private_data = NULL;
+static pthread_mutex_t rollup_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void rollup_get_default_config(RollupConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(RollupConfig));
+    strncpy(config->directory, "data", sizeof(config->directory) - 1);
+    config->tier_count = 3;
+    config->tiers[0].period_s = 1;
+    config->tiers[0].segment_span_s = 3600;
+    strncpy(config->tiers[0].prefix, "sensor_data_1s", sizeof(config->tiers[0].prefix) - 1);
+    config->tiers[1].period_s = 60;
+    config->tiers[1].segment_span_s = 86400;
+    strncpy(config->tiers[1].prefix, "sensor_data_1m", sizeof(config->tiers[1].prefix) - 1);
+    config->tiers[2].period_s = 3600;
+    config->tiers[2].segment_span_s = 30 * 86400;
+    strncpy(config->tiers[2].prefix, "sensor_data_1h", sizeof(config->tiers[2].prefix) - 1);
+}
+
+bool rollup_init(const RollupConfig* config) {
+    RollupConfig effective;
+
+    if (config) {
+        memcpy(&effective, config, sizeof(RollupConfig));
+    } else {
+        rollup_get_default_config(&effective);
+    }
+
+    // Validate tier layout
+    if (effective.tier_count == 0 || effective.tier_count > ROLLUP_MAX_TIERS) {
+        return false;
+    }
+    for (uint32_t i = 0; i < effective.tier_count; i++) {
+        if (effective.tiers[i].period_s == 0 || effective.tiers[i].segment_span_s == 0) {
+            return false;
+        }
+        if (i > 0 && effective.tiers[i].period_s % effective.tiers[i - 1].period_s != 0) {
+            return false;
+        }
+    }
+
+    pthread_mutex_lock(&rollup_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&rollup_mutex);
+        return false;
+    }
+
+    // Allocate private data
+    private_data = (RollupPrivate*)calloc(1, sizeof(RollupPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&rollup_mutex);
+        return false;
+    }
+    memcpy(&private_data->config, &effective, sizeof(RollupConfig));
+
+    // One segment series per tier; segments are opened on the first closed bucket
+    for (uint32_t i = 0; i < effective.tier_count; i++) {
+        if (!segment_writer_open(&private_data->writers[i], effective.directory,
+                                 effective.tiers[i].prefix,
+                                 "Bucket Start,Sensor ID,Sensor Type,Min,Max,Sum,Count,Last",
+                                 effective.tiers[i].segment_span_s, 0)) {
+            while (i-- > 0) {
+                segment_writer_close(&private_data->writers[i]);
+            }
+            free(private_data);
+            private_data = NULL;
+            pthread_mutex_unlock(&rollup_mutex);
+            return false;
+        }
+    }
+
+    pthread_mutex_unlock(&rollup_mutex);
+    return true;
+}
+
+void rollup_cleanup(void) {
+    pthread_mutex_lock(&rollup_mutex);
+
+    if (private_data) {
+        // Close every open bucket, finest tier first so that it cascades upwards
+        for (uint32_t s = 0; s < ROLLUP_MAX_SENSORS; s++) {
+            RollupSensor* entry = &private_data->sensors[s];
+            if (entry->id[0] == '\0') {
+                continue;
+            }
+            for (uint32_t t = 0; t < private_data->config.tier_count; t++) {
+                if (entry->open[t]) {
+                    close_bucket(entry, t);
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < private_data->config.tier_count; i++) {
+            segment_writer_close(&private_data->writers[i]);
+        }
+
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&rollup_mutex);
+}
+
+bool rollup_add_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data || !data->is_valid) {
+        return false;
+    }
+
+    pthread_mutex_lock(&rollup_mutex);
+
+    if (!private_data) {
+        pthread_mutex_unlock(&rollup_mutex);
+        return false;
+    }
+
+    RollupSensor* entry = find_sensor(sensor->id, true);
+    if (!entry) {
+        pthread_mutex_unlock(&rollup_mutex);
+        return false;
+    }
+    entry->type = sensor->type;
+
+    // A raw sample is a one-sample bucket of the finest tier
+    RollupBucket sample = {
+        .bucket_start = data->timestamp,
+        .min_value = data->value,
+        .max_value = data->value,
+        .sum = data->value,
+        .count = 1,
+        .last_value = data->value,
+        .last_timestamp = data->timestamp
+    };
+    merge_bucket(entry, 0, &sample);
+
+    bool result = !private_data->write_failed;
+    private_data->write_failed = false;
+
+    pthread_mutex_unlock(&rollup_mutex);
+    return result;
+}
+
+bool rollup_flush(uint32_t now) {
+    pthread_mutex_lock(&rollup_mutex);
+
+    if (!private_data) {
+        pthread_mutex_unlock(&rollup_mutex);
+        return false;
+    }
+
+    for (uint32_t s = 0; s < ROLLUP_MAX_SENSORS; s++) {
+        RollupSensor* entry = &private_data->sensors[s];
+        if (entry->id[0] == '\0') {
+            continue;
+        }
+        for (uint32_t t = 0; t < private_data->config.tier_count; t++) {
+            uint32_t period = private_data->config.tiers[t].period_s;
+            if (entry->open[t] && entry->buckets[t].bucket_start + period <= now) {
+                close_bucket(entry, t);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < private_data->config.tier_count; i++) {
+        segment_writer_flush(&private_data->writers[i]);
+    }
+
+    bool result = !private_data->write_failed;
+    private_data->write_failed = false;
+
+    pthread_mutex_unlock(&rollup_mutex);
+    return result;
+}
+
+bool rollup_get_bucket(const char* sensor_id, uint32_t tier, RollupBucket* bucket) {
+    if (!sensor_id || !bucket) {
+        return false;
+    }
+
+    pthread_mutex_lock(&rollup_mutex);
+
+    bool found = false;
+    if (private_data && tier < private_data->config.tier_count) {
+        RollupSensor* entry = find_sensor(sensor_id, false);
+        if (entry && entry->open[tier]) {
+            memcpy(bucket, &entry->buckets[tier], sizeof(RollupBucket));
+            found = true;
+        }
+    }
+
+    pthread_mutex_unlock(&rollup_mutex);
+    return found;
+}
+
+// Private helper functions
+static RollupSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, ROLLUP_MAX_SENSORS,
+                                          RollupSensor, id);
+    return (RollupSensor*)sensor_table_find(&table, id, create, NULL);
+}
+
+static void merge_bucket(RollupSensor* entry, uint32_t tier, const RollupBucket* source) {
+    uint32_t period = private_data->config.tiers[tier].period_s;
+    uint32_t start = source->bucket_start - source->bucket_start % period;
+    RollupBucket* bucket = &entry->buckets[tier];
+
+    // Moving into a later bucket closes the current one first. Late data is folded
+    // into the open bucket since closed buckets have already been published.
+    if (entry->open[tier] && start > bucket->bucket_start) {
+        close_bucket(entry, tier);
+    }
+
+    if (!entry->open[tier]) {
+        memcpy(bucket, source, sizeof(RollupBucket));
+        bucket->bucket_start = start;
+        entry->open[tier] = true;
+        return;
+    }
+
+    if (source->min_value < bucket->min_value) {
+        bucket->min_value = source->min_value;
+    }
+    if (source->max_value > bucket->max_value) {
+        bucket->max_value = source->max_value;
+    }
+    bucket->sum += source->sum;
+    bucket->count += source->count;
+    if (source->last_timestamp >= bucket->last_timestamp) {
+        bucket->last_value = source->last_value;
+        bucket->last_timestamp = source->last_timestamp;
+    }
+}
+
+static void close_bucket(RollupSensor* entry, uint32_t tier) {
+    RollupBucket closed = entry->buckets[tier];
+    entry->open[tier] = false;
+
+    write_bucket(tier, entry, &closed);
+
+    // Cascade into the next coarser tier
+    if (tier + 1 < private_data->config.tier_count) {
+        merge_bucket(entry, tier + 1, &closed);
+    }
+}
+
+static void write_bucket(uint32_t tier, const RollupSensor* entry, const RollupBucket* bucket) {
+    char line[192];
+
+    // %.9g round-trips a float exactly, %.17g a double
+    snprintf(line, sizeof(line), "%u,%s,%s,%.9g,%.9g,%.17g,%u,%.9g",
+             bucket->bucket_start,
+             entry->id,
+             sensor_type_to_string(entry->type),
+             bucket->min_value,
+             bucket->max_value,
+             bucket->sum,
+             bucket->count,
+             bucket->last_value);
+
+    if (!segment_writer_write(&private_data->writers[tier], bucket->bucket_start, line)) {
+        private_data->write_failed = true;
+    }
+}
@@ -0,0 +1,815 @@
+/**
+ * @file rules.c
+ * @brief Expression rules engine for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Expressions are compiled by recursive descent straight into postfix bytecode, with
+ * the stack depth tracked during emission so evaluation needs no bounds checks. Each
+ * sensor referenced by a rule heads a list of subscriptions (rule, operand), which is
+ * all a sample has to walk to find the work it causes.
+ */
+
+#include "../include/rules.h"
+#include "../include/window_stats.h"
+#include "../include/value_cache.h"
+#include "../include/event_queue.h"
+#include "../include/kalman.h"
+#include "../include/operating_state.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <pthread.h>
+
+#define RULES_MAX_SUBSCRIPTIONS (RULES_MAX_RULES * RULE_MAX_OPERANDS)
+
+// Compiler state
+typedef struct {
+    const char* text;
+    const char* pos;
+    const char* error;
+    RuleProgram* program;
+    uint32_t depth;
+    uint32_t nesting;
+} RuleParser;
+
+// Evaluation state of one operand
+typedef struct {
+    uint32_t window;            // Window index for window statistics
+    uint32_t sensor;            // Slot of the sensor in the sensor table
+    bool valid;                 // Operand has a value
+    bool has_previous;          // Previous sample known, for rates
+    float previous_value;
+    uint32_t previous_timestamp;
+} RuleOperandState;
+
+// Installed rule
+typedef struct {
+    bool used;
+    char name[32];
+    RuleProgram program;
+    RuleOperandState operands[RULE_MAX_OPERANDS];
+    float values[RULE_MAX_OPERANDS];
+    RuleStatus status;
+    uint32_t mark;              // Pass in which the rule was last queued for evaluation
+} RuleEntry;
+
+// Sensor read by at least one rule
+typedef struct {
+    char id[32];
+    int32_t first;              // First subscription, -1 if none
+    uint32_t window_mark[WINDOW_STATS_MAX_WINDOWS]; // Pass in which each window was fetched
+    bool window_found[WINDOW_STATS_MAX_WINDOWS];
+    SlidingWindowStats windows[WINDOW_STATS_MAX_WINDOWS]; // Window statistics of that pass
+} RuleSensor;
+
+// Operand of a rule reading a sensor
+typedef struct {
+    uint16_t rule;
+    uint8_t operand;
+    int32_t next;               // Next subscription of the sensor or of the free list
+} RuleSubscription;
+
+// Private data structure
+typedef struct {
+    RuleEntry rules[RULES_MAX_RULES];
+    RuleSensor sensors[RULES_MAX_SENSORS];
+    RuleSubscription subscriptions[RULES_MAX_SUBSCRIPTIONS];
+    int32_t free_subscription;
+    uint16_t pending[RULES_MAX_RULES];
+    uint32_t mark;
+} RulesPrivate;
+
+// Forward declarations of private functions
+static bool parse_or(RuleParser* parser);
+static bool parse_and(RuleParser* parser);
+static bool parse_comparison(RuleParser* parser);
+static bool parse_sum(RuleParser* parser);
+static bool parse_term(RuleParser* parser);
+static bool parse_unary(RuleParser* parser);
+static bool parse_primary(RuleParser* parser);
+static bool parse_operand(RuleParser* parser, const char* name, size_t name_length);
+static bool parse_function(const char* name, size_t length, RuleOperandKind* kind, uint32_t* width_s);
+static bool match(RuleParser* parser, const char* token);
+static bool fail(RuleParser* parser, const char* at);
+static bool emit(RuleParser* parser, RuleOpcode opcode, uint32_t arg);
+static void skip_space(RuleParser* parser);
+static void refresh_operand(RuleEntry* rule, uint32_t index, const SensorData* data, uint32_t mark);
+static bool evaluate_rule(RuleEntry* rule, const Sensor* sensor, const SensorData* data);
+static RuleEntry* find_rule(const char* name);
+static RuleSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static RulesPrivate* private_data = NULL;
+static pthread_mutex_t rules_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool rule_compile(const char* expression, RuleProgram* program, uint32_t* error_offset) {
+    if (!expression || !program) {
+        return false;
+    }
+
+    memset(program, 0, sizeof(RuleProgram));
+
+    RuleParser parser;
+    memset(&parser, 0, sizeof(parser));
+    parser.text = expression;
+    parser.pos = expression;
+    parser.program = program;
+
+    bool ok = parse_or(&parser);
+    if (ok) {
+        skip_space(&parser);
+        if (*parser.pos != '\0') {
+            ok = fail(&parser, parser.pos);
+        }
+    }
+
+    if (!ok && error_offset) {
+        *error_offset = (uint32_t)(parser.error - expression);
+    }
+    return ok;
+}
+
+float rule_program_run(const RuleProgram* program, const float* operands) {
+    // The top of the stack lives in a register; the compiler guarantees a balanced
+    // program within RULE_MAX_STACK
+    float stack[RULE_MAX_STACK];
+    uint32_t top = 0;
+    float value = NAN;
+
+    for (uint32_t i = 0; i < program->length; i++) {
+        RuleInstruction instruction = program->code[i];
+        switch ((RuleOpcode)instruction.opcode) {
+            case RULE_OP_CONST: stack[top++] = value; value = program->constants[instruction.arg]; break;
+            case RULE_OP_LOAD:  stack[top++] = value; value = operands[instruction.arg]; break;
+            case RULE_OP_NEG:   value = -value; break;
+            case RULE_OP_NOT:   value = value == 0.0f ? 1.0f : 0.0f; break;
+            case RULE_OP_ADD:   value = stack[--top] + value; break;
+            case RULE_OP_SUB:   value = stack[--top] - value; break;
+            case RULE_OP_MUL:   value = stack[--top] * value; break;
+            case RULE_OP_DIV:   value = stack[--top] / value; break;
+            case RULE_OP_LT:    value = stack[--top] < value ? 1.0f : 0.0f; break;
+            case RULE_OP_LE:    value = stack[--top] <= value ? 1.0f : 0.0f; break;
+            case RULE_OP_GT:    value = stack[--top] > value ? 1.0f : 0.0f; break;
+            case RULE_OP_GE:    value = stack[--top] >= value ? 1.0f : 0.0f; break;
+            case RULE_OP_EQ:    value = stack[--top] == value ? 1.0f : 0.0f; break;
+            case RULE_OP_NE:    value = stack[--top] != value ? 1.0f : 0.0f; break;
+            case RULE_OP_AND:   value = (stack[--top] != 0.0f && value != 0.0f) ? 1.0f : 0.0f; break;
+            case RULE_OP_OR:    value = (stack[--top] != 0.0f || value != 0.0f) ? 1.0f : 0.0f; break;
+            default:            return NAN;
+        }
+    }
+
+    return value;
+}
+
+bool rules_init(void) {
+    pthread_mutex_lock(&rules_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&rules_mutex);
+        return false;
+    }
+
+    private_data = (RulesPrivate*)calloc(1, sizeof(RulesPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&rules_mutex);
+        return false;
+    }
+
+    for (int32_t i = 0; i < RULES_MAX_SUBSCRIPTIONS; i++) {
+        private_data->subscriptions[i].next = i + 1 < RULES_MAX_SUBSCRIPTIONS ? i + 1 : -1;
+    }
+    private_data->free_subscription = 0;
+
+    pthread_mutex_unlock(&rules_mutex);
+    return true;
+}
+
+void rules_cleanup(void) {
+    pthread_mutex_lock(&rules_mutex);
+
+    if (private_data) {
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&rules_mutex);
+}
+
+bool rules_add(const char* name, const char* expression, uint32_t* error_offset) {
+    if (!name || !name[0] || !expression) {
+        return false;
+    }
+
+    RuleProgram program;
+    if (!rule_compile(expression, &program, error_offset)) {
+        return false;
+    }
+
+    // Resolve window widths before touching the tables
+    uint32_t windows[RULE_MAX_OPERANDS] = { 0 };
+    for (uint32_t i = 0; i < program.operand_count; i++) {
+        const RuleOperand* operand = &program.operands[i];
+        if (operand->kind >= RULE_OPERAND_AVG &&
+            !window_stats_find_window(operand->width_s, &windows[i])) {
+            if (error_offset) {
+                *error_offset = operand->offset;
+            }
+            return false;
+        }
+    }
+
+    pthread_mutex_lock(&rules_mutex);
+
+    if (!private_data || find_rule(name)) {
+        pthread_mutex_unlock(&rules_mutex);
+        return false;
+    }
+
+    uint32_t index = 0;
+    while (index < RULES_MAX_RULES && private_data->rules[index].used) {
+        index++;
+    }
+    if (index == RULES_MAX_RULES) {
+        pthread_mutex_unlock(&rules_mutex);
+        return false;
+    }
+
+    uint32_t slots[RULE_MAX_OPERANDS];
+    for (uint32_t i = 0; i < program.operand_count; i++) {
+        RuleSensor* sensor = find_sensor(program.operands[i].sensor_id, true);
+        if (!sensor) {
+            pthread_mutex_unlock(&rules_mutex);
+            return false;
+        }
+        slots[i] = (uint32_t)(sensor - private_data->sensors);
+    }
+
+    RuleEntry* rule = &private_data->rules[index];
+    memset(rule, 0, sizeof(RuleEntry));
+    rule->used = true;
+    strncpy(rule->name, name, sizeof(rule->name) - 1);
+    memcpy(&rule->program, &program, sizeof(RuleProgram));
+
+    for (uint32_t i = 0; i < program.operand_count; i++) {
+        const RuleOperand* operand = &program.operands[i];
+        RuleOperandState* state = &rule->operands[i];
+        state->window = windows[i];
+        state->sensor = slots[i];
+
+        // Seed from the latest good reading of the sensor
+        CachedValue cached;
+        if (value_cache_get(operand->sensor_id, 0, 0, &cached) && cached.quality == VALUE_QUALITY_GOOD) {
+            SensorData seed;
+            memset(&seed, 0, sizeof(seed));
+            seed.type = cached.type;
+            seed.value = cached.value;
+            seed.timestamp = cached.timestamp;
+            seed.is_valid = true;
+            refresh_operand(rule, i, &seed, ++private_data->mark);
+        }
+
+        // Subscribe the operand to its sensor
+        int32_t subscription = private_data->free_subscription;
+        RuleSubscription* entry = &private_data->subscriptions[subscription];
+        private_data->free_subscription = entry->next;
+        entry->rule = (uint16_t)index;
+        entry->operand = (uint8_t)i;
+        entry->next = private_data->sensors[slots[i]].first;
+        private_data->sensors[slots[i]].first = subscription;
+    }
+
+    pthread_mutex_unlock(&rules_mutex);
+    return true;
+}
+
+bool rules_remove(const char* name) {
+    if (!name) {
+        return false;
+    }
+
+    pthread_mutex_lock(&rules_mutex);
+
+    RuleEntry* rule = private_data ? find_rule(name) : NULL;
+    if (!rule) {
+        pthread_mutex_unlock(&rules_mutex);
+        return false;
+    }
+
+    uint16_t index = (uint16_t)(rule - private_data->rules);
+    for (uint32_t i = 0; i < rule->program.operand_count; i++) {
+        RuleSensor* sensor = &private_data->sensors[rule->operands[i].sensor];
+        int32_t* link = &sensor->first;
+        while (*link >= 0) {
+            RuleSubscription* entry = &private_data->subscriptions[*link];
+            if (entry->rule == index) {
+                int32_t released = *link;
+                *link = entry->next;
+                entry->next = private_data->free_subscription;
+                private_data->free_subscription = released;
+            } else {
+                link = &entry->next;
+            }
+        }
+    }
+    memset(rule, 0, sizeof(RuleEntry));
+
+    pthread_mutex_unlock(&rules_mutex);
+    return true;
+}
+
+bool rules_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data) {
+        return false;
+    }
+
+    pthread_mutex_lock(&rules_mutex);
+
+    RuleSensor* entry = private_data ? find_sensor(sensor->id, false) : NULL;
+    if (!entry) {
+        pthread_mutex_unlock(&rules_mutex);
+        return false;
+    }
+
+    // Refresh the operands reading this sensor and queue each affected rule once
+    uint32_t mark = ++private_data->mark;
+    uint32_t pending = 0;
+    for (int32_t i = entry->first; i >= 0; i = private_data->subscriptions[i].next) {
+        const RuleSubscription* subscription = &private_data->subscriptions[i];
+        RuleEntry* rule = &private_data->rules[subscription->rule];
+        refresh_operand(rule, subscription->operand, data, mark);
+        if (rule->mark != mark) {
+            rule->mark = mark;
+            private_data->pending[pending++] = subscription->rule;
+        }
+    }
+
+    bool changed = false;
+    for (uint32_t i = 0; i < pending; i++) {
+        if (evaluate_rule(&private_data->rules[private_data->pending[i]], sensor, data)) {
+            changed = true;
+        }
+    }
+
+    pthread_mutex_unlock(&rules_mutex);
+    return changed;
+}
+
+bool rules_get_status(const char* name, RuleStatus* status) {
+    if (!name || !status) {
+        return false;
+    }
+
+    pthread_mutex_lock(&rules_mutex);
+
+    RuleEntry* rule = private_data ? find_rule(name) : NULL;
+    if (rule) {
+        memcpy(status, &rule->status, sizeof(RuleStatus));
+    }
+
+    pthread_mutex_unlock(&rules_mutex);
+    return rule != NULL;
+}
+
+// Private helper functions
+static bool parse_or(RuleParser* parser) {
+    if (!parse_and(parser)) {
+        return false;
+    }
+    while (match(parser, "||")) {
+        if (!parse_and(parser) || !emit(parser, RULE_OP_OR, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool parse_and(RuleParser* parser) {
+    if (!parse_comparison(parser)) {
+        return false;
+    }
+    while (match(parser, "&&")) {
+        if (!parse_comparison(parser) || !emit(parser, RULE_OP_AND, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool parse_comparison(RuleParser* parser) {
+    static const struct {
+        const char* token;
+        RuleOpcode opcode;
+    } operators[] = {
+        { "<=", RULE_OP_LE }, { ">=", RULE_OP_GE }, { "==", RULE_OP_EQ }, { "!=", RULE_OP_NE },
+        { "<", RULE_OP_LT }, { ">", RULE_OP_GT }
+    };
+
+    if (!parse_sum(parser)) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); i++) {
+        if (match(parser, operators[i].token)) {
+            return parse_sum(parser) && emit(parser, operators[i].opcode, 0);
+        }
+    }
+    return true;
+}
+
+static bool parse_sum(RuleParser* parser) {
+    if (!parse_term(parser)) {
+        return false;
+    }
+    for (;;) {
+        RuleOpcode opcode;
+        if (match(parser, "+")) {
+            opcode = RULE_OP_ADD;
+        } else if (match(parser, "-")) {
+            opcode = RULE_OP_SUB;
+        } else {
+            return true;
+        }
+        if (!parse_term(parser) || !emit(parser, opcode, 0)) {
+            return false;
+        }
+    }
+}
+
+static bool parse_term(RuleParser* parser) {
+    if (!parse_unary(parser)) {
+        return false;
+    }
+    for (;;) {
+        RuleOpcode opcode;
+        if (match(parser, "*")) {
+            opcode = RULE_OP_MUL;
+        } else if (match(parser, "/")) {
+            opcode = RULE_OP_DIV;
+        } else {
+            return true;
+        }
+        if (!parse_unary(parser) || !emit(parser, opcode, 0)) {
+            return false;
+        }
+    }
+}
+
+static bool parse_unary(RuleParser* parser) {
+    // Every parenthesis and prefix operator recurses through here, so this bounds the
+    // recursion on hostile input
+    skip_space(parser);
+    const char* start = parser->pos;
+    bool nested = *start == '-' || *start == '(' || (*start == '!' && start[1] != '=');
+    if (nested && parser->nesting == RULE_MAX_NESTING) {
+        return fail(parser, start);
+    }
+    parser->nesting += nested;
+
+    bool ok;
+    if (match(parser, "-")) {
+        ok = parse_unary(parser) && emit(parser, RULE_OP_NEG, 0);
+    } else if (parser->pos[0] == '!' && parser->pos[1] != '=') {
+        parser->pos++;
+        ok = parse_unary(parser) && emit(parser, RULE_OP_NOT, 0);
+    } else {
+        ok = parse_primary(parser);
+    }
+
+    parser->nesting -= nested;
+    return ok;
+}
+
+static bool parse_primary(RuleParser* parser) {
+    skip_space(parser);
+    const char* start = parser->pos;
+
+    if (*start == '(') {
+        parser->pos++;
+        if (!parse_or(parser)) {
+            return false;
+        }
+        return match(parser, ")") || fail(parser, parser->pos);
+    }
+
+    if (isdigit((unsigned char)*start) || *start == '.') {
+        char* end;
+        float value = strtof(start, &end);
+        if (end == start || !isfinite(value)) {
+            return fail(parser, start);
+        }
+        parser->pos = end;
+
+        RuleProgram* program = parser->program;
+        uint32_t index = 0;
+        while (index < program->constant_count && program->constants[index] != value) {
+            index++;
+        }
+        if (index == program->constant_count) {
+            if (index == RULE_MAX_CONSTANTS) {
+                return fail(parser, start);
+            }
+            program->constants[program->constant_count++] = value;
+        }
+        return emit(parser, RULE_OP_CONST, index);
+    }
+
+    if (isalpha((unsigned char)*start) || *start == '_') {
+        const char* end = start;
+        while (isalnum((unsigned char)*end) || *end == '_' || *end == '.') {
+            end++;
+        }
+        parser->pos = end;
+        return parse_operand(parser, start, (size_t)(end - start));
+    }
+
+    return fail(parser, start);
+}
+
+static bool parse_operand(RuleParser* parser, const char* name, size_t name_length) {
+    RuleOperand operand;
+    memset(&operand, 0, sizeof(operand));
+    operand.offset = (uint32_t)(name - parser->text);
+
+    const char* id = name;
+    size_t id_length = name_length;
+
+    if (match(parser, "(")) {
+        // Function call: the argument is a sensor identifier
+        if (!parse_function(name, name_length, &operand.kind, &operand.width_s)) {
+            return fail(parser, name);
+        }
+        skip_space(parser);
+        id = parser->pos;
+        while (*parser->pos && (isalnum((unsigned char)*parser->pos) || strchr("_.:-", *parser->pos))) {
+            parser->pos++;
+        }
+        id_length = (size_t)(parser->pos - id);
+        if (id_length == 0 || !match(parser, ")")) {
+            return fail(parser, parser->pos);
+        }
+    } else {
+        operand.kind = RULE_OPERAND_VALUE;
+    }
+
+    if (id_length >= sizeof(operand.sensor_id)) {
+        return fail(parser, id);
+    }
+    memcpy(operand.sensor_id, id, id_length);
+
+    // Identical operands share one slot
+    RuleProgram* program = parser->program;
+    uint32_t index = 0;
+    while (index < program->operand_count &&
+           (program->operands[index].kind != operand.kind ||
+            program->operands[index].width_s != operand.width_s ||
+            strcmp(program->operands[index].sensor_id, operand.sensor_id) != 0)) {
+        index++;
+    }
+    if (index == program->operand_count) {
+        if (index == RULE_MAX_OPERANDS) {
+            return fail(parser, name);
+        }
+        program->operands[program->operand_count++] = operand;
+    }
+    return emit(parser, RULE_OP_LOAD, index);
+}
+
+static bool parse_function(const char* name, size_t length, RuleOperandKind* kind, uint32_t* width_s) {
+    static const struct {
+        const char* prefix;
+        RuleOperandKind kind;
+    } windowed[] = {
+        { "avg_", RULE_OPERAND_AVG }, { "min_", RULE_OPERAND_MIN }, { "max_", RULE_OPERAND_MAX },
+        { "std_", RULE_OPERAND_STD }, { "count_", RULE_OPERAND_COUNT }
+    };
+
+    *width_s = 0;
+    if (length == 5 && strncmp(name, "value", 5) == 0) {
+        *kind = RULE_OPERAND_VALUE;
+        return true;
+    }
+    if (length == 4 && strncmp(name, "rate", 4) == 0) {
+        *kind = RULE_OPERAND_RATE;
+        return true;
+    }
+    if (length == 8 && strncmp(name, "filtered", 8) == 0) {
+        *kind = RULE_OPERAND_FILTERED;
+        return true;
+    }
+    if (length == 5 && strncmp(name, "state", 5) == 0) {
+        *kind = RULE_OPERAND_STATE;
+        return true;
+    }
+
+    for (size_t i = 0; i < sizeof(windowed) / sizeof(windowed[0]); i++) {
+        size_t prefix_length = strlen(windowed[i].prefix);
+        if (length <= prefix_length || strncmp(name, windowed[i].prefix, prefix_length) != 0) {
+            continue;
+        }
+
+        // Width: digits followed by one unit letter
+        uint32_t width = 0;
+        size_t pos = prefix_length;
+        while (pos < length && isdigit((unsigned char)name[pos]) && width < 1000000) {
+            width = width * 10 + (uint32_t)(name[pos++] - '0');
+        }
+        if (width == 0 || pos + 1 != length) {
+            return false;
+        }
+        switch (name[pos]) {
+            case 's': break;
+            case 'm': width *= 60; break;
+            case 'h': width *= 3600; break;
+            default: return false;
+        }
+        *kind = windowed[i].kind;
+        *width_s = width;
+        return true;
+    }
+
+    return false;
+}
+
+static bool match(RuleParser* parser, const char* token) {
+    skip_space(parser);
+    size_t length = strlen(token);
+    if (strncmp(parser->pos, token, length) != 0) {
+        return false;
+    }
+    parser->pos += length;
+    return true;
+}
+
+static bool fail(RuleParser* parser, const char* at) {
+    if (!parser->error) {
+        parser->error = at;
+    }
+    return false;
+}
+
+static bool emit(RuleParser* parser, RuleOpcode opcode, uint32_t arg) {
+    RuleProgram* program = parser->program;
+    if (program->length == RULE_MAX_CODE) {
+        return fail(parser, parser->pos);
+    }
+
+    if (opcode == RULE_OP_CONST || opcode == RULE_OP_LOAD) {
+        if (parser->depth == RULE_MAX_STACK) {
+            return fail(parser, parser->pos);
+        }
+        parser->depth++;
+    } else if (opcode != RULE_OP_NEG && opcode != RULE_OP_NOT) {
+        parser->depth--;
+    }
+
+    program->code[program->length].opcode = (uint8_t)opcode;
+    program->code[program->length].arg = (uint8_t)arg;
+    program->length++;
+    return true;
+}
+
+static void skip_space(RuleParser* parser) {
+    while (isspace((unsigned char)*parser->pos)) {
+        parser->pos++;
+    }
+}
+
+static void refresh_operand(RuleEntry* rule, uint32_t index, const SensorData* data, uint32_t mark) {
+    const RuleOperand* operand = &rule->program.operands[index];
+    RuleOperandState* state = &rule->operands[index];
+    float* value = &rule->values[index];
+
+    switch (operand->kind) {
+        case RULE_OPERAND_VALUE:
+            state->valid = data->is_valid;
+            if (data->is_valid) {
+                *value = data->value;
+            }
+            break;
+
+        case RULE_OPERAND_RATE:
+            if (!data->is_valid) {
+                break;
+            }
+            if (!state->has_previous) {
+                state->has_previous = true;
+            } else if (data->timestamp > state->previous_timestamp) {
+                *value = (data->value - state->previous_value) /
+                         (float)(data->timestamp - state->previous_timestamp);
+                state->valid = true;
+            } else {
+                // Same second as the previous sample: keep the older reference
+                break;
+            }
+            state->previous_value = data->value;
+            state->previous_timestamp = data->timestamp;
+            break;
+
+        case RULE_OPERAND_FILTERED: {
+            KalmanEstimate estimate;
+            if (kalman_get_estimate(operand->sensor_id, &estimate)) {
+                *value = estimate.value;
+                state->valid = true;
+            }
+            break;
+        }
+
+        case RULE_OPERAND_STATE: {
+            OperatingStateStatus status;
+            if (operating_state_get(operand->sensor_id, &status) && status.state >= 0) {
+                *value = (float)status.state;
+                state->valid = true;
+            }
+            break;
+        }
+
+        default: {
+            // Fetch each window of the sensor once per pass, however many operands read it
+            RuleSensor* sensor = &private_data->sensors[state->sensor];
+            uint32_t window = state->window;
+            if (sensor->window_mark[window] != mark) {
+                sensor->window_mark[window] = mark;
+                sensor->window_found[window] = window_stats_get(operand->sensor_id, window,
+                                                                data->timestamp,
+                                                                &sensor->windows[window]);
+            }
+            if (!sensor->window_found[window]) {
+                break;
+            }
+            const SlidingWindowStats* stats = &sensor->windows[window];
+            state->valid = stats->count > 0 || operand->kind == RULE_OPERAND_COUNT;
+            switch (operand->kind) {
+                case RULE_OPERAND_AVG:   *value = (float)stats->mean; break;
+                case RULE_OPERAND_MIN:   *value = stats->min_value; break;
+                case RULE_OPERAND_MAX:   *value = stats->max_value; break;
+                case RULE_OPERAND_STD:   *value = (float)stats->std_deviation; break;
+                default:                 *value = (float)stats->count; break;
+            }
+            break;
+        }
+    }
+}
+
+static bool evaluate_rule(RuleEntry* rule, const Sensor* sensor, const SensorData* data) {
+    RuleStatus* status = &rule->status;
+
+    status->ready = true;
+    for (uint32_t i = 0; i < rule->program.operand_count; i++) {
+        if (!rule->operands[i].valid) {
+            status->ready = false;
+            return false;
+        }
+    }
+
+    float result = rule_program_run(&rule->program, rule->values);
+    bool active = result != 0.0f && !isnan(result);
+    status->result = result;
+    status->evaluations++;
+    if (active == status->active) {
+        return false;
+    }
+
+    status->active = active;
+    status->last_change = data->timestamp;
+    if (active) {
+        status->activations++;
+    }
+
+    MonitorEvent event;
+    memset(&event, 0, sizeof(event));
+    event.type = EVENT_RULE;
+    strncpy(event.sensor_id, rule->name, sizeof(event.sensor_id) - 1);
+    event.sensor_type = sensor->type;
+    event.timestamp = data->timestamp;
+    event.value = data->value;
+    event.from_state = active ? 0 : 1;
+    event.to_state = active ? 1 : 0;
+    event.score = result;
+    event_queue_push(&event);
+    return true;
+}
+
+static RuleEntry* find_rule(const char* name) {
+    // Linear scan; only rule management looks rules up by name
+    for (uint32_t i = 0; i < RULES_MAX_RULES; i++) {
+        RuleEntry* rule = &private_data->rules[i];
+        if (rule->used && strncmp(rule->name, name, sizeof(rule->name) - 1) == 0) {
+            return rule;
+        }
+    }
+    return NULL;
+}
+
+static RuleSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, RULES_MAX_SENSORS, RuleSensor, id);
+    bool created;
+    RuleSensor* entry = (RuleSensor*)sensor_table_find(&table, id, create, &created);
+    if (created) {
+        // Sensors stay in the table when their rules are removed
+        entry->first = -1;
+    }
+    return entry;
+}
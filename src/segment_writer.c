@@ -0,0 +1,197 @@
+/**
+ * @file segment_writer.c
+ * @brief Time-segmented CSV files for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/segment_writer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// Forward declarations of private functions
+static bool start_segment(SegmentWriter* writer, uint32_t start);
+static bool write_late(SegmentWriter* writer, uint32_t timestamp, const char* line);
+
+bool segment_writer_open(SegmentWriter* writer, const char* directory, const char* prefix,
+                         const char* header, uint32_t span_s, uint32_t max_size_kb) {
+    if (!writer || !directory || !prefix || !header || span_s == 0) {
+        return false;
+    }
+
+    memset(writer, 0, sizeof(SegmentWriter));
+    strncpy(writer->directory, directory, sizeof(writer->directory) - 1);
+    strncpy(writer->prefix, prefix, sizeof(writer->prefix) - 1);
+    strncpy(writer->header, header, sizeof(writer->header) - 1);
+    writer->span_s = span_s;
+    writer->max_size_kb = max_size_kb;
+    writer->file = NULL;
+
+    // Create directory if it doesn't exist
+    if (mkdir(writer->directory, 0755) != 0 && errno != EEXIST) {
+        return false;
+    }
+
+    return true;
+}
+
+bool segment_writer_write(SegmentWriter* writer, uint32_t timestamp, const char* line) {
+    if (!writer || !line) {
+        return false;
+    }
+
+    if (!writer->file) {
+        if (!start_segment(writer, timestamp - timestamp % writer->span_s)) {
+            return false;
+        }
+    } else if (timestamp < writer->segment_start) {
+        // Before the open segment: keep the file names bounding their contents
+        return write_late(writer, timestamp, line);
+    } else if (timestamp >= writer->segment_start - writer->segment_start % writer->span_s +
+                            writer->span_s) {
+        // Past the span: start the segment this record is aligned to
+        if (!start_segment(writer, timestamp - timestamp % writer->span_s)) {
+            return false;
+        }
+    } else if (writer->max_size_kb > 0 &&
+               writer->segment_bytes >= writer->max_size_kb * 1024u &&
+               timestamp > writer->segment_start) {
+        // Size limit reached inside the span: split at the record time
+        if (!start_segment(writer, timestamp)) {
+            return false;
+        }
+    }
+
+    int written = fprintf(writer->file, "%s\n", line);
+    if (written < 0) {
+        return false;
+    }
+    writer->segment_bytes += (uint32_t)written;
+
+    return true;
+}
+
+void segment_writer_flush(SegmentWriter* writer) {
+    if (writer && writer->file) {
+        fflush(writer->file);
+    }
+}
+
+void segment_writer_close(SegmentWriter* writer) {
+    if (writer && writer->file) {
+        fclose(writer->file);
+        writer->file = NULL;
+    }
+}
+
+bool segment_writer_path(char* path, size_t size, const char* directory, const char* prefix,
+                         uint32_t start) {
+    if (!path || !directory || !prefix) {
+        return false;
+    }
+
+    int length = snprintf(path, size, "%s/%s-%010u%s", directory, prefix, start, SEGMENT_SUFFIX);
+    return length > 0 && (size_t)length < size;
+}
+
+bool segment_writer_parse_name(const char* name, const char* prefix, uint32_t* start) {
+    if (!name || !prefix || !start) {
+        return false;
+    }
+
+    size_t prefix_length = strlen(prefix);
+    if (strncmp(name, prefix, prefix_length) != 0 || name[prefix_length] != '-') {
+        return false;
+    }
+
+    // Exactly ten digits followed by the suffix
+    const char* digits = name + prefix_length + 1;
+    uint32_t value = 0;
+    for (int i = 0; i < 10; i++) {
+        if (digits[i] < '0' || digits[i] > '9') {
+            return false;
+        }
+        value = value * 10u + (uint32_t)(digits[i] - '0');
+    }
+    if (strcmp(digits + 10, SEGMENT_SUFFIX) != 0) {
+        return false;
+    }
+
+    *start = value;
+    return true;
+}
+
+// Private helper functions
+static bool start_segment(SegmentWriter* writer, uint32_t start) {
+    char path[256];
+
+    segment_writer_close(writer);
+
+    if (!segment_writer_path(path, sizeof(path), writer->directory, writer->prefix, start)) {
+        return false;
+    }
+
+    // Append so that a restart within the same span continues the segment
+    writer->file = fopen(path, "a");
+    if (!writer->file) {
+        return false;
+    }
+
+    writer->segment_start = start;
+    writer->segment_bytes = (uint32_t)ftell(writer->file);
+
+    if (writer->segment_bytes == 0) {
+        int written = fprintf(writer->file, "%s\n", writer->header);
+        if (written < 0) {
+            return false;
+        }
+        writer->segment_bytes = (uint32_t)written;
+    }
+
+    return true;
+}
+
+static bool write_late(SegmentWriter* writer, uint32_t timestamp, const char* line) {
+    DIR* dir = opendir(writer->directory);
+    if (!dir) {
+        return false;
+    }
+
+    // The segment covering the record is the latest one starting at or before it; with
+    // none left, the record starts the segment its span is aligned to
+    uint32_t start = timestamp - timestamp % writer->span_s;
+    bool found = false;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        uint32_t segment_start;
+        if (segment_writer_parse_name(entry->d_name, writer->prefix, &segment_start) &&
+            segment_start <= timestamp && (!found || segment_start > start)) {
+            start = segment_start;
+            found = true;
+        }
+    }
+    closedir(dir);
+
+    char path[256];
+    if (!segment_writer_path(path, sizeof(path), writer->directory, writer->prefix, start)) {
+        return false;
+    }
+    FILE* file = fopen(path, "a");
+    if (!file) {
+        return false;
+    }
+
+    bool result = (ftell(file) > 0 || fprintf(file, "%s\n", writer->header) >= 0) &&
+                  fprintf(file, "%s\n", line) >= 0;
+    if (fclose(file) != 0) {
+        result = false;
+    }
+    if (result) {
+        writer->late_records++;
+    }
+    return result;
+}
@@ -6,7 +6,9 @@
  */
 
 #include "../include/sensor.h"
+#include "../include/value_cache.h"
 #include <string.h>
+#include <strings.h>
 #include <time.h>
 
 // Error message strings
@@ -156,9 +158,13 @@ bool sensor_read_data(Sensor* sensor, SensorData* data) {
     if (!sensor->read(data)) {
         sensor->last_error = data->error;
         sensor->error_count++;
+        value_cache_update(sensor, data);
         return false;
     }
 
+    // Publish the reading so that consumers of the current value never call the driver
+    value_cache_update(sensor, data);
+
     sensor->last_error = SENSOR_ERROR_NONE;
     return true;
 }
@@ -183,6 +189,36 @@ const char* sensor_type_to_string(SensorType type) {
     return sensor_type_strings[type];
 }
 
+bool sensor_string_to_type(const char* type_str, SensorType* type) {
+    if (!type_str || !type) {
+        return false;
+    }
+
+    for (size_t i = 0; i < sizeof(sensor_type_strings) / sizeof(sensor_type_strings[0]); i++) {
+        if (strcasecmp(type_str, sensor_type_strings[i]) == 0) {
+            *type = (SensorType)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool sensor_string_to_error(const char* error_str, SensorError* error) {
+    if (!error_str || !error) {
+        return false;
+    }
+
+    for (size_t i = 0; i < sizeof(error_messages) / sizeof(error_messages[0]); i++) {
+        if (strcasecmp(error_str, error_messages[i]) == 0) {
+            *error = (SensorError)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void sensor_set_name(Sensor* sensor, const char* name) {
     if (sensor && name) {
         strncpy(sensor->name, name, sizeof(sensor->name) - 1);
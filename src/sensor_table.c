@@ -0,0 +1,53 @@
+/**
+ * @file sensor_table.c
+ * @brief Per-sensor lookup tables for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/sensor_table.h"
+#include <stdio.h>
+#include <string.h>
+
+uint32_t sensor_table_hash(const char* id) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    while (*id) {
+        hash ^= (uint8_t)*id++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void* sensor_table_find(const SensorTable* table, const char* id, bool create, bool* created) {
+    if (created) {
+        *created = false;
+    }
+    if (!table || !id || id[0] == '\0') {
+        return NULL;
+    }
+
+    uint32_t mask = table->capacity - 1;
+    uint32_t slot = sensor_table_hash(id) & mask;
+
+    // Linear probing; entries are never removed, so a free entry ends the sequence
+    for (uint32_t probe = 0; probe < table->capacity; probe++) {
+        char* entry = (char*)table->entries + (size_t)((slot + probe) & mask) * table->entry_size;
+        char* entry_id = entry + table->id_offset;
+        if (entry_id[0] == '\0') {
+            if (!create) {
+                return NULL;
+            }
+            snprintf(entry_id, table->id_size, "%s", id);
+            if (created) {
+                *created = true;
+            }
+            return entry;
+        }
+        if (strncmp(entry_id, id, table->id_size - 1) == 0) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
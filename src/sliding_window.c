@@ -0,0 +1,203 @@
+/**
+ * @file sliding_window.c
+ * @brief Time-based sliding window statistics for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/sliding_window.h"
+#include <string.h>
+#include <math.h>
+
+// Forward declarations of private functions
+static void close_bucket(SlidingWindow* window, uint32_t number);
+static void evict_bucket(SlidingWindow* window);
+static void reset_window(SlidingWindow* window, uint32_t current);
+static SlidingWindowBucket* bucket_at(SlidingWindow* window, uint32_t number);
+
+bool sliding_window_init(SlidingWindow* window, uint32_t width_s) {
+    if (!window || width_s == 0 || width_s % SLIDING_WINDOW_BUCKETS != 0) {
+        return false;
+    }
+
+    memset(window, 0, sizeof(SlidingWindow));
+    window->width_s = width_s;
+    window->bucket_s = width_s / SLIDING_WINDOW_BUCKETS;
+    return true;
+}
+
+void sliding_window_add(SlidingWindow* window, uint32_t timestamp, float value) {
+    if (!window || window->bucket_s == 0) {
+        return;
+    }
+
+    if (!window->started) {
+        window->started = true;
+        window->current = timestamp / window->bucket_s;
+    } else {
+        sliding_window_advance(window, timestamp);
+    }
+
+    // Re-centre the sums on the first sample of an empty window
+    SlidingWindowBucket* open = bucket_at(window, window->current);
+    if (window->count == 0 && open->count == 0) {
+        window->shift = value;
+        window->sum = 0.0;
+        window->sum_squares = 0.0;
+    }
+
+    double shifted = (double)value - window->shift;
+    if (open->count == 0 || value < open->min_value) {
+        open->min_value = value;
+    }
+    if (open->count == 0 || value > open->max_value) {
+        open->max_value = value;
+    }
+    open->count++;
+    open->sum += shifted;
+    open->sum_squares += shifted * shifted;
+}
+
+void sliding_window_advance(SlidingWindow* window, uint32_t now) {
+    if (!window || !window->started) {
+        return;
+    }
+
+    uint32_t target = now / window->bucket_s;
+    if (target <= window->current) {
+        return;
+    }
+
+    // After a gap of a whole window nothing survives; start over without stepping
+    if (target - window->current >= SLIDING_WINDOW_BUCKETS) {
+        reset_window(window, target);
+        return;
+    }
+
+    while (window->current < target) {
+        close_bucket(window, window->current);
+        window->current++;
+        evict_bucket(window);
+    }
+}
+
+void sliding_window_get(SlidingWindow* window, uint32_t now, SlidingWindowStats* stats) {
+    if (!stats) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(SlidingWindowStats));
+    if (!window || !window->started) {
+        return;
+    }
+
+    sliding_window_advance(window, now);
+
+    const SlidingWindowBucket* open = bucket_at(window, window->current);
+    uint64_t count = window->count + open->count;
+    if (count == 0) {
+        return;
+    }
+
+    double sum = window->sum + open->sum;
+    double sum_squares = window->sum_squares + open->sum_squares;
+    double mean = sum / (double)count;
+    double variance = sum_squares / (double)count - mean * mean;
+
+    stats->count = count;
+    stats->mean = window->shift + mean;
+    stats->std_deviation = (count > 1 && variance > 0.0) ? sqrt(variance) : 0.0;
+
+    bool have_closed = window->min_size > 0;
+    float min_value = have_closed ?
+        bucket_at(window, window->min_deque[window->min_head])->min_value : open->min_value;
+    float max_value = have_closed ?
+        bucket_at(window, window->max_deque[window->max_head])->max_value : open->max_value;
+    if (open->count > 0) {
+        if (open->min_value < min_value) {
+            min_value = open->min_value;
+        }
+        if (open->max_value > max_value) {
+            max_value = open->max_value;
+        }
+    }
+    stats->min_value = min_value;
+    stats->max_value = max_value;
+}
+
+// Private helper functions
+static SlidingWindowBucket* bucket_at(SlidingWindow* window, uint32_t number) {
+    return &window->buckets[number % SLIDING_WINDOW_BUCKETS];
+}
+
+static void close_bucket(SlidingWindow* window, uint32_t number) {
+    const SlidingWindowBucket* bucket = bucket_at(window, number);
+    if (bucket->count == 0) {
+        return;
+    }
+
+    window->count += bucket->count;
+    window->sum += bucket->sum;
+    window->sum_squares += bucket->sum_squares;
+
+    // Drop entries the new bucket dominates, then append it
+    while (window->min_size > 0) {
+        uint32_t back = (window->min_head + window->min_size - 1) % SLIDING_WINDOW_BUCKETS;
+        if (bucket_at(window, window->min_deque[back])->min_value < bucket->min_value) {
+            break;
+        }
+        window->min_size--;
+    }
+    window->min_deque[(window->min_head + window->min_size) % SLIDING_WINDOW_BUCKETS] = number;
+    window->min_size++;
+
+    while (window->max_size > 0) {
+        uint32_t back = (window->max_head + window->max_size - 1) % SLIDING_WINDOW_BUCKETS;
+        if (bucket_at(window, window->max_deque[back])->max_value > bucket->max_value) {
+            break;
+        }
+        window->max_size--;
+    }
+    window->max_deque[(window->max_head + window->max_size) % SLIDING_WINDOW_BUCKETS] = number;
+    window->max_size++;
+}
+
+static void evict_bucket(SlidingWindow* window) {
+    // The bucket that drops out shares its ring slot with the new open bucket
+    uint32_t number = window->current - SLIDING_WINDOW_BUCKETS;
+    SlidingWindowBucket* bucket = bucket_at(window, window->current);
+
+    if (bucket->count > 0) {
+        window->count -= bucket->count;
+        window->sum -= bucket->sum;
+        window->sum_squares -= bucket->sum_squares;
+        if (window->count == 0) {
+            // Clear accumulated rounding while the window is empty
+            window->sum = 0.0;
+            window->sum_squares = 0.0;
+        }
+
+        if (window->min_size > 0 && window->min_deque[window->min_head] == number) {
+            window->min_head = (window->min_head + 1) % SLIDING_WINDOW_BUCKETS;
+            window->min_size--;
+        }
+        if (window->max_size > 0 && window->max_deque[window->max_head] == number) {
+            window->max_head = (window->max_head + 1) % SLIDING_WINDOW_BUCKETS;
+            window->max_size--;
+        }
+    }
+
+    memset(bucket, 0, sizeof(SlidingWindowBucket));
+}
+
+static void reset_window(SlidingWindow* window, uint32_t current) {
+    memset(window->buckets, 0, sizeof(window->buckets));
+    window->current = current;
+    window->count = 0;
+    window->sum = 0.0;
+    window->sum_squares = 0.0;
+    window->min_head = 0;
+    window->min_size = 0;
+    window->max_head = 0;
+    window->max_size = 0;
+}
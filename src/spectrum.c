@@ -0,0 +1,112 @@
+/**
+ * @file spectrum.c
+ * @brief Streaming spectral analysis for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/spectrum.h"
+#include <string.h>
+#include <math.h>
+
+// Forward declarations of private functions
+static void analyze_block(SpectrumAnalyzer* analyzer, FftPlan* plan, SpectrumFrame* frame);
+
+bool spectrum_analyzer_init(SpectrumAnalyzer* analyzer, const SpectrumConfig* config) {
+    if (!analyzer || !config || config->sample_rate <= 0.0f || config->fft_size < FFT_MIN_SIZE ||
+        config->fft_size > FFT_MAX_SIZE || (config->fft_size & (config->fft_size - 1)) != 0 ||
+        config->hop == 0 || config->hop > config->fft_size ||
+        config->band_count > SPECTRUM_MAX_BANDS || config->peak_count > SPECTRUM_MAX_PEAKS) {
+        return false;
+    }
+    for (uint32_t i = 0; i < config->band_count; i++) {
+        if (config->band_edges_hz[i + 1] <= config->band_edges_hz[i]) {
+            return false;
+        }
+    }
+
+    memcpy(&analyzer->config, config, sizeof(SpectrumConfig));
+    analyzer->fill = 0;
+    analyzer->block_start = 0;
+    return true;
+}
+
+uint32_t spectrum_analyzer_push(SpectrumAnalyzer* analyzer, FftPlan* plan, const float* samples,
+                                size_t count, SpectrumCallback callback, void* context) {
+    if (!analyzer || !plan || (!samples && count > 0) ||
+        plan->size != analyzer->config.fft_size || plan->window != analyzer->config.window) {
+        return 0;
+    }
+
+    uint32_t size = analyzer->config.fft_size;
+    uint32_t hop = analyzer->config.hop;
+    uint32_t frames = 0;
+
+    while (count > 0) {
+        uint32_t take = size - analyzer->fill;
+        if (take > count) {
+            take = (uint32_t)count;
+        }
+        memcpy(analyzer->block + analyzer->fill, samples, take * sizeof(float));
+        analyzer->fill += take;
+        samples += take;
+        count -= take;
+
+        if (analyzer->fill < size) {
+            break;
+        }
+
+        SpectrumFrame frame;
+        analyze_block(analyzer, plan, &frame);
+        frames++;
+        if (callback) {
+            callback(&frame, context);
+        }
+
+        // Keep the overlap as the start of the next block
+        memmove(analyzer->block, analyzer->block + hop, (size - hop) * sizeof(float));
+        analyzer->fill = size - hop;
+        analyzer->block_start += hop;
+    }
+
+    return frames;
+}
+
+void spectrum_get_default_config(SpectrumConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    static const float edges[] = { 10.0f, 1000.0f, 2000.0f, 5000.0f, 10000.0f };
+
+    memset(config, 0, sizeof(SpectrumConfig));
+    config->sample_rate = 25600.0f;
+    config->fft_size = 4096;
+    config->hop = 2048;
+    config->window = FFT_WINDOW_HANN;
+    config->band_count = sizeof(edges) / sizeof(edges[0]) - 1;
+    memcpy(config->band_edges_hz, edges, sizeof(edges));
+    config->peak_count = 5;
+}
+
+// Private helper functions
+static void analyze_block(SpectrumAnalyzer* analyzer, FftPlan* plan, SpectrumFrame* frame) {
+    const SpectrumConfig* config = &analyzer->config;
+
+    fft_power_spectrum(plan, analyzer->block, analyzer->power);
+
+    double total = 0.0;
+    for (uint32_t k = 0; k <= config->fft_size / 2; k++) {
+        total += analyzer->power[k];
+    }
+
+    frame->first_sample = analyzer->block_start;
+    frame->rms = (float)sqrt(total);
+    memset(frame->band_energy, 0, sizeof(frame->band_energy));
+    for (uint32_t i = 0; i < config->band_count; i++) {
+        frame->band_energy[i] = fft_band_energy(plan, analyzer->power, config->sample_rate,
+                                                config->band_edges_hz[i], config->band_edges_hz[i + 1]);
+    }
+    frame->peak_count = fft_find_peaks(plan, analyzer->power, config->sample_rate,
+                                       frame->peaks, config->peak_count);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file stream_stats.c
+ * @brief Streaming statistics accumulators for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/stream_stats.h"
+#include <math.h>
+
+// Forward declarations of private functions
+static void kahan_add(StreamStats* stats, double value);
+
+void stream_stats_init(StreamStats* stats) {
+    if (!stats) {
+        return;
+    }
+
+    stats->count = 0;
+    stats->mean = 0.0;
+    stats->m2 = 0.0;
+    stats->sum = 0.0;
+    stats->compensation = 0.0;
+    stats->min = INFINITY;
+    stats->max = -INFINITY;
+}
+
+void stream_stats_add(StreamStats* stats, double value) {
+    if (!stats) {
+        return;
+    }
+
+    stats->count++;
+    double delta = value - stats->mean;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * (value - stats->mean);
+    kahan_add(stats, value);
+
+    if (value < stats->min) {
+        stats->min = value;
+    }
+    if (value > stats->max) {
+        stats->max = value;
+    }
+}
+
+void stream_stats_merge(StreamStats* stats, const StreamStats* other) {
+    if (!stats || !other || other->count == 0) {
+        return;
+    }
+    if (stats->count == 0) {
+        *stats = *other;
+        return;
+    }
+
+    // Chan et al. pairwise combination of mean and squared deviations
+    double count = (double)stats->count + (double)other->count;
+    double delta = other->mean - stats->mean;
+    stats->mean += delta * (double)other->count / count;
+    stats->m2 += other->m2 + delta * delta * (double)stats->count * (double)other->count / count;
+    stats->count += other->count;
+
+    kahan_add(stats, other->sum);
+    kahan_add(stats, -other->compensation);
+
+    if (other->min < stats->min) {
+        stats->min = other->min;
+    }
+    if (other->max > stats->max) {
+        stats->max = other->max;
+    }
+}
+
+double stream_stats_mean(const StreamStats* stats) {
+    if (!stats || stats->count == 0) {
+        return 0.0;
+    }
+
+    // The compensated sum's error stays within about two ulps of the sum of |x|, whatever
+    // the count, where a plain sum grows with it; the Welford mean only drives m2
+    return (stats->sum - stats->compensation) / (double)stats->count;
+}
+
+double stream_stats_variance(const StreamStats* stats) {
+    if (!stats || stats->count < 2) {
+        return 0.0;
+    }
+
+    double variance = stats->m2 / (double)stats->count;
+    return variance > 0.0 ? variance : 0.0;
+}
+
+double stream_stats_stddev(const StreamStats* stats) {
+    return sqrt(stream_stats_variance(stats));
+}
+
+// Private helper functions
+static void kahan_add(StreamStats* stats, double value) {
+    double y = value - stats->compensation;
+    double t = stats->sum + y;
+    stats->compensation = (t - stats->sum) - y;
+    stats->sum = t;
+}
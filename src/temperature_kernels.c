@@ -0,0 +1,505 @@
+/**
+ * @file temperature_kernels.c
+ * @brief Batch dew point and heat index kernels for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Dew point uses the Magnus formula (Sonntag 1990 coefficients) and heat index the NWS
+ * Rothfusz regression with its low- and high-humidity adjustments. The natural log in
+ * the Magnus formula is a Cephes-style polynomial on the float mantissa, accurate to a
+ * few ulp for the normal range the clamped humidity allows.
+ *
+ * The AVX2, SSE2 and NEON kernels and the scalar code perform the same IEEE operations
+ * in the same order, with contraction into fused multiply-add disabled for this file,
+ * so every path returns bit-identical results. The widest path the CPU supports is
+ * chosen at run time on x86; the scalar code handles array tails and other targets.
+ */
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#include "../include/temperature_sensor.h"
+#include <string.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KERNELS_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define KERNELS_NEON 1
+#endif
+
+// Magnus coefficients over water, -45..60 °C
+#define MAGNUS_B 17.62f
+#define MAGNUS_C 243.12f
+
+// Humidity is clamped so the logarithm stays finite
+#define HUMIDITY_MIN 0.1f
+#define HUMIDITY_MAX 100.0f
+
+// Natural log polynomial (Cephes logf)
+#define LOG_SQRTHF 0.707106781186547524f
+#define LOG_P0 7.0376836292e-2f
+#define LOG_P1 -1.1514610310e-1f
+#define LOG_P2 1.1676998740e-1f
+#define LOG_P3 -1.2420140846e-1f
+#define LOG_P4 1.4249322787e-1f
+#define LOG_P5 -1.6668057665e-1f
+#define LOG_P6 2.0000714765e-1f
+#define LOG_P7 -2.4999993993e-1f
+#define LOG_P8 3.3333331174e-1f
+#define LOG_Q1 -2.12194440e-4f
+#define LOG_Q2 0.693359375f
+
+// Rothfusz regression, °F and %
+#define HI_C1 -42.379f
+#define HI_C2 2.04901523f
+#define HI_C3 10.14333127f
+#define HI_C4 -0.22475541f
+#define HI_C5 -6.83783e-3f
+#define HI_C6 -5.481717e-2f
+#define HI_C7 1.22874e-3f
+#define HI_C8 8.5282e-4f
+#define HI_C9 -1.99e-6f
+
+// Forward declarations of private functions
+static float fast_logf(float x);
+static float dew_point_scalar(float t, float rh);
+static float heat_index_scalar(float t, float rh);
+#ifdef KERNELS_X86
+static size_t dew_point_avx2(const float* t, const float* rh, float* out, size_t n);
+static size_t heat_index_avx2(const float* t, const float* rh, float* out, size_t n);
+static size_t dew_point_sse2(const float* t, const float* rh, float* out, size_t n);
+static size_t heat_index_sse2(const float* t, const float* rh, float* out, size_t n);
+static bool has_avx2(void);
+#endif
+#ifdef KERNELS_NEON
+static size_t dew_point_neon(const float* t, const float* rh, float* out, size_t n);
+static size_t heat_index_neon(const float* t, const float* rh, float* out, size_t n);
+#endif
+
+void temperature_sensor_dew_point_batch(const float* t, const float* rh, float* out, size_t n) {
+    if (!t || !rh || !out) {
+        return;
+    }
+
+    size_t done = 0;
+#if defined(KERNELS_X86)
+    done = has_avx2() ? dew_point_avx2(t, rh, out, n) : dew_point_sse2(t, rh, out, n);
+#elif defined(KERNELS_NEON)
+    done = dew_point_neon(t, rh, out, n);
+#endif
+    for (size_t i = done; i < n; i++) {
+        out[i] = dew_point_scalar(t[i], rh[i]);
+    }
+}
+
+void temperature_sensor_heat_index_batch(const float* t, const float* rh, float* out, size_t n) {
+    if (!t || !rh || !out) {
+        return;
+    }
+
+    size_t done = 0;
+#if defined(KERNELS_X86)
+    done = has_avx2() ? heat_index_avx2(t, rh, out, n) : heat_index_sse2(t, rh, out, n);
+#elif defined(KERNELS_NEON)
+    done = heat_index_neon(t, rh, out, n);
+#endif
+    for (size_t i = done; i < n; i++) {
+        out[i] = heat_index_scalar(t[i], rh[i]);
+    }
+}
+
+float temperature_sensor_calculate_dew_point(float temperature, float humidity) {
+    return dew_point_scalar(temperature, humidity);
+}
+
+float temperature_sensor_calculate_heat_index(float temperature, float humidity) {
+    return heat_index_scalar(temperature, humidity);
+}
+
+// Private helper functions
+static float fast_logf(float x) {
+    // x = m * 2^e with m in [0.5, 1); valid for positive normal x
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    float e = (float)((int32_t)(bits >> 23) - 126);
+    bits = (bits & 0x007FFFFFu) | 0x3F000000u;
+    float m;
+    memcpy(&m, &bits, sizeof(m));
+
+    // Centre the mantissa on 1: m in [sqrt(0.5), sqrt(2)) after the fold
+    bool fold = m < LOG_SQRTHF;
+    e = e - (fold ? 1.0f : 0.0f);
+    m = (m + (fold ? m : 0.0f)) - 1.0f;
+
+    float z = m * m;
+    float y = LOG_P0;
+    y = y * m + LOG_P1;
+    y = y * m + LOG_P2;
+    y = y * m + LOG_P3;
+    y = y * m + LOG_P4;
+    y = y * m + LOG_P5;
+    y = y * m + LOG_P6;
+    y = y * m + LOG_P7;
+    y = y * m + LOG_P8;
+    y = (y * m) * z;
+    y = y + LOG_Q1 * e;
+    y = y + -0.5f * z;
+    float r = m + y;
+    return r + LOG_Q2 * e;
+}
+
+static float dew_point_scalar(float t, float rh) {
+    rh = rh > HUMIDITY_MIN ? rh : HUMIDITY_MIN;
+    rh = rh < HUMIDITY_MAX ? rh : HUMIDITY_MAX;
+    float gamma = fast_logf(rh * 0.01f) + (MAGNUS_B * t) / (MAGNUS_C + t);
+    return (MAGNUS_C * gamma) / (MAGNUS_B - gamma);
+}
+
+static float heat_index_scalar(float t, float rh) {
+    float f = t * 1.8f + 32.0f;
+
+    // NWS: the simple Steadman estimate applies below 80 °F
+    float simple = 0.5f * (((f + 61.0f) + (f - 68.0f) * 1.2f) + rh * 0.094f);
+
+    float f2 = f * f;
+    float rh2 = rh * rh;
+    float full = HI_C1 + HI_C2 * f;
+    full = full + HI_C3 * rh;
+    full = full + HI_C4 * (f * rh);
+    full = full + HI_C5 * f2;
+    full = full + HI_C6 * rh2;
+    full = full + HI_C7 * (f2 * rh);
+    full = full + HI_C8 * (f * rh2);
+    full = full + HI_C9 * (f2 * rh2);
+
+    // Dry air adjustment, RH < 13 % and 80..112 °F
+    float span = (17.0f - fabsf(f - 95.0f)) / 17.0f;
+    span = span > 0.0f ? span : 0.0f;
+    float dry = ((13.0f - rh) * 0.25f) * sqrtf(span);
+    bool is_dry = rh < 13.0f && f > 80.0f && f < 112.0f;
+    full = full - (is_dry ? dry : 0.0f);
+
+    // Humid air adjustment, RH > 85 % and 80..87 °F
+    float humid = ((rh - 85.0f) * 0.1f) * ((87.0f - f) * 0.2f);
+    bool is_humid = rh > 85.0f && f > 80.0f && f < 87.0f;
+    full = full + (is_humid ? humid : 0.0f);
+
+    float hi = ((simple + f) * 0.5f >= 80.0f) ? full : simple;
+    return (hi - 32.0f) / 1.8f;
+}
+
+#ifdef KERNELS_X86
+static bool has_avx2(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return supported == 1;
+}
+
+__attribute__((target("sse2")))
+static inline __m128 log_sse2(__m128 x) {
+    __m128i bits = _mm_castps_si128(x);
+    __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+    bits = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F000000));
+    __m128 m = _mm_castsi128_ps(bits);
+
+    __m128 fold = _mm_cmplt_ps(m, _mm_set1_ps(LOG_SQRTHF));
+    e = _mm_sub_ps(e, _mm_and_ps(fold, _mm_set1_ps(1.0f)));
+    m = _mm_sub_ps(_mm_add_ps(m, _mm_and_ps(fold, m)), _mm_set1_ps(1.0f));
+
+    __m128 z = _mm_mul_ps(m, m);
+    __m128 y = _mm_set1_ps(LOG_P0);
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(LOG_P1));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(LOG_P2));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(LOG_P3));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(LOG_P4));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(LOG_P5));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(LOG_P6));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(LOG_P7));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(LOG_P8));
+    y = _mm_mul_ps(_mm_mul_ps(y, m), z);
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(LOG_Q1), e));
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(-0.5f), z));
+    __m128 r = _mm_add_ps(m, y);
+    return _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(LOG_Q2), e));
+}
+
+__attribute__((target("sse2")))
+static size_t dew_point_sse2(const float* t, const float* rh, float* out, size_t n) {
+    const __m128 b = _mm_set1_ps(MAGNUS_B);
+    const __m128 c = _mm_set1_ps(MAGNUS_C);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 tv = _mm_loadu_ps(t + i);
+        __m128 hv = _mm_loadu_ps(rh + i);
+        hv = _mm_max_ps(hv, _mm_set1_ps(HUMIDITY_MIN));
+        hv = _mm_min_ps(hv, _mm_set1_ps(HUMIDITY_MAX));
+        __m128 gamma = _mm_add_ps(log_sse2(_mm_mul_ps(hv, _mm_set1_ps(0.01f))),
+                                  _mm_div_ps(_mm_mul_ps(b, tv), _mm_add_ps(c, tv)));
+        _mm_storeu_ps(out + i, _mm_div_ps(_mm_mul_ps(c, gamma), _mm_sub_ps(b, gamma)));
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static inline __m128 select_sse2(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+__attribute__((target("sse2")))
+static size_t heat_index_sse2(const float* t, const float* rh, float* out, size_t n) {
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 tv = _mm_loadu_ps(t + i);
+        __m128 h = _mm_loadu_ps(rh + i);
+        __m128 f = _mm_add_ps(_mm_mul_ps(tv, _mm_set1_ps(1.8f)), _mm_set1_ps(32.0f));
+
+        __m128 simple = _mm_add_ps(_mm_add_ps(_mm_add_ps(f, _mm_set1_ps(61.0f)),
+                                              _mm_mul_ps(_mm_sub_ps(f, _mm_set1_ps(68.0f)), _mm_set1_ps(1.2f))),
+                                   _mm_mul_ps(h, _mm_set1_ps(0.094f)));
+        simple = _mm_mul_ps(_mm_set1_ps(0.5f), simple);
+
+        __m128 f2 = _mm_mul_ps(f, f);
+        __m128 h2 = _mm_mul_ps(h, h);
+        __m128 full = _mm_add_ps(_mm_set1_ps(HI_C1), _mm_mul_ps(_mm_set1_ps(HI_C2), f));
+        full = _mm_add_ps(full, _mm_mul_ps(_mm_set1_ps(HI_C3), h));
+        full = _mm_add_ps(full, _mm_mul_ps(_mm_set1_ps(HI_C4), _mm_mul_ps(f, h)));
+        full = _mm_add_ps(full, _mm_mul_ps(_mm_set1_ps(HI_C5), f2));
+        full = _mm_add_ps(full, _mm_mul_ps(_mm_set1_ps(HI_C6), h2));
+        full = _mm_add_ps(full, _mm_mul_ps(_mm_set1_ps(HI_C7), _mm_mul_ps(f2, h)));
+        full = _mm_add_ps(full, _mm_mul_ps(_mm_set1_ps(HI_C8), _mm_mul_ps(f, h2)));
+        full = _mm_add_ps(full, _mm_mul_ps(_mm_set1_ps(HI_C9), _mm_mul_ps(f2, h2)));
+
+        __m128 distance = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(f, _mm_set1_ps(95.0f)));
+        __m128 span = _mm_div_ps(_mm_sub_ps(_mm_set1_ps(17.0f), distance), _mm_set1_ps(17.0f));
+        span = _mm_max_ps(span, _mm_setzero_ps());
+        __m128 dry = _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(13.0f), h), _mm_set1_ps(0.25f)),
+                                _mm_sqrt_ps(span));
+        __m128 hot = _mm_and_ps(_mm_cmpgt_ps(f, _mm_set1_ps(80.0f)), _mm_cmplt_ps(f, _mm_set1_ps(112.0f)));
+        __m128 is_dry = _mm_and_ps(_mm_cmplt_ps(h, _mm_set1_ps(13.0f)), hot);
+        full = _mm_sub_ps(full, _mm_and_ps(is_dry, dry));
+
+        __m128 humid = _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(h, _mm_set1_ps(85.0f)), _mm_set1_ps(0.1f)),
+                                  _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(87.0f), f), _mm_set1_ps(0.2f)));
+        __m128 warm = _mm_and_ps(_mm_cmpgt_ps(f, _mm_set1_ps(80.0f)), _mm_cmplt_ps(f, _mm_set1_ps(87.0f)));
+        __m128 is_humid = _mm_and_ps(_mm_cmpgt_ps(h, _mm_set1_ps(85.0f)), warm);
+        full = _mm_add_ps(full, _mm_and_ps(is_humid, humid));
+
+        __m128 use_full = _mm_cmpge_ps(_mm_mul_ps(_mm_add_ps(simple, f), _mm_set1_ps(0.5f)),
+                                       _mm_set1_ps(80.0f));
+        __m128 hi = select_sse2(use_full, full, simple);
+        _mm_storeu_ps(out + i, _mm_div_ps(_mm_sub_ps(hi, _mm_set1_ps(32.0f)), _mm_set1_ps(1.8f)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static inline __m256 log_avx2(__m256 x) {
+    __m256i bits = _mm256_castps_si256(x);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+    bits = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)),
+                           _mm256_set1_epi32(0x3F000000));
+    __m256 m = _mm256_castsi256_ps(bits);
+
+    __m256 fold = _mm256_cmp_ps(m, _mm256_set1_ps(LOG_SQRTHF), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(fold, _mm256_set1_ps(1.0f)));
+    m = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(fold, m)), _mm256_set1_ps(1.0f));
+
+    __m256 z = _mm256_mul_ps(m, m);
+    __m256 y = _mm256_set1_ps(LOG_P0);
+    y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(LOG_P1));
+    y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(LOG_P2));
+    y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(LOG_P3));
+    y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(LOG_P4));
+    y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(LOG_P5));
+    y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(LOG_P6));
+    y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(LOG_P7));
+    y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(LOG_P8));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, m), z);
+    y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(LOG_Q1), e));
+    y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(-0.5f), z));
+    __m256 r = _mm256_add_ps(m, y);
+    return _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(LOG_Q2), e));
+}
+
+__attribute__((target("avx2")))
+static size_t dew_point_avx2(const float* t, const float* rh, float* out, size_t n) {
+    const __m256 b = _mm256_set1_ps(MAGNUS_B);
+    const __m256 c = _mm256_set1_ps(MAGNUS_C);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 tv = _mm256_loadu_ps(t + i);
+        __m256 hv = _mm256_loadu_ps(rh + i);
+        hv = _mm256_max_ps(hv, _mm256_set1_ps(HUMIDITY_MIN));
+        hv = _mm256_min_ps(hv, _mm256_set1_ps(HUMIDITY_MAX));
+        __m256 gamma = _mm256_add_ps(log_avx2(_mm256_mul_ps(hv, _mm256_set1_ps(0.01f))),
+                                     _mm256_div_ps(_mm256_mul_ps(b, tv), _mm256_add_ps(c, tv)));
+        _mm256_storeu_ps(out + i, _mm256_div_ps(_mm256_mul_ps(c, gamma), _mm256_sub_ps(b, gamma)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t heat_index_avx2(const float* t, const float* rh, float* out, size_t n) {
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 tv = _mm256_loadu_ps(t + i);
+        __m256 h = _mm256_loadu_ps(rh + i);
+        __m256 f = _mm256_add_ps(_mm256_mul_ps(tv, _mm256_set1_ps(1.8f)), _mm256_set1_ps(32.0f));
+
+        __m256 simple = _mm256_add_ps(
+            _mm256_add_ps(_mm256_add_ps(f, _mm256_set1_ps(61.0f)),
+                          _mm256_mul_ps(_mm256_sub_ps(f, _mm256_set1_ps(68.0f)), _mm256_set1_ps(1.2f))),
+            _mm256_mul_ps(h, _mm256_set1_ps(0.094f)));
+        simple = _mm256_mul_ps(_mm256_set1_ps(0.5f), simple);
+
+        __m256 f2 = _mm256_mul_ps(f, f);
+        __m256 h2 = _mm256_mul_ps(h, h);
+        __m256 full = _mm256_add_ps(_mm256_set1_ps(HI_C1), _mm256_mul_ps(_mm256_set1_ps(HI_C2), f));
+        full = _mm256_add_ps(full, _mm256_mul_ps(_mm256_set1_ps(HI_C3), h));
+        full = _mm256_add_ps(full, _mm256_mul_ps(_mm256_set1_ps(HI_C4), _mm256_mul_ps(f, h)));
+        full = _mm256_add_ps(full, _mm256_mul_ps(_mm256_set1_ps(HI_C5), f2));
+        full = _mm256_add_ps(full, _mm256_mul_ps(_mm256_set1_ps(HI_C6), h2));
+        full = _mm256_add_ps(full, _mm256_mul_ps(_mm256_set1_ps(HI_C7), _mm256_mul_ps(f2, h)));
+        full = _mm256_add_ps(full, _mm256_mul_ps(_mm256_set1_ps(HI_C8), _mm256_mul_ps(f, h2)));
+        full = _mm256_add_ps(full, _mm256_mul_ps(_mm256_set1_ps(HI_C9), _mm256_mul_ps(f2, h2)));
+
+        __m256 distance = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _mm256_sub_ps(f, _mm256_set1_ps(95.0f)));
+        __m256 span = _mm256_div_ps(_mm256_sub_ps(_mm256_set1_ps(17.0f), distance), _mm256_set1_ps(17.0f));
+        span = _mm256_max_ps(span, _mm256_setzero_ps());
+        __m256 dry = _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(13.0f), h), _mm256_set1_ps(0.25f)),
+                                   _mm256_sqrt_ps(span));
+        __m256 hot = _mm256_and_ps(_mm256_cmp_ps(f, _mm256_set1_ps(80.0f), _CMP_GT_OQ),
+                                   _mm256_cmp_ps(f, _mm256_set1_ps(112.0f), _CMP_LT_OQ));
+        __m256 is_dry = _mm256_and_ps(_mm256_cmp_ps(h, _mm256_set1_ps(13.0f), _CMP_LT_OQ), hot);
+        full = _mm256_sub_ps(full, _mm256_and_ps(is_dry, dry));
+
+        __m256 humid = _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(h, _mm256_set1_ps(85.0f)), _mm256_set1_ps(0.1f)),
+                                     _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(87.0f), f), _mm256_set1_ps(0.2f)));
+        __m256 warm = _mm256_and_ps(_mm256_cmp_ps(f, _mm256_set1_ps(80.0f), _CMP_GT_OQ),
+                                    _mm256_cmp_ps(f, _mm256_set1_ps(87.0f), _CMP_LT_OQ));
+        __m256 is_humid = _mm256_and_ps(_mm256_cmp_ps(h, _mm256_set1_ps(85.0f), _CMP_GT_OQ), warm);
+        full = _mm256_add_ps(full, _mm256_and_ps(is_humid, humid));
+
+        __m256 use_full = _mm256_cmp_ps(_mm256_mul_ps(_mm256_add_ps(simple, f), _mm256_set1_ps(0.5f)),
+                                        _mm256_set1_ps(80.0f), _CMP_GE_OQ);
+        __m256 hi = _mm256_blendv_ps(simple, full, use_full);
+        _mm256_storeu_ps(out + i, _mm256_div_ps(_mm256_sub_ps(hi, _mm256_set1_ps(32.0f)), _mm256_set1_ps(1.8f)));
+    }
+    return i;
+}
+#endif // KERNELS_X86
+
+#ifdef KERNELS_NEON
+static inline float32x4_t log_neon(float32x4_t x) {
+    uint32x4_t bits = vreinterpretq_u32_f32(x);
+    float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(126)));
+    bits = vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFF)), vdupq_n_u32(0x3F000000));
+    float32x4_t m = vreinterpretq_f32_u32(bits);
+
+    uint32x4_t fold = vcltq_f32(m, vdupq_n_f32(LOG_SQRTHF));
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(fold, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+    m = vsubq_f32(vaddq_f32(m, vreinterpretq_f32_u32(vandq_u32(fold, vreinterpretq_u32_f32(m)))),
+                  vdupq_n_f32(1.0f));
+
+    float32x4_t z = vmulq_f32(m, m);
+    float32x4_t y = vdupq_n_f32(LOG_P0);
+    y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(LOG_P1));
+    y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(LOG_P2));
+    y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(LOG_P3));
+    y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(LOG_P4));
+    y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(LOG_P5));
+    y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(LOG_P6));
+    y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(LOG_P7));
+    y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(LOG_P8));
+    y = vmulq_f32(vmulq_f32(y, m), z);
+    y = vaddq_f32(y, vmulq_f32(vdupq_n_f32(LOG_Q1), e));
+    y = vaddq_f32(y, vmulq_f32(vdupq_n_f32(-0.5f), z));
+    float32x4_t r = vaddq_f32(m, y);
+    return vaddq_f32(r, vmulq_f32(vdupq_n_f32(LOG_Q2), e));
+}
+
+static inline float32x4_t mask_neon(uint32x4_t mask, float32x4_t value) {
+    return vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(value)));
+}
+
+static size_t dew_point_neon(const float* t, const float* rh, float* out, size_t n) {
+    const float32x4_t b = vdupq_n_f32(MAGNUS_B);
+    const float32x4_t c = vdupq_n_f32(MAGNUS_C);
+    const float32x4_t lo = vdupq_n_f32(HUMIDITY_MIN);
+    const float32x4_t hi = vdupq_n_f32(HUMIDITY_MAX);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t tv = vld1q_f32(t + i);
+        float32x4_t hv = vld1q_f32(rh + i);
+        // Compare-and-select rather than vmaxq/vminq, matching the scalar NaN handling
+        hv = vbslq_f32(vcgtq_f32(hv, lo), hv, lo);
+        hv = vbslq_f32(vcltq_f32(hv, hi), hv, hi);
+        float32x4_t gamma = vaddq_f32(log_neon(vmulq_f32(hv, vdupq_n_f32(0.01f))),
+                                      vdivq_f32(vmulq_f32(b, tv), vaddq_f32(c, tv)));
+        vst1q_f32(out + i, vdivq_f32(vmulq_f32(c, gamma), vsubq_f32(b, gamma)));
+    }
+    return i;
+}
+
+static size_t heat_index_neon(const float* t, const float* rh, float* out, size_t n) {
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t tv = vld1q_f32(t + i);
+        float32x4_t h = vld1q_f32(rh + i);
+        float32x4_t f = vaddq_f32(vmulq_f32(tv, vdupq_n_f32(1.8f)), vdupq_n_f32(32.0f));
+
+        float32x4_t simple = vaddq_f32(
+            vaddq_f32(vaddq_f32(f, vdupq_n_f32(61.0f)),
+                      vmulq_f32(vsubq_f32(f, vdupq_n_f32(68.0f)), vdupq_n_f32(1.2f))),
+            vmulq_f32(h, vdupq_n_f32(0.094f)));
+        simple = vmulq_f32(vdupq_n_f32(0.5f), simple);
+
+        float32x4_t f2 = vmulq_f32(f, f);
+        float32x4_t h2 = vmulq_f32(h, h);
+        float32x4_t full = vaddq_f32(vdupq_n_f32(HI_C1), vmulq_f32(vdupq_n_f32(HI_C2), f));
+        full = vaddq_f32(full, vmulq_f32(vdupq_n_f32(HI_C3), h));
+        full = vaddq_f32(full, vmulq_f32(vdupq_n_f32(HI_C4), vmulq_f32(f, h)));
+        full = vaddq_f32(full, vmulq_f32(vdupq_n_f32(HI_C5), f2));
+        full = vaddq_f32(full, vmulq_f32(vdupq_n_f32(HI_C6), h2));
+        full = vaddq_f32(full, vmulq_f32(vdupq_n_f32(HI_C7), vmulq_f32(f2, h)));
+        full = vaddq_f32(full, vmulq_f32(vdupq_n_f32(HI_C8), vmulq_f32(f, h2)));
+        full = vaddq_f32(full, vmulq_f32(vdupq_n_f32(HI_C9), vmulq_f32(f2, h2)));
+
+        float32x4_t distance = vabsq_f32(vsubq_f32(f, vdupq_n_f32(95.0f)));
+        float32x4_t span = vdivq_f32(vsubq_f32(vdupq_n_f32(17.0f), distance), vdupq_n_f32(17.0f));
+        span = vbslq_f32(vcgtq_f32(span, vdupq_n_f32(0.0f)), span, vdupq_n_f32(0.0f));
+        float32x4_t dry = vmulq_f32(vmulq_f32(vsubq_f32(vdupq_n_f32(13.0f), h), vdupq_n_f32(0.25f)),
+                                    vsqrtq_f32(span));
+        uint32x4_t hot = vandq_u32(vcgtq_f32(f, vdupq_n_f32(80.0f)), vcltq_f32(f, vdupq_n_f32(112.0f)));
+        uint32x4_t is_dry = vandq_u32(vcltq_f32(h, vdupq_n_f32(13.0f)), hot);
+        full = vsubq_f32(full, mask_neon(is_dry, dry));
+
+        float32x4_t humid = vmulq_f32(vmulq_f32(vsubq_f32(h, vdupq_n_f32(85.0f)), vdupq_n_f32(0.1f)),
+                                      vmulq_f32(vsubq_f32(vdupq_n_f32(87.0f), f), vdupq_n_f32(0.2f)));
+        uint32x4_t warm = vandq_u32(vcgtq_f32(f, vdupq_n_f32(80.0f)), vcltq_f32(f, vdupq_n_f32(87.0f)));
+        uint32x4_t is_humid = vandq_u32(vcgtq_f32(h, vdupq_n_f32(85.0f)), warm);
+        full = vaddq_f32(full, mask_neon(is_humid, humid));
+
+        uint32x4_t use_full = vcgeq_f32(vmulq_f32(vaddq_f32(simple, f), vdupq_n_f32(0.5f)), vdupq_n_f32(80.0f));
+        float32x4_t hi = vbslq_f32(use_full, full, simple);
+        vst1q_f32(out + i, vdivq_f32(vsubq_f32(hi, vdupq_n_f32(32.0f)), vdupq_n_f32(1.8f)));
+    }
+    return i;
+}
+#endif // KERNELS_NEON
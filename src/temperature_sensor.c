@@ -6,16 +6,22 @@
  */
 
 #include "../include/temperature_sensor.h"
+#include "../include/alert.h"
+#include "../include/rcu.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
 
 // Private data structure
 typedef struct {
-    TemperatureConfig config;
+    RcuPointer config;                  // Immutable TemperatureConfig, replaced as a whole
     TemperatureSensorData last_reading;
     TemperatureStats stats;
+    StreamStats accumulator;
+    QuantileSketch sketch;
     uint32_t last_sample_time;
+    uint32_t last_sample_timestamp;
 } TemperatureSensorPrivate;
 
 // Forward declarations of private functions
@@ -23,8 +29,6 @@ static bool temperature_init(void);
 static bool temperature_read(SensorData* data);
 static void temperature_cleanup(void);
 static void update_stats(TemperatureSensorPrivate* private, float value);
-static float calculate_dew_point(float temperature, float humidity);
-static float calculate_heat_index(float temperature, float humidity);
 
 // Private data instance
 static TemperatureSensorPrivate* private_data = NULL;
@@ -49,8 +53,16 @@ bool temperature_sensor_init(Sensor* sensor, const char* id, TemperatureConfig*
         return false;
     }
 
-    // Copy configuration
-    memcpy(&private_data->config, config, sizeof(TemperatureConfig));
+    // Publish a private copy of the configuration
+    TemperatureConfig* config_copy = (TemperatureConfig*)malloc(sizeof(TemperatureConfig));
+    if (!config_copy) {
+        free(private_data);
+        private_data = NULL;
+        sensor->last_error = SENSOR_ERROR_MEMORY;
+        return false;
+    }
+    memcpy(config_copy, config, sizeof(TemperatureConfig));
+    atomic_init(&private_data->config.pointer, config_copy);
     
     // Initialize last reading
     private_data->last_reading.temperature = 0.0f;
@@ -66,9 +78,12 @@ bool temperature_sensor_init(Sensor* sensor, const char* id, TemperatureConfig*
     private_data->stats.sample_count = 0;
     private_data->stats.alert_count = 0;
     private_data->stats.critical_count = 0;
+    stream_stats_init(&private_data->accumulator);
+    quantile_sketch_init(&private_data->sketch);
     
     // Initialize last sample time
     private_data->last_sample_time = 0;
+    private_data->last_sample_timestamp = 0;
 
     // Set sensor interface functions
     sensor->initialize = temperature_init;
@@ -96,11 +111,17 @@ static bool temperature_read(SensorData* data) {
         return false;
     }
 
+    // The configuration in use stays valid until the end of the read, even if it is replaced
+    rcu_read_lock();
+    const TemperatureConfig* config = (const TemperatureConfig*)rcu_dereference(&private_data->config);
+
     // Check if we need to wait for the next sample
     uint32_t current_time = (uint32_t)time(NULL) * 1000; // Convert to milliseconds
-    if (current_time - private_data->last_sample_time < private_data->config.sampling_rate_ms) {
-        // Return the last reading
+    if (current_time - private_data->last_sample_time < config->sampling_rate_ms) {
+        // Return the last reading, with the time it was taken
+        rcu_read_unlock();
         data->value = private_data->last_reading.temperature;
+        data->timestamp = private_data->last_sample_timestamp;
         data->is_valid = true;
         data->error = SENSOR_ERROR_NONE;
         return true;
@@ -110,24 +131,24 @@ static bool temperature_read(SensorData* data) {
     // For demonstration, we'll simulate a reading with some variation
     float base_temp = 25.0f;
     float variation = ((float)rand() / RAND_MAX) * 2.0f - 1.0f; // -1 to 1
-    private_data->last_reading.temperature = base_temp + variation + private_data->config.calibration_offset;
+    private_data->last_reading.temperature = base_temp + variation + config->calibration_offset;
     
-    if (private_data->config.enable_humidity) {
+    if (config->enable_humidity) {
         private_data->last_reading.humidity = 45.0f + ((float)rand() / RAND_MAX) * 10.0f; // 45-55%
     } else {
         private_data->last_reading.humidity = 0.0f;
     }
     
     // Calculate derived values
-    if (private_data->config.enable_dew_point && private_data->last_reading.humidity > 0.0f) {
-        private_data->last_reading.dew_point = calculate_dew_point(
+    if (config->enable_dew_point && private_data->last_reading.humidity > 0.0f) {
+        private_data->last_reading.dew_point = temperature_sensor_calculate_dew_point(
             private_data->last_reading.temperature, 
             private_data->last_reading.humidity
         );
     }
     
-    if (private_data->config.enable_heat_index && private_data->last_reading.humidity > 0.0f) {
-        private_data->last_reading.heat_index = calculate_heat_index(
+    if (config->enable_heat_index && private_data->last_reading.humidity > 0.0f) {
+        private_data->last_reading.heat_index = temperature_sensor_calculate_heat_index(
             private_data->last_reading.temperature, 
             private_data->last_reading.humidity
         );
@@ -143,32 +164,28 @@ static bool temperature_read(SensorData* data) {
     
     // Update last sample time
     private_data->last_sample_time = current_time;
+    private_data->last_sample_timestamp = data->timestamp;
 
-    // Check if temperature is within bounds
-    if (data->value < private_data->config.min_temp || 
-        data->value > private_data->config.max_temp) {
+    // Check if temperature is within bounds; alert and critical thresholds are
+    // evaluated by the alert engine, not reported as read errors
+    bool in_range = data->value >= config->min_temp && data->value <= config->max_temp;
+    rcu_read_unlock();
+    if (!in_range) {
         data->error = SENSOR_ERROR_OUT_OF_RANGE;
         return false;
     }
 
-    // Check if temperature exceeds alert threshold
-    if (data->value > private_data->config.alert_threshold) {
-        // Still return true but set error to indicate warning
-        data->error = SENSOR_ERROR_OUT_OF_RANGE;
-        private_data->stats.alert_count++;
-    }
-    
-    // Check if temperature exceeds critical threshold
-    if (data->value > private_data->config.critical_threshold) {
-        data->error = SENSOR_ERROR_OUT_OF_RANGE;
-        private_data->stats.critical_count++;
-    }
-
     return true;
 }
 
+bool temperature_sensor_read(Sensor* sensor, SensorData* data) {
+    return sensor_read_data(sensor, data);
+}
+
 static void temperature_cleanup(void) {
     if (private_data) {
+        rcu_synchronize();
+        free(rcu_dereference(&private_data->config));
         free(private_data);
         private_data = NULL;
     }
@@ -180,12 +197,44 @@ void temperature_sensor_cleanup(Sensor* sensor) {
     }
 }
 
-void temperature_sensor_get_stats(Sensor* sensor, TemperatureStats* stats) {
+void temperature_sensor_get_stats(const Sensor* sensor, TemperatureStats* stats) {
     if (!sensor || !stats || !private_data) {
         return;
     }
     
     memcpy(stats, &private_data->stats, sizeof(TemperatureStats));
+
+    AlertStatus status;
+    if (alert_get_status(sensor->id, &status)) {
+        stats->alert_count = status.alert_count;
+        stats->critical_count = status.critical_count;
+    }
+}
+
+void temperature_sensor_get_stream_stats(const Sensor* sensor, StreamStats* stats) {
+    if (!sensor || !stats || !private_data) {
+        return;
+    }
+
+    memcpy(stats, &private_data->accumulator, sizeof(StreamStats));
+}
+
+void temperature_sensor_get_quantiles(const Sensor* sensor, TemperatureQuantiles* quantiles) {
+    if (!sensor || !quantiles || !private_data) {
+        return;
+    }
+
+    quantiles->p50 = quantile_sketch_quantile(&private_data->sketch, 0.50);
+    quantiles->p95 = quantile_sketch_quantile(&private_data->sketch, 0.95);
+    quantiles->p99 = quantile_sketch_quantile(&private_data->sketch, 0.99);
+}
+
+void temperature_sensor_get_sketch(const Sensor* sensor, QuantileSketch* sketch) {
+    if (!sensor || !sketch || !private_data) {
+        return;
+    }
+
+    memcpy(sketch, &private_data->sketch, sizeof(QuantileSketch));
 }
 
 void temperature_sensor_reset_stats(Sensor* sensor) {
@@ -200,30 +249,33 @@ void temperature_sensor_reset_stats(Sensor* sensor) {
     private_data->stats.sample_count = 0;
     private_data->stats.alert_count = 0;
     private_data->stats.critical_count = 0;
+    stream_stats_init(&private_data->accumulator);
+    quantile_sketch_init(&private_data->sketch);
 }
 
-void temperature_sensor_set_config(Sensor* sensor, TemperatureConfig* config) {
+bool temperature_sensor_set_config(Sensor* sensor, const TemperatureConfig* config) {
     if (!sensor || !config || !private_data) {
-        return;
+        return false;
     }
-    
-    memcpy(&private_data->config, config, sizeof(TemperatureConfig));
+
+    // Readers keep using the old copy until they finish; it is freed after them
+    TemperatureConfig* config_copy = (TemperatureConfig*)malloc(sizeof(TemperatureConfig));
+    if (!config_copy) {
+        return false;
+    }
+    memcpy(config_copy, config, sizeof(TemperatureConfig));
+    rcu_retire(rcu_publish(&private_data->config, config_copy), free);
+    return true;
 }
 
 void temperature_sensor_get_config(Sensor* sensor, TemperatureConfig* config) {
     if (!sensor || !config || !private_data) {
         return;
     }
-    
-    memcpy(config, &private_data->config, sizeof(TemperatureConfig));
-}
-
-float temperature_sensor_calculate_dew_point(float temperature, float humidity) {
-    return calculate_dew_point(temperature, humidity);
-}
 
-float temperature_sensor_calculate_heat_index(float temperature, float humidity) {
-    return calculate_heat_index(temperature, humidity);
+    rcu_read_lock();
+    memcpy(config, rcu_dereference(&private_data->config), sizeof(TemperatureConfig));
+    rcu_read_unlock();
 }
 
 // Private helper functions
@@ -232,43 +284,13 @@ static void update_stats(TemperatureSensorPrivate* private, float value) {
         return;
     }
     
-    // Update min/max
-    if (value < private->stats.min_value) {
-        private->stats.min_value = value;
-    }
-    if (value > private->stats.max_value) {
-        private->stats.max_value = value;
-    }
-    
-    // Update average
-    private->stats.avg_value = (private->stats.avg_value * private->stats.sample_count + value) / 
-                              (private->stats.sample_count + 1);
-    
-    // Update sample count
-    private->stats.sample_count++;
+    // Accumulate in double precision; the float fields are a snapshot for reporting
+    stream_stats_add(&private->accumulator, value);
+    quantile_sketch_add(&private->sketch, value);
     
-    // Note: Standard deviation calculation would require storing all values
-    // For simplicity, we're not implementing it here
+    private->stats.min_value = (float)private->accumulator.min;
+    private->stats.max_value = (float)private->accumulator.max;
+    private->stats.avg_value = (float)stream_stats_mean(&private->accumulator);
+    private->stats.std_deviation = (float)stream_stats_stddev(&private->accumulator);
+    private->stats.sample_count = (uint32_t)private->accumulator.count;
 }
-
-static float calculate_dew_point(float temperature, float humidity) {
-    // Simple approximation formula for dew point
-    // Td = T - ((100 - RH) / 5)
-    // where Td is dew point in °C, T is temperature in °C, and RH is relative humidity in %
-    return temperature - ((100.0f - humidity) / 5.0f);
-}
-
-static float calculate_heat_index(float temperature, float humidity) {
-    // Simple approximation formula for heat index
-    // HI = 0.5 * (T + 61.0 + ((T-68.0)*1.2) + (RH*0.094))
-    // where HI is heat index in °F, T is temperature in °F, and RH is relative humidity in %
-    
-    // Convert temperature from °C to °F
-    float temp_f = temperature * 9.0f / 5.0f + 32.0f;
-    
-    // Calculate heat index in °F
-    float hi_f = 0.5f * (temp_f + 61.0f + ((temp_f - 68.0f) * 1.2f) + (humidity * 0.094f));
-    
-    // Convert back to °C
-    return (hi_f - 32.0f) * 5.0f / 9.0f;
-} 
\ No newline at end of file
@@ -0,0 +1,212 @@
+/**
+ * @file trend.c
+ * @brief Trend estimation and time-to-threshold prediction for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/trend.h"
+#include "../include/alert.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#define TREND_INITIAL_COVARIANCE 1.0e6  // Prior uncertainty of level and slope
+
+// Per-sensor estimator
+typedef struct {
+    char id[32];
+    TrendEstimator estimator;
+} TrendSensor;
+
+// Private data structure
+typedef struct {
+    TrendConfig config;
+    TrendSensor sensors[TREND_MAX_SENSORS];
+} TrendPrivate;
+
+// Forward declarations of private functions
+static TrendSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static TrendPrivate* private_data = NULL;
+static pthread_mutex_t trend_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void trend_estimator_init(TrendEstimator* estimator) {
+    if (!estimator) {
+        return;
+    }
+
+    memset(estimator, 0, sizeof(TrendEstimator));
+    estimator->p00 = TREND_INITIAL_COVARIANCE;
+    estimator->p11 = TREND_INITIAL_COVARIANCE;
+}
+
+bool trend_estimator_update(TrendEstimator* estimator, double forgetting_factor,
+                            uint32_t timestamp, float value) {
+    if (!estimator) {
+        return false;
+    }
+
+    if (estimator->count == 0) {
+        estimator->reference = timestamp;
+    } else if (timestamp <= estimator->reference) {
+        // Repeated or out-of-order samples would shrink the slope's information
+        return false;
+    }
+
+    // RLS step for the regressor (1, dt), dt relative to the previous sample
+    double dt = (double)(timestamp - estimator->reference);
+    double px0 = estimator->p00 + estimator->p01 * dt;
+    double px1 = estimator->p01 + estimator->p11 * dt;
+    double denominator = forgetting_factor + px0 + px1 * dt;
+    double k0 = px0 / denominator;
+    double k1 = px1 / denominator;
+    double error = (double)value - (estimator->level + estimator->slope * dt);
+
+    estimator->level += k0 * error;
+    estimator->slope += k1 * error;
+    estimator->p00 = (estimator->p00 - k0 * px0) / forgetting_factor;
+    estimator->p01 = (estimator->p01 - k0 * px1) / forgetting_factor;
+    estimator->p11 = (estimator->p11 - k1 * px1) / forgetting_factor;
+
+    // Move the reference to this sample so that dt stays small and the level is current:
+    // (level, slope) -> (level + slope * dt, slope), P -> T P T' with T = [1 dt; 0 1]
+    estimator->level += estimator->slope * dt;
+    estimator->p00 += dt * (2.0 * estimator->p01 + dt * estimator->p11);
+    estimator->p01 += dt * estimator->p11;
+    estimator->reference = timestamp;
+    estimator->count++;
+
+    return true;
+}
+
+float trend_estimator_time_to(const TrendEstimator* estimator, float threshold) {
+    if (!estimator || estimator->count == 0) {
+        return INFINITY;
+    }
+    if (estimator->level >= threshold) {
+        return 0.0f;
+    }
+    if (estimator->slope <= 0.0) {
+        return INFINITY;
+    }
+    return (float)((threshold - estimator->level) / estimator->slope);
+}
+
+bool trend_init(const TrendConfig* config) {
+    TrendConfig defaults;
+    if (!config) {
+        trend_get_default_config(&defaults);
+        config = &defaults;
+    }
+    if (config->forgetting_factor <= 0.0 || config->forgetting_factor > 1.0) {
+        return false;
+    }
+
+    pthread_mutex_lock(&trend_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&trend_mutex);
+        return false;
+    }
+
+    private_data = (TrendPrivate*)calloc(1, sizeof(TrendPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&trend_mutex);
+        return false;
+    }
+    memcpy(&private_data->config, config, sizeof(TrendConfig));
+
+    pthread_mutex_unlock(&trend_mutex);
+    return true;
+}
+
+void trend_cleanup(void) {
+    pthread_mutex_lock(&trend_mutex);
+
+    if (private_data) {
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&trend_mutex);
+}
+
+bool trend_process_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data || !data->is_valid) {
+        return false;
+    }
+
+    pthread_mutex_lock(&trend_mutex);
+
+    TrendSensor* entry = private_data ? find_sensor(sensor->id, true) : NULL;
+    bool fitted = entry && trend_estimator_update(&entry->estimator,
+                                                  private_data->config.forgetting_factor,
+                                                  data->timestamp, data->value);
+
+    pthread_mutex_unlock(&trend_mutex);
+    return fitted;
+}
+
+bool trend_get_status(const char* sensor_id, TrendStatus* status) {
+    if (!sensor_id || !status) {
+        return false;
+    }
+
+    pthread_mutex_lock(&trend_mutex);
+
+    TrendEstimator estimator;
+    uint32_t min_samples = 0;
+    TrendSensor* entry = private_data ? find_sensor(sensor_id, false) : NULL;
+    if (entry) {
+        memcpy(&estimator, &entry->estimator, sizeof(TrendEstimator));
+        min_samples = private_data->config.min_samples;
+    }
+
+    pthread_mutex_unlock(&trend_mutex);
+
+    if (!entry) {
+        return false;
+    }
+
+    status->level = (float)estimator.level;
+    status->slope_per_s = (float)estimator.slope;
+    status->timestamp = estimator.reference;
+    status->valid = estimator.count >= min_samples;
+    status->time_to_alert_s = INFINITY;
+    status->time_to_critical_s = INFINITY;
+
+    // Thresholds are looked up outside the trend lock; the alert engine has its own
+    AlertConfig thresholds;
+    if (status->valid && alert_get_config(sensor_id, &thresholds)) {
+        status->time_to_alert_s = trend_estimator_time_to(&estimator, thresholds.alert_threshold);
+        status->time_to_critical_s = trend_estimator_time_to(&estimator, thresholds.critical_threshold);
+    }
+
+    return true;
+}
+
+void trend_get_default_config(TrendConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    // About the last 100 samples carry weight
+    config->forgetting_factor = 0.99;
+    config->min_samples = 10;
+}
+
+// Private helper functions
+static TrendSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, TREND_MAX_SENSORS,
+                                          TrendSensor, id);
+    bool created;
+    TrendSensor* entry = (TrendSensor*)sensor_table_find(&table, id, create, &created);
+    if (created) {
+        trend_estimator_init(&entry->estimator);
+    }
+    return entry;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file value_cache.c
+ * @brief Last-value cache for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/value_cache.h"
+#include "../include/sensor_table.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+// Slot states; the identifier is immutable once the slot is ready
+#define SLOT_EMPTY 0u
+#define SLOT_READY 1u
+
+// One sensor's last value, one cache line. The fields are read and written with relaxed
+// atomics inside the sequence lock, which is odd while an update is in progress.
+typedef struct {
+    _Alignas(64) _Atomic uint32_t lock;
+    _Atomic uint32_t state;
+    _Atomic uint32_t value_bits;
+    _Atomic uint32_t timestamp;
+    _Atomic uint32_t sequence;
+    _Atomic uint32_t meta;          // quality | error << 8 | type << 16
+    char id[32];
+} ValueSlot;
+
+_Static_assert(sizeof(ValueSlot) == 64, "value cache slot must fill one cache line");
+
+// Private data structure
+typedef struct {
+    ValueSlot slots[VALUE_CACHE_MAX_SENSORS];
+} ValueCachePrivate;
+
+// Forward declarations of private functions
+static ValueSlot* find_slot(const char* id);
+static ValueSlot* claim_slot(const char* id);
+
+// Private data instance; static so that lock-free readers never see it freed
+static ValueCachePrivate private_data;
+static pthread_mutex_t value_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void value_cache_reset(void) {
+    pthread_mutex_lock(&value_cache_mutex);
+    memset(&private_data, 0, sizeof(private_data));
+    pthread_mutex_unlock(&value_cache_mutex);
+}
+
+bool value_cache_update(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data) {
+        return false;
+    }
+
+    ValueSlot* slot = find_slot(sensor->id);
+    if (!slot) {
+        slot = claim_slot(sensor->id);
+        if (!slot) {
+            return false;
+        }
+    }
+
+    uint32_t value_bits;
+    memcpy(&value_bits, &data->value, sizeof(value_bits));
+    ValueQuality quality = data->is_valid && data->error == SENSOR_ERROR_NONE ?
+                           VALUE_QUALITY_GOOD : VALUE_QUALITY_BAD;
+    uint32_t meta = (uint32_t)quality | ((uint32_t)data->error & 0xFFu) << 8 |
+                    ((uint32_t)data->type & 0xFFu) << 16;
+
+    // Take the slot's write side: even -> odd
+    uint32_t lock = atomic_load_explicit(&slot->lock, memory_order_relaxed);
+    for (;;) {
+        if (lock & 1u) {
+            lock = atomic_load_explicit(&slot->lock, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&slot->lock, &lock, lock + 1,
+                                                  memory_order_acquire, memory_order_relaxed)) {
+            break;
+        }
+    }
+    atomic_thread_fence(memory_order_release);
+
+    uint32_t timestamp = atomic_load_explicit(&slot->timestamp, memory_order_relaxed);
+    uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    bool older = sequence > 0 && data->timestamp < timestamp;
+    bool repeated = sequence > 0 && data->timestamp == timestamp &&
+                    atomic_load_explicit(&slot->value_bits, memory_order_relaxed) == value_bits &&
+                    atomic_load_explicit(&slot->meta, memory_order_relaxed) == meta;
+
+    if (!older && !repeated) {
+        atomic_store_explicit(&slot->value_bits, value_bits, memory_order_relaxed);
+        atomic_store_explicit(&slot->timestamp, data->timestamp, memory_order_relaxed);
+        atomic_store_explicit(&slot->meta, meta, memory_order_relaxed);
+        atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&slot->lock, lock + 2, memory_order_release);
+    return true;
+}
+
+bool value_cache_get(const char* sensor_id, uint32_t now, uint32_t max_age_s, CachedValue* value) {
+    if (!sensor_id || !value) {
+        return false;
+    }
+
+    ValueSlot* slot = find_slot(sensor_id);
+    if (!slot) {
+        return false;
+    }
+
+    uint32_t value_bits, timestamp, sequence, meta;
+    for (;;) {
+        uint32_t before = atomic_load_explicit(&slot->lock, memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+        value_bits = atomic_load_explicit(&slot->value_bits, memory_order_relaxed);
+        timestamp = atomic_load_explicit(&slot->timestamp, memory_order_relaxed);
+        sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+        meta = atomic_load_explicit(&slot->meta, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->lock, memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    if (sequence == 0) {
+        return false;
+    }
+
+    memcpy(&value->value, &value_bits, sizeof(value_bits));
+    value->timestamp = timestamp;
+    value->sequence = sequence;
+    value->age_s = now > timestamp ? now - timestamp : 0;
+    value->quality = (ValueQuality)(meta & 0xFFu);
+    value->error = (SensorError)((meta >> 8) & 0xFFu);
+    value->type = (SensorType)((meta >> 16) & 0xFFu);
+    if (value->quality == VALUE_QUALITY_GOOD && max_age_s > 0 && value->age_s > max_age_s) {
+        value->quality = VALUE_QUALITY_STALE;
+    }
+
+    return true;
+}
+
+const char* value_cache_quality_to_string(ValueQuality quality) {
+    switch (quality) {
+        case VALUE_QUALITY_NONE:
+            return "None";
+        case VALUE_QUALITY_GOOD:
+            return "Good";
+        case VALUE_QUALITY_BAD:
+            return "Bad";
+        case VALUE_QUALITY_STALE:
+            return "Stale";
+        default:
+            return "Unknown";
+    }
+}
+
+// Private helper functions
+static ValueSlot* find_slot(const char* id) {
+    uint32_t mask = VALUE_CACHE_MAX_SENSORS - 1;
+    uint32_t slot = sensor_table_hash(id) & mask;
+
+    // Linear probing without locks; slots are only ever added, and an empty slot ends
+    // the probe sequence because claim_slot() publishes the identifier before the state
+    for (uint32_t probe = 0; probe < VALUE_CACHE_MAX_SENSORS; probe++) {
+        ValueSlot* entry = &private_data.slots[(slot + probe) & mask];
+        if (atomic_load_explicit(&entry->state, memory_order_acquire) == SLOT_EMPTY) {
+            return NULL;
+        }
+        if (strncmp(entry->id, id, sizeof(entry->id) - 1) == 0) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static ValueSlot* claim_slot(const char* id) {
+    uint32_t mask = VALUE_CACHE_MAX_SENSORS - 1;
+    uint32_t slot = sensor_table_hash(id) & mask;
+    ValueSlot* claimed = NULL;
+
+    pthread_mutex_lock(&value_cache_mutex);
+
+    for (uint32_t probe = 0; probe < VALUE_CACHE_MAX_SENSORS; probe++) {
+        ValueSlot* entry = &private_data.slots[(slot + probe) & mask];
+        if (atomic_load_explicit(&entry->state, memory_order_relaxed) == SLOT_EMPTY) {
+            snprintf(entry->id, sizeof(entry->id), "%s", id);
+            atomic_store_explicit(&entry->state, SLOT_READY, memory_order_release);
+            claimed = entry;
+            break;
+        }
+        if (strncmp(entry->id, id, sizeof(entry->id) - 1) == 0) {
+            // Claimed by another writer since our lock-free lookup
+            claimed = entry;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&value_cache_mutex);
+    return claimed;
+}
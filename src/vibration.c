@@ -0,0 +1,276 @@
+/**
+ * @file vibration.c
+ * @brief Vibration condition indicators for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Power sums are taken of x - shift, where the shift is the previous window's mean, so
+ * the central moments recovered from them do not suffer from cancellation when the
+ * signal rides on a large offset. Vector lanes accumulate in float over short chunks
+ * and are flushed into double sums, which bounds the rounding error per window.
+ */
+
+#include "../include/vibration.h"
+#include <string.h>
+#include <math.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define VIBRATION_SSE2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define VIBRATION_NEON 1
+#endif
+
+#define VIBRATION_PI 3.14159265358979323846
+#define VIBRATION_CHUNK 256         // Samples accumulated in float lanes before a flush
+
+// Forward declarations of private functions
+static void accumulate(VibrationAnalyzer* analyzer, const float* samples, uint32_t count);
+static void accumulate_chunk(VibrationAnalyzer* analyzer, const float* samples, uint32_t count);
+static void finish_window(VibrationAnalyzer* analyzer, VibrationFeatures* features);
+static void reset_window(VibrationAnalyzer* analyzer);
+
+bool vibration_analyzer_init(VibrationAnalyzer* analyzer, const VibrationConfig* config) {
+    if (!analyzer || !config || !(config->sample_rate > 0.0f) || config->window_size < 2 ||
+        !(config->envelope_highpass_hz > 0.0f) ||
+        !(config->envelope_highpass_hz < config->sample_rate / 2.0f) ||
+        !(config->envelope_lowpass_hz > 0.0f) ||
+        !(config->envelope_lowpass_hz < config->sample_rate / 2.0f)) {
+        return false;
+    }
+
+    memset(analyzer, 0, sizeof(VibrationAnalyzer));
+    memcpy(&analyzer->config, config, sizeof(VibrationConfig));
+
+    // One-pole RC filters
+    double dt = 1.0 / config->sample_rate;
+    double rc_high = 1.0 / (2.0 * VIBRATION_PI * config->envelope_highpass_hz);
+    double rc_low = 1.0 / (2.0 * VIBRATION_PI * config->envelope_lowpass_hz);
+    analyzer->highpass_coeff = (float)(rc_high / (rc_high + dt));
+    analyzer->lowpass_coeff = (float)(dt / (rc_low + dt));
+
+    reset_window(analyzer);
+    return true;
+}
+
+uint32_t vibration_analyzer_push(VibrationAnalyzer* analyzer, const float* samples, size_t count,
+                                 VibrationCallback callback, void* context) {
+    if (!analyzer || (!samples && count > 0)) {
+        return 0;
+    }
+
+    if (count > 0 && !analyzer->primed) {
+        analyzer->shift = samples[0];
+        analyzer->highpass_input = samples[0];
+        analyzer->primed = true;
+    }
+
+    uint32_t window_size = analyzer->config.window_size;
+    uint32_t windows = 0;
+
+    while (count > 0) {
+        uint32_t take = window_size - analyzer->fill;
+        if (take > count) {
+            take = (uint32_t)count;
+        }
+        accumulate(analyzer, samples, take);
+        analyzer->fill += take;
+        samples += take;
+        count -= take;
+
+        if (analyzer->fill < window_size) {
+            break;
+        }
+
+        VibrationFeatures features;
+        finish_window(analyzer, &features);
+        windows++;
+        if (callback) {
+            callback(&features, context);
+        }
+
+        analyzer->window_start += window_size;
+        analyzer->shift = features.mean;
+        reset_window(analyzer);
+    }
+
+    return windows;
+}
+
+void vibration_get_default_config(VibrationConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->sample_rate = 25600.0f;
+    config->window_size = 12800;
+    config->envelope_highpass_hz = 1000.0f;
+    config->envelope_lowpass_hz = 1000.0f;
+}
+
+// Private helper functions
+static void accumulate(VibrationAnalyzer* analyzer, const float* samples, uint32_t count) {
+    while (count > 0) {
+        uint32_t take = count < VIBRATION_CHUNK ? count : VIBRATION_CHUNK;
+        accumulate_chunk(analyzer, samples, take);
+        samples += take;
+        count -= take;
+    }
+}
+
+static void accumulate_chunk(VibrationAnalyzer* analyzer, const float* samples, uint32_t count) {
+    const float shift = analyzer->shift;
+    const float hp_coeff = analyzer->highpass_coeff;
+    const float lp_coeff = analyzer->lowpass_coeff;
+    float hp = analyzer->highpass_state;
+    float hp_input = analyzer->highpass_input;
+    float envelope = analyzer->envelope;
+    double envelope_sum = 0.0;
+    double envelope_sum_sq = 0.0;
+    float s1 = 0.0f, s2 = 0.0f, s3 = 0.0f, s4 = 0.0f;
+    float max_value = analyzer->max_value;
+    float min_value = analyzer->min_value;
+    uint32_t i = 0;
+
+#if defined(VIBRATION_SSE2) || defined(VIBRATION_NEON)
+    float lanes[6][4];
+#if defined(VIBRATION_SSE2)
+    __m128 c = _mm_set1_ps(shift);
+    __m128 v1 = _mm_setzero_ps(), v2 = _mm_setzero_ps();
+    __m128 v3 = _mm_setzero_ps(), v4 = _mm_setzero_ps();
+    __m128 vmax = _mm_set1_ps(max_value), vmin = _mm_set1_ps(min_value);
+#else
+    float32x4_t c = vdupq_n_f32(shift);
+    float32x4_t v1 = vdupq_n_f32(0.0f), v2 = vdupq_n_f32(0.0f);
+    float32x4_t v3 = vdupq_n_f32(0.0f), v4 = vdupq_n_f32(0.0f);
+    float32x4_t vmax = vdupq_n_f32(max_value), vmin = vdupq_n_f32(min_value);
+#endif
+    for (; i + 4 <= count; i += 4) {
+#if defined(VIBRATION_SSE2)
+        __m128 x = _mm_loadu_ps(samples + i);
+        __m128 d = _mm_sub_ps(x, c);
+        __m128 d2 = _mm_mul_ps(d, d);
+        v1 = _mm_add_ps(v1, d);
+        v2 = _mm_add_ps(v2, d2);
+        v3 = _mm_add_ps(v3, _mm_mul_ps(d2, d));
+        v4 = _mm_add_ps(v4, _mm_mul_ps(d2, d2));
+        vmax = _mm_max_ps(vmax, x);
+        vmin = _mm_min_ps(vmin, x);
+#else
+        float32x4_t x = vld1q_f32(samples + i);
+        float32x4_t d = vsubq_f32(x, c);
+        float32x4_t d2 = vmulq_f32(d, d);
+        v1 = vaddq_f32(v1, d);
+        v2 = vaddq_f32(v2, d2);
+        v3 = vmlaq_f32(v3, d2, d);
+        v4 = vmlaq_f32(v4, d2, d2);
+        vmax = vmaxq_f32(vmax, x);
+        vmin = vminq_f32(vmin, x);
+#endif
+        // Envelope of the same four samples while they are in registers
+        for (uint32_t k = 0; k < 4; k++) {
+            float value = samples[i + k];
+            hp = hp_coeff * (hp + value - hp_input);
+            hp_input = value;
+            envelope += lp_coeff * (fabsf(hp) - envelope);
+            envelope_sum += envelope;
+            envelope_sum_sq += (double)envelope * envelope;
+        }
+    }
+#if defined(VIBRATION_SSE2)
+    _mm_storeu_ps(lanes[0], v1);
+    _mm_storeu_ps(lanes[1], v2);
+    _mm_storeu_ps(lanes[2], v3);
+    _mm_storeu_ps(lanes[3], v4);
+    _mm_storeu_ps(lanes[4], vmax);
+    _mm_storeu_ps(lanes[5], vmin);
+#else
+    vst1q_f32(lanes[0], v1);
+    vst1q_f32(lanes[1], v2);
+    vst1q_f32(lanes[2], v3);
+    vst1q_f32(lanes[3], v4);
+    vst1q_f32(lanes[4], vmax);
+    vst1q_f32(lanes[5], vmin);
+#endif
+    for (uint32_t k = 0; k < 4; k++) {
+        s1 += lanes[0][k];
+        s2 += lanes[1][k];
+        s3 += lanes[2][k];
+        s4 += lanes[3][k];
+        max_value = fmaxf(max_value, lanes[4][k]);
+        min_value = fminf(min_value, lanes[5][k]);
+    }
+#endif
+
+    for (; i < count; i++) {
+        float value = samples[i];
+        float d = value - shift;
+        float d2 = d * d;
+        s1 += d;
+        s2 += d2;
+        s3 += d2 * d;
+        s4 += d2 * d2;
+        max_value = fmaxf(max_value, value);
+        min_value = fminf(min_value, value);
+
+        hp = hp_coeff * (hp + value - hp_input);
+        hp_input = value;
+        envelope += lp_coeff * (fabsf(hp) - envelope);
+        envelope_sum += envelope;
+        envelope_sum_sq += (double)envelope * envelope;
+    }
+
+    analyzer->sums[0] += s1;
+    analyzer->sums[1] += s2;
+    analyzer->sums[2] += s3;
+    analyzer->sums[3] += s4;
+    analyzer->max_value = max_value;
+    analyzer->min_value = min_value;
+    analyzer->highpass_state = hp;
+    analyzer->highpass_input = hp_input;
+    analyzer->envelope = envelope;
+    analyzer->envelope_sum += envelope_sum;
+    analyzer->envelope_sum_sq += envelope_sum_sq;
+}
+
+static void finish_window(VibrationAnalyzer* analyzer, VibrationFeatures* features) {
+    double n = (double)analyzer->config.window_size;
+
+    // Raw moments of x - shift, then central moments
+    double m1 = analyzer->sums[0] / n;
+    double e2 = analyzer->sums[1] / n;
+    double e3 = analyzer->sums[2] / n;
+    double e4 = analyzer->sums[3] / n;
+    double variance = e2 - m1 * m1;
+    double m3 = e3 - 3.0 * m1 * e2 + 2.0 * m1 * m1 * m1;
+    double m4 = e4 - 4.0 * m1 * e3 + 6.0 * m1 * m1 * e2 - 3.0 * m1 * m1 * m1 * m1;
+    if (variance < 0.0) {
+        variance = 0.0;
+    }
+
+    double mean = analyzer->shift + m1;
+    double rms = sqrt(variance);
+    double peak = fmax(analyzer->max_value - mean, mean - analyzer->min_value);
+
+    features->first_sample = analyzer->window_start;
+    features->mean = (float)mean;
+    features->rms = (float)rms;
+    features->peak = (float)peak;
+    features->crest_factor = rms > 0.0 ? (float)(peak / rms) : 0.0f;
+    features->skewness = variance > 0.0 ? (float)(m3 / (variance * rms)) : 0.0f;
+    features->kurtosis = variance > 0.0 ? (float)(m4 / (variance * variance)) : 0.0f;
+
+    double envelope_mean = analyzer->envelope_sum / n;
+    double envelope_variance = analyzer->envelope_sum_sq / n - envelope_mean * envelope_mean;
+    features->envelope_rms = envelope_variance > 0.0 ? (float)sqrt(envelope_variance) : 0.0f;
+}
+
+static void reset_window(VibrationAnalyzer* analyzer) {
+    analyzer->fill = 0;
+    memset(analyzer->sums, 0, sizeof(analyzer->sums));
+    analyzer->max_value = -INFINITY;
+    analyzer->min_value = INFINITY;
+    analyzer->envelope_sum = 0.0;
+    analyzer->envelope_sum_sq = 0.0;
+}
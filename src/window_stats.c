@@ -0,0 +1,169 @@
+/**
+ * @file window_stats.c
+ * @brief Per-sensor sliding window statistics for the Industrial AI-Powered Edge Monitoring System
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ */
+
+#include "../include/window_stats.h"
+#include "../include/sensor_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Per-sensor window state
+typedef struct {
+    char id[32];
+    SlidingWindow windows[WINDOW_STATS_MAX_WINDOWS];
+} WindowStatsSensor;
+
+// Private data structure
+typedef struct {
+    WindowStatsConfig config;
+    WindowStatsSensor sensors[WINDOW_STATS_MAX_SENSORS];
+} WindowStatsPrivate;
+
+// Forward declarations of private functions
+static WindowStatsSensor* find_sensor(const char* id, bool create);
+
+// Private data instance
+static WindowStatsPrivate* private_data = NULL;
+static pthread_mutex_t window_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void window_stats_get_default_config(WindowStatsConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(WindowStatsConfig));
+    config->widths_s[0] = 60;
+    config->widths_s[1] = 15 * 60;
+    config->widths_s[2] = 3600;
+    config->window_count = 3;
+}
+
+bool window_stats_init(const WindowStatsConfig* config) {
+    WindowStatsConfig effective;
+
+    if (config) {
+        memcpy(&effective, config, sizeof(WindowStatsConfig));
+    } else {
+        window_stats_get_default_config(&effective);
+    }
+
+    if (effective.window_count == 0 || effective.window_count > WINDOW_STATS_MAX_WINDOWS) {
+        return false;
+    }
+    for (uint32_t i = 0; i < effective.window_count; i++) {
+        if (effective.widths_s[i] == 0 || effective.widths_s[i] % SLIDING_WINDOW_BUCKETS != 0) {
+            return false;
+        }
+    }
+
+    pthread_mutex_lock(&window_stats_mutex);
+
+    if (private_data) {
+        pthread_mutex_unlock(&window_stats_mutex);
+        return false;
+    }
+
+    private_data = (WindowStatsPrivate*)calloc(1, sizeof(WindowStatsPrivate));
+    if (!private_data) {
+        pthread_mutex_unlock(&window_stats_mutex);
+        return false;
+    }
+    memcpy(&private_data->config, &effective, sizeof(WindowStatsConfig));
+
+    pthread_mutex_unlock(&window_stats_mutex);
+    return true;
+}
+
+void window_stats_cleanup(void) {
+    pthread_mutex_lock(&window_stats_mutex);
+
+    if (private_data) {
+        free(private_data);
+        private_data = NULL;
+    }
+
+    pthread_mutex_unlock(&window_stats_mutex);
+}
+
+bool window_stats_add_sample(const Sensor* sensor, const SensorData* data) {
+    if (!sensor || !data || !data->is_valid) {
+        return false;
+    }
+
+    pthread_mutex_lock(&window_stats_mutex);
+
+    if (!private_data) {
+        pthread_mutex_unlock(&window_stats_mutex);
+        return false;
+    }
+
+    WindowStatsSensor* entry = find_sensor(sensor->id, true);
+    if (entry) {
+        for (uint32_t i = 0; i < private_data->config.window_count; i++) {
+            sliding_window_add(&entry->windows[i], data->timestamp, data->value);
+        }
+    }
+
+    pthread_mutex_unlock(&window_stats_mutex);
+    return entry != NULL;
+}
+
+bool window_stats_get(const char* sensor_id, uint32_t window, uint32_t now, SlidingWindowStats* stats) {
+    if (!sensor_id || !stats) {
+        return false;
+    }
+
+    pthread_mutex_lock(&window_stats_mutex);
+
+    bool found = false;
+    if (private_data && window < private_data->config.window_count) {
+        WindowStatsSensor* entry = find_sensor(sensor_id, false);
+        if (entry) {
+            sliding_window_get(&entry->windows[window], now, stats);
+            found = true;
+        }
+    }
+
+    pthread_mutex_unlock(&window_stats_mutex);
+    return found;
+}
+
+bool window_stats_find_window(uint32_t width_s, uint32_t* window) {
+    if (!window) {
+        return false;
+    }
+
+    pthread_mutex_lock(&window_stats_mutex);
+
+    bool found = false;
+    if (private_data) {
+        for (uint32_t i = 0; i < private_data->config.window_count; i++) {
+            if (private_data->config.widths_s[i] == width_s) {
+                *window = i;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&window_stats_mutex);
+    return found;
+}
+
+// Private helper functions
+static WindowStatsSensor* find_sensor(const char* id, bool create) {
+    SensorTable table = SENSOR_TABLE_INIT(private_data->sensors, WINDOW_STATS_MAX_SENSORS,
+                                          WindowStatsSensor, id);
+    bool created;
+    WindowStatsSensor* entry = (WindowStatsSensor*)sensor_table_find(&table, id, create, &created);
+    if (created) {
+        for (uint32_t i = 0; i < private_data->config.window_count; i++) {
+            sliding_window_init(&entry->windows[i], private_data->config.widths_s[i]);
+        }
+    }
+    return entry;
+}
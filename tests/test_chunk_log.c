@@ -0,0 +1,190 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+#include "../include/chunk_log.h"
+
+// Test configuration
+#define TEST_SENSORS 3
+#define TEST_SAMPLES 1000
+#define TEST_CHUNK_SAMPLES 64
+static const uint32_t TEST_START = 1700000000u;
+
+static char test_dir[] = "/tmp/edgetrack_chunk_log_XXXXXX";
+static ChunkLogConfig config;
+static Sensor sensors[TEST_SENSORS];
+
+// Samples read back, per sensor
+typedef struct {
+    uint32_t count[TEST_SENSORS];
+    bool in_order;
+    bool values_match;
+} QueryResult;
+
+static float test_value(uint32_t sensor, uint32_t i) {
+    return 100.0f * sensor + 0.25f * i;
+}
+
+static bool collect_samples(const char* sensor_id, SensorType type, const uint32_t* timestamps,
+                            const float* values, uint32_t count, void* context) {
+    QueryResult* result = (QueryResult*)context;
+    (void)type;
+
+    for (uint32_t s = 0; s < TEST_SENSORS; s++) {
+        if (strcmp(sensor_id, sensors[s].id) != 0) {
+            continue;
+        }
+        for (uint32_t k = 0; k < count; k++) {
+            uint32_t i = timestamps[k] - TEST_START;
+            if (i != result->count[s]) {
+                result->in_order = false;
+            }
+            if (values[k] != test_value(s, i)) {
+                result->values_match = false;
+            }
+            result->count[s]++;
+        }
+    }
+    return true;
+}
+
+static void query_all(QueryResult* result) {
+    memset(result, 0, sizeof(QueryResult));
+    result->in_order = true;
+    result->values_match = true;
+    assert(chunk_log_query(NULL, TEST_START, TEST_START + TEST_SAMPLES, collect_samples, result));
+}
+
+// Test that samples come back in order, from the buffers and from the data file
+static int test_round_trip(void) {
+    QueryResult result;
+
+    assert(chunk_log_init(&config));
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        for (uint32_t s = 0; s < TEST_SENSORS; s++) {
+            SensorData data;
+            memset(&data, 0, sizeof(data));
+            data.type = sensors[s].type;
+            data.timestamp = TEST_START + i;
+            data.value = test_value(s, i);
+            data.is_valid = true;
+            assert(chunk_log_append(&sensors[s], &data));
+        }
+    }
+
+    // Part of every sensor's samples is still buffered
+    query_all(&result);
+    for (uint32_t s = 0; s < TEST_SENSORS; s++) {
+        assert(result.count[s] == TEST_SAMPLES);
+    }
+    assert(result.in_order && result.values_match);
+    chunk_log_cleanup();
+
+    // Reopen from the index, then rebuild the index from the data file
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            assert(unlink(config.index_file) == 0);
+        }
+        assert(chunk_log_init(&config));
+        assert(chunk_log_chunk_count() == TEST_SENSORS * ((TEST_SAMPLES + TEST_CHUNK_SAMPLES - 1) / TEST_CHUNK_SAMPLES));
+        query_all(&result);
+        for (uint32_t s = 0; s < TEST_SENSORS; s++) {
+            assert(result.count[s] == TEST_SAMPLES);
+        }
+        assert(result.in_order && result.values_match);
+        chunk_log_cleanup();
+    }
+    return 0;
+}
+
+// Test that every stored chunk passes its CRC and that a flipped payload bit fails it
+static int test_crc(void) {
+    FILE* file = fopen(config.data_file, "rb");
+    assert(file);
+
+    static uint8_t payload[CHUNK_LOG_MAX_SAMPLES * (sizeof(uint32_t) + sizeof(float))];
+    ChunkHeader header;
+    uint32_t chunks = 0;
+    while (fread(&header, sizeof(header), 1, file) == 1) {
+        assert(chunk_log_verify_chunk(&header, NULL));
+        size_t size = header.count * (sizeof(uint32_t) + sizeof(float));
+        assert(fread(payload, 1, size, file) == size);
+        assert(chunk_log_verify_chunk(&header, payload));
+
+        payload[size / 2] ^= 0x10;
+        assert(!chunk_log_verify_chunk(&header, payload));
+        chunks++;
+    }
+    fclose(file);
+
+    assert(chunks == TEST_SENSORS * ((TEST_SAMPLES + TEST_CHUNK_SAMPLES - 1) / TEST_CHUNK_SAMPLES));
+    return 0;
+}
+
+// Test that a query skips and counts a chunk whose payload no longer matches its CRC
+static int test_damaged_chunk(void) {
+    QueryResult result;
+    ChunkHeader header;
+
+    // The second chunk in the file is the first one of the second sensor
+    FILE* file = fopen(config.data_file, "r+b");
+    assert(file);
+    assert(fread(&header, sizeof(header), 1, file) == 1);
+    long second = (long)(sizeof(header) + header.count * (sizeof(uint32_t) + sizeof(float)));
+    long target = second + (long)sizeof(header) + TEST_CHUNK_SAMPLES * (long)sizeof(uint32_t) + 1;
+    assert(fseek(file, target, SEEK_SET) == 0);
+    int byte = fgetc(file);
+    assert(byte != EOF);
+    assert(fseek(file, target, SEEK_SET) == 0);
+    assert(fputc(byte ^ 0x10, file) != EOF);
+    fclose(file);
+
+    assert(chunk_log_init(&config));
+    query_all(&result);
+    assert(chunk_log_skipped_chunks() == 1);
+    assert(result.count[0] == TEST_SAMPLES && result.count[2] == TEST_SAMPLES);
+    assert(result.count[1] == TEST_SAMPLES - TEST_CHUNK_SAMPLES);
+    assert(result.values_match);
+    chunk_log_cleanup();
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running chunk log tests...\n");
+
+    assert(mkdtemp(test_dir));
+    chunk_log_get_default_config(&config);
+    snprintf(config.data_file, sizeof(config.data_file), "%s/samples.dat", test_dir);
+    snprintf(config.index_file, sizeof(config.index_file), "%s/samples.idx", test_dir);
+    config.chunk_samples = TEST_CHUNK_SAMPLES;
+    config.max_buffer_age_s = 0;
+
+    for (uint32_t s = 0; s < TEST_SENSORS; s++) {
+        char id[16];
+        snprintf(id, sizeof(id), "CL%03u", s);
+        assert(sensor_init(&sensors[s], SENSOR_TYPE_TEMPERATURE, id));
+    }
+
+    int result = test_round_trip();
+    printf("Chunk log round trip test %s\n", result == 0 ? "passed" : "failed");
+    if (result == 0) {
+        result = test_crc();
+        printf("Chunk log CRC test %s\n", result == 0 ? "passed" : "failed");
+    }
+    if (result == 0) {
+        result = test_damaged_chunk();
+        printf("Chunk log damaged chunk test %s\n", result == 0 ? "passed" : "failed");
+    }
+
+    unlink(config.data_file);
+    unlink(config.index_file);
+    rmdir(test_dir);
+    if (result != 0) {
+        return 1;
+    }
+
+    printf("All chunk log tests passed\n");
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "../include/compression.h"
+
+// Test configuration
+#define TEST_SAMPLES 20000
+static const float TEST_DEVIATION = 0.5f;
+static const uint32_t TEST_MAX_INTERVAL = 120;
+
+static SensorData samples[TEST_SAMPLES];
+static SensorData points[TEST_SAMPLES + 1];
+
+// Random walk with a slow oscillation, sampled with occasional gaps
+static void generate_samples(void) {
+    float level = 20.0f;
+    uint32_t timestamp = 1700000000u;
+
+    srand(1);
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        level += 0.1f * ((float)rand() / RAND_MAX - 0.5f);
+        timestamp += rand() % 20 == 0 ? 1 + rand() % 30 : 1;
+        memset(&samples[i], 0, sizeof(SensorData));
+        samples[i].timestamp = timestamp;
+        samples[i].value = level + 3.0f * sinf(i * 0.002f);
+        samples[i].is_valid = true;
+    }
+}
+
+// Compress the samples and return the number of forwarded points
+static uint32_t compress_samples(const CompressionConfig* config) {
+    Compressor compressor;
+    uint32_t count = 0;
+
+    compressor_init(&compressor);
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        SensorData output[COMPRESSION_MAX_OUTPUT];
+        uint32_t forwarded = compressor_update(&compressor, config, &samples[i], output);
+        assert(forwarded <= COMPRESSION_MAX_OUTPUT);
+        for (uint32_t k = 0; k < forwarded; k++) {
+            points[count++] = output[k];
+        }
+    }
+    if (compressor_flush(&compressor, &points[count])) {
+        count++;
+    }
+    return count;
+}
+
+// Check reconstruction error, forwarded points and the longest gap between points
+static int check_reconstruction(const CompressionConfig* config, uint32_t count) {
+    uint32_t point = 0;
+
+    assert(count > 1 && count < TEST_SAMPLES / 4);
+    for (uint32_t k = 1; k < count; k++) {
+        assert(points[k].timestamp > points[k - 1].timestamp);
+        assert(points[k].timestamp - points[k - 1].timestamp <= TEST_MAX_INTERVAL + 30);
+    }
+
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        uint32_t t = samples[i].timestamp;
+        while (point + 1 < count && points[point + 1].timestamp <= t) {
+            point++;
+        }
+
+        float reconstructed = points[point].value;
+        if (config->method == COMPRESSION_SWINGING_DOOR && point + 1 < count &&
+            points[point].timestamp < t) {
+            const SensorData* a = &points[point];
+            const SensorData* b = &points[point + 1];
+            reconstructed = a->value + (b->value - a->value) *
+                            (float)(t - a->timestamp) / (float)(b->timestamp - a->timestamp);
+        }
+
+        if (fabsf(reconstructed - samples[i].value) > config->deviation * 1.001f) {
+            printf("%s: sample %u off by %g\n", compression_method_to_string(config->method), i,
+                   fabsf(reconstructed - samples[i].value));
+            return 1;
+        }
+
+        // Forwarded points are real samples
+        if (points[point].timestamp == t) {
+            assert(points[point].value == samples[i].value);
+        }
+    }
+    return 0;
+}
+
+// Test that deadband and swinging door stay within their deviation
+static int test_error_bounds(void) {
+    CompressionConfig config;
+    compression_get_default_config(&config);
+    config.deviation = TEST_DEVIATION;
+    config.max_interval_s = TEST_MAX_INTERVAL;
+
+    config.method = COMPRESSION_DEADBAND;
+    if (check_reconstruction(&config, compress_samples(&config)) != 0) {
+        return 1;
+    }
+
+    config.method = COMPRESSION_SWINGING_DOOR;
+    if (check_reconstruction(&config, compress_samples(&config)) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+// Test that no compression forwards every sample
+static int test_no_compression(void) {
+    CompressionConfig config;
+    compression_get_default_config(&config);
+    config.method = COMPRESSION_NONE;
+
+    assert(compress_samples(&config) == TEST_SAMPLES);
+    assert(memcmp(points, samples, sizeof(SensorData) * TEST_SAMPLES) == 0);
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running compression tests...\n");
+    generate_samples();
+
+    if (test_error_bounds() != 0) {
+        printf("Compression error bound test failed\n");
+        return 1;
+    }
+    printf("Compression error bound test passed\n");
+
+    if (test_no_compression() != 0) {
+        printf("No compression test failed\n");
+        return 1;
+    }
+    printf("No compression test passed\n");
+
+    printf("All compression tests passed\n");
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "../include/fft.h"
+
+// Test configuration
+static const double TEST_TOLERANCE = 1e-4;
+
+static FftPlan plan;
+static float input[FFT_MAX_SIZE];
+
+// Largest difference between the plan's spectrum and a direct DFT of the windowed block,
+// relative to the largest bin
+static double compare_with_dft(uint32_t size) {
+    double largest = 0.0;
+    double error = 0.0;
+
+    for (uint32_t k = 0; k <= size / 2; k++) {
+        double re = 0.0;
+        double im = 0.0;
+        for (uint32_t n = 0; n < size; n++) {
+            double x = (double)input[n] * plan.window_coeffs[n];
+            double angle = -2.0 * M_PI * (double)((uint64_t)k * n % size) / size;
+            re += x * cos(angle);
+            im += x * sin(angle);
+        }
+        largest = fmax(largest, hypot(re, im));
+        error = fmax(error, hypot(re - plan.spectrum_re[k], im - plan.spectrum_im[k]));
+    }
+
+    return error / largest;
+}
+
+// Test the transform against a direct DFT for every size and window
+static int test_fft_matches_dft(void) {
+    srand(1);
+    for (uint32_t size = FFT_MIN_SIZE; size <= 2048; size *= 2) {
+        for (int window = FFT_WINDOW_RECTANGULAR; window <= FFT_WINDOW_BLACKMAN_HARRIS; window++) {
+            assert(fft_plan_init(&plan, size, (FftWindow)window));
+            for (uint32_t n = 0; n < size; n++) {
+                input[n] = 2.0f * sinf(0.37f * n) + 0.5f * cosf(1.9f * n) + (float)rand() / RAND_MAX - 0.5f;
+            }
+            fft_forward(&plan, input);
+            double error = compare_with_dft(size);
+            if (error > TEST_TOLERANCE) {
+                printf("size %u, %s window: relative error %g\n", size,
+                       fft_window_to_string((FftWindow)window), error);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+// Test that unsupported sizes are rejected
+static int test_fft_rejects_sizes(void) {
+    assert(!fft_plan_init(&plan, FFT_MIN_SIZE / 2, FFT_WINDOW_HANN));
+    assert(!fft_plan_init(&plan, FFT_MAX_SIZE * 2, FFT_WINDOW_HANN));
+    assert(!fft_plan_init(&plan, 100, FFT_WINDOW_HANN));
+    return 0;
+}
+
+// Test that a pure tone is found at its frequency and amplitude
+static int test_fft_peak(void) {
+    const float sample_rate = 1000.0f;
+    const uint32_t size = 1024;
+
+    assert(fft_plan_init(&plan, size, FFT_WINDOW_HANN));
+    for (uint32_t n = 0; n < size; n++) {
+        input[n] = 3.0f * sinf(2.0f * (float)M_PI * 123.4f * n / sample_rate);
+    }
+
+    static float power[FFT_MAX_SIZE / 2 + 1];
+    FftPeak peak;
+    fft_power_spectrum(&plan, input, power);
+    assert(fft_find_peaks(&plan, power, sample_rate, &peak, 1) == 1);
+    assert(fabsf(peak.frequency_hz - 123.4f) < 0.2f);
+    assert(fabsf(peak.amplitude - 3.0f) < 0.1f);
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running FFT tests...\n");
+
+    if (test_fft_matches_dft() != 0) {
+        printf("FFT against DFT test failed\n");
+        return 1;
+    }
+    printf("FFT against DFT test passed\n");
+
+    if (test_fft_rejects_sizes() != 0) {
+        printf("FFT size test failed\n");
+        return 1;
+    }
+    printf("FFT size test passed\n");
+
+    if (test_fft_peak() != 0) {
+        printf("FFT peak test failed\n");
+        return 1;
+    }
+    printf("FFT peak test passed\n");
+
+    printf("All FFT tests passed\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "../include/forecast.h"
+
+// Test configuration
+#define TEST_DAYS 3
+static const uint32_t TEST_START = 1699920000u;  // Midnight UTC
+static const float TEST_NOISE = 0.5f;
+
+// Standard normal noise from a fixed seed
+static float gauss(void) {
+    float u = (rand() + 1.0f) / (RAND_MAX + 2.0f);
+    float v = (rand() + 1.0f) / (RAND_MAX + 2.0f);
+    return sqrtf(-2.0f * logf(u)) * cosf(6.2831853f * v);
+}
+
+// Daily cycle of a noisy temperature
+static float daily_value(uint32_t timestamp) {
+    return 20.0f + 3.0f * sinf(6.2831853f * (float)(timestamp % 86400) / 86400.0f) + TEST_NOISE * gauss();
+}
+
+// Feed samples every `interval` seconds, returning how many deviated once ready
+static uint32_t feed(HoltWinters* model, const ForecastConfig* config, uint32_t interval) {
+    uint32_t deviations = 0;
+    for (uint32_t t = TEST_START; t < TEST_START + TEST_DAYS * 86400; t += interval) {
+        if (holt_winters_update(model, config, t, daily_value(t), NULL)) {
+            deviations++;
+        }
+    }
+    return deviations;
+}
+
+// Test that a sensor reporting several times per slot learns its residual spread
+static int test_dense_sensor(void) {
+    ForecastConfig config;
+    HoltWinters model;
+
+    srand(1);
+    forecast_get_default_config(&config);
+    assert(holt_winters_init(&model, &config));
+    assert(feed(&model, &config, 10) <= 2);
+    assert(model.ready);
+    assert(fabsf(sqrtf(model.variance) - TEST_NOISE) < 0.15f);
+    holt_winters_free(&model);
+    return 0;
+}
+
+// Test that a sensor reporting less than once per slot is not flagged on every sample
+static int test_sparse_sensor(void) {
+    ForecastConfig config;
+    HoltWinters model;
+    ForecastScore score;
+
+    srand(2);
+    forecast_get_default_config(&config);
+    assert(holt_winters_init(&model, &config));
+    assert(feed(&model, &config, 300) <= 2);
+    assert(model.ready);
+    assert(sqrtf(model.variance) > 0.5f * TEST_NOISE);
+
+    // A real fault still stands out
+    uint32_t t = TEST_START + TEST_DAYS * 86400;
+    assert(holt_winters_update(&model, &config, t, daily_value(t) + 20.0f * TEST_NOISE, &score));
+    assert(score.deviation > config.threshold);
+    holt_winters_free(&model);
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running forecast tests...\n");
+
+    if (test_dense_sensor() != 0) {
+        printf("Dense sensor test failed\n");
+        return 1;
+    }
+    printf("Dense sensor test passed\n");
+
+    if (test_sparse_sensor() != 0) {
+        printf("Sparse sensor test failed\n");
+        return 1;
+    }
+    printf("Sparse sensor test passed\n");
+
+    printf("All forecast tests passed\n");
+    return 0;
+}
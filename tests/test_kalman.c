@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "../include/kalman.h"
+
+// Test configuration
+#define TEST_LANES 13       // Not a multiple of the vector width, so the scalar tail runs too
+#define TEST_STEPS 5000
+
+static KalmanBank vector_bank;
+static KalmanBank scalar_bank;
+
+static float test_reading(uint32_t lane, uint32_t t) {
+    return 20.0f + lane + sinf(t * 0.01f) + (float)rand() / RAND_MAX;
+}
+
+// Test that one sweep over all lanes gives bit-identical results to stepping lanes one by one
+static int test_vector_scalar_parity(void) {
+    KalmanConfig level_config;
+    KalmanConfig slope_config;
+    kalman_get_default_config(&slope_config);
+    level_config = slope_config;
+    level_config.model = KALMAN_MODEL_LEVEL;
+    slope_config.model = KALMAN_MODEL_LEVEL_SLOPE;
+
+    kalman_bank_init(&vector_bank);
+    kalman_bank_init(&scalar_bank);
+    srand(1);
+    for (uint32_t lane = 0; lane < TEST_LANES; lane++) {
+        const KalmanConfig* config = lane % 2 ? &level_config : &slope_config;
+        float value = test_reading(lane, 0);
+        assert(kalman_bank_start_lane(&vector_bank, lane, config, value));
+        assert(kalman_bank_start_lane(&scalar_bank, lane, config, value));
+    }
+
+    for (uint32_t t = 1; t <= TEST_STEPS; t++) {
+        for (uint32_t lane = 0; lane < TEST_LANES; lane++) {
+            // Some lanes only predict, over uneven time steps
+            float dt = (float)(1 + rand() % 3);
+            float measurement = rand() % 4 == 0 ? NAN : test_reading(lane, t);
+            vector_bank.dt[lane] = scalar_bank.dt[lane] = dt;
+            vector_bank.measurement[lane] = scalar_bank.measurement[lane] = measurement;
+        }
+        kalman_bank_step(&vector_bank, 0, TEST_LANES);
+        for (uint32_t lane = 0; lane < TEST_LANES; lane++) {
+            kalman_bank_step(&scalar_bank, lane, 1);
+        }
+    }
+
+    assert(memcmp(vector_bank.level, scalar_bank.level, sizeof(float) * TEST_LANES) == 0);
+    assert(memcmp(vector_bank.slope, scalar_bank.slope, sizeof(float) * TEST_LANES) == 0);
+    assert(memcmp(vector_bank.p00, scalar_bank.p00, sizeof(float) * TEST_LANES) == 0);
+    assert(memcmp(vector_bank.p01, scalar_bank.p01, sizeof(float) * TEST_LANES) == 0);
+    assert(memcmp(vector_bank.p11, scalar_bank.p11, sizeof(float) * TEST_LANES) == 0);
+    return 0;
+}
+
+// Test that the registry's queued sweeps give the same estimates as filtering each sensor alone
+static int test_registry_matches_bank(void) {
+    KalmanConfig config;
+    Sensor sensors[TEST_LANES];
+    bool started[TEST_LANES] = {false};
+    uint32_t last_timestamp[TEST_LANES] = {0};
+
+    kalman_get_default_config(&config);
+    kalman_bank_init(&scalar_bank);
+    assert(kalman_init(&config));
+    for (uint32_t lane = 0; lane < TEST_LANES; lane++) {
+        char id[16];
+        snprintf(id, sizeof(id), "K%02u", lane);
+        assert(sensor_init(&sensors[lane], SENSOR_TYPE_TEMPERATURE, id));
+    }
+
+    srand(2);
+    for (uint32_t t = 1000; t < 1000 + TEST_STEPS; t++) {
+        for (uint32_t lane = 0; lane < TEST_LANES; lane++) {
+            if (rand() % 4 == 0) {
+                continue;
+            }
+            // An occasional second sample in the same tick is folded in straight away
+            int samples = rand() % 10 == 0 ? 2 : 1;
+            for (int i = 0; i < samples; i++) {
+                SensorData data;
+                memset(&data, 0, sizeof(data));
+                data.timestamp = t;
+                data.is_valid = true;
+                data.value = test_reading(lane, t);
+                assert(kalman_process_sample(&sensors[lane], &data));
+
+                if (!started[lane]) {
+                    assert(kalman_bank_start_lane(&scalar_bank, lane, &config, data.value));
+                    started[lane] = true;
+                } else {
+                    scalar_bank.measurement[lane] = data.value;
+                    scalar_bank.dt[lane] = (float)(t - last_timestamp[lane]);
+                    kalman_bank_step(&scalar_bank, lane, 1);
+                }
+                last_timestamp[lane] = t;
+            }
+
+            // Reading an estimate folds in the sensor's queued sample
+            if (rand() % 5 == 0) {
+                KalmanEstimate estimate;
+                assert(kalman_get_estimate(sensors[lane].id, &estimate));
+                assert(memcmp(&estimate.value, &scalar_bank.level[lane], sizeof(float)) == 0);
+                assert(memcmp(&estimate.slope, &scalar_bank.slope[lane], sizeof(float)) == 0);
+            }
+        }
+    }
+
+    kalman_cleanup();
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running Kalman tests...\n");
+
+    if (test_vector_scalar_parity() != 0) {
+        printf("Vector and scalar parity test failed\n");
+        return 1;
+    }
+    printf("Vector and scalar parity test passed\n");
+
+    if (test_registry_matches_bank() != 0) {
+        printf("Registry batching test failed\n");
+        return 1;
+    }
+    printf("Registry batching test passed\n");
+
+    printf("All Kalman tests passed\n");
+    return 0;
+}
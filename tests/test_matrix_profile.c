@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "../include/matrix_profile.h"
+
+// Test configuration
+#define TEST_WINDOW 32
+#define TEST_LENGTH 600
+#define TEST_EXTRA 40
+static const double TEST_TOLERANCE = 1e-3;
+
+static float series[TEST_LENGTH + TEST_EXTRA];
+
+// Nearest non-trivial z-normalized distance of one subsequence, by brute force
+static double brute_force_distance(uint32_t index, uint32_t subsequences, uint32_t exclusion) {
+    double best = INFINITY;
+
+    for (uint32_t j = 0; j < subsequences; j++) {
+        if ((index > j ? index - j : j - index) < exclusion) {
+            continue;
+        }
+        double mean_a = 0.0, mean_b = 0.0;
+        for (uint32_t k = 0; k < TEST_WINDOW; k++) {
+            mean_a += series[index + k];
+            mean_b += series[j + k];
+        }
+        mean_a /= TEST_WINDOW;
+        mean_b /= TEST_WINDOW;
+
+        double var_a = 0.0, var_b = 0.0, cov = 0.0;
+        for (uint32_t k = 0; k < TEST_WINDOW; k++) {
+            double a = series[index + k] - mean_a;
+            double b = series[j + k] - mean_b;
+            var_a += a * a;
+            var_b += b * b;
+            cov += a * b;
+        }
+        double r = cov / sqrt(var_a * var_b);
+        best = fmin(best, sqrt(fmax(0.0, 2.0 * TEST_WINDOW * (1.0 - r))));
+    }
+
+    return best;
+}
+
+static int compare_with_brute_force(const MatrixProfile* profile) {
+    uint32_t subsequences = matrix_profile_subsequences(profile);
+
+    for (uint32_t i = 0; i < subsequences; i++) {
+        MatrixProfileMatch match;
+        assert(matrix_profile_get(profile, i, &match));
+        double expected = brute_force_distance(i, subsequences, profile->config.exclusion);
+        if (fabs(match.distance - expected) > TEST_TOLERANCE * fmax(1.0, expected)) {
+            printf("subsequence %u: distance %g, brute force %g\n", i, match.distance, expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void init_profile(MatrixProfile* profile, uint32_t threads) {
+    MatrixProfileConfig config;
+    matrix_profile_get_default_config(&config);
+    config.window = TEST_WINDOW;
+    config.period_s = 1;
+    config.threads = threads;
+    assert(matrix_profile_init(profile, &config));
+}
+
+// Test the batch computation, single- and multi-threaded, against a brute-force profile
+static int test_compute(void) {
+    for (uint32_t threads = 1; threads <= 4; threads *= 4) {
+        MatrixProfile profile;
+        init_profile(&profile, threads);
+        for (uint32_t i = 0; i < TEST_LENGTH; i++) {
+            assert(matrix_profile_append(&profile, 1000 + i, series[i]));
+        }
+        assert(matrix_profile_compute(&profile) == 1.0f);
+        int result = compare_with_brute_force(&profile);
+        matrix_profile_free(&profile);
+        if (result != 0) {
+            return result;
+        }
+    }
+    return 0;
+}
+
+// Test that extending the profile one sample at a time keeps it exact
+static int test_update(void) {
+    MatrixProfile profile;
+    init_profile(&profile, 1);
+    for (uint32_t i = 0; i < TEST_LENGTH; i++) {
+        assert(matrix_profile_append(&profile, 1000 + i, series[i]));
+    }
+    assert(matrix_profile_compute(&profile) == 1.0f);
+    for (uint32_t i = TEST_LENGTH; i < TEST_LENGTH + TEST_EXTRA; i++) {
+        assert(matrix_profile_update(&profile, 1000 + i, series[i]));
+    }
+
+    int result = compare_with_brute_force(&profile);
+    matrix_profile_free(&profile);
+    return result;
+}
+
+// Test that updates during an interrupted computation keep it, and it finishes exact
+static int test_interrupted_update(void) {
+    MatrixProfile profile;
+    init_profile(&profile, 1);
+    for (uint32_t i = 0; i < TEST_LENGTH; i++) {
+        assert(matrix_profile_append(&profile, 1000 + i, series[i]));
+    }
+    profile.config.time_budget_s = 1e-9f;
+    float coverage = matrix_profile_compute(&profile);
+    assert(coverage >= 0.0f && coverage < 1.0f);
+    for (uint32_t i = TEST_LENGTH; i < TEST_LENGTH + TEST_EXTRA; i++) {
+        assert(matrix_profile_update(&profile, 1000 + i, series[i]));
+    }
+
+    // The remaining bands still cover the series the computation started on
+    profile.config.time_budget_s = 0.0f;
+    assert(matrix_profile_compute(&profile) == 1.0f);
+    assert(profile.profiled == TEST_LENGTH - TEST_WINDOW + 1);
+    int result = compare_with_brute_force(&profile);
+    matrix_profile_free(&profile);
+    return result;
+}
+
+// Test that flat and interpolated straight stretches are neither motifs nor discords
+static int test_shapeless(void) {
+    MatrixProfile profile;
+    MatrixProfileMatch matches[3];
+    init_profile(&profile, 1);
+
+    // Constant over [200, 300), then no samples over (400, 480)
+    for (uint32_t i = 0; i < TEST_LENGTH; i++) {
+        if (i > 400 && i < 480) {
+            continue;
+        }
+        assert(matrix_profile_append(&profile, 1000 + i, i >= 200 && i < 300 ? 0.5f : series[i]));
+    }
+    assert(matrix_profile_compute(&profile) == 1.0f);
+    assert(!matrix_profile_get(&profile, 220, &matches[0]));
+    assert(!matrix_profile_get(&profile, 420, &matches[0]));
+    assert(matrix_profile_get(&profile, 100, &matches[0]));
+
+    uint32_t found = matrix_profile_motifs(&profile, matches, 3);
+    assert(found == 3);
+    for (uint32_t i = 0; i < found; i++) {
+        assert(profile.inv_norm[matches[i].index] > 0.0 && profile.inv_norm[matches[i].neighbor] > 0.0);
+    }
+    found = matrix_profile_discords(&profile, matches, 3);
+    assert(found == 3);
+    for (uint32_t i = 0; i < found; i++) {
+        assert(profile.inv_norm[matches[i].index] > 0.0);
+        assert(matches[i].distance < sqrt(2.0 * TEST_WINDOW));
+    }
+    matrix_profile_free(&profile);
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running matrix profile tests...\n");
+
+    // A noisy periodic signal with one distorted cycle
+    srand(1);
+    for (uint32_t i = 0; i < TEST_LENGTH + TEST_EXTRA; i++) {
+        series[i] = sinf(2.0f * (float)M_PI * i / 50.0f) + 0.2f * ((float)rand() / RAND_MAX - 0.5f);
+        if (i >= 300 && i < 330) {
+            series[i] += 0.8f * sinf(2.0f * (float)M_PI * i / 7.0f);
+        }
+    }
+
+    if (test_compute() != 0) {
+        printf("Matrix profile computation test failed\n");
+        return 1;
+    }
+    printf("Matrix profile computation test passed\n");
+
+    if (test_update() != 0) {
+        printf("Matrix profile update test failed\n");
+        return 1;
+    }
+    printf("Matrix profile update test passed\n");
+
+    if (test_interrupted_update() != 0) {
+        printf("Interrupted update test failed\n");
+        return 1;
+    }
+    printf("Interrupted update test passed\n");
+
+    if (test_shapeless() != 0) {
+        printf("Shapeless subsequence test failed\n");
+        return 1;
+    }
+    printf("Shapeless subsequence test passed\n");
+
+    printf("All matrix profile tests passed\n");
+    return 0;
+}
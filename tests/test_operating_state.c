@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "../include/operating_state.h"
+
+// Test configuration
+#define TEST_MEMBERS 4
+#define TEST_HOURS 48
+static const uint32_t TEST_START = 1699999200u;  // Aligned to the hour
+
+// Standard normal noise from a fixed seed
+static float gauss(void) {
+    float u = (rand() + 1.0f) / (RAND_MAX + 2.0f);
+    float v = (rand() + 1.0f) / (RAND_MAX + 2.0f);
+    return sqrtf(-2.0f * logf(u)) * cosf(6.2831853f * v);
+}
+
+// Feed one sample per second to each sensor, `step` times the hour modulo 3 above its base
+static void feed(Sensor* sensors, uint32_t members, uint32_t start, uint32_t seconds, float step) {
+    for (uint32_t t = start; t < start + seconds; t++) {
+        float level = step * (float)(((t - start) / 3600) % 3);
+        for (uint32_t i = 0; i < members; i++) {
+            SensorData data;
+            memset(&data, 0, sizeof(data));
+            data.type = SENSOR_TYPE_TEMPERATURE;
+            data.is_valid = true;
+            data.timestamp = t;
+            data.value = 20.0f + (float)i + level + gauss();
+            operating_state_process_sample(&sensors[i], &data);
+        }
+    }
+}
+
+static void init_sensors(Sensor* sensors, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        char id[16];
+        snprintf(id, sizeof(id), "TEMP%03u", i + 1);
+        assert(sensor_init(&sensors[i], SENSOR_TYPE_TEMPERATURE, id));
+        sensor_set_location(&sensors[i], "line-1");
+    }
+}
+
+// Test that a machine in one condition keeps one state
+static int test_steady_state(void) {
+    Sensor sensors[TEST_MEMBERS];
+    OperatingStateStatus status;
+
+    srand(1);
+    assert(operating_state_init(NULL));
+    init_sensors(sensors, TEST_MEMBERS);
+    feed(sensors, TEST_MEMBERS, TEST_START, TEST_HOURS * 3600, 0.0f);
+
+    assert(operating_state_get("TEMP001", &status));
+    assert(status.windows == TEST_HOURS * 60 - 1);  // The last window is still open
+    assert(status.states == 1);
+    assert(status.state == 0);
+    assert(status.changes == 0);
+    operating_state_cleanup();
+    return 0;
+}
+
+// Test that an hourly cycle through three load levels is followed without extra changes
+static int test_load_cycle(void) {
+    Sensor sensors[TEST_MEMBERS];
+    OperatingStateStatus status;
+
+    srand(2);
+    assert(operating_state_init(NULL));
+    init_sensors(sensors, TEST_MEMBERS);
+    feed(sensors, TEST_MEMBERS, TEST_START, TEST_HOURS * 3600, 5.0f);
+
+    // One change per hour boundary, the first few while the states are still being learned
+    assert(operating_state_get("TEMP001", &status));
+    assert(status.states == 3);
+    assert(status.changes >= TEST_HOURS - 3 && status.changes <= TEST_HOURS - 1);
+    assert(status.state == (int32_t)((TEST_HOURS - 1) % 3));
+    operating_state_cleanup();
+    return 0;
+}
+
+// Test that a sensor joining a learned group restarts its learning
+static int test_late_member(void) {
+    Sensor sensors[TEST_MEMBERS + 1];
+    OperatingStateStatus status;
+
+    srand(3);
+    assert(operating_state_init(NULL));
+    init_sensors(sensors, TEST_MEMBERS + 1);
+    feed(sensors, TEST_MEMBERS, TEST_START, 3600, 0.0f);
+    assert(operating_state_get("TEMP001", &status));
+    assert(status.members == TEST_MEMBERS && status.state == 0);
+
+    // The window the new sensor joins in rebuilds the group, which has no state until
+    // a batch of windows with all five members has closed
+    feed(sensors, TEST_MEMBERS + 1, TEST_START + 3600, 120, 0.0f);
+    assert(operating_state_get("TEMP005", &status));
+    assert(status.members == TEST_MEMBERS + 1);
+    assert(status.state == -1);
+
+    feed(sensors, TEST_MEMBERS + 1, TEST_START + 3720, 3600, 0.0f);
+    assert(operating_state_get("TEMP005", &status));
+    assert(status.state == 0);
+    assert(status.changes == 0);
+    operating_state_cleanup();
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running operating state tests...\n");
+
+    if (test_steady_state() != 0) {
+        printf("Steady state test failed\n");
+        return 1;
+    }
+    printf("Steady state test passed\n");
+
+    if (test_load_cycle() != 0) {
+        printf("Load cycle test failed\n");
+        return 1;
+    }
+    printf("Load cycle test passed\n");
+
+    if (test_late_member() != 0) {
+        printf("Late member test failed\n");
+        return 1;
+    }
+    printf("Late member test passed\n");
+
+    printf("All operating state tests passed\n");
+    return 0;
+}
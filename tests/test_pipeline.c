@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/pipeline.h"
+#include "../include/pipeline_stages.h"
+
+// Test configuration
+#define TEST_SINKS (PIPELINE_MAX_STAGES - 4)
+
+static uint32_t sink_calls = 0;
+
+static bool count_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)sensor;
+    (void)data;
+    (void)context;
+    sink_calls++;
+    return true;
+}
+
+static bool stop_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)sensor;
+    (void)data;
+    (void)context;
+    return false;
+}
+
+// Test registration order, stopping and the counters
+static int test_stages(void) {
+    Sensor sensor;
+    SensorData data;
+    PipelineStageStats stats[PIPELINE_MAX_STAGES];
+
+    assert(sensor_init(&sensor, SENSOR_TYPE_TEMPERATURE, "TEMP001"));
+    memset(&data, 0, sizeof(data));
+    data.is_valid = true;
+
+    pipeline_clear();
+    sink_calls = 0;
+    assert(pipeline_register_stage("first", count_stage, NULL));
+    assert(pipeline_register_stage("stop", stop_stage, NULL));
+    assert(pipeline_register_stage("never", count_stage, NULL));
+    assert(!pipeline_process(&sensor, &data));
+    assert(sink_calls == 1);
+
+    assert(pipeline_get_stats(stats, PIPELINE_MAX_STAGES) == 3);
+    assert(strcmp(stats[1].name, "stop") == 0);
+    assert(stats[1].processed == 1 && stats[1].stopped == 1);
+    assert(stats[2].processed == 0);
+
+    pipeline_truncate(1);
+    assert(pipeline_get_stage_count() == 1);
+    assert(pipeline_process(&sensor, &data));
+    assert(sink_calls == 2);
+    pipeline_clear();
+    return 0;
+}
+
+// Test that default stages that do not fit are all removed again, along with their components
+static int test_default_stages_rollback(void) {
+    pipeline_clear();
+    for (uint32_t i = 0; i < TEST_SINKS; i++) {
+        assert(pipeline_register_stage("sink", count_stage, NULL));
+    }
+
+    assert(!pipeline_register_default_stages(NULL));
+    assert(pipeline_get_stage_count() == TEST_SINKS);
+
+    // The components were released, so they come up again once there is room
+    pipeline_truncate(2);
+    assert(pipeline_register_default_stages(NULL));
+    assert(pipeline_get_stage_count() > 2);
+    pipeline_cleanup_default_stages();
+    assert(pipeline_get_stage_count() == 0);
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running pipeline tests...\n");
+
+    if (test_stages() != 0) {
+        printf("Pipeline stage test failed\n");
+        return 1;
+    }
+    printf("Pipeline stage test passed\n");
+
+    if (test_default_stages_rollback() != 0) {
+        printf("Default stage rollback test failed\n");
+        return 1;
+    }
+    printf("Default stage rollback test passed\n");
+
+    printf("All pipeline tests passed\n");
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "../include/rules.h"
+
+// Compile an expression without operands and run it
+static float evaluate(const char* expression) {
+    RuleProgram program;
+    uint32_t error_offset;
+
+    assert(rule_compile(expression, &program, &error_offset));
+    assert(program.operand_count == 0);
+    return rule_program_run(&program, NULL);
+}
+
+// Test precedence and the result of every operator
+static int test_evaluation(void) {
+    assert(evaluate("1 + 2 * 3") == 7.0f);
+    assert(evaluate("(1 + 2) * 3") == 9.0f);
+    assert(evaluate("10 - 4 - 3") == 3.0f);
+    assert(evaluate("12 / 4 / 3") == 1.0f);
+    assert(evaluate("-2 * -3") == 6.0f);
+    assert(evaluate("!0 + !5") == 1.0f);
+    assert(evaluate("1 < 2 && 2 <= 2 && 3 > 2 && 3 >= 3 && 4 == 4 && 4 != 5") == 1.0f);
+    assert(evaluate("1 > 2 || 0") == 0.0f);
+    assert(evaluate("0 || 1 && 0") == 0.0f);
+    assert(evaluate("1 + 1 > 1 && 2.5 * 2 == 5") == 1.0f);
+    return 0;
+}
+
+// Test that operands are resolved once and loaded by index
+static int test_operands(void) {
+    RuleProgram program;
+    uint32_t error_offset;
+
+    assert(rule_compile("avg_1m(TEMP001) > 40 && rate(CUR003) > 2 || TEMP001 > avg_1m(TEMP001) + 10",
+                        &program, &error_offset));
+    assert(program.operand_count == 3);
+    assert(program.operands[0].kind == RULE_OPERAND_AVG);
+    assert(program.operands[0].width_s == 60);
+    assert(strcmp(program.operands[0].sensor_id, "TEMP001") == 0);
+    assert(program.operands[1].kind == RULE_OPERAND_RATE);
+    assert(program.operands[2].kind == RULE_OPERAND_VALUE);
+
+    const float quiet[3] = {35.0f, 0.5f, 36.0f};
+    const float hot[3] = {41.0f, 3.0f, 42.0f};
+    const float spike[3] = {35.0f, 0.0f, 46.0f};
+    assert(rule_program_run(&program, quiet) == 0.0f);
+    assert(rule_program_run(&program, hot) == 1.0f);
+    assert(rule_program_run(&program, spike) == 1.0f);
+    return 0;
+}
+
+// Test that syntax errors are reported at their offset
+static int test_errors(void) {
+    RuleProgram program;
+    uint32_t error_offset;
+
+    assert(!rule_compile("1 +", &program, &error_offset));
+    assert(error_offset == 3);
+    assert(!rule_compile("(1 + 2", &program, &error_offset));
+    assert(error_offset == 6);
+    assert(!rule_compile("1 2", &program, &error_offset));
+    assert(error_offset == 2);
+    assert(!rule_compile("avg_7x(TEMP001) > 1", &program, &error_offset));
+    assert(!rule_compile("", &program, &error_offset));
+    return 0;
+}
+
+// Test that deep nesting is rejected instead of exhausting the C stack
+static int test_nesting_limit(void) {
+    RuleProgram program;
+    uint32_t error_offset;
+    const size_t length = 3000000;
+    char* text = (char*)malloc(length + 1);
+    assert(text);
+
+    memset(text, '(', length);
+    text[length] = '\0';
+    assert(!rule_compile(text, &program, &error_offset));
+    assert(error_offset == RULE_MAX_NESTING);
+
+    memset(text, '-', length);
+    assert(!rule_compile(text, &program, &error_offset));
+    assert(error_offset == RULE_MAX_NESTING);
+
+    // Just within the limit
+    size_t depth = RULE_MAX_NESTING;
+    memset(text, '(', depth);
+    text[depth] = '1';
+    memset(text + depth + 1, ')', depth);
+    text[2 * depth + 1] = '\0';
+    assert(rule_compile(text, &program, &error_offset));
+    assert(rule_program_run(&program, NULL) == 1.0f);
+
+    free(text);
+    return 0;
+}
+
+// Test that a registered rule follows the samples of its sensor
+static int test_rule_activation(void) {
+    Sensor sensor;
+    SensorData data;
+    RuleStatus status;
+    uint32_t error_offset;
+
+    assert(sensor_init(&sensor, SENSOR_TYPE_TEMPERATURE, "TEMP001"));
+    assert(rules_init());
+    assert(rules_add("overheat", "TEMP001 > 40", &error_offset));
+
+    memset(&data, 0, sizeof(data));
+    data.type = SENSOR_TYPE_TEMPERATURE;
+    data.is_valid = true;
+    const float values[] = {35.0f, 41.0f, 42.0f, 39.0f, 45.0f};
+    for (uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        data.timestamp = 1000 + i;
+        data.value = values[i];
+        rules_process_sample(&sensor, &data);
+    }
+
+    assert(rules_get_status("overheat", &status));
+    assert(status.ready && status.active);
+    assert(status.evaluations == 5);
+    assert(status.activations == 2);
+    assert(status.last_change == 1004);
+
+    assert(rules_remove("overheat"));
+    assert(!rules_get_status("overheat", &status));
+    rules_cleanup();
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running rules tests...\n");
+
+    if (test_evaluation() != 0) {
+        printf("Rule evaluation test failed\n");
+        return 1;
+    }
+    printf("Rule evaluation test passed\n");
+
+    if (test_operands() != 0) {
+        printf("Rule operand test failed\n");
+        return 1;
+    }
+    printf("Rule operand test passed\n");
+
+    if (test_errors() != 0) {
+        printf("Rule error test failed\n");
+        return 1;
+    }
+    printf("Rule error test passed\n");
+
+    if (test_nesting_limit() != 0) {
+        printf("Rule nesting limit test failed\n");
+        return 1;
+    }
+    printf("Rule nesting limit test passed\n");
+
+    if (test_rule_activation() != 0) {
+        printf("Rule activation test failed\n");
+        return 1;
+    }
+    printf("Rule activation test passed\n");
+
+    printf("All rules tests passed\n");
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+#include "../include/segment_writer.h"
+#include "../include/retention.h"
+
+// Test configuration
+#define TEST_SPAN_S 100
+#define TEST_PREFIX "test"
+#define TEST_HEADER "Timestamp,Value"
+static const uint32_t TEST_START = 1700000000u;  // Aligned to the span
+
+static char test_dir[] = "/tmp/edgetrack_segment_writer_XXXXXX";
+
+// Read a segment, checking its header and that its records lie within [start, end)
+static uint32_t read_segment(uint32_t start, uint32_t end, uint32_t* records) {
+    char path[256];
+    assert(segment_writer_path(path, sizeof(path), test_dir, TEST_PREFIX, start));
+    FILE* file = fopen(path, "r");
+    assert(file);
+
+    char line[64];
+    assert(fgets(line, sizeof(line), file) && strcmp(line, TEST_HEADER "\n") == 0);
+    uint32_t count = 0;
+    uint32_t last = 0;
+    while (fgets(line, sizeof(line), file)) {
+        uint32_t timestamp = (uint32_t)strtoul(line, NULL, 10);
+        assert(timestamp >= start && timestamp < end);
+        assert(strcmp(line + 10, ",1\n") == 0);
+        last = timestamp;
+        count++;
+    }
+    fclose(file);
+    *records = count;
+    return last;
+}
+
+static void write_record(SegmentWriter* writer, uint32_t timestamp) {
+    char line[32];
+    snprintf(line, sizeof(line), "%u,1", timestamp);
+    assert(segment_writer_write(writer, timestamp, line));
+}
+
+// Test that a record older than the open segment lands in the segment covering it
+static int test_late_records(void) {
+    SegmentWriter writer;
+    uint32_t records;
+
+    assert(segment_writer_open(&writer, test_dir, TEST_PREFIX, TEST_HEADER, TEST_SPAN_S, 0));
+    for (uint32_t t = TEST_START; t < TEST_START + 2 * TEST_SPAN_S; t += 10) {
+        write_record(&writer, t);
+    }
+    assert(writer.segment_start == TEST_START + TEST_SPAN_S);
+
+    // Held back past the rotation, as compressed samples can be
+    write_record(&writer, TEST_START + 95);
+    assert(writer.late_records == 1);
+    assert(read_segment(TEST_START, TEST_START + TEST_SPAN_S, &records) == TEST_START + 95);
+    assert(records == 11);
+
+    // Older than every segment: starts the segment of its own span
+    write_record(&writer, TEST_START - TEST_SPAN_S + 5);
+    assert(writer.late_records == 2);
+    segment_writer_close(&writer);
+    read_segment(TEST_START - TEST_SPAN_S, TEST_START, &records);
+    assert(records == 1);
+    read_segment(TEST_START + TEST_SPAN_S, TEST_START + 2 * TEST_SPAN_S, &records);
+    assert(records == 10);
+    return 0;
+}
+
+// Test that compaction merges closed segments into one, keeping every record once
+static int test_compaction(void) {
+    SegmentWriter writer;
+    RetentionConfig config;
+    RetentionStats stats;
+    uint32_t records;
+
+    // Three more closed segments after the ones test_late_records() left, then the open one
+    assert(segment_writer_open(&writer, test_dir, TEST_PREFIX, TEST_HEADER, TEST_SPAN_S, 0));
+    for (uint32_t t = TEST_START + 2 * TEST_SPAN_S; t < TEST_START + 6 * TEST_SPAN_S; t += 10) {
+        write_record(&writer, t);
+    }
+    segment_writer_close(&writer);
+
+    memset(&config, 0, sizeof(config));
+    snprintf(config.directory, sizeof(config.directory), "%s", test_dir);
+    snprintf(config.tiers[0].prefix, sizeof(config.tiers[0].prefix), "%s", TEST_PREFIX);
+    config.tiers[0].compact_min_kb = 1;
+    config.tiers[0].compact_target_kb = 64;
+    config.tier_count = 1;
+    config.interval_s = 3600;
+    assert(retention_init(&config));
+    assert(retention_run_once(TEST_START + 6 * TEST_SPAN_S));
+    retention_get_stats(&stats);
+    retention_cleanup();
+
+    // Six closed segments became one; the open one is untouched
+    assert(stats.segments_merged == 5);
+    assert(stats.segment_count == 2);
+    assert(read_segment(TEST_START - TEST_SPAN_S, TEST_START + 5 * TEST_SPAN_S, &records) ==
+           TEST_START + 5 * TEST_SPAN_S - 10);
+    assert(records == 1 + 11 + 10 + 3 * 10);
+    read_segment(TEST_START + 5 * TEST_SPAN_S, TEST_START + 6 * TEST_SPAN_S, &records);
+    assert(records == 10);
+    return 0;
+}
+
+// Main test function
+int main(void) {
+    printf("Running segment writer tests...\n");
+
+    assert(mkdtemp(test_dir));
+
+    if (test_late_records() != 0) {
+        printf("Late record test failed\n");
+        return 1;
+    }
+    printf("Late record test passed\n");
+
+    if (test_compaction() != 0) {
+        printf("Compaction test failed\n");
+        return 1;
+    }
+    printf("Compaction test passed\n");
+
+    // Compaction left the merged segment and the open one
+    char path[256];
+    segment_writer_path(path, sizeof(path), test_dir, TEST_PREFIX, TEST_START - TEST_SPAN_S);
+    unlink(path);
+    segment_writer_path(path, sizeof(path), test_dir, TEST_PREFIX, TEST_START + 5 * TEST_SPAN_S);
+    unlink(path);
+    rmdir(test_dir);
+
+    printf("All segment writer tests passed\n");
+    return 0;
+}
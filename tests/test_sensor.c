@@ -1,147 +1,121 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include <assert.h>
 #include "../include/sensor.h"
 #include "../include/temperature_sensor.h"
-#include "../include/logger.h"
 
 // Test configuration
-static const char* TEST_LOG_FILE = "test.log";
-static const int TEST_SENSOR_ID = 1;
-static const int TEST_SAMPLING_RATE = 1000;
+static const char* TEST_SENSOR_ID = "TEST001";
 static const float TEST_MIN_VALUE = -40.0f;
 static const float TEST_MAX_VALUE = 125.0f;
 
-// Test logger initialization
-static int test_logger_init(void) {
-    LoggerConfig config = {
-        .log_file_path = TEST_LOG_FILE,
-        .min_log_level = LOG_LEVEL_DEBUG,
-        .max_file_size = 1024 * 1024,  // 1MB
-        .max_files = 3,
-        .log_to_console = true,
-        .log_to_file = true,
-        .include_timestamp = true
-    };
+// Test sensor initialization
+static int test_sensor_init(void) {
+    Sensor sensor;
+    memset(&sensor, 0, sizeof(sensor));
 
-    int result = logger_init(&config);
-    assert(result == 0 && "Logger initialization failed");
-    return result;
-}
+    assert(sensor_init(&sensor, SENSOR_TYPE_PRESSURE, TEST_SENSOR_ID) && "Sensor initialization failed");
+    assert(strcmp(sensor.id, TEST_SENSOR_ID) == 0);
+    assert(sensor.type == SENSOR_TYPE_PRESSURE);
+    assert(sensor.sample_count == 0 && sensor.error_count == 0);
+    assert(sensor.last_error == SENSOR_ERROR_NONE);
 
-// Test sensor creation
-static int test_sensor_create(void) {
-    SensorConfig config = {
-        .sensor_id = TEST_SENSOR_ID,
-        .sampling_rate = TEST_SAMPLING_RATE
-    };
+    sensor_set_name(&sensor, "Inlet pressure");
+    sensor_set_location(&sensor, "line-1");
+    assert(strcmp(sensor.name, "Inlet pressure") == 0);
+    assert(strcmp(sensor.location, "line-1") == 0);
 
-    Sensor* sensor = sensor_create(&config);
-    assert(sensor != NULL && "Sensor creation failed");
-
-    sensor_destroy(sensor);
+    sensor_cleanup(&sensor);
     return 0;
 }
 
-// Test temperature sensor creation
-static int test_temperature_sensor_create(void) {
-    TemperatureSensorConfig config = {
-        .sensor_id = TEST_SENSOR_ID,
-        .sampling_rate = TEST_SAMPLING_RATE,
-        .min_value = TEST_MIN_VALUE,
-        .max_value = TEST_MAX_VALUE
-    };
-
-    TemperatureSensor* sensor = temperature_sensor_create(&config);
-    assert(sensor != NULL && "Temperature sensor creation failed");
+// Test type and error names
+static int test_string_conversion(void) {
+    for (int type = SENSOR_TYPE_TEMPERATURE; type <= SENSOR_TYPE_MAGNETIC; type++) {
+        SensorType parsed;
+        assert(sensor_string_to_type(sensor_type_to_string((SensorType)type), &parsed));
+        assert(parsed == (SensorType)type);
+    }
+    for (int error = SENSOR_ERROR_NONE; error <= SENSOR_ERROR_CALIBRATION; error++) {
+        SensorError parsed;
+        assert(sensor_string_to_error(sensor_error_to_string((SensorError)error), &parsed));
+        assert(parsed == (SensorError)error);
+    }
 
-    temperature_sensor_destroy(sensor);
+    SensorType type;
+    assert(!sensor_string_to_type("NO_SUCH_TYPE", &type));
     return 0;
 }
 
-// Test temperature sensor start/stop
-static int test_temperature_sensor_control(void) {
-    TemperatureSensorConfig config = {
-        .sensor_id = TEST_SENSOR_ID,
-        .sampling_rate = TEST_SAMPLING_RATE,
-        .min_value = TEST_MIN_VALUE,
-        .max_value = TEST_MAX_VALUE
+// Test temperature sensor readings
+static int test_temperature_sensor_read(void) {
+    TemperatureConfig config = {
+        .min_temp = TEST_MIN_VALUE,
+        .max_temp = TEST_MAX_VALUE,
+        .alert_threshold = 40.0f,
+        .critical_threshold = 45.0f,
+        .calibration_offset = 0.0f,
+        .sampling_rate_ms = 1000,
+        .enable_humidity = true,
+        .enable_dew_point = true,
+        .enable_heat_index = true
     };
 
-    TemperatureSensor* sensor = temperature_sensor_create(&config);
-    assert(sensor != NULL && "Temperature sensor creation failed");
-
-    int result = temperature_sensor_start(sensor);
-    assert(result == 0 && "Temperature sensor start failed");
-
-    // Wait for a few samples
-    Sleep(3000);  // Windows-specific, use sleep(3) on Unix
+    Sensor sensor;
+    memset(&sensor, 0, sizeof(sensor));
+    assert(temperature_sensor_init(&sensor, TEST_SENSOR_ID, &config) && "Temperature sensor initialization failed");
 
-    result = temperature_sensor_stop(sensor);
-    assert(result == 0 && "Temperature sensor stop failed");
+    for (int i = 0; i < 10; i++) {
+        SensorData data;
+        assert(temperature_sensor_read(&sensor, &data) && "Temperature sensor read failed");
+        assert(data.is_valid);
+        assert(data.type == SENSOR_TYPE_TEMPERATURE);
+        assert(data.value >= TEST_MIN_VALUE && data.value <= TEST_MAX_VALUE);
+    }
 
-    temperature_sensor_destroy(sensor);
+    temperature_sensor_cleanup(&sensor);
     return 0;
 }
 
-// Test error handling
-static int test_error_handling(void) {
-    // Test invalid configuration
-    TemperatureSensorConfig config = {
-        .sensor_id = TEST_SENSOR_ID,
-        .sampling_rate = 0,  // Invalid sampling rate
-        .min_value = TEST_MAX_VALUE,
-        .max_value = TEST_MIN_VALUE  // Invalid range
-    };
-
-    TemperatureSensor* sensor = temperature_sensor_create(&config);
-    assert(sensor == NULL && "Should fail with invalid configuration");
-
+// Test derived quantities
+static int test_dew_point(void) {
+    // Saturated air has its dew point at the air temperature
+    assert(fabsf(temperature_sensor_calculate_dew_point(20.0f, 100.0f) - 20.0f) < 0.1f);
+    // 25 °C at 50 % relative humidity condenses at about 13.9 °C
+    assert(fabsf(temperature_sensor_calculate_dew_point(25.0f, 50.0f) - 13.9f) < 0.3f);
     return 0;
 }
 
 // Main test function
 int main(void) {
-    printf("Running EdgeTrack tests...\n");
+    printf("Running sensor tests...\n");
 
-    // Initialize logger
-    if (test_logger_init() != 0) {
-        printf("Logger initialization test failed\n");
+    if (test_sensor_init() != 0) {
+        printf("Sensor initialization test failed\n");
         return 1;
     }
-    printf("Logger initialization test passed\n");
+    printf("Sensor initialization test passed\n");
 
-    // Test sensor creation
-    if (test_sensor_create() != 0) {
-        printf("Sensor creation test failed\n");
+    if (test_string_conversion() != 0) {
+        printf("String conversion test failed\n");
         return 1;
     }
-    printf("Sensor creation test passed\n");
+    printf("String conversion test passed\n");
 
-    // Test temperature sensor creation
-    if (test_temperature_sensor_create() != 0) {
-        printf("Temperature sensor creation test failed\n");
+    if (test_temperature_sensor_read() != 0) {
+        printf("Temperature sensor read test failed\n");
         return 1;
     }
-    printf("Temperature sensor creation test passed\n");
+    printf("Temperature sensor read test passed\n");
 
-    // Test temperature sensor control
-    if (test_temperature_sensor_control() != 0) {
-        printf("Temperature sensor control test failed\n");
+    if (test_dew_point() != 0) {
+        printf("Dew point test failed\n");
         return 1;
     }
-    printf("Temperature sensor control test passed\n");
+    printf("Dew point test passed\n");
 
-    // Test error handling
-    if (test_error_handling() != 0) {
-        printf("Error handling test failed\n");
-        return 1;
-    }
-    printf("Error handling test passed\n");
-
-    // Cleanup
-    logger_cleanup();
-
-    printf("All tests passed successfully!\n");
+    printf("All sensor tests passed\n");
     return 0;
-} 
\ No newline at end of file
+}
@@ -0,0 +1,133 @@
+/**
+ * @file edgetrack_export.c
+ * @brief Export chunk log history to an Apache Arrow IPC file
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Opens the chunk log read-only, so it can run next to the live logger, and writes the
+ * selected sensor and time range as an Arrow IPC file for pandas, Polars, DuckDB or
+ * Apache.Arrow for .NET.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include "../include/chunk_log.h"
+#include "../include/arrow_export.h"
+
+// Forward declarations of private functions
+static void print_usage(const char* program);
+static bool parse_time(const char* text, uint32_t* value);
+
+int main(int argc, char** argv) {
+    static const struct option long_options[] = {
+        { "data",   required_argument, NULL, 'd' },
+        { "sensor", required_argument, NULL, 's' },
+        { "from",   required_argument, NULL, 'f' },
+        { "to",     required_argument, NULL, 't' },
+        { "help",   no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    const char* data_dir = "data";
+    const char* sensor_id = NULL;
+    uint32_t from = 0;
+    uint32_t to = UINT32_MAX;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "d:s:f:t:h", long_options, NULL)) != -1) {
+        switch (option) {
+            case 'd':
+                data_dir = optarg;
+                break;
+            case 's':
+                sensor_id = optarg;
+                break;
+            case 'f':
+                if (!parse_time(optarg, &from)) {
+                    fprintf(stderr, "Error: invalid start time %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 't':
+                if (!parse_time(optarg, &to)) {
+                    fprintf(stderr, "Error: invalid end time %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind != argc - 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    ChunkLogConfig config;
+    chunk_log_get_default_config(&config);
+    snprintf(config.data_file, sizeof(config.data_file), "%s/samples.dat", data_dir);
+    snprintf(config.index_file, sizeof(config.index_file), "%s/samples.idx", data_dir);
+    config.read_only = true;
+
+    if (!chunk_log_init(&config)) {
+        fprintf(stderr, "Error: Could not open chunk log in %s\n", data_dir);
+        return 1;
+    }
+
+    struct timespec start_time, end_time;
+    ArrowExportStats stats;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    bool result = arrow_export_chunk_log(argv[optind], sensor_id, from, to, &stats);
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    uint32_t skipped_chunks = chunk_log_skipped_chunks();
+    chunk_log_cleanup();
+    if (skipped_chunks > 0) {
+        fprintf(stderr, "Warning: skipped %u damaged chunks\n", skipped_chunks);
+    }
+
+    if (!result) {
+        fprintf(stderr, "Error: Could not export to %s\n", argv[optind]);
+        return 1;
+    }
+
+    double elapsed = (double)(end_time.tv_sec - start_time.tv_sec) +
+                     (double)(end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+
+    printf("Export Statistics:\n");
+    printf("  Rows: %llu\n", (unsigned long long)stats.rows);
+    printf("  Record Batches: %u\n", stats.batches);
+    printf("  File Size: %llu bytes\n", (unsigned long long)stats.bytes);
+    printf("  Elapsed: %.3f s\n", elapsed);
+
+    return 0;
+}
+
+// Private helper functions
+static void print_usage(const char* program) {
+    printf("Usage: %s [options] OUTPUT.arrow\n", program);
+    printf("Export chunk log samples to an Apache Arrow IPC file.\n\n");
+    printf("Options:\n");
+    printf("  -d, --data DIR    Directory holding samples.dat and samples.idx (default: data)\n");
+    printf("  -s, --sensor ID   Export only this sensor (default: all sensors)\n");
+    printf("  -f, --from T      First time to export, Unix seconds\n");
+    printf("  -t, --to T        Last time to export, Unix seconds\n");
+    printf("  -h, --help        Show this help message\n");
+}
+
+static bool parse_time(const char* text, uint32_t* value) {
+    char* end;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || parsed > UINT32_MAX) {
+        return false;
+    }
+    *value = (uint32_t)parsed;
+    return true;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file edgetrack_motif.c
+ * @brief Find motifs and discords in chunk log history with the matrix profile
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Opens the chunk log read-only, so it can run next to the live logger, computes the
+ * matrix profile of one sensor's history and prints its closest recurring patterns and
+ * its most unusual stretches. Flat stretches and the straight lines interpolation draws
+ * across compressed history are left out of both.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include "../include/chunk_log.h"
+#include "../include/matrix_profile.h"
+
+#define MOTIF_MAX_TOP 64
+
+// Forward declarations of private functions
+static void print_usage(const char* program);
+static bool parse_number(const char* text, uint32_t* value);
+static const char* format_time(uint32_t timestamp, char* buffer, size_t size);
+static void print_matches(const char* title, const MatrixProfileMatch* matches, uint32_t count, bool motifs);
+
+int main(int argc, char** argv) {
+    static const struct option long_options[] = {
+        { "data",    required_argument, NULL, 'd' },
+        { "sensor",  required_argument, NULL, 's' },
+        { "from",    required_argument, NULL, 'f' },
+        { "to",      required_argument, NULL, 't' },
+        { "window",  required_argument, NULL, 'w' },
+        { "period",  required_argument, NULL, 'p' },
+        { "threads", required_argument, NULL, 'j' },
+        { "budget",  required_argument, NULL, 'b' },
+        { "top",     required_argument, NULL, 'n' },
+        { "help",    no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    const char* data_dir = "data";
+    const char* sensor_id = NULL;
+    uint32_t from = 0;
+    uint32_t to = UINT32_MAX;
+    uint32_t top = 3;
+    MatrixProfileConfig profile_config;
+    matrix_profile_get_default_config(&profile_config);
+
+    int option;
+    while ((option = getopt_long(argc, argv, "d:s:f:t:w:p:j:b:n:h", long_options, NULL)) != -1) {
+        bool valid = true;
+        switch (option) {
+            case 'd':
+                data_dir = optarg;
+                break;
+            case 's':
+                sensor_id = optarg;
+                break;
+            case 'f':
+                valid = parse_number(optarg, &from);
+                break;
+            case 't':
+                valid = parse_number(optarg, &to);
+                break;
+            case 'w':
+                valid = parse_number(optarg, &profile_config.window);
+                break;
+            case 'p':
+                valid = parse_number(optarg, &profile_config.period_s);
+                break;
+            case 'j':
+                valid = parse_number(optarg, &profile_config.threads);
+                break;
+            case 'b': {
+                char* end;
+                profile_config.time_budget_s = strtof(optarg, &end);
+                valid = *optarg != '\0' && *end == '\0' && profile_config.time_budget_s >= 0.0f;
+                break;
+            }
+            case 'n':
+                valid = parse_number(optarg, &top) && top > 0 && top <= MOTIF_MAX_TOP;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+        if (!valid) {
+            fprintf(stderr, "Error: invalid value %s for -%c\n", optarg, option);
+            return 1;
+        }
+    }
+
+    if (!sensor_id || optind != argc) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    MatrixProfile profile;
+    if (!matrix_profile_init(&profile, &profile_config)) {
+        fprintf(stderr, "Error: invalid matrix profile configuration\n");
+        return 1;
+    }
+
+    ChunkLogConfig config;
+    chunk_log_get_default_config(&config);
+    snprintf(config.data_file, sizeof(config.data_file), "%s/samples.dat", data_dir);
+    snprintf(config.index_file, sizeof(config.index_file), "%s/samples.idx", data_dir);
+    config.read_only = true;
+
+    if (!chunk_log_init(&config)) {
+        fprintf(stderr, "Error: Could not open chunk log in %s\n", data_dir);
+        matrix_profile_free(&profile);
+        return 1;
+    }
+    bool loaded = matrix_profile_load(&profile, sensor_id, from, to);
+    uint32_t skipped_chunks = chunk_log_skipped_chunks();
+    chunk_log_cleanup();
+    if (skipped_chunks > 0) {
+        fprintf(stderr, "Warning: skipped %u damaged chunks\n", skipped_chunks);
+    }
+
+    if (!loaded) {
+        fprintf(stderr, "Error: Could not read the history of %s\n", sensor_id);
+        matrix_profile_free(&profile);
+        return 1;
+    }
+    if (matrix_profile_subsequences(&profile) == 0) {
+        fprintf(stderr, "Error: %s has %u points, fewer than the window of %u\n", sensor_id,
+                profile.length, profile.config.window);
+        matrix_profile_free(&profile);
+        return 1;
+    }
+
+    struct timespec start_time, end_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    float coverage = matrix_profile_compute(&profile);
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    if (coverage < 0.0f) {
+        fprintf(stderr, "Error: Could not compute the matrix profile\n");
+        matrix_profile_free(&profile);
+        return 1;
+    }
+
+    double elapsed = (double)(end_time.tv_sec - start_time.tv_sec) +
+                     (double)(end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+
+    printf("Matrix Profile of %s:\n", sensor_id);
+    printf("  Points: %u every %u s\n", profile.length, profile.config.period_s);
+    printf("  Window: %u points\n", profile.config.window);
+    printf("  Threads: %u\n", profile.config.threads);
+    printf("  Coverage: %.1f%%%s\n", coverage * 100.0f, coverage < 1.0f ? " (approximate)" : "");
+    printf("  Elapsed: %.3f s\n\n", elapsed);
+
+    MatrixProfileMatch matches[MOTIF_MAX_TOP];
+    print_matches("Motifs", matches, matrix_profile_motifs(&profile, matches, top), true);
+    print_matches("Discords", matches, matrix_profile_discords(&profile, matches, top), false);
+
+    matrix_profile_free(&profile);
+    return 0;
+}
+
+// Private helper functions
+static void print_usage(const char* program) {
+    printf("Usage: %s --sensor ID [options]\n", program);
+    printf("Find recurring patterns (motifs) and unusual stretches (discords) in a sensor's history.\n\n");
+    printf("Options:\n");
+    printf("  -d, --data DIR     Directory holding samples.dat and samples.idx (default: data)\n");
+    printf("  -s, --sensor ID    Sensor to analyze\n");
+    printf("  -f, --from T       First time to analyze, Unix seconds\n");
+    printf("  -t, --to T         Last time to analyze, Unix seconds\n");
+    printf("  -w, --window N     Pattern length in points (default: 3600)\n");
+    printf("  -p, --period S     Seconds between points (default: 1)\n");
+    printf("  -j, --threads N    Worker threads (default: one per CPU)\n");
+    printf("  -b, --budget S     Stop after S seconds with an approximate profile (default: exact)\n");
+    printf("  -n, --top N        Motifs and discords to print (default: 3)\n");
+    printf("  -h, --help         Show this help message\n");
+}
+
+static bool parse_number(const char* text, uint32_t* value) {
+    char* end;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || parsed > UINT32_MAX) {
+        return false;
+    }
+    *value = (uint32_t)parsed;
+    return true;
+}
+
+static const char* format_time(uint32_t timestamp, char* buffer, size_t size) {
+    time_t seconds = (time_t)timestamp;
+    struct tm utc;
+    gmtime_r(&seconds, &utc);
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &utc);
+    return buffer;
+}
+
+static void print_matches(const char* title, const MatrixProfileMatch* matches, uint32_t count, bool motifs) {
+    char first[32];
+    char second[32];
+    printf("%s:\n", title);
+    for (uint32_t i = 0; i < count; i++) {
+        printf("  %u. %s %s %s (distance %.2f)\n", i + 1,
+               format_time(matches[i].timestamp, first, sizeof(first)),
+               motifs ? "matches" : "nearest",
+               format_time(matches[i].neighbor_timestamp, second, sizeof(second)), matches[i].distance);
+    }
+    if (count == 0) {
+        printf("  none\n");
+    }
+}
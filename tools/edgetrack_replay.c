@@ -0,0 +1,671 @@
+/**
+ * @file edgetrack_replay.c
+ * @brief Replay recorded samples through the processing pipeline
+ * @author ELYES
+ * @copyright Copyright (c) ELYES 2024-2025. All rights reserved.
+ *
+ * Reads data log segments (CSV) or chunk log data files and feeds every sample, in time
+ * order, through the same analytics stages the live system uses, optionally followed by
+ * storage sinks. Replay runs in real time, at a multiple of real time, or as fast as the
+ * pipeline can absorb the samples, and reports end-to-end throughput and the monitoring
+ * events raised when done.
+ *
+ * Storage keeps only the points compression forwards, so replaying it feeds the
+ * analytics fewer, irregularly spaced samples than the live system saw; events that
+ * depend on every sample (anomaly, change points, forecasts) can differ from the live
+ * ones unless the sensors were stored without compression.
+ *
+ * Recorded samples carry no sensor location, which the correlation and operating-state
+ * stages group by; pass the map the live system writes next to its data log with
+ * --locations to reproduce those groups.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/sensor.h"
+#include "../include/pipeline.h"
+#include "../include/pipeline_stages.h"
+#include "../include/event_queue.h"
+#include "../include/value_cache.h"
+#include "../include/chunk_log.h"
+#include "../include/rollup.h"
+#include "../include/sensor_table.h"
+
+#define REPLAY_MAX_SENSORS 4096   ///< Distinct sensors in one replay (power of two)
+#define REPLAY_EVENT_TYPES (EVENT_STATE_CHANGE + 1)   ///< Number of monitoring event types
+
+// Replay options
+typedef struct {
+    double speed;           ///< Multiple of real time, 0 for as fast as possible
+    const char* output_dir; ///< Directory for replayed storage, NULL for none
+    const char* locations;  ///< Sensor location map (CSV), NULL for none
+    bool quiet;             ///< Suppress the per-file progress lines
+} ReplayOptions;
+
+// Location of a recorded sensor
+typedef struct {
+    char id[32];
+    char location[64];
+} SensorLocation;
+
+// Replay state shared by all inputs
+typedef struct {
+    ReplayOptions options;
+    Sensor sensors[REPLAY_MAX_SENSORS];
+    SensorLocation sensor_locations[REPLAY_MAX_SENSORS];
+    bool clock_started;
+    uint32_t first_timestamp;
+    struct timespec clock_origin;
+    struct timespec start_time;
+    uint64_t samples;
+    uint64_t rejected;
+    uint64_t skipped_chunks;
+    uint64_t events[REPLAY_EVENT_TYPES];
+    uint32_t flush_timestamp;
+} ReplayState;
+
+// Chunk being merged into the replay stream
+typedef struct {
+    ChunkHeader header;
+    uint32_t* timestamps;
+    float* values;
+    uint32_t position;
+} ChunkCursor;
+
+// Location of a chunk in a data file
+typedef struct {
+    uint64_t offset;
+    uint32_t t_min;
+} ChunkLocation;
+
+// Forward declarations of private functions
+static void print_usage(const char* program);
+static bool load_locations(ReplayState* state, const char* path);
+static bool replay_csv(ReplayState* state, const char* path);
+static bool replay_chunks(ReplayState* state, const char* path);
+static void deliver(ReplayState* state, const char* sensor_id, SensorType type, const SensorData* data);
+static void pace(ReplayState* state, uint32_t timestamp);
+static void flush_outputs(ReplayState* state, uint32_t timestamp);
+static Sensor* lookup_sensor(ReplayState* state, const char* id, SensorType type);
+static bool parse_timestamp(const char* text, uint32_t* timestamp);
+static bool chunk_log_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool rollup_stage(const Sensor* sensor, const SensorData* data, void* context);
+static bool cursor_before(const ChunkCursor* a, const ChunkCursor* b);
+static void heap_push(ChunkCursor** heap, size_t* size, ChunkCursor* cursor);
+static ChunkCursor* heap_pop(ChunkCursor** heap, size_t* size);
+static int compare_locations(const void* a, const void* b);
+
+// Replay state instance; large enough to keep off the stack
+static ReplayState state;
+
+int main(int argc, char** argv) {
+    static const struct option long_options[] = {
+        { "speed",    required_argument, NULL, 's' },
+        { "realtime", no_argument,       NULL, 'r' },
+        { "fast",     no_argument,       NULL, 'f' },
+        { "output",   required_argument, NULL, 'o' },
+        { "locations", required_argument, NULL, 'l' },
+        { "quiet",    no_argument,       NULL, 'q' },
+        { "help",     no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    state.options.speed = 0.0;
+    state.options.output_dir = NULL;
+    state.options.locations = NULL;
+    state.options.quiet = false;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "s:rfo:l:qh", long_options, NULL)) != -1) {
+        switch (option) {
+            case 's':
+                state.options.speed = strtod(optarg, NULL);
+                if (state.options.speed < 0.0) {
+                    fprintf(stderr, "Error: speed must not be negative\n");
+                    return 1;
+                }
+                break;
+            case 'r':
+                state.options.speed = 1.0;
+                break;
+            case 'f':
+                state.options.speed = 0.0;
+                break;
+            case 'o':
+                state.options.output_dir = optarg;
+                break;
+            case 'l':
+                state.options.locations = optarg;
+                break;
+            case 'q':
+                state.options.quiet = true;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind >= argc) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (state.options.locations && !load_locations(&state, state.options.locations)) {
+        fprintf(stderr, "Error: Could not read sensor locations from %s\n", state.options.locations);
+        return 1;
+    }
+
+    // Optional storage sinks writing the replayed stream to a separate directory, ahead
+    // of the analytics as in the live system
+    event_queue_reset();
+    value_cache_reset();
+    if (state.options.output_dir) {
+        ChunkLogConfig chunk_config;
+        chunk_log_get_default_config(&chunk_config);
+        snprintf(chunk_config.data_file, sizeof(chunk_config.data_file), "%s/samples.dat",
+                 state.options.output_dir);
+        snprintf(chunk_config.index_file, sizeof(chunk_config.index_file), "%s/samples.idx",
+                 state.options.output_dir);
+        // Buffer ages are measured in replayed time, see flush_outputs()
+
+        RollupConfig rollup_config;
+        rollup_get_default_config(&rollup_config);
+        strncpy(rollup_config.directory, state.options.output_dir, sizeof(rollup_config.directory) - 1);
+
+        if (!rollup_init(&rollup_config) || !chunk_log_init(&chunk_config)) {
+            fprintf(stderr, "Error: Could not open output storage in %s\n", state.options.output_dir);
+            rollup_cleanup();
+            return 1;
+        }
+        if (!pipeline_register_stage("chunk_log", chunk_log_stage, NULL) ||
+            !pipeline_register_stage("rollup", rollup_stage, NULL)) {
+            fprintf(stderr, "Error: Could not register the storage stages\n");
+            pipeline_clear();
+            chunk_log_cleanup();
+            rollup_cleanup();
+            return 1;
+        }
+    }
+    if (!pipeline_register_default_stages(NULL)) {
+        fprintf(stderr, "Error: Could not initialize the analytics stages\n");
+        pipeline_clear();
+        if (state.options.output_dir) {
+            chunk_log_cleanup();
+            rollup_cleanup();
+        }
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &state.start_time);
+
+    bool result = true;
+    for (int i = optind; i < argc; i++) {
+        const char* path = argv[i];
+        size_t length = strlen(path);
+        bool ok;
+
+        if (length > 4 && strcmp(path + length - 4, ".dat") == 0) {
+            ok = replay_chunks(&state, path);
+        } else {
+            ok = replay_csv(&state, path);
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Error: Could not replay %s\n", path);
+            result = false;
+        } else if (!state.options.quiet) {
+            printf("Replayed %s (%llu samples so far)\n", path, (unsigned long long)state.samples);
+        }
+    }
+
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    double elapsed = (double)(end_time.tv_sec - state.start_time.tv_sec) +
+                     (double)(end_time.tv_nsec - state.start_time.tv_nsec) / 1e9;
+
+    // Stage counters are read before the cleanup clears the pipeline
+    PipelineStageStats stats[PIPELINE_MAX_STAGES];
+    uint32_t stage_count = pipeline_get_stats(stats, PIPELINE_MAX_STAGES);
+    pipeline_cleanup_default_stages();
+    if (state.options.output_dir) {
+        // Buckets whose period ended with the replayed stream close on the last tick
+        rollup_flush(state.flush_timestamp + 1);
+        chunk_log_cleanup();
+        rollup_cleanup();
+    }
+
+    printf("\nReplay Statistics:\n");
+    printf("  Samples: %llu\n", (unsigned long long)state.samples);
+    printf("  Rejected Rows: %llu\n", (unsigned long long)state.rejected);
+    printf("  Skipped Chunks: %llu\n", (unsigned long long)state.skipped_chunks);
+    printf("  Elapsed: %.3f s\n", elapsed);
+    printf("  Throughput: %.0f samples/s\n", elapsed > 0.0 ? (double)state.samples / elapsed : 0.0);
+
+    for (int type = 0; type < REPLAY_EVENT_TYPES; type++) {
+        printf("  %s Events: %llu\n", event_queue_type_to_string((MonitorEventType)type),
+               (unsigned long long)state.events[type]);
+    }
+    printf("  Dropped Events: %llu\n", (unsigned long long)event_queue_dropped());
+    for (uint32_t i = 0; i < stage_count; i++) {
+        printf("  Stage %-15s processed %llu, stopped %llu\n", stats[i].name,
+               (unsigned long long)stats[i].processed, (unsigned long long)stats[i].stopped);
+    }
+
+    return result ? 0 : 1;
+}
+
+// Private helper functions
+static void print_usage(const char* program) {
+    printf("Usage: %s [options] FILE...\n", program);
+    printf("Replay data log segments (*.csv) or chunk log data files (*.dat).\n\n");
+    printf("Options:\n");
+    printf("  -s, --speed N     Replay at N times real time\n");
+    printf("  -r, --realtime    Replay in real time (same as --speed 1)\n");
+    printf("  -f, --fast        Replay as fast as possible (default)\n");
+    printf("  -o, --output DIR  Also write the replayed stream to a chunk log and rollups in DIR\n");
+    printf("  -l, --locations FILE\n");
+    printf("                    Read sensor locations from FILE (Sensor ID,Location lines),\n");
+    printf("                    such as the locations.csv the live system writes\n");
+    printf("  -q, --quiet       Only print the final statistics\n");
+    printf("  -h, --help        Show this help message\n");
+}
+
+static bool load_locations(ReplayState* replay, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    SensorTable table = SENSOR_TABLE_INIT(replay->sensor_locations, REPLAY_MAX_SENSORS, SensorLocation, id);
+    char line[256];
+    bool result = true;
+    while (result && fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || strncmp(line, "Sensor ID,", 10) == 0) {
+            continue;
+        }
+
+        // Sensor ID,Location; the location is the rest of the line
+        char* comma = strchr(line, ',');
+        if (!comma) {
+            result = false;
+            break;
+        }
+        *comma = '\0';
+        SensorLocation* entry = (SensorLocation*)sensor_table_find(&table, line, true, NULL);
+        if (!entry) {
+            result = false;
+            break;
+        }
+        snprintf(entry->location, sizeof(entry->location), "%s", comma + 1);
+    }
+
+    result = result && !ferror(file);
+    fclose(file);
+    return result;
+}
+
+static bool replay_csv(ReplayState* replay, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    char line[512];
+    bool header = true;
+    while (fgets(line, sizeof(line), file)) {
+        if (header) {
+            header = false;
+            if (strncmp(line, "Timestamp,", 10) == 0) {
+                continue;
+            }
+        }
+
+        // Timestamp,Sensor ID,Sensor Type,Value,Unit,Valid,Error
+        char* fields[7];
+        int count = 0;
+        char* cursor = line;
+        line[strcspn(line, "\r\n")] = '\0';
+        while (count < 7) {
+            fields[count++] = cursor;
+            char* comma = strchr(cursor, ',');
+            if (!comma) {
+                break;
+            }
+            *comma = '\0';
+            cursor = comma + 1;
+        }
+
+        SensorType type;
+        SensorData data;
+        memset(&data, 0, sizeof(data));
+        if (count < 7 || !parse_timestamp(fields[0], &data.timestamp) ||
+            !sensor_string_to_type(fields[2], &type)) {
+            replay->rejected++;
+            continue;
+        }
+
+        char* end;
+        data.type = type;
+        data.value = strtof(fields[3], &end);
+        if (end == fields[3]) {
+            replay->rejected++;
+            continue;
+        }
+        strncpy(data.unit, fields[4], sizeof(data.unit) - 1);
+        data.is_valid = strcmp(fields[5], "Valid") == 0;
+        if (!sensor_string_to_error(fields[6], &data.error)) {
+            data.error = SENSOR_ERROR_NONE;
+        }
+
+        deliver(replay, fields[1], type, &data);
+    }
+
+    bool result = !ferror(file);
+    fclose(file);
+    return result;
+}
+
+static bool replay_chunks(ReplayState* replay, const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    off_t file_size = lseek(fd, 0, SEEK_END);
+    if (file_size < 0) {
+        close(fd);
+        return false;
+    }
+
+    // Locate every chunk from its header; chunks are found by walking from one to the
+    // next, so the walk ends at the first damaged header or a torn tail
+    size_t location_count = 0;
+    size_t location_capacity = 0;
+    ChunkLocation* locations = NULL;
+    uint64_t offset = 0;
+    ChunkHeader header;
+    while (pread(fd, &header, sizeof(header), (off_t)offset) == (ssize_t)sizeof(header) &&
+           chunk_log_verify_chunk(&header, NULL) &&
+           offset + sizeof(ChunkHeader) + (uint64_t)header.count * (sizeof(uint32_t) + sizeof(float)) <=
+               (uint64_t)file_size) {
+        if (location_count == location_capacity) {
+            location_capacity = location_capacity ? location_capacity * 2 : 1024;
+            ChunkLocation* grown = (ChunkLocation*)realloc(locations,
+                                                           location_capacity * sizeof(ChunkLocation));
+            if (!grown) {
+                free(locations);
+                close(fd);
+                return false;
+            }
+            locations = grown;
+        }
+        locations[location_count].offset = offset;
+        locations[location_count].t_min = header.t_min;
+        location_count++;
+        offset += sizeof(ChunkHeader) + (uint64_t)header.count * (sizeof(uint32_t) + sizeof(float));
+    }
+    if (offset < (uint64_t)file_size) {
+        fprintf(stderr, "Warning: %s: ignoring %llu bytes from offset %llu, not a complete chunk\n", path,
+                (unsigned long long)((uint64_t)file_size - offset), (unsigned long long)offset);
+    }
+    qsort(locations, location_count, sizeof(ChunkLocation), compare_locations);
+
+    // Merge chunks by sample time; a chunk is opened once the stream reaches its start
+    ChunkCursor** heap = (ChunkCursor**)malloc((location_count + 1) * sizeof(ChunkCursor*));
+    size_t heap_size = 0;
+    size_t next_location = 0;
+    bool result = heap != NULL;
+
+    while (result && (heap_size > 0 || next_location < location_count)) {
+        if (next_location < location_count &&
+            (heap_size == 0 ||
+             locations[next_location].t_min <= heap[0]->timestamps[heap[0]->position])) {
+            ChunkCursor* cursor = (ChunkCursor*)calloc(1, sizeof(ChunkCursor));
+            uint64_t chunk_offset = locations[next_location++].offset;
+            if (!cursor ||
+                pread(fd, &cursor->header, sizeof(ChunkHeader), (off_t)chunk_offset) !=
+                    (ssize_t)sizeof(ChunkHeader)) {
+                free(cursor);
+                result = false;
+                break;
+            }
+
+            size_t count = cursor->header.count;
+            cursor->timestamps = (uint32_t*)malloc(count * (sizeof(uint32_t) + sizeof(float)));
+            if (!cursor->timestamps ||
+                pread(fd, cursor->timestamps, count * (sizeof(uint32_t) + sizeof(float)),
+                      (off_t)(chunk_offset + sizeof(ChunkHeader))) !=
+                    (ssize_t)(count * (sizeof(uint32_t) + sizeof(float)))) {
+                free(cursor->timestamps);
+                free(cursor);
+                result = false;
+                break;
+            }
+            if (!chunk_log_verify_chunk(&cursor->header, cursor->timestamps)) {
+                fprintf(stderr, "Warning: %s: skipping chunk at offset %llu, CRC mismatch\n", path,
+                        (unsigned long long)chunk_offset);
+                replay->skipped_chunks++;
+                free(cursor->timestamps);
+                free(cursor);
+                continue;
+            }
+            cursor->values = (float*)(cursor->timestamps + count);
+            cursor->header.sensor_id[sizeof(cursor->header.sensor_id) - 1] = '\0';
+            heap_push(heap, &heap_size, cursor);
+            continue;
+        }
+
+        ChunkCursor* cursor = heap_pop(heap, &heap_size);
+        SensorData data;
+        memset(&data, 0, sizeof(data));
+        data.type = (SensorType)cursor->header.sensor_type;
+        data.timestamp = cursor->timestamps[cursor->position];
+        data.value = cursor->values[cursor->position];
+        data.is_valid = true;
+        data.error = SENSOR_ERROR_NONE;
+        deliver(replay, cursor->header.sensor_id, data.type, &data);
+
+        if (++cursor->position < cursor->header.count) {
+            heap_push(heap, &heap_size, cursor);
+        } else {
+            free(cursor->timestamps);
+            free(cursor);
+        }
+    }
+
+    while (heap_size > 0) {
+        ChunkCursor* cursor = heap_pop(heap, &heap_size);
+        free(cursor->timestamps);
+        free(cursor);
+    }
+    free(heap);
+    free(locations);
+    close(fd);
+    return result;
+}
+
+static void deliver(ReplayState* replay, const char* sensor_id, SensorType type, const SensorData* data) {
+    Sensor* sensor = lookup_sensor(replay, sensor_id, type);
+    if (!sensor) {
+        replay->rejected++;
+        return;
+    }
+
+    pace(replay, data->timestamp);
+    flush_outputs(replay, data->timestamp);
+    sensor->sample_count++;
+    // Publish the reading as sensor_read_data() does live, for the rule operands
+    value_cache_update(sensor, data);
+    pipeline_process(sensor, data);
+    replay->samples++;
+
+    // Drain the events after every sample so that the queue never fills up
+    MonitorEvent event;
+    while (event_queue_pop(&event)) {
+        if ((int)event.type >= 0 && (int)event.type < REPLAY_EVENT_TYPES) {
+            replay->events[event.type]++;
+        }
+    }
+}
+
+static void pace(ReplayState* replay, uint32_t timestamp) {
+    if (replay->options.speed <= 0.0) {
+        return;
+    }
+
+    // The first sample anchors recorded time to the wall clock
+    if (!replay->clock_started) {
+        replay->clock_started = true;
+        replay->first_timestamp = timestamp;
+        clock_gettime(CLOCK_MONOTONIC, &replay->clock_origin);
+        return;
+    }
+    if (timestamp <= replay->first_timestamp) {
+        return;
+    }
+
+    double offset = (double)(timestamp - replay->first_timestamp) / replay->options.speed;
+    struct timespec target = replay->clock_origin;
+    target.tv_sec += (time_t)offset;
+    target.tv_nsec += (long)((offset - (double)(time_t)offset) * 1e9);
+    if (target.tv_nsec >= 1000000000L) {
+        target.tv_sec++;
+        target.tv_nsec -= 1000000000L;
+    }
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL) == EINTR) {
+        // Interrupted by a signal, keep waiting
+    }
+}
+
+static void flush_outputs(ReplayState* replay, uint32_t timestamp) {
+    // Replayed time drives the storage sinks as the wall clock does live, once per
+    // replayed second
+    if (!replay->options.output_dir || timestamp <= replay->flush_timestamp) {
+        return;
+    }
+    replay->flush_timestamp = timestamp;
+    chunk_log_flush(timestamp);
+    rollup_flush(timestamp);
+}
+
+static Sensor* lookup_sensor(ReplayState* replay, const char* id, SensorType type) {
+    SensorTable table = SENSOR_TABLE_INIT(replay->sensors, REPLAY_MAX_SENSORS, Sensor, id);
+    bool created;
+    Sensor* sensor = (Sensor*)sensor_table_find(&table, id, true, &created);
+    if (created) {
+        if (!sensor_init(sensor, type, id)) {
+            sensor->id[0] = '\0';
+            return NULL;
+        }
+        SensorTable locations = SENSOR_TABLE_INIT(replay->sensor_locations, REPLAY_MAX_SENSORS,
+                                                  SensorLocation, id);
+        const SensorLocation* entry = (const SensorLocation*)sensor_table_find(&locations, id, false, NULL);
+        if (entry) {
+            sensor_set_location(sensor, entry->location);
+        }
+    }
+    return sensor;
+}
+
+static bool parse_timestamp(const char* text, uint32_t* timestamp) {
+    struct tm fields;
+    memset(&fields, 0, sizeof(fields));
+
+    // Data log time ("%Y-%m-%d %H:%M:%S", local time) or plain Unix seconds
+    if (sscanf(text, "%d-%d-%d %d:%d:%d", &fields.tm_year, &fields.tm_mon, &fields.tm_mday,
+               &fields.tm_hour, &fields.tm_min, &fields.tm_sec) == 6) {
+        fields.tm_year -= 1900;
+        fields.tm_mon -= 1;
+        fields.tm_isdst = -1;
+        time_t value = mktime(&fields);
+        if (value == (time_t)-1) {
+            return false;
+        }
+        *timestamp = (uint32_t)value;
+        return true;
+    }
+
+    char* end;
+    unsigned long value = strtoul(text, &end, 10);
+    if (end == text || *end != '\0') {
+        return false;
+    }
+    *timestamp = (uint32_t)value;
+    return true;
+}
+
+static bool chunk_log_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    chunk_log_append(sensor, data);
+    return true;
+}
+
+static bool rollup_stage(const Sensor* sensor, const SensorData* data, void* context) {
+    (void)context;
+    rollup_add_sample(sensor, data);
+    return true;
+}
+
+static bool cursor_before(const ChunkCursor* a, const ChunkCursor* b) {
+    return a->timestamps[a->position] < b->timestamps[b->position];
+}
+
+static void heap_push(ChunkCursor** heap, size_t* size, ChunkCursor* cursor) {
+    size_t index = (*size)++;
+    heap[index] = cursor;
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!cursor_before(heap[index], heap[parent])) {
+            break;
+        }
+        ChunkCursor* swap = heap[parent];
+        heap[parent] = heap[index];
+        heap[index] = swap;
+        index = parent;
+    }
+}
+
+static ChunkCursor* heap_pop(ChunkCursor** heap, size_t* size) {
+    ChunkCursor* top = heap[0];
+    heap[0] = heap[--(*size)];
+
+    size_t index = 0;
+    for (;;) {
+        size_t left = index * 2 + 1;
+        size_t right = left + 1;
+        size_t smallest = index;
+        if (left < *size && cursor_before(heap[left], heap[smallest])) {
+            smallest = left;
+        }
+        if (right < *size && cursor_before(heap[right], heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            break;
+        }
+        ChunkCursor* swap = heap[smallest];
+        heap[smallest] = heap[index];
+        heap[index] = swap;
+        index = smallest;
+    }
+
+    return top;
+}
+
+static int compare_locations(const void* a, const void* b) {
+    uint32_t left = ((const ChunkLocation*)a)->t_min;
+    uint32_t right = ((const ChunkLocation*)b)->t_min;
+    return (left > right) - (left < right);
+}